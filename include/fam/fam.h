@@ -66,6 +66,7 @@
 
 #include <stdint.h>   // needed for uint64_t etc.
 #include <sys/stat.h> // needed for mode_t
+#include <sys/uio.h>  // needed for struct iovec
 
 #ifdef __cplusplus
 /** C++ Header
@@ -110,6 +111,130 @@ typedef enum {
     RAID5
 } Fam_Redundancy_Level;
 
+/**
+ * Enumeration defining the data types supported by collective operations.
+ */
+typedef enum {
+    /** 32-bit signed integer */
+    FAM_TYPE_INT32 = 0,
+    /** 64-bit signed integer */
+    FAM_TYPE_INT64,
+    /** 32-bit unsigned integer */
+    FAM_TYPE_UINT32,
+    /** 64-bit unsigned integer */
+    FAM_TYPE_UINT64,
+    /** single precision floating point */
+    FAM_TYPE_FLOAT,
+    /** double precision floating point */
+    FAM_TYPE_DOUBLE
+} Fam_Type;
+
+/**
+ * Enumeration defining the operations supported by fam_reduce(),
+ * fam_allreduce() and fam_reduce_item().
+ */
+typedef enum {
+    /** sum of the elements */
+    FAM_REDUCE_SUM = 0,
+    /** product of the elements */
+    FAM_REDUCE_PROD,
+    /** minimum of the elements */
+    FAM_REDUCE_MIN,
+    /** maximum of the elements */
+    FAM_REDUCE_MAX,
+    /** Euclidean norm of the elements, as a double (fam_reduce_item() only) */
+    FAM_REDUCE_NORM
+} Fam_Reduce_Op;
+
+/**
+ * Enumeration defining the updates of the signal word supported by
+ * fam_put_signal().
+ */
+typedef enum {
+    /** replace the signal word with the signal value */
+    FAM_SIGNAL_SET = 0,
+    /** add the signal value to the signal word */
+    FAM_SIGNAL_ADD
+} Fam_Signal_Op;
+
+/**
+ * Enumeration defining the comparisons supported by fam_wait_until() and
+ * related calls.
+ */
+typedef enum {
+    /** equal to the given value */
+    FAM_CMP_EQ = 0,
+    /** not equal to the given value */
+    FAM_CMP_NE,
+    /** greater than the given value */
+    FAM_CMP_GT,
+    /** greater than or equal to the given value */
+    FAM_CMP_GE,
+    /** less than the given value */
+    FAM_CMP_LT,
+    /** less than or equal to the given value */
+    FAM_CMP_LE
+} Fam_Cmp;
+
+/**
+ * Enumeration defining the predicates supported by fam_scan() and
+ * fam_scan_to_item().
+ */
+typedef enum {
+    /** the field lies between the low and high bounds, inclusive */
+    FAM_SCAN_RANGE = 0,
+    /** the field is equal to the low bound */
+    FAM_SCAN_EQUAL
+} Fam_Scan_Op;
+
+/**
+ * Enumeration defining the digests computed by fam_checksum().
+ */
+typedef enum {
+    /** CRC32C (Castagnoli), in the low-order 32 bits */
+    FAM_CHECKSUM_CRC32C = 0,
+    /** 64-bit xxHash (XXH64) with a seed of 0 */
+    FAM_CHECKSUM_XXH64
+} Fam_Checksum_Algo;
+
+/**
+ * Bound of a scan predicate, of the data type of the field
+ */
+typedef union {
+    int32_t i32;
+    int64_t i64;
+    uint32_t u32;
+    uint64_t u64;
+    float f;
+    double d;
+} Fam_Scan_Value;
+
+/**
+ * Predicate on a fixed-width field of the records scanned by fam_scan()
+ */
+typedef struct {
+    /** byte offset of the field within the record */
+    uint64_t fieldOffset;
+    /** data type of the field */
+    Fam_Type type;
+    /** comparison of the field with the bounds */
+    Fam_Scan_Op op;
+    /** lower bound of a range, or value of an equality match */
+    Fam_Scan_Value low;
+    /** upper bound of a range */
+    Fam_Scan_Value high;
+} Fam_Scan_Predicate;
+
+/**
+ * Column of the records copied to the result of fam_scan()
+ */
+typedef struct {
+    /** byte offset of the column within the record */
+    uint64_t offset;
+    /** size of the column */
+    uint64_t size;
+} Fam_Scan_Column;
+
 /**
  * FAM Global descriptor represents both the region and data item in FAM.
  */
@@ -123,6 +248,41 @@ typedef struct {
     uint64_t offset;
 } Fam_Global_Descriptor;
 
+/**
+ * Capability handed out by the memory server for a data item, once it checked
+ * the permission of a user on it. A PE of that user holding a capability which
+ * has not expired uses its key without checking permission with the memory
+ * server again. The expiry only bounds how long a PE relies on the capability:
+ * the memory server honours the key for as long as the data item is
+ * registered, as it does for keys obtained otherwise.
+ */
+typedef struct {
+    /** libfabric access key */
+    uint64_t key;
+    /** size of the data item */
+    uint64_t size;
+    /** 1 if the key allows read-write access, 0 for read-only access */
+    uint64_t perm;
+    /** time (seconds since epoch) after which the capability is not valid;
+     * 0 if there is no capability */
+    uint64_t expiry;
+    /** user and group whose permission was checked */
+    uint32_t uid;
+    uint32_t gid;
+} Fam_Capability;
+
+/**
+ * Size in bytes of a data item descriptor serialized with
+ * fam_descriptor_serialize()
+ */
+#define FAM_DESCRIPTOR_SERIALIZED_SIZE 88
+
+/**
+ * Opaque handle of a subscription to the changes of a range of a data item,
+ * returned by fam_watch()
+ */
+class Fam_Watch;
+
 /**
  * Structure defining a FAM descriptor. Descriptors are PE independent data
  * structures that enable the OpenFAM library to uniquely locate an area of
@@ -157,6 +317,10 @@ class Fam_Descriptor {
     uint64_t get_size();
     // get memory server id
     uint64_t get_memserver_id();
+    // set capability
+    void set_capability(Fam_Capability cap);
+    // get capability
+    Fam_Capability get_capability();
 
   private:
     class FamDescriptorImpl_;
@@ -237,6 +401,17 @@ typedef struct {
     char *numConsumer;
     /** FAM runtime - Default, pmix*/
     char *runtime;
+    /** Memory server address exchange - RPC (default): every PE requests the
+     * addresses from the memory servers, RUNTIME: PE 0 requests them and
+     * shares them with other PEs through the PMI runtime */
+    char *addrExchange;
+    /** Barrier algorithm - RUNTIME (default): barrier of the PMI runtime,
+     * FAM: dissemination barrier using atomics on a data item in FAM */
+    char *barrier;
+    /** Waiting in fam_wait_until - POLL (default): the PE polls the location
+     * with exponential backoff, SERVER: the memory server watches the
+     * location and replies once the condition is met */
+    char *waitMode;
 } Fam_Options;
 
 class fam {
@@ -273,6 +448,45 @@ class fam {
      */
     void fam_barrier_all();
 
+    /**
+     * Collective call which copies a buffer of the root PE into the buffer of
+     * every other PE.
+     * @param data - buffer holding the data on the root PE, and receiving it
+     * on other PEs
+     * @param nbytes - size of the buffer
+     * @param root - PE broadcasting the data
+     */
+    void fam_broadcast(void *data, uint64_t nbytes, int root);
+
+    /**
+     * Collective call which combines the elements of the source buffers of
+     * all PEs with the given operation, and stores the result in the
+     * destination buffer of the root PE.
+     * @param dest - buffer receiving the result on the root PE
+     * @param src - buffer holding the elements of the calling PE
+     * @param nElements - number of elements in the buffers
+     * @param type - data type of the elements
+     * @param op - reduction operation
+     * @param root - PE receiving the result
+     * @see #fam_allreduce
+     */
+    void fam_reduce(void *dest, const void *src, uint64_t nElements,
+                    Fam_Type type, Fam_Reduce_Op op, int root);
+
+    /**
+     * Collective call which combines the elements of the source buffers of
+     * all PEs with the given operation, and stores the result in the
+     * destination buffer of every PE.
+     * @param dest - buffer receiving the result
+     * @param src - buffer holding the elements of the calling PE
+     * @param nElements - number of elements in the buffers
+     * @param type - data type of the elements
+     * @param op - reduction operation
+     * @see #fam_reduce
+     */
+    void fam_allreduce(void *dest, const void *src, uint64_t nElements,
+                       Fam_Type type, Fam_Reduce_Op op);
+
     /**
      * List known options for this version of the library. Provides a way for
      * programs to check which options are known to the library.
@@ -309,6 +523,66 @@ class fam {
      */
     Fam_Descriptor *fam_lookup(const char *itemName, const char *regionName);
 
+    /**
+     * look up multiple data items of a region in FAM by name in the name
+     * service, with a single request to the memory server.
+     * @param itemNames - array of names of the data items
+     * @param nItems - number of data items
+     * @param regionName - name of the region containing the data items
+     * @param descriptors - array of nItems, filled with descriptors to the
+     * data items
+     * @see #fam_lookup
+     */
+    void fam_lookup_batch(const char **itemNames, uint64_t nItems,
+                          const char *regionName, Fam_Descriptor **descriptors);
+
+    /**
+     * Resolve the access key and size of multiple data item descriptors ahead
+     * of their first use, with a single request per memory server.
+     * @param descriptors - array of data item descriptors
+     * @param nItems - number of descriptors
+     * @see #fam_lookup_batch
+     */
+    void fam_prepare(Fam_Descriptor **descriptors, uint64_t nItems);
+
+    /**
+     * Serialize a data item descriptor into a buffer, so that it can be sent
+     * to other PEs. The serialized descriptor holds the global descriptor,
+     * access key, size, memory server id and capability of the data item.
+     * @param descriptor - descriptor associated with some data item
+     * @param buffer - buffer of at least FAM_DESCRIPTOR_SERIALIZED_SIZE bytes
+     * @param len - on input the size of buffer, on return the number of bytes
+     * written
+     * @see #fam_descriptor_deserialize
+     */
+    void fam_descriptor_serialize(Fam_Descriptor *descriptor, void *buffer,
+                                  size_t *len);
+
+    /**
+     * Create a data item descriptor from a buffer filled by
+     * fam_descriptor_serialize(), possibly on another PE. PEs of another user
+     * than the one the descriptor was serialized by check their permission
+     * with the memory server on first access.
+     * @param buffer - serialized descriptor
+     * @param len - size of the serialized descriptor
+     * @return - data item descriptor
+     * @see #fam_descriptor_serialize
+     */
+    Fam_Descriptor *fam_descriptor_deserialize(const void *buffer, size_t len);
+
+    /**
+     * Collective call which broadcasts a data item descriptor from the root PE
+     * to all the PEs, so that only the root has to look up the data item.
+     * @param root - PE holding the descriptor
+     * @param descriptor - descriptor associated with some data item on the
+     * root PE, ignored on other PEs
+     * @return - descriptor on the root PE, a new data item descriptor on other
+     * PEs
+     * @see #fam_descriptor_serialize
+     */
+    Fam_Descriptor *fam_broadcast_descriptor(int root,
+                                             Fam_Descriptor *descriptor);
+
     // ALLOCATION Group
 
     /**
@@ -382,6 +656,35 @@ class fam {
      */
     void fam_deallocate(Fam_Descriptor *descriptor);
 
+    /**
+     * Allocate multiple data items within a region, with a single request to
+     * the memory server holding the region. Either all the data items are
+     * allocated, or none of them.
+     * @param nItems - number of data items
+     * @param sizes - array of nItems sizes, in bytes
+     * @param names - (optional) array of nItems names of the data items; null,
+     * or null entries, for unnamed data items
+     * @param accessPermissions - permissions associated with the data items
+     * @param region - descriptor of the region within which the data items are
+     * allocated
+     * @param descriptors - array of nItems, filled with descriptors to the
+     * data items
+     * @see #fam_allocate()
+     * @see #fam_deallocate_batch()
+     */
+    void fam_allocate_batch(uint64_t nItems, const uint64_t *sizes,
+                            const char **names, mode_t accessPermissions,
+                            Fam_Region_Descriptor *region,
+                            Fam_Descriptor **descriptors);
+
+    /**
+     * Deallocate multiple data items, with a single request per memory server.
+     * @param descriptors - array of descriptors associated with the data items
+     * @param nItems - number of data items
+     * @see #fam_allocate_batch()
+     */
+    void fam_deallocate_batch(Fam_Descriptor **descriptors, uint64_t nItems);
+
     /**
      * Change permissions associated with a data item descriptor.
      * @param descriptor - descriptor associated with some data item
@@ -476,6 +779,27 @@ class fam {
     void fam_put_nonblocking(void *local, Fam_Descriptor *descriptor,
                              uint64_t offset, uint64_t nbytes);
 
+    /**
+     * Copy data from local memory to FAM and then update a signal word, so
+     * that a PE which observes the signal update also observes the data.
+     * Blocks until the data is written.
+     * @param local - pointer to local memory. Must point to valid data in local
+     * memory
+     * @param descriptor - valid descriptor in FAM
+     * @param offset - byte offset within the region defined by the descriptor
+     * to where data should be copied
+     * @param nbytes - number of bytes to be copied from local to FAM
+     * @param sigDescriptor - valid descriptor of the data item holding the
+     * signal word
+     * @param sigOffset - byte offset of the 64-bit signal word
+     * @param sigValue - value used to update the signal word
+     * @param op - update of the signal word, set or add
+     */
+    void fam_put_signal(void *local, Fam_Descriptor *descriptor,
+                        uint64_t offset, uint64_t nbytes,
+                        Fam_Descriptor *sigDescriptor, uint64_t sigOffset,
+                        uint64_t sigValue, Fam_Signal_Op op);
+
     // LOAD/STORE sub-group
 
     /**
@@ -659,6 +983,110 @@ class fam {
                                  uint64_t nElements, uint64_t *elementIndex,
                                  uint64_t elementSize);
 
+    /**
+     * Copy a subarray of up to 3 dimensions, e.g. a tile of a matrix, from FAM
+     * to local memory, blocking while the copy is complete.
+     * @param local - pointer to local memory receiving the subarray
+     * @param descriptor - valid descriptor containing FAM reference
+     * @param offset - byte offset within the data item of the first element
+     * @param elementSize - size of the element in bytes
+     * @param nDims - number of dimensions of the subarray
+     * @param shape - number of elements along each dimension, outermost first
+     * @param famStrides - distance in elements between consecutive elements
+     * along each dimension in FAM
+     * @param localStrides - distance in elements between consecutive elements
+     * along each dimension in local memory; NULL if the subarray is packed
+     * @return - 0 for normal completion, 1 in case of unsuccessful completion,
+     * negative number in case of exception
+     * @see #fam_put_subarray
+     */
+    int fam_get_subarray(void *local, Fam_Descriptor *descriptor,
+                         uint64_t offset, uint64_t elementSize, uint64_t nDims,
+                         const uint64_t *shape, const uint64_t *famStrides,
+                         const uint64_t *localStrides = NULL);
+
+    /**
+     * Copy a subarray of up to 3 dimensions, e.g. a tile of a matrix, from
+     * local memory to FAM, blocking while the copy is complete.
+     * @param local - pointer to local memory containing the subarray
+     * @param descriptor - valid descriptor containing FAM reference
+     * @param offset - byte offset within the data item of the first element
+     * @param elementSize - size of the element in bytes
+     * @param nDims - number of dimensions of the subarray
+     * @param shape - number of elements along each dimension, outermost first
+     * @param famStrides - distance in elements between consecutive elements
+     * along each dimension in FAM
+     * @param localStrides - distance in elements between consecutive elements
+     * along each dimension in local memory; NULL if the subarray is packed
+     * @return - 0 for normal completion, 1 in case of unsuccessful completion,
+     * negative number in case of exception
+     * @see #fam_get_subarray
+     */
+    int fam_put_subarray(void *local, Fam_Descriptor *descriptor,
+                         uint64_t offset, uint64_t elementSize, uint64_t nDims,
+                         const uint64_t *shape, const uint64_t *famStrides,
+                         const uint64_t *localStrides = NULL);
+
+    /**
+     * Gather variable-length records of a data item in FAM to local buffers,
+     * blocking while the copy is complete. Each record has the length of the
+     * local buffer receiving it.
+     * @param localIov - local buffers receiving the records
+     * @param descriptor - valid descriptor containing FAM reference
+     * @param offsets - byte offsets of the records within the data item
+     * @param nIov - number of records
+     * @return - 0 for normal completion, 1 in case of unsuccessful completion,
+     * negative number in case of exception
+     * @see #fam_scatter_iov_blocking
+     */
+    int fam_gather_iov_blocking(struct iovec *localIov,
+                                Fam_Descriptor *descriptor,
+                                uint64_t *offsets, uint64_t nIov);
+
+    /**
+     * Initiate a gather of variable-length records of a data item in FAM to
+     * local buffers, return before completion. Use fam_quiet() to wait for
+     * the completion of the copy.
+     * @param localIov - local buffers receiving the records
+     * @param descriptor - valid descriptor containing FAM reference
+     * @param offsets - byte offsets of the records within the data item
+     * @param nIov - number of records
+     * @see #fam_scatter_iov_nonblocking
+     */
+    void fam_gather_iov_nonblocking(struct iovec *localIov,
+                                    Fam_Descriptor *descriptor,
+                                    uint64_t *offsets, uint64_t nIov);
+
+    /**
+     * Scatter local buffers to variable-length records of a data item in
+     * FAM, blocking while the copy is complete. Each record has the length of
+     * the local buffer it is copied from.
+     * @param localIov - local buffers containing the records
+     * @param descriptor - valid descriptor containing FAM reference
+     * @param offsets - byte offsets of the records within the data item
+     * @param nIov - number of records
+     * @return - 0 for normal completion, 1 in case of unsuccessful completion,
+     * negative number in case of exception
+     * @see #fam_gather_iov_blocking
+     */
+    int fam_scatter_iov_blocking(struct iovec *localIov,
+                                 Fam_Descriptor *descriptor,
+                                 uint64_t *offsets, uint64_t nIov);
+
+    /**
+     * Initiate a scatter of local buffers to variable-length records of a
+     * data item in FAM, return before completion. Use fam_quiet() to wait for
+     * the completion of the copy.
+     * @param localIov - local buffers containing the records
+     * @param descriptor - valid descriptor containing FAM reference
+     * @param offsets - byte offsets of the records within the data item
+     * @param nIov - number of records
+     * @see #fam_gather_iov_nonblocking
+     */
+    void fam_scatter_iov_nonblocking(struct iovec *localIov,
+                                     Fam_Descriptor *descriptor,
+                                     uint64_t *offsets, uint64_t nIov);
+
     // COPY Subgroup
 
     /**
@@ -675,11 +1103,161 @@ class fam {
     void *fam_copy(Fam_Descriptor *src, uint64_t srcOffset,
                    Fam_Descriptor **dest, uint64_t destOffset, uint64_t nbytes);
 
+    /**
+     * Copy data from one FAM-resident data item into an existing data item,
+     * without allocating a new one. The destination may be held by another
+     * memory server, which the source's memory server writes to directly; it
+     * must then be started with the list of memory servers.
+     * @param src - valid descriptor to source data item in FAM.
+     * @param srcOffset - byte offset within the space defined by the src
+     * descriptor from which memory should be copied.
+     * @param dest - valid descriptor to the existing destination data item.
+     * @param destOffset - byte offset within the space defined by the dest
+     * descriptor to which memory should be copied.
+     * @param nbytes - number of bytes to be copied
+     * @return - wait object of the copy, see fam_copy_wait()
+     */
+    void *fam_copy(Fam_Descriptor *src, uint64_t srcOffset,
+                   Fam_Descriptor *dest, uint64_t destOffset, uint64_t nbytes);
+
     /**
      * Wait for copy operation correspond to the wait object passed to complete
      * @param waitObj - unique tag to copy operation
      */
     void fam_copy_wait(void *waitObj);
+
+    /**
+     * Set a range of a data item in FAM to a byte value. The memory server
+     * fills the range locally, so the bytes are not sent over the fabric.
+     * Returns before completion; use fam_fill_wait() to wait for it.
+     * @param descriptor - valid descriptor to data item in FAM
+     * @param offset - byte offset within the data item of the range
+     * @param value - value of the bytes, converted to unsigned char
+     * @param nbytes - size of the range
+     * @return - wait object to pass to fam_fill_wait()
+     */
+    void *fam_memset(Fam_Descriptor *descriptor, uint64_t offset, int value,
+                     uint64_t nbytes);
+
+    /**
+     * Set consecutive elements of a data item in FAM to a value. The memory
+     * server fills the elements locally, so the data is not sent over the
+     * fabric. Returns before completion; use fam_fill_wait() to wait for it.
+     * @param descriptor - valid descriptor to data item in FAM
+     * @param offset - byte offset within the data item of the first element
+     * @param value - value the elements are set to
+     * @param nElements - number of elements
+     * @return - wait object to pass to fam_fill_wait()
+     */
+    void *fam_fill(Fam_Descriptor *descriptor, uint64_t offset, int32_t value,
+                   uint64_t nElements);
+    void *fam_fill(Fam_Descriptor *descriptor, uint64_t offset, int64_t value,
+                   uint64_t nElements);
+    void *fam_fill(Fam_Descriptor *descriptor, uint64_t offset, uint32_t value,
+                   uint64_t nElements);
+    void *fam_fill(Fam_Descriptor *descriptor, uint64_t offset, uint64_t value,
+                   uint64_t nElements);
+    void *fam_fill(Fam_Descriptor *descriptor, uint64_t offset, float value,
+                   uint64_t nElements);
+    void *fam_fill(Fam_Descriptor *descriptor, uint64_t offset, double value,
+                   uint64_t nElements);
+
+    /**
+     * Wait for a fam_memset() or fam_fill() to complete
+     * @param waitObj - wait object returned by fam_memset() or fam_fill()
+     */
+    void fam_fill_wait(void *waitObj);
+
+    /**
+     * Reduce consecutive elements of a data item in FAM on the memory server,
+     * which only returns the result.
+     * @param descriptor - valid descriptor to data item in FAM
+     * @param offset - byte offset within the data item of the first element
+     * @param nElements - number of elements, at least one
+     * @param type - data type of the elements
+     * @param op - reduction operation
+     * @param result - receives the result, an element of the data type, or a
+     * double for FAM_REDUCE_NORM
+     */
+    void fam_reduce_item(Fam_Descriptor *descriptor, uint64_t offset,
+                         uint64_t nElements, Fam_Type type, Fam_Reduce_Op op,
+                         void *result);
+
+    /**
+     * Scan fixed-size records of a data item in FAM on the memory server, and
+     * copy the records which satisfy all the predicates into a local buffer.
+     * Only the selected columns of the matching records are returned, one
+     * after the other.
+     * @param descriptor - valid descriptor to data item in FAM
+     * @param offset - byte offset within the data item of the first record
+     * @param recordSize - size of a record
+     * @param nRecords - number of records to scan
+     * @param predicates - array of predicates, may be NULL if nPredicates is 0
+     * @param nPredicates - number of predicates; with none all records match
+     * @param columns - array of columns, may be NULL if nColumns is 0
+     * @param nColumns - number of columns; with none whole records are copied
+     * @param local - buffer receiving the matching records
+     * @param localSize - size of the buffer
+     * @param nScanned - if not NULL, set to the number of records scanned,
+     * smaller than nRecords if the buffer filled up
+     * @return - number of records copied into the buffer
+     */
+    uint64_t fam_scan(Fam_Descriptor *descriptor, uint64_t offset,
+                      uint64_t recordSize, uint64_t nRecords,
+                      Fam_Scan_Predicate *predicates, uint64_t nPredicates,
+                      Fam_Scan_Column *columns, uint64_t nColumns, void *local,
+                      uint64_t localSize, uint64_t *nScanned = NULL);
+
+    /**
+     * Scan fixed-size records of a data item in FAM on the memory server, and
+     * copy the records which satisfy all the predicates into another data
+     * item held by the same memory server.
+     * @param descriptor - valid descriptor to data item in FAM
+     * @param offset - byte offset within the data item of the first record
+     * @param recordSize - size of a record
+     * @param nRecords - number of records to scan
+     * @param predicates - array of predicates, may be NULL if nPredicates is 0
+     * @param nPredicates - number of predicates; with none all records match
+     * @param columns - array of columns, may be NULL if nColumns is 0
+     * @param nColumns - number of columns; with none whole records are copied
+     * @param dest - valid descriptor to the data item receiving the records
+     * @param destOffset - byte offset within dest of the first record
+     * @param destSize - size of the range of dest receiving the records
+     * @param nScanned - if not NULL, set to the number of records scanned,
+     * smaller than nRecords if the range filled up
+     * @return - number of records copied into dest
+     */
+    uint64_t fam_scan_to_item(Fam_Descriptor *descriptor, uint64_t offset,
+                              uint64_t recordSize, uint64_t nRecords,
+                              Fam_Scan_Predicate *predicates,
+                              uint64_t nPredicates, Fam_Scan_Column *columns,
+                              uint64_t nColumns, Fam_Descriptor *dest,
+                              uint64_t destOffset, uint64_t destSize,
+                              uint64_t *nScanned = NULL);
+
+    /**
+     * Compute a digest of a range of a data item in FAM on the memory
+     * server, which only returns the digest.
+     * @param descriptor - valid descriptor to data item in FAM
+     * @param offset - byte offset within the data item of the range
+     * @param nbytes - size of the range
+     * @param algo - digest algorithm
+     * @return - digest of the range; a CRC32C is in the low-order 32 bits
+     */
+    uint64_t fam_checksum(Fam_Descriptor *descriptor, uint64_t offset,
+                          uint64_t nbytes, Fam_Checksum_Algo algo);
+
+    /**
+     * Compare the contents of two data items in FAM on the memory server(s).
+     * @param a - valid descriptor to data item in FAM
+     * @param b - valid descriptor to data item in FAM
+     * @param diffOffset - if not NULL and the items differ, set to the offset
+     * of the first byte which differs, or to the size of the smaller item if
+     * it is a prefix of the other one
+     * @return - true if the items have the same size and contents
+     */
+    bool fam_compare_items(Fam_Descriptor *a, Fam_Descriptor *b,
+                           uint64_t *diffOffset = NULL);
     // ATOMICS Group
 
     // NON fetching routines
@@ -1031,6 +1609,78 @@ class fam {
      */
     void fam_quiet(void);
 
+    /**
+     * Wait until a 64-bit word in FAM compares to a value as requested. The
+     * word is written by other PEs, e.g. with fam_set or fam_put_signal.
+     * @param descriptor - valid descriptor to data item in FAM
+     * @param offset - byte offset within the data item of the word
+     * @param cmp - comparison of the word to the value
+     * @param value - value the word is compared to
+     * @return - value of the word which satisfied the condition
+     */
+    uint64_t fam_wait_until(Fam_Descriptor *descriptor, uint64_t offset,
+                            Fam_Cmp cmp, uint64_t value);
+
+    /**
+     * Wait until any of several 64-bit words in a data item compares to a
+     * value as requested.
+     * @param descriptor - valid descriptor to data item in FAM
+     * @param offsets - byte offsets within the data item of the words
+     * @param nOffsets - number of words
+     * @param cmp - comparison of the words to the value
+     * @param value - value the words are compared to
+     * @return - index in offsets of a word which satisfied the condition
+     */
+    uint64_t fam_wait_until_any(Fam_Descriptor *descriptor,
+                                const uint64_t *offsets, uint64_t nOffsets,
+                                Fam_Cmp cmp, uint64_t value);
+
+    /**
+     * Wait until all of several 64-bit words in a data item have compared to
+     * a value as requested.
+     * @param descriptor - valid descriptor to data item in FAM
+     * @param offsets - byte offsets within the data item of the words
+     * @param nOffsets - number of words
+     * @param cmp - comparison of the words to the value
+     * @param value - value the words are compared to
+     */
+    void fam_wait_until_all(Fam_Descriptor *descriptor,
+                            const uint64_t *offsets, uint64_t nOffsets,
+                            Fam_Cmp cmp, uint64_t value);
+
+    /**
+     * Subscribe to the changes of a range of a data item. The memory server
+     * checks the range every interval milliseconds, so that all the writes
+     * and atomics landing within one interval are reported as one change.
+     * Intervals below 10 milliseconds are raised to it, and a memory server
+     * does not watch ranges larger than 16 MiB.
+     * @param descriptor - valid descriptor to data item in FAM
+     * @param offset - byte offset within the data item of the range
+     * @param nbytes - size of the range
+     * @param interval - time in milliseconds between two checks of the range
+     * @return - watch to pass to fam_watch_next() and fam_unwatch()
+     */
+    Fam_Watch *fam_watch(Fam_Descriptor *descriptor, uint64_t offset,
+                         uint64_t nbytes, uint64_t interval);
+
+    /**
+     * Wait for the next change of a watched range.
+     * @param watch - watch returned by fam_watch()
+     * @param offset - set to the byte offset within the data item of the
+     * bytes which changed
+     * @param nbytes - set to the size of the range covering the changed bytes
+     * @param timeout - time in milliseconds to wait for a change
+     * @return - true if a change was reported, false on timeout
+     */
+    bool fam_watch_next(Fam_Watch *watch, uint64_t *offset, uint64_t *nbytes,
+                        uint64_t timeout);
+
+    /**
+     * Cancel a watch and release its resources.
+     * @param watch - watch returned by fam_watch()
+     */
+    void fam_unwatch(Fam_Watch *watch);
+
     /**
      * fam() - constructor for fam class
      */
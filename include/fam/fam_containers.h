@@ -0,0 +1,342 @@
+/*
+ * fam_containers.h
+ * Copyright (c) 2020 Hewlett Packard Enterprise Development, LP. All rights
+ * reserved. Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+#ifndef FAM_CONTAINERS_H
+#define FAM_CONTAINERS_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "fam/fam.h"
+
+namespace openfam {
+
+/**
+ * Bounded multi-producer multi-consumer queue of fixed size elements, held in
+ * a FAM data item. Each cell carries a sequence number which tells producers
+ * and consumers whether the cell is free or filled for a given position, so
+ * that the head and tail are only updated with fam_compare_swap.
+ */
+class Fam_Queue {
+  public:
+    /**
+     * Size of the data item needed for a queue.
+     * @param capacity - maximum number of elements in the queue
+     * @param elementSize - size in bytes of an element
+     * @return - size in bytes of the data item
+     */
+    static uint64_t size(uint64_t capacity, uint64_t elementSize);
+
+    /**
+     * Initialize an empty queue in a data item. Must be called by a single
+     * PE before any PE uses the queue.
+     * @param famObj - initialized fam object
+     * @param descriptor - data item of at least size(capacity, elementSize)
+     * bytes
+     * @param capacity - maximum number of elements in the queue
+     * @param elementSize - size in bytes of an element
+     */
+    static void initialize(fam *famObj, Fam_Descriptor *descriptor,
+                           uint64_t capacity, uint64_t elementSize);
+
+    /**
+     * Create a handle to a queue initialized in a data item.
+     * @param famObj - initialized fam object
+     * @param descriptor - data item holding the queue
+     */
+    Fam_Queue(fam *famObj, Fam_Descriptor *descriptor);
+
+    /**
+     * Add an element at the tail of the queue.
+     * @param element - element to be added
+     * @return - true if the element was added, false if the queue is full
+     */
+    bool enqueue(const void *element);
+
+    /**
+     * Remove the element at the head of the queue.
+     * @param element - buffer receiving the element
+     * @return - true if an element was removed, false if the queue is empty
+     */
+    bool dequeue(void *element);
+
+  private:
+    fam *famObj;
+    Fam_Descriptor *descriptor;
+    uint64_t capacity;
+    uint64_t elementSize;
+    uint64_t cell_offset(uint64_t position);
+};
+
+/**
+ * Append-only log of variable size records, held in a FAM data item. Writers
+ * reserve space with fam_compare_swap on the tail, which only advances if the
+ * records fit, and commit a record by writing its length after its contents,
+ * so that readers never see a partially written record.
+ */
+class Fam_Log {
+  public:
+    /**
+     * Size of the data item needed for a log.
+     * @param capacity - number of bytes available for records, including a
+     * header of 8 bytes per record
+     * @return - size in bytes of the data item
+     */
+    static uint64_t size(uint64_t capacity);
+
+    /**
+     * Initialize an empty log in a data item. Must be called by a single PE
+     * before any PE uses the log.
+     * @param famObj - initialized fam object
+     * @param descriptor - data item of at least size(capacity) bytes
+     * @param capacity - number of bytes available for records
+     */
+    static void initialize(fam *famObj, Fam_Descriptor *descriptor,
+                           uint64_t capacity);
+
+    /**
+     * Create a handle to a log initialized in a data item.
+     * @param famObj - initialized fam object
+     * @param descriptor - data item holding the log
+     */
+    Fam_Log(fam *famObj, Fam_Descriptor *descriptor);
+
+    /**
+     * Append a record to the log.
+     * @param record - contents of the record
+     * @param nbytes - size of the record, must not be 0
+     * @return - position of the record in the log
+     * @throws Fam_Exception - FAM_ERR_RESOURCE if the log is full
+     */
+    uint64_t append(const void *record, uint64_t nbytes);
+
+    /**
+     * Append several records to the log, reserving space for all of them at
+     * once.
+     * @param records - contents of the records
+     * @param nbytes - sizes of the records, none of which may be 0
+     * @param nRecords - number of records
+     * @return - position of the first record in the log
+     * @throws Fam_Exception - FAM_ERR_RESOURCE if the log is full
+     */
+    uint64_t append_batch(const void **records, const uint64_t *nbytes,
+                          uint64_t nRecords);
+
+    /**
+     * Read the record at a given position.
+     * @param position - position of the record
+     * @param record - buffer receiving the contents of the record
+     * @param maxBytes - size of the buffer
+     * @param next - set to the position of the following record
+     * @return - size of the record, 0 if no record has been committed at the
+     * position yet
+     * @throws Fam_InvalidOption_Exception - if the buffer is too small
+     */
+    uint64_t read(uint64_t position, void *record, uint64_t maxBytes,
+                  uint64_t *next);
+
+    /**
+     * Position following the records reserved so far. Records before it may
+     * not be committed yet.
+     * @return - tail of the log
+     */
+    uint64_t tail();
+
+  private:
+    fam *famObj;
+    Fam_Descriptor *descriptor;
+    uint64_t capacity;
+};
+
+/**
+ * Hash map with open addressing and linear probing, held in a FAM data item.
+ * Keys are non-zero 64-bit integers and values have a fixed size. Buckets are
+ * claimed with fam_compare_swap on the key, and probing reads several buckets
+ * with a single fam_get_blocking. Entries can not be removed.
+ */
+class Fam_Hash_Map {
+  public:
+    /**
+     * Size of the data item needed for a hash map.
+     * @param capacity - number of buckets
+     * @param valueSize - size in bytes of a value
+     * @return - size in bytes of the data item
+     */
+    static uint64_t size(uint64_t capacity, uint64_t valueSize);
+
+    /**
+     * Initialize an empty hash map in a data item. Must be called by a single
+     * PE before any PE uses the hash map.
+     * @param famObj - initialized fam object
+     * @param descriptor - data item of at least size(capacity, valueSize)
+     * bytes
+     * @param capacity - number of buckets
+     * @param valueSize - size in bytes of a value
+     */
+    static void initialize(fam *famObj, Fam_Descriptor *descriptor,
+                           uint64_t capacity, uint64_t valueSize);
+
+    /**
+     * Create a handle to a hash map initialized in a data item.
+     * @param famObj - initialized fam object
+     * @param descriptor - data item holding the hash map
+     */
+    Fam_Hash_Map(fam *famObj, Fam_Descriptor *descriptor);
+
+    /**
+     * Insert a key and its value, if the key is not in the hash map.
+     * @param key - non-zero key
+     * @param value - value of the key
+     * @return - true if the key was inserted, false if it was already present
+     * @throws Fam_Exception - FAM_ERR_RESOURCE if the hash map is full
+     */
+    bool insert(uint64_t key, const void *value);
+
+    /**
+     * Look up the value of a key.
+     * @param key - non-zero key
+     * @param value - buffer receiving the value
+     * @return - true if the key was found
+     */
+    bool find(uint64_t key, void *value);
+
+  private:
+    fam *famObj;
+    Fam_Descriptor *descriptor;
+    uint64_t capacity;
+    uint64_t valueSize;
+    uint64_t bucket_offset(uint64_t bucket);
+    uint64_t bucket_size();
+    uint64_t read_buckets(uint64_t first, void *buckets);
+};
+
+/**
+ * Default maximum number of tasks taken from another PE by a single steal
+ */
+#define FAM_TASK_POOL_STEAL_BATCH 16
+
+/**
+ * Pool of fixed size tasks shared by all PEs, held in a FAM data item. Each
+ * PE owns a deque to which only it adds tasks, at the bottom. Tasks are taken
+ * from the top of a deque, one at a time by its owner and in batches of up to
+ * half of the deque by idle PEs stealing from it. The top and bottom of a
+ * deque are packed in a single word updated with fam_compare_swap. A count
+ * of pending tasks in the pool lets PEs detect when all the work is done,
+ * including the tasks added while running other tasks.
+ */
+class Fam_Task_Pool {
+  public:
+    /**
+     * Size of the data item needed for a task pool.
+     * @param numPEs - number of PEs using the pool
+     * @param capacity - maximum number of tasks in the deque of a PE
+     * @param taskSize - size in bytes of a task
+     * @return - size in bytes of the data item
+     */
+    static uint64_t size(uint64_t numPEs, uint64_t capacity,
+                         uint64_t taskSize);
+
+    /**
+     * Initialize an empty task pool in a data item. Must be called by a
+     * single PE before any PE uses the pool.
+     * @param famObj - initialized fam object
+     * @param descriptor - data item of at least size(numPEs, capacity,
+     * taskSize) bytes
+     * @param numPEs - number of PEs using the pool
+     * @param capacity - maximum number of tasks in the deque of a PE
+     * @param taskSize - size in bytes of a task
+     */
+    static void initialize(fam *famObj, Fam_Descriptor *descriptor,
+                           uint64_t numPEs, uint64_t capacity,
+                           uint64_t taskSize);
+
+    /**
+     * Create a handle to a task pool initialized in a data item. The deque
+     * of the handle is the one of the calling PE.
+     * @param famObj - initialized fam object
+     * @param descriptor - data item holding the task pool
+     * @param stealBatch - maximum number of tasks taken by a single steal
+     */
+    Fam_Task_Pool(fam *famObj, Fam_Descriptor *descriptor,
+                  uint64_t stealBatch = FAM_TASK_POOL_STEAL_BATCH);
+
+    /**
+     * Add a task to the deque of the calling PE. The initial tasks of all
+     * PEs must be added before any PE calls get, e.g. by following them with
+     * fam_barrier_all.
+     * @param task - task to be added
+     * @return - true if the task was added, false if the deque is full
+     */
+    bool add(const void *task);
+
+    /**
+     * Add several tasks to the deque of the calling PE, publishing all of
+     * them with a single update of the deque.
+     * @param tasks - array of nTasks tasks
+     * @param nTasks - number of tasks
+     * @return - true if the tasks were added, false if the deque does not
+     * have room for all of them, in which case none is added
+     */
+    bool add_batch(const void *tasks, uint64_t nTasks);
+
+    /**
+     * Get a task to run, from the deque of the calling PE or else stolen from
+     * another PE. The task returned by the previous call is considered done.
+     * Waits while the pool is empty but other PEs are still running tasks,
+     * as they may add new ones.
+     * @param task - buffer receiving the task
+     * @return - true if a task was returned, false once all the tasks of the
+     * pool are done
+     */
+    bool get(void *task);
+
+  private:
+    fam *famObj;
+    Fam_Descriptor *descriptor;
+    uint64_t numPEs;
+    uint64_t capacity;
+    uint64_t taskSize;
+    uint64_t stealBatch;
+    uint64_t myPE;
+    // Tasks stolen in a batch and not returned by get yet
+    std::vector<char> stolen;
+    uint64_t stolenCount;
+    // Number of tasks returned by get and not yet removed from the count of
+    // pending tasks
+    uint64_t doneCount;
+    bool running;
+    unsigned int seed;
+    uint64_t deque_offset(uint64_t pe);
+    uint64_t task_offset(uint64_t pe, uint64_t position);
+    uint64_t take(uint64_t pe, uint64_t maxTasks, void *tasks);
+};
+
+} // namespace openfam
+
+#endif /* end of FAM_CONTAINERS_H */
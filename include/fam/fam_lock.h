@@ -0,0 +1,152 @@
+/*
+ * fam_lock.h
+ * Copyright (c) 2020 Hewlett Packard Enterprise Development, LP. All rights
+ * reserved. Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+#ifndef FAM_LOCK_H
+#define FAM_LOCK_H
+
+#include <stdint.h>
+
+#include "fam/fam.h"
+
+namespace openfam {
+
+/**
+ * MCS queue lock shared by the PEs of a job, held in a FAM data item. Each PE
+ * waiting for the lock polls a flag in its own queue node, so that waiters do
+ * not contend on a single word, and the lock is granted in FIFO order.
+ * A PE may hold or wait for the lock from one thread at a time.
+ *
+ * The data item must be at least Fam_Lock::size(numPEs) bytes, and must be
+ * zeroed before the lock is first used.
+ */
+class Fam_Lock {
+  public:
+    /**
+     * Size of the data item needed for a lock shared by numPEs PEs.
+     * @param numPEs - number of PEs sharing the lock
+     * @return - size in bytes of the data item
+     */
+    static uint64_t size(int numPEs);
+
+    /**
+     * Create a handle to a lock held in a data item.
+     * @param famObj - initialized fam object
+     * @param descriptor - data item holding the lock
+     * @param offset - byte offset of the lock within the data item
+     */
+    Fam_Lock(fam *famObj, Fam_Descriptor *descriptor, uint64_t offset = 0);
+
+    /**
+     * Acquire the lock, waiting until it is granted to the calling PE.
+     */
+    void lock();
+
+    /**
+     * Acquire the lock only if it is free.
+     * @return - true if the lock was acquired
+     */
+    bool try_lock();
+
+    /**
+     * Release the lock, handing it over to the next waiting PE if any. FAM
+     * updates issued while holding the lock are complete before the lock is
+     * released.
+     */
+    void unlock();
+
+  private:
+    fam *famObj;
+    Fam_Descriptor *descriptor;
+    uint64_t offset;
+    uint64_t myId;
+    uint64_t tail_offset() { return offset; }
+    uint64_t next_offset(uint64_t id);
+    uint64_t locked_offset(uint64_t id);
+};
+
+/**
+ * Reader-writer lock shared by the PEs of a job, held in a FAM data item.
+ * Writers are queued on a Fam_Lock and then wait for active readers to
+ * drain. Readers announce themselves with an atomic counter, and back off
+ * while a writer holds or waits for the lock, so that writers are not
+ * starved.
+ *
+ * The data item must be at least Fam_RW_Lock::size(numPEs) bytes, and must be
+ * zeroed before the lock is first used.
+ */
+class Fam_RW_Lock {
+  public:
+    /**
+     * Size of the data item needed for a reader-writer lock shared by
+     * numPEs PEs.
+     * @param numPEs - number of PEs sharing the lock
+     * @return - size in bytes of the data item
+     */
+    static uint64_t size(int numPEs);
+
+    /**
+     * Create a handle to a reader-writer lock held in a data item.
+     * @param famObj - initialized fam object
+     * @param descriptor - data item holding the lock
+     * @param offset - byte offset of the lock within the data item
+     */
+    Fam_RW_Lock(fam *famObj, Fam_Descriptor *descriptor, uint64_t offset = 0);
+
+    /**
+     * Acquire the lock for reading, along with other readers.
+     */
+    void read_lock();
+
+    /**
+     * Release the lock held for reading.
+     */
+    void read_unlock();
+
+    /**
+     * Acquire the lock for writing, excluding readers and other writers.
+     */
+    void write_lock();
+
+    /**
+     * Release the lock held for writing.
+     */
+    void write_unlock();
+
+  private:
+    fam *famObj;
+    Fam_Descriptor *descriptor;
+    uint64_t offset;
+    Fam_Lock writerLock;
+    uint64_t readers_offset() { return offset; }
+    uint64_t writer_offset() { return offset + sizeof(uint64_t); }
+};
+
+} // namespace openfam
+
+#endif /* end of FAM_LOCK_H */
@@ -34,6 +34,7 @@
 
 #include "fam/fam.h"
 #include "common/fam_internal.h"
+#include "common/fam_scan.h"
 
 namespace openfam {
 
@@ -57,6 +58,12 @@ class Fam_Allocator {
                                      mode_t accessPermissions,
                                      Fam_Region_Descriptor *region) = 0;
     virtual void deallocate(Fam_Descriptor *descriptor) = 0;
+    virtual void allocate_batch(const char **names, const uint64_t *sizes,
+                                uint64_t nItems, mode_t accessPermissions,
+                                Fam_Region_Descriptor *region,
+                                Fam_Descriptor **descriptors) = 0;
+    virtual void deallocate_batch(Fam_Descriptor **descriptors,
+                                  uint64_t nItems) = 0;
 
     virtual int change_permission(Fam_Region_Descriptor *descriptor,
                                   mode_t accessPermissions) = 0;
@@ -70,19 +77,60 @@ class Fam_Allocator {
     check_permission_get_info(Fam_Region_Descriptor *descriptor) = 0;
     virtual Fam_Region_Item_Info
     check_permission_get_info(Fam_Descriptor *descriptor) = 0;
+    virtual void lookup_batch(const char **itemNames, uint64_t nItems,
+                              const char *regionName, uint64_t memoryServerId,
+                              Fam_Descriptor **descriptors) = 0;
+    virtual void check_permission_get_info_batch(
+        Fam_Descriptor **descriptors, uint64_t nItems,
+        Fam_Region_Item_Info *itemInfo) = 0;
 
     virtual void *copy(Fam_Descriptor *src, uint64_t srcOffset,
                        Fam_Descriptor **dest, uint64_t destOffset,
                        uint64_t nbytes) = 0;
 
+    virtual void *copy(Fam_Descriptor *src, uint64_t srcOffset,
+                       Fam_Descriptor *dest, uint64_t destOffset,
+                       uint64_t nbytes) = 0;
+
     virtual void wait_for_copy(void *waitObj) = 0;
 
+    virtual void *fill(Fam_Descriptor *descriptor, uint64_t offset,
+                       uint64_t nbytes, uint64_t pattern,
+                       uint64_t patternSize) = 0;
+
     virtual void *fam_map(Fam_Descriptor *descriptor) = 0;
     virtual void fam_unmap(void *local, Fam_Descriptor *descriptor) = 0;
 
     virtual void acquire_CAS_lock(Fam_Descriptor *descriptor) = 0;
     virtual void release_CAS_lock(Fam_Descriptor *descriptor) = 0;
 
+    virtual bool wait_until(Fam_Descriptor *descriptor, uint64_t offset,
+                            Fam_Cmp cmp, uint64_t value, uint64_t timeout,
+                            uint64_t *current) = 0;
+
+    virtual Fam_Watch *watch(Fam_Descriptor *descriptor, uint64_t offset,
+                             uint64_t nbytes, uint64_t interval) = 0;
+
+    virtual uint64_t reduce_item(Fam_Descriptor *descriptor, uint64_t offset,
+                                 uint64_t nElements, Fam_Type type,
+                                 Fam_Reduce_Op op) = 0;
+
+    virtual uint64_t scan(Fam_Descriptor *descriptor, uint64_t offset,
+                          const Fam_Scan_Query &query, void *local,
+                          uint64_t localSize, uint64_t *nScanned) = 0;
+
+    virtual uint64_t scan_to_item(Fam_Descriptor *descriptor, uint64_t offset,
+                                  const Fam_Scan_Query &query,
+                                  Fam_Descriptor *dest, uint64_t destOffset,
+                                  uint64_t destSize, uint64_t *nScanned) = 0;
+
+    virtual uint64_t checksum(Fam_Descriptor *descriptor, uint64_t offset,
+                              uint64_t nbytes, Fam_Checksum_Algo algo) = 0;
+
+    virtual bool compare(Fam_Descriptor *descriptor, uint64_t offset,
+                         Fam_Descriptor *other, uint64_t otherOffset,
+                         uint64_t nbytes, uint64_t *diffOffset) = 0;
+
     virtual int get_addr_size(size_t *addrSize, uint64_t nodeId) = 0;
     virtual int get_addr(void *addr, size_t addrSize, uint64_t nodeId) = 0;
 };
@@ -60,6 +60,61 @@ Fam_Allocator_Grpc::Fam_Allocator_Grpc(MemServerMap name, uint64_t port) {
     }
 }
 
+Fam_Allocator_Grpc::Fam_Allocator_Grpc(MemServerMap name, uint64_t port,
+                                       Fam_Runtime *famRuntime) {
+    std::ostringstream message;
+    int ret;
+
+    if (name.size() == 0) {
+        throw Fam_Allocator_Exception(FAM_ERR_RPC_CLIENT_NOTFOUND,
+                                      "server name not found");
+    }
+    if (famRuntime == NULL) {
+        throw Fam_Allocator_Exception(FAM_ERR_PMI, "runtime not initialized");
+    }
+    rpcClients = new RpcClientMap();
+
+    // Only PE 0 sends signal_start to the memory servers
+    bool isRoot = (famRuntime->my_pe() == 0);
+    for (auto obj = name.begin(); obj != name.end(); ++obj) {
+        Fam_Rpc_Client *client =
+            new Fam_Rpc_Client((obj->second).c_str(), port, isRoot);
+        rpcClients->insert({ obj->first, client });
+    }
+
+    if (isRoot) {
+        for (auto obj : *rpcClients) {
+            std::string key = "fam_memsrv_addr_" + std::to_string(obj.first);
+            ret = famRuntime->runtime_kvs_put(key.c_str(),
+                                              obj.second->get_addr(),
+                                              obj.second->get_addr_size());
+            if (ret != 0) {
+                message << "Failed to publish memory server address: " << ret;
+                throw Fam_Pmi_Exception(message.str().c_str());
+            }
+        }
+    }
+
+    if ((ret = famRuntime->runtime_kvs_fence()) != 0) {
+        message << "Failed to exchange memory server address: " << ret;
+        throw Fam_Pmi_Exception(message.str().c_str());
+    }
+
+    if (!isRoot) {
+        char addr[RUNTIME_KVS_MAX_VALUE_LEN];
+        for (auto obj : *rpcClients) {
+            std::string key = "fam_memsrv_addr_" + std::to_string(obj.first);
+            size_t addrSize = sizeof(addr);
+            ret = famRuntime->runtime_kvs_get(0, key.c_str(), addr, &addrSize);
+            if (ret != 0) {
+                message << "Failed to read memory server address: " << ret;
+                throw Fam_Pmi_Exception(message.str().c_str());
+            }
+            obj.second->set_addr(addr, addrSize);
+        }
+    }
+}
+
 Fam_Allocator_Grpc::~Fam_Allocator_Grpc() {
     if (rpcClients != NULL) {
         for (auto rpc_client : *rpcClients) {
@@ -114,6 +169,44 @@ void Fam_Allocator_Grpc::deallocate(Fam_Descriptor *descriptor) {
     return rpcClient->deallocate(descriptor);
 }
 
+void Fam_Allocator_Grpc::allocate_batch(const char **names,
+                                        const uint64_t *sizes, uint64_t nItems,
+                                        mode_t accessPermissions,
+                                        Fam_Region_Descriptor *region,
+                                        Fam_Descriptor **descriptors) {
+    Fam_Rpc_Client *rpcClient = get_rpc_client(region->get_memserver_id());
+    return rpcClient->allocate_batch(names, sizes, nItems, accessPermissions,
+                                     region, descriptors);
+}
+
+void Fam_Allocator_Grpc::deallocate_batch(Fam_Descriptor **descriptors,
+                                          uint64_t nItems) {
+    // Group the items by memory server, so that each memory server is
+    // contacted once for all of its items
+    std::map<uint64_t, std::vector<uint64_t>> itemsPerServer;
+    for (uint64_t ndx = 0; ndx < nItems; ndx++) {
+        itemsPerServer[descriptors[ndx]->get_memserver_id()].push_back(ndx);
+    }
+
+    // Deallocate the items of every memory server before reporting an error
+    int errorCode = 0;
+    std::string errorMsg;
+    for (auto obj : itemsPerServer) {
+        Fam_Rpc_Client *rpcClient = get_rpc_client(obj.first);
+        try {
+            rpcClient->deallocate_batch(descriptors, obj.second);
+        } catch (Fam_Allocator_Exception &e) {
+            if (!errorCode) {
+                errorCode = e.fam_error();
+                errorMsg = e.fam_error_msg();
+            }
+        }
+    }
+    if (errorCode)
+        throw Fam_Allocator_Exception((enum Fam_Error)errorCode,
+                                      errorMsg.c_str());
+}
+
 int Fam_Allocator_Grpc::change_permission(Fam_Region_Descriptor *descriptor,
                                           mode_t accessPermissions) {
     Fam_Rpc_Client *rpcClient = get_rpc_client(descriptor->get_memserver_id());
@@ -152,6 +245,32 @@ Fam_Allocator_Grpc::check_permission_get_info(Fam_Descriptor *descriptor) {
     return rpcClient->check_permission_get_info(descriptor);
 }
 
+void Fam_Allocator_Grpc::lookup_batch(const char **itemNames, uint64_t nItems,
+                                      const char *regionName,
+                                      uint64_t memoryServerId,
+                                      Fam_Descriptor **descriptors) {
+    Fam_Rpc_Client *rpcClient = get_rpc_client(memoryServerId);
+    return rpcClient->lookup_batch(itemNames, nItems, regionName,
+                                   memoryServerId, descriptors);
+}
+
+void Fam_Allocator_Grpc::check_permission_get_info_batch(
+    Fam_Descriptor **descriptors, uint64_t nItems,
+    Fam_Region_Item_Info *itemInfo) {
+    // Group the items by memory server, so that each memory server is
+    // contacted once for all of its items
+    std::map<uint64_t, std::vector<uint64_t>> itemsPerServer;
+    for (uint64_t ndx = 0; ndx < nItems; ndx++) {
+        itemsPerServer[descriptors[ndx]->get_memserver_id()].push_back(ndx);
+    }
+
+    for (auto obj : itemsPerServer) {
+        Fam_Rpc_Client *rpcClient = get_rpc_client(obj.first);
+        rpcClient->check_permission_get_info_batch(descriptors, obj.second,
+                                                   itemInfo);
+    }
+}
+
 void *Fam_Allocator_Grpc::copy(Fam_Descriptor *src, uint64_t srcOffset,
                                Fam_Descriptor **dest, uint64_t destOffset,
                                uint64_t nbytes) {
@@ -159,12 +278,33 @@ void *Fam_Allocator_Grpc::copy(Fam_Descriptor *src, uint64_t srcOffset,
     return rpcClient->copy(src, srcOffset, dest, destOffset, nbytes);
 }
 
+/*
+ * A destination held by another memory server is written directly by the
+ * memory server of the source, which checks the destination with it.
+ */
+void *Fam_Allocator_Grpc::copy(Fam_Descriptor *src, uint64_t srcOffset,
+                               Fam_Descriptor *dest, uint64_t destOffset,
+                               uint64_t nbytes) {
+    Fam_Rpc_Client *rpcClient = get_rpc_client(src->get_memserver_id());
+    if (dest->get_memserver_id() == src->get_memserver_id())
+        return rpcClient->copy(src, srcOffset, dest, destOffset, nbytes);
+
+    return rpcClient->copy(src, srcOffset, dest, destOffset, nbytes, true);
+}
+
 void Fam_Allocator_Grpc::wait_for_copy(void *waitObj) {
     uint64_t memoryServerId = ((Fam_Copy_Tag *)waitObj)->memServerId;
     Fam_Rpc_Client *rpcClient = get_rpc_client(memoryServerId);
     return rpcClient->wait_for_copy(waitObj);
 }
 
+void *Fam_Allocator_Grpc::fill(Fam_Descriptor *descriptor, uint64_t offset,
+                               uint64_t nbytes, uint64_t pattern,
+                               uint64_t patternSize) {
+    Fam_Rpc_Client *rpcClient = get_rpc_client(descriptor->get_memserver_id());
+    return rpcClient->fill(descriptor, offset, nbytes, pattern, patternSize);
+}
+
 void *Fam_Allocator_Grpc::fam_map(Fam_Descriptor *descriptor) {
     FAM_UNIMPLEMENTED_GRPC();
     return NULL;
@@ -185,6 +325,64 @@ void Fam_Allocator_Grpc::release_CAS_lock(Fam_Descriptor *descriptor) {
     return rpcClient->release_CAS_lock(descriptor);
 }
 
+bool Fam_Allocator_Grpc::wait_until(Fam_Descriptor *descriptor,
+                                    uint64_t offset, Fam_Cmp cmp,
+                                    uint64_t value, uint64_t timeout,
+                                    uint64_t *current) {
+    Fam_Rpc_Client *rpcClient = get_rpc_client(descriptor->get_memserver_id());
+    return rpcClient->wait_until(descriptor, offset, cmp, value, timeout,
+                                 current);
+}
+
+Fam_Watch *Fam_Allocator_Grpc::watch(Fam_Descriptor *descriptor,
+                                     uint64_t offset, uint64_t nbytes,
+                                     uint64_t interval) {
+    Fam_Rpc_Client *rpcClient = get_rpc_client(descriptor->get_memserver_id());
+    return rpcClient->watch(descriptor, offset, nbytes, interval);
+}
+
+uint64_t Fam_Allocator_Grpc::reduce_item(Fam_Descriptor *descriptor,
+                                         uint64_t offset, uint64_t nElements,
+                                         Fam_Type type, Fam_Reduce_Op op) {
+    Fam_Rpc_Client *rpcClient = get_rpc_client(descriptor->get_memserver_id());
+    return rpcClient->reduce_item(descriptor, offset, nElements, type, op);
+}
+
+uint64_t Fam_Allocator_Grpc::scan(Fam_Descriptor *descriptor, uint64_t offset,
+                                  const Fam_Scan_Query &query, void *local,
+                                  uint64_t localSize, uint64_t *nScanned) {
+    Fam_Rpc_Client *rpcClient = get_rpc_client(descriptor->get_memserver_id());
+    return rpcClient->scan(descriptor, offset, query, local, localSize,
+                           nScanned);
+}
+
+uint64_t Fam_Allocator_Grpc::scan_to_item(Fam_Descriptor *descriptor,
+                                          uint64_t offset,
+                                          const Fam_Scan_Query &query,
+                                          Fam_Descriptor *dest,
+                                          uint64_t destOffset,
+                                          uint64_t destSize,
+                                          uint64_t *nScanned) {
+    Fam_Rpc_Client *rpcClient = get_rpc_client(descriptor->get_memserver_id());
+    return rpcClient->scan_to_item(descriptor, offset, query, dest,
+                                   destOffset, destSize, nScanned);
+}
+
+uint64_t Fam_Allocator_Grpc::checksum(Fam_Descriptor *descriptor,
+                                      uint64_t offset, uint64_t nbytes,
+                                      Fam_Checksum_Algo algo) {
+    Fam_Rpc_Client *rpcClient = get_rpc_client(descriptor->get_memserver_id());
+    return rpcClient->checksum(descriptor, offset, nbytes, algo);
+}
+
+bool Fam_Allocator_Grpc::compare(Fam_Descriptor *descriptor, uint64_t offset,
+                                 Fam_Descriptor *other, uint64_t otherOffset,
+                                 uint64_t nbytes, uint64_t *diffOffset) {
+    Fam_Rpc_Client *rpcClient = get_rpc_client(descriptor->get_memserver_id());
+    return rpcClient->compare(descriptor, offset, other, otherOffset, nbytes,
+                              diffOffset);
+}
+
 int Fam_Allocator_Grpc::get_addr_size(size_t *addrSize,
                                       uint64_t memoryServerId = 0) {
     Fam_Rpc_Client *rpcClient = get_rpc_client(memoryServerId);
@@ -31,6 +31,7 @@
 #define FAM_ALLOCATOR_GRPC_H_
 
 #include "allocator/fam_allocator.h"
+#include "pmi/fam_runtime.h"
 #include "rpc/fam_rpc_client.h"
 
 namespace openfam {
@@ -42,6 +43,18 @@ class Fam_Allocator_Grpc : public Fam_Allocator {
   public:
     Fam_Allocator_Grpc(MemServerMap name, uint64_t port);
 
+    /**
+     * Create the allocator and obtain the memory server fabric addresses
+     * through the PMI runtime. Only PE 0 requests the addresses from the
+     * memory servers and publishes them; all other PEs read them from the
+     * runtime key-value store.
+     * @param name - memory server id to name map
+     * @param port - grpc port of the memory servers
+     * @param famRuntime - initialized PMI runtime
+     */
+    Fam_Allocator_Grpc(MemServerMap name, uint64_t port,
+                       Fam_Runtime *famRuntime);
+
     ~Fam_Allocator_Grpc();
 
     void allocator_initialize();
@@ -61,6 +74,11 @@ class Fam_Allocator_Grpc : public Fam_Allocator {
                              mode_t accessPermissions,
                              Fam_Region_Descriptor *region);
     void deallocate(Fam_Descriptor *descriptor);
+    void allocate_batch(const char **names, const uint64_t *sizes,
+                        uint64_t nItems, mode_t accessPermissions,
+                        Fam_Region_Descriptor *region,
+                        Fam_Descriptor **descriptors);
+    void deallocate_batch(Fam_Descriptor **descriptors, uint64_t nItems);
 
     int change_permission(Fam_Region_Descriptor *descriptor,
                           mode_t accessPermissions);
@@ -72,12 +90,45 @@ class Fam_Allocator_Grpc : public Fam_Allocator {
     Fam_Region_Item_Info
     check_permission_get_info(Fam_Region_Descriptor *descriptor);
     Fam_Region_Item_Info check_permission_get_info(Fam_Descriptor *descriptor);
+    void lookup_batch(const char **itemNames, uint64_t nItems,
+                      const char *regionName, uint64_t memoryServerId,
+                      Fam_Descriptor **descriptors);
+    void check_permission_get_info_batch(Fam_Descriptor **descriptors,
+                                         uint64_t nItems,
+                                         Fam_Region_Item_Info *itemInfo);
 
     void *copy(Fam_Descriptor *src, uint64_t srcOffset, Fam_Descriptor **dest,
                uint64_t destOffset, uint64_t nbytes);
 
+    /**
+     * copy - Ask the memory server to copy a range of a data item into an
+     * existing data item, which it holds or pushes the data to; the returned
+     * object is waited for with wait_for_copy.
+     * @param src - Descriptor associated with the source data item
+     * @param srcOffset - byte offset of the range within src
+     * @param dest - Descriptor associated with the destination data item
+     * @param destOffset - byte offset within dest of the copy
+     * @param nbytes - size of the range
+     * @return - wait object of the copy
+     */
+    void *copy(Fam_Descriptor *src, uint64_t srcOffset, Fam_Descriptor *dest,
+               uint64_t destOffset, uint64_t nbytes);
+
     void wait_for_copy(void *waitObj);
 
+    /**
+     * fill - Ask the memory server to fill a range of a data item with a
+     * pattern repeated; the returned object is waited for with wait_for_copy.
+     * @param descriptor - Descriptor associated with the data item in FAM
+     * @param offset - byte offset of the range within the data item
+     * @param nbytes - size of the range
+     * @param pattern - value repeated over the range
+     * @param patternSize - size of the pattern in bytes, 1, 2, 4 or 8
+     * @return - wait object of the fill
+     */
+    void *fill(Fam_Descriptor *descriptor, uint64_t offset, uint64_t nbytes,
+               uint64_t pattern, uint64_t patternSize);
+
     /**
      * fam_map - Map a data item in FAM to the process virtual address space.
      * @param descriptor - Descriptor associated with the data item in FAM.
@@ -108,6 +159,107 @@ class Fam_Allocator_Grpc : public Fam_Allocator {
      */
     virtual void release_CAS_lock(Fam_Descriptor *descriptor);
 
+    /**
+     * wait_until - Ask the memory server to watch a word of a data item until
+     * it satisfies a condition or a timeout expires.
+     * @param descriptor - Descriptor associated with the data item in FAM
+     * @param offset - byte offset of the word within the data item
+     * @param cmp - comparison of the word to the value
+     * @param value - value the word is compared to
+     * @param timeout - time in milliseconds after which the server replies
+     * @param current - set to the last value of the word read by the server
+     * @return - true if the condition was met
+     */
+    virtual bool wait_until(Fam_Descriptor *descriptor, uint64_t offset,
+                            Fam_Cmp cmp, uint64_t value, uint64_t timeout,
+                            uint64_t *current);
+
+    /**
+     * watch - Ask the memory server to stream the changes of a range of a
+     * data item.
+     * @param descriptor - Descriptor associated with the data item in FAM
+     * @param offset - byte offset of the range within the data item
+     * @param nbytes - size of the range
+     * @param interval - time in milliseconds between two checks of the range
+     * @return - watch receiving the changes
+     */
+    virtual Fam_Watch *watch(Fam_Descriptor *descriptor, uint64_t offset,
+                             uint64_t nbytes, uint64_t interval);
+
+    /**
+     * reduce_item - Ask the memory server to reduce consecutive elements of a
+     * data item.
+     * @param descriptor - Descriptor associated with the data item in FAM
+     * @param offset - byte offset of the first element within the data item
+     * @param nElements - number of elements
+     * @param type - data type of the elements
+     * @param op - reduction operation
+     * @return - bytes of the result, in the low-order bytes of the word
+     */
+    virtual uint64_t reduce_item(Fam_Descriptor *descriptor, uint64_t offset,
+                                 uint64_t nElements, Fam_Type type,
+                                 Fam_Reduce_Op op);
+
+    /**
+     * scan - Ask the memory server to scan the records of a data item, and
+     * return the matching ones in the response.
+     * @param descriptor - Descriptor associated with the data item in FAM
+     * @param offset - byte offset of the first record within the data item
+     * @param query - records to scan, predicates and columns
+     * @param local - buffer receiving the matching records
+     * @param localSize - size of the buffer
+     * @param nScanned - set to the number of records scanned
+     * @return - number of records copied into the buffer
+     */
+    virtual uint64_t scan(Fam_Descriptor *descriptor, uint64_t offset,
+                          const Fam_Scan_Query &query, void *local,
+                          uint64_t localSize, uint64_t *nScanned);
+
+    /**
+     * scan_to_item - Ask the memory server to scan the records of a data
+     * item, and write the matching ones to another data item it holds.
+     * @param descriptor - Descriptor associated with the data item in FAM
+     * @param offset - byte offset of the first record within the data item
+     * @param query - records to scan, predicates and columns
+     * @param dest - Descriptor of the data item receiving the records
+     * @param destOffset - byte offset within dest of the first record
+     * @param destSize - size of the range of dest receiving the records
+     * @param nScanned - set to the number of records scanned
+     * @return - number of records copied into dest
+     */
+    virtual uint64_t scan_to_item(Fam_Descriptor *descriptor, uint64_t offset,
+                                  const Fam_Scan_Query &query,
+                                  Fam_Descriptor *dest, uint64_t destOffset,
+                                  uint64_t destSize, uint64_t *nScanned);
+
+    /**
+     * checksum - Ask the memory server to compute a digest of a range of a
+     * data item.
+     * @param descriptor - Descriptor associated with the data item in FAM
+     * @param offset - byte offset of the range within the data item
+     * @param nbytes - size of the range
+     * @param algo - digest algorithm
+     * @return - digest of the range
+     */
+    virtual uint64_t checksum(Fam_Descriptor *descriptor, uint64_t offset,
+                              uint64_t nbytes, Fam_Checksum_Algo algo);
+
+    /**
+     * compare - Ask the memory server to compare ranges of two data items it
+     * holds.
+     * @param descriptor - Descriptor associated with the data item in FAM
+     * @param offset - byte offset of the range within the data item
+     * @param other - Descriptor of the other data item
+     * @param otherOffset - byte offset of the range within other
+     * @param nbytes - size of the ranges
+     * @param diffOffset - set to the offset within the ranges of the first
+     * byte which differs
+     * @return - true if the ranges are equal
+     */
+    virtual bool compare(Fam_Descriptor *descriptor, uint64_t offset,
+                         Fam_Descriptor *other, uint64_t otherOffset,
+                         uint64_t nbytes, uint64_t *diffOffset);
+
     virtual int get_addr_size(size_t *addrSize, uint64_t nodeId);
 
     virtual int get_addr(void *addr, size_t addrSize, uint64_t nodeId);
@@ -27,11 +27,16 @@
  * See https://spdx.org/licenses/BSD-3-Clause
  *
  */
+#include <atomic>
 #include <iostream>
 #include <stdint.h>   // needed
 #include <sys/stat.h> // needed for mode_t
+#include <thread>
+#include <unistd.h>
+#include <vector>
 
 #include "allocator/fam_allocator_nvmm.h"
+#include "common/fam_watch.h"
 #include "fam/fam.h"
 
 using namespace std;
@@ -154,6 +159,72 @@ void Fam_Allocator_NVMM::deallocate(Fam_Descriptor *descriptor) {
     return;
 }
 
+void Fam_Allocator_NVMM::allocate_batch(const char **names,
+                                        const uint64_t *sizes, uint64_t nItems,
+                                        mode_t accessPermissions,
+                                        Fam_Region_Descriptor *region,
+                                        Fam_Descriptor **descriptors) {
+    Fam_Global_Descriptor globalDescriptor = region->get_global_descriptor();
+    std::vector<string> itemNames;
+    std::vector<size_t> itemSizes;
+    std::vector<Fam_DataItem_Metadata> dataitems;
+    std::vector<void *> localPointers;
+    uint64_t key;
+    for (uint64_t ndx = 0; ndx < nItems; ndx++) {
+        itemNames.push_back((names && names[ndx]) ? names[ndx] : "");
+        itemSizes.push_back((size_t)sizes[ndx]);
+    }
+    try {
+        allocator->allocate_batch(globalDescriptor.regionId, itemNames,
+                                  itemSizes, accessPermissions, uid, gid,
+                                  dataitems, localPointers);
+    }
+    catch (Memserver_Exception &e) {
+        throw Fam_Allocator_Exception((enum Fam_Error)e.fam_error(),
+                                      e.fam_error_msg());
+    }
+
+    // All the items have the same owner and permissions
+    if (nItems == 0)
+        return;
+    if (allocator->check_dataitem_permission(dataitems[0], 1, uid, gid)) {
+        key = FAM_WRITE_KEY_SHM | FAM_READ_KEY_SHM;
+    } else if (allocator->check_dataitem_permission(dataitems[0], 0, uid,
+                                                    gid)) {
+        key = FAM_READ_KEY_SHM;
+    } else {
+        throw Fam_Allocator_Exception(FAM_ERR_NOPERM,
+                                      "Not permitted to use this dataitem");
+    }
+    for (uint64_t ndx = 0; ndx < nItems; ndx++) {
+        globalDescriptor.offset = dataitems[ndx].offset;
+        descriptors[ndx] = new Fam_Descriptor(globalDescriptor, sizes[ndx]);
+        descriptors[ndx]->set_base_address(localPointers[ndx]);
+        descriptors[ndx]->bind_key(key);
+    }
+}
+
+void Fam_Allocator_NVMM::deallocate_batch(Fam_Descriptor **descriptors,
+                                          uint64_t nItems) {
+    // Deallocate all the items before reporting the first error
+    int errorCode = 0;
+    std::string errorMsg;
+    for (uint64_t ndx = 0; ndx < nItems; ndx++) {
+        try {
+            deallocate(descriptors[ndx]);
+        }
+        catch (Fam_Allocator_Exception &e) {
+            if (!errorCode) {
+                errorCode = e.fam_error();
+                errorMsg = e.fam_error_msg();
+            }
+        }
+    }
+    if (errorCode)
+        throw Fam_Allocator_Exception((enum Fam_Error)errorCode,
+                                      errorMsg.c_str());
+}
+
 int Fam_Allocator_NVMM::change_permission(Fam_Region_Descriptor *descriptor,
                                           mode_t accessPermissions) {
 
@@ -334,6 +405,196 @@ Fam_Allocator_NVMM::check_permission_get_info(Fam_Descriptor *descriptor) {
     return itemInfo;
 }
 
+void Fam_Allocator_NVMM::lookup_batch(const char **itemNames, uint64_t nItems,
+                                      const char *regionName,
+                                      uint64_t memoryServerId,
+                                      Fam_Descriptor **descriptors) {
+    for (uint64_t ndx = 0; ndx < nItems; ndx++) {
+        try {
+            descriptors[ndx] =
+                lookup(itemNames[ndx], regionName, memoryServerId);
+        }
+        catch (Fam_Allocator_Exception &e) {
+            for (uint64_t i = 0; i < ndx; i++) {
+                delete descriptors[i];
+                descriptors[i] = NULL;
+            }
+            throw;
+        }
+    }
+}
+
+void Fam_Allocator_NVMM::check_permission_get_info_batch(
+    Fam_Descriptor **descriptors, uint64_t nItems,
+    Fam_Region_Item_Info *itemInfo) {
+    for (uint64_t ndx = 0; ndx < nItems; ndx++) {
+        itemInfo[ndx] = check_permission_get_info(descriptors[ndx]);
+    }
+}
+
+bool Fam_Allocator_NVMM::wait_until(Fam_Descriptor *descriptor,
+                                    uint64_t offset, Fam_Cmp cmp,
+                                    uint64_t value, uint64_t timeout,
+                                    uint64_t *current) {
+    Fam_Global_Descriptor globalDescriptor =
+        descriptor->get_global_descriptor();
+    try {
+        return allocator->wait_until(globalDescriptor.regionId,
+                                     globalDescriptor.offset, offset, uid, gid,
+                                     cmp, value, timeout, *current);
+    }
+    catch (Memserver_Exception &e) {
+        throw Fam_Allocator_Exception((enum Fam_Error)e.fam_error(),
+                                      e.fam_error_msg());
+    }
+}
+
+/*
+ * Watch of a range in shared memory; a thread compares the range with a
+ * snapshot at every interval until the watch is deleted.
+ */
+class Fam_Watch_Local : public Fam_Watch {
+  public:
+    Fam_Watch_Local(char *local, uint64_t size, uint64_t checkInterval)
+        : live(local), snapshot(local, local + size), interval(checkInterval),
+          halt(false) {
+        scanThread = std::thread(&Fam_Watch_Local::scan, this);
+    }
+
+    ~Fam_Watch_Local() {
+        halt = true;
+        scanThread.join();
+    }
+
+  private:
+    void scan() {
+        while (!halt) {
+            usleep((useconds_t)(interval * 1000));
+            openfam_invalidate(live, snapshot.size());
+            uint64_t first, last;
+            if (fam_watch_scan(live, snapshot.data(), snapshot.size(), &first,
+                               &last))
+                notify(first, last - first);
+        }
+        finish();
+    }
+
+    char *live;
+    std::vector<char> snapshot;
+    uint64_t interval;
+    std::atomic<bool> halt;
+    std::thread scanThread;
+};
+
+Fam_Watch *Fam_Allocator_NVMM::watch(Fam_Descriptor *descriptor,
+                                     uint64_t offset, uint64_t nbytes,
+                                     uint64_t interval) {
+    Fam_Global_Descriptor globalDescriptor =
+        descriptor->get_global_descriptor();
+    char *local;
+    try {
+        local = (char *)allocator->get_local_range(
+            globalDescriptor.regionId, globalDescriptor.offset, offset, nbytes,
+            uid, gid);
+    }
+    catch (Memserver_Exception &e) {
+        throw Fam_Allocator_Exception((enum Fam_Error)e.fam_error(),
+                                      e.fam_error_msg());
+    }
+    openfam_invalidate(local, nbytes);
+    return new Fam_Watch_Local(
+        local, nbytes, std::max(interval, (uint64_t)FAM_WATCH_MIN_INTERVAL));
+}
+
+uint64_t Fam_Allocator_NVMM::reduce_item(Fam_Descriptor *descriptor,
+                                         uint64_t offset, uint64_t nElements,
+                                         Fam_Type type, Fam_Reduce_Op op) {
+    Fam_Global_Descriptor globalDescriptor =
+        descriptor->get_global_descriptor();
+    try {
+        return allocator->reduce_item(globalDescriptor.regionId,
+                                      globalDescriptor.offset, offset,
+                                      nElements, uid, gid, type, op);
+    }
+    catch (Memserver_Exception &e) {
+        throw Fam_Allocator_Exception((enum Fam_Error)e.fam_error(),
+                                      e.fam_error_msg());
+    }
+}
+
+uint64_t Fam_Allocator_NVMM::scan(Fam_Descriptor *descriptor, uint64_t offset,
+                                  const Fam_Scan_Query &query, void *local,
+                                  uint64_t localSize, uint64_t *nScanned) {
+    Fam_Global_Descriptor globalDescriptor =
+        descriptor->get_global_descriptor();
+    try {
+        return allocator->scan(globalDescriptor.regionId,
+                               globalDescriptor.offset, offset, query, uid,
+                               gid, local, localSize, *nScanned);
+    }
+    catch (Memserver_Exception &e) {
+        throw Fam_Allocator_Exception((enum Fam_Error)e.fam_error(),
+                                      e.fam_error_msg());
+    }
+}
+
+uint64_t Fam_Allocator_NVMM::scan_to_item(Fam_Descriptor *descriptor,
+                                          uint64_t offset,
+                                          const Fam_Scan_Query &query,
+                                          Fam_Descriptor *dest,
+                                          uint64_t destOffset,
+                                          uint64_t destSize,
+                                          uint64_t *nScanned) {
+    Fam_Global_Descriptor globalDescriptor =
+        descriptor->get_global_descriptor();
+    Fam_Global_Descriptor destGlobalDescriptor = dest->get_global_descriptor();
+    try {
+        return allocator->scan_to_item(
+            globalDescriptor.regionId, globalDescriptor.offset, offset, query,
+            destGlobalDescriptor.regionId, destGlobalDescriptor.offset,
+            destOffset, destSize, uid, gid, *nScanned);
+    }
+    catch (Memserver_Exception &e) {
+        throw Fam_Allocator_Exception((enum Fam_Error)e.fam_error(),
+                                      e.fam_error_msg());
+    }
+}
+
+uint64_t Fam_Allocator_NVMM::checksum(Fam_Descriptor *descriptor,
+                                      uint64_t offset, uint64_t nbytes,
+                                      Fam_Checksum_Algo algo) {
+    Fam_Global_Descriptor globalDescriptor =
+        descriptor->get_global_descriptor();
+    try {
+        return allocator->checksum(globalDescriptor.regionId,
+                                   globalDescriptor.offset, offset, nbytes,
+                                   uid, gid, algo);
+    }
+    catch (Memserver_Exception &e) {
+        throw Fam_Allocator_Exception((enum Fam_Error)e.fam_error(),
+                                      e.fam_error_msg());
+    }
+}
+
+bool Fam_Allocator_NVMM::compare(Fam_Descriptor *descriptor, uint64_t offset,
+                                 Fam_Descriptor *other, uint64_t otherOffset,
+                                 uint64_t nbytes, uint64_t *diffOffset) {
+    Fam_Global_Descriptor globalDescriptor =
+        descriptor->get_global_descriptor();
+    Fam_Global_Descriptor otherGlobalDescriptor =
+        other->get_global_descriptor();
+    try {
+        return allocator->compare(
+            globalDescriptor.regionId, globalDescriptor.offset, offset,
+            otherGlobalDescriptor.regionId, otherGlobalDescriptor.offset,
+            otherOffset, nbytes, uid, gid, *diffOffset);
+    }
+    catch (Memserver_Exception &e) {
+        throw Fam_Allocator_Exception((enum Fam_Error)e.fam_error(),
+                                      e.fam_error_msg());
+    }
+}
+
 void *Fam_Allocator_NVMM::fam_map(Fam_Descriptor *descriptor) {
     Fam_Global_Descriptor globalDescriptor =
         descriptor->get_global_descriptor();
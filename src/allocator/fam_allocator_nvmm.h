@@ -56,6 +56,11 @@ class Fam_Allocator_NVMM : public Fam_Allocator {
                              mode_t accessPermissions,
                              Fam_Region_Descriptor *region);
     void deallocate(Fam_Descriptor *descriptor);
+    void allocate_batch(const char **names, const uint64_t *sizes,
+                        uint64_t nItems, mode_t accessPermissions,
+                        Fam_Region_Descriptor *region,
+                        Fam_Descriptor **descriptors);
+    void deallocate_batch(Fam_Descriptor **descriptors, uint64_t nItems);
 
     int change_permission(Fam_Region_Descriptor *descriptor,
                           mode_t accessPermissions);
@@ -68,12 +73,28 @@ class Fam_Allocator_NVMM : public Fam_Allocator {
     Fam_Region_Item_Info
     check_permission_get_info(Fam_Region_Descriptor *descriptor);
     Fam_Region_Item_Info check_permission_get_info(Fam_Descriptor *descriptor);
+    void lookup_batch(const char **itemNames, uint64_t nItems,
+                      const char *regionName, uint64_t memoryServerId,
+                      Fam_Descriptor **descriptors);
+    void check_permission_get_info_batch(Fam_Descriptor **descriptors,
+                                         uint64_t nItems,
+                                         Fam_Region_Item_Info *itemInfo);
     void *copy(Fam_Descriptor *src, uint64_t srcOffset, Fam_Descriptor **dest,
                uint64_t destOffset, uint64_t nbytes) {
         return NULL;
     }
 
+    void *copy(Fam_Descriptor *src, uint64_t srcOffset, Fam_Descriptor *dest,
+               uint64_t destOffset, uint64_t nbytes) {
+        return NULL;
+    }
+
     void wait_for_copy(void *waitObj) {}
+
+    void *fill(Fam_Descriptor *descriptor, uint64_t offset, uint64_t nbytes,
+               uint64_t pattern, uint64_t patternSize) {
+        return NULL;
+    }
     /**
      * fam_map - Map a data item in FAM to the process virtual address space.
      * @param descriptor - Descriptor associated with the data item in FAM.
@@ -106,6 +127,103 @@ class Fam_Allocator_NVMM : public Fam_Allocator {
      */
     void release_CAS_lock(Fam_Descriptor *descriptor) {}
 
+    /**
+     * wait_until - Watch a word of a data item in shared memory until it
+     * satisfies a condition or a timeout expires.
+     * @param descriptor - Descriptor associated with the data item in FAM
+     * @param offset - byte offset of the word within the data item
+     * @param cmp - comparison of the word to the value
+     * @param value - value the word is compared to
+     * @param timeout - time in milliseconds to wait
+     * @param current - set to the last value of the word
+     * @return - true if the condition was met
+     */
+    bool wait_until(Fam_Descriptor *descriptor, uint64_t offset, Fam_Cmp cmp,
+                    uint64_t value, uint64_t timeout, uint64_t *current);
+
+    /**
+     * watch - Watch a range of a data item in shared memory for changes.
+     * @param descriptor - Descriptor associated with the data item in FAM
+     * @param offset - byte offset of the range within the data item
+     * @param nbytes - size of the range
+     * @param interval - time in milliseconds between two checks of the range
+     * @return - watch receiving the changes
+     */
+    Fam_Watch *watch(Fam_Descriptor *descriptor, uint64_t offset,
+                     uint64_t nbytes, uint64_t interval);
+
+    /**
+     * reduce_item - Reduce consecutive elements of a data item in shared
+     * memory.
+     * @param descriptor - Descriptor associated with the data item in FAM
+     * @param offset - byte offset of the first element within the data item
+     * @param nElements - number of elements
+     * @param type - data type of the elements
+     * @param op - reduction operation
+     * @return - bytes of the result, in the low-order bytes of the word
+     */
+    uint64_t reduce_item(Fam_Descriptor *descriptor, uint64_t offset,
+                         uint64_t nElements, Fam_Type type, Fam_Reduce_Op op);
+
+    /**
+     * scan - Scan the records of a data item in shared memory, and copy the
+     * matching ones to a local buffer.
+     * @param descriptor - Descriptor associated with the data item in FAM
+     * @param offset - byte offset of the first record within the data item
+     * @param query - records to scan, predicates and columns
+     * @param local - buffer receiving the matching records
+     * @param localSize - size of the buffer
+     * @param nScanned - set to the number of records scanned
+     * @return - number of records copied into the buffer
+     */
+    uint64_t scan(Fam_Descriptor *descriptor, uint64_t offset,
+                  const Fam_Scan_Query &query, void *local, uint64_t localSize,
+                  uint64_t *nScanned);
+
+    /**
+     * scan_to_item - Scan the records of a data item in shared memory, and
+     * copy the matching ones to another data item.
+     * @param descriptor - Descriptor associated with the data item in FAM
+     * @param offset - byte offset of the first record within the data item
+     * @param query - records to scan, predicates and columns
+     * @param dest - Descriptor of the data item receiving the records
+     * @param destOffset - byte offset within dest of the first record
+     * @param destSize - size of the range of dest receiving the records
+     * @param nScanned - set to the number of records scanned
+     * @return - number of records copied into dest
+     */
+    uint64_t scan_to_item(Fam_Descriptor *descriptor, uint64_t offset,
+                          const Fam_Scan_Query &query, Fam_Descriptor *dest,
+                          uint64_t destOffset, uint64_t destSize,
+                          uint64_t *nScanned);
+
+    /**
+     * checksum - Compute a digest of a range of a data item in shared
+     * memory.
+     * @param descriptor - Descriptor associated with the data item in FAM
+     * @param offset - byte offset of the range within the data item
+     * @param nbytes - size of the range
+     * @param algo - digest algorithm
+     * @return - digest of the range
+     */
+    uint64_t checksum(Fam_Descriptor *descriptor, uint64_t offset,
+                      uint64_t nbytes, Fam_Checksum_Algo algo);
+
+    /**
+     * compare - Compare ranges of two data items in shared memory.
+     * @param descriptor - Descriptor associated with the data item in FAM
+     * @param offset - byte offset of the range within the data item
+     * @param other - Descriptor of the other data item
+     * @param otherOffset - byte offset of the range within other
+     * @param nbytes - size of the ranges
+     * @param diffOffset - set to the offset within the ranges of the first
+     * byte which differs
+     * @return - true if the ranges are equal
+     */
+    bool compare(Fam_Descriptor *descriptor, uint64_t offset,
+                 Fam_Descriptor *other, uint64_t otherOffset, uint64_t nbytes,
+                 uint64_t *diffOffset);
+
   private:
     Memserver_Allocator *allocator;
     uint32_t uid;
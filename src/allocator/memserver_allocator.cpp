@@ -28,6 +28,7 @@
  *
  */
 #include "allocator/memserver_allocator.h"
+#include <random>
 
 namespace openfam {
 Memserver_Allocator::Memserver_Allocator() {
@@ -37,9 +38,16 @@ Memserver_Allocator::Memserver_Allocator() {
     metadataManager = FAM_Metadata_Manager::GetInstance();
     (void)pthread_mutex_init(&heapMapLock, NULL);
     init_poolId_bmap();
+    copyEngine = new Memserver_Copy_Engine();
+    writeCount = 0;
+    // Start generations at a random value, so that they are not reused
+    // across restarts of the memory server
+    std::random_device randomDevice;
+    itemGeneration = ((uint64_t)randomDevice() << 32) | randomDevice();
 }
 
 Memserver_Allocator::~Memserver_Allocator() {
+    delete copyEngine;
     delete heapMap;
     pthread_mutex_destroy(&heapMapLock);
 }
@@ -74,10 +82,14 @@ void Memserver_Allocator::init_poolId_bmap() {
  * nbytes - size of region in bytes
  * permission - Permission for the region
  * uid/gid - user id and group id
+ * uniformItems - give all the data items of the region its owner and
+ * permission, so that its memory can be registered as a whole. Ignored for
+ * regions larger than MAX_REGION_MR_SIZE.
  */
 int Memserver_Allocator::create_region(string name, uint64_t &regionId,
                                        size_t nbytes, mode_t permission,
-                                       uint32_t uid, uint32_t gid) {
+                                       uint32_t uid, uint32_t gid,
+                                       bool uniformItems) {
     ostringstream message;
     message << "Error While creating region : ";
 
@@ -167,6 +179,7 @@ int Memserver_Allocator::create_region(string name, uint64_t &regionId,
     region.uid = uid;
     region.gid = gid;
     region.size = nbytes;
+    region.uniformItems = (uniformItems && (tmpSize <= MAX_REGION_MR_SIZE));
     ret = metadataManager->metadata_insert_region(regionId, name, &region);
     if (ret != META_NO_ERROR) {
         message << "Can not insert region into metadata service, ";
@@ -294,6 +307,14 @@ int Memserver_Allocator::resize_region(uint64_t regionId, uint32_t uid,
                                   message.str().c_str());
     }
 
+    // The keys of a region registered as a whole can not reach beyond
+    // MAX_REGION_MR_SIZE
+    if (region.uniformItems && (nbytes > MAX_REGION_MR_SIZE)) {
+        message << "Region registered as a whole can not grow beyond "
+                << MAX_REGION_MR_SIZE << " bytes";
+        throw Memserver_Exception(RESIZE_FAILED, message.str().c_str());
+    }
+
     // Get the heap and open it if not open already
     Heap *heap = 0;
     HeapMap::iterator it = get_heap(regionId, heap);
@@ -344,17 +365,60 @@ int Memserver_Allocator::allocate(string name, uint64_t regionId, size_t nbytes,
                                   uint32_t uid, uint32_t gid,
                                   Fam_DataItem_Metadata &dataitem,
                                   void *&localPointer) {
-    ostringstream message;
-    message << "Error While allocating dataitem : ";
+    Heap *heap = get_allocation_heap(regionId, permission, uid, gid);
+    allocate_from_heap(heap, name, regionId, nbytes, offset, permission, uid,
+                       gid, dataitem, localPointer);
+    return ALLOC_NO_ERROR;
+}
 
-    // Check if the name size is bigger than MAX_KEY_LEN supported
-    if (name.size() > metadataManager->metadata_maxkeylen()) {
-        message << "Name too long";
-        throw Memserver_Exception(DATAITEM_NAME_TOO_LONG,
-                                  message.str().c_str());
+/*
+ * Allocate multiple data items in a region. The region and its heap are
+ * resolved and checked once for all the items. Either all the items are
+ * allocated, or none of them.
+ * names - names of the data items, empty for unnamed ones
+ * sizes - sizes of the data items
+ * dataitems - dataitem descriptors of the allocated items
+ * localPointers - local pointers for the dataitem offsets
+ */
+void Memserver_Allocator::allocate_batch(
+    uint64_t regionId, const std::vector<string> &names,
+    const std::vector<size_t> &sizes, mode_t permission, uint32_t uid,
+    uint32_t gid, std::vector<Fam_DataItem_Metadata> &dataitems,
+    std::vector<void *> &localPointers) {
+    Heap *heap = get_allocation_heap(regionId, permission, uid, gid);
+
+    dataitems.resize(sizes.size());
+    localPointers.resize(sizes.size());
+    for (size_t ndx = 0; ndx < sizes.size(); ndx++) {
+        uint64_t offset;
+        try {
+            allocate_from_heap(heap, names[ndx], regionId, sizes[ndx], offset,
+                               permission, uid, gid, dataitems[ndx],
+                               localPointers[ndx]);
+        } catch (Memserver_Exception &e) {
+            // Release the items allocated so far
+            for (size_t i = 0; i < ndx; i++) {
+                metadataManager->metadata_delete_dataitem(
+                    dataitems[i].offset / MIN_OBJ_SIZE, regionId);
+                heap->Free(dataitems[i].offset);
+            }
+            dataitems.clear();
+            localPointers.clear();
+            throw;
+        }
     }
+}
+
+/*
+ * Check that the region exists and that the caller may allocate data items in
+ * it with the given permission, and return the heap of the region.
+ */
+Heap *Memserver_Allocator::get_allocation_heap(uint64_t regionId,
+                                               mode_t permission, uint32_t uid,
+                                               uint32_t gid) {
+    ostringstream message;
+    message << "Error While allocating dataitem : ";
 
-    size_t tmpSize;
     // Check with metadata service if the region exist, if not return error
     Fam_Region_Metadata region;
     int ret = metadataManager->metadata_find_region(regionId, region);
@@ -376,17 +440,17 @@ int Memserver_Allocator::allocate(string name, uint64_t regionId, size_t nbytes,
         }
     }
 
-    // Check with metadata service if data item with the requested name
-    // is already exist, if exists return error
-    if (name != "") {
-        ret = metadataManager->metadata_find_dataitem(name, regionId, dataitem);
-        if (ret == META_NO_ERROR) {
-            message << "Dataitem with the name provided already exist";
-            throw Memserver_Exception(DATAITEM_EXIST, message.str().c_str());
-        }
+    // A key of a region registered as a whole reaches all its data items, so
+    // they all have the owner and the permission of the region
+    if (region.uniformItems &&
+        ((uid != region.uid) || (gid != region.gid) ||
+         (permission != region.perm))) {
+        message << "Dataitems of the region must have its owner and "
+                   "permission";
+        throw Memserver_Exception(DATAITEM_ALLOC_NOT_PERMITTED,
+                                  message.str().c_str());
     }
 
-    // Call NVMM to create a new data item
     Heap *heap = 0;
 
     HeapMap::iterator it = get_heap(regionId, heap);
@@ -403,7 +467,39 @@ int Memserver_Allocator::allocate(string name, uint64_t regionId, size_t nbytes,
                                       message.str().c_str());
         }
     }
+    return heap;
+}
 
+/*
+ * Allocate a data item from the heap of its region, and register it with the
+ * metadata service.
+ */
+void Memserver_Allocator::allocate_from_heap(
+    Heap *heap, string name, uint64_t regionId, size_t nbytes,
+    uint64_t &offset, mode_t permission, uint32_t uid, uint32_t gid,
+    Fam_DataItem_Metadata &dataitem, void *&localPointer) {
+    ostringstream message;
+    message << "Error While allocating dataitem : ";
+    int ret;
+
+    // Check if the name size is bigger than MAX_KEY_LEN supported
+    if (name.size() > metadataManager->metadata_maxkeylen()) {
+        message << "Name too long";
+        throw Memserver_Exception(DATAITEM_NAME_TOO_LONG,
+                                  message.str().c_str());
+    }
+
+    // Check with metadata service if data item with the requested name
+    // is already exist, if exists return error
+    if (name != "") {
+        ret = metadataManager->metadata_find_dataitem(name, regionId, dataitem);
+        if (ret == META_NO_ERROR) {
+            message << "Dataitem with the name provided already exist";
+            throw Memserver_Exception(DATAITEM_EXIST, message.str().c_str());
+        }
+    }
+
+    size_t tmpSize;
     // If the requested siz is lessar than MIN_OBJ_SIZE,
     // allocate data item of size MIN_OBJ_SIZE
     if (nbytes < MIN_OBJ_SIZE)
@@ -437,6 +533,7 @@ int Memserver_Allocator::allocate(string name, uint64_t regionId, size_t nbytes,
     dataitem.gid = gid;
     dataitem.uid = uid;
     dataitem.size = nbytes;
+    dataitem.generation = __sync_add_and_fetch(&itemGeneration, 1);
     if (name == "")
         ret = metadataManager->metadata_insert_dataitem(dataitemId, regionId,
                                                         &dataitem);
@@ -448,8 +545,6 @@ int Memserver_Allocator::allocate(string name, uint64_t regionId, size_t nbytes,
         heap->Free(offset);
         throw Memserver_Exception(DATAITEM_NOT_INSERTED, message.str().c_str());
     }
-
-    return ALLOC_NO_ERROR;
 }
 
 /*
@@ -539,6 +634,14 @@ int Memserver_Allocator::change_region_permission(uint64_t regionId,
                                   message.str().c_str());
     }
 
+    // The data items of a region registered as a whole keep its permission
+    if (region.uniformItems) {
+        message << "Permission of a region registered as a whole can not be "
+                   "modified";
+        throw Memserver_Exception(REGION_PERM_MODIFY_NOT_PERMITTED,
+                                  message.str().c_str());
+    }
+
     // Update the permission of region with metadata service
     region.perm = permission;
     ret = metadataManager->metadata_modify_region(regionId, &region);
@@ -574,6 +677,16 @@ int Memserver_Allocator::change_dataitem_permission(uint64_t regionId,
                                   message.str().c_str());
     }
 
+    // The data items of a region registered as a whole keep its permission
+    Fam_Region_Metadata region;
+    ret = metadataManager->metadata_find_region(regionId, region);
+    if ((ret == META_NO_ERROR) && region.uniformItems &&
+        (permission != region.perm)) {
+        message << "Dataitems of the region must have its permission";
+        throw Memserver_Exception(ITEM_PERM_MODIFY_NOT_PERMITTED,
+                                  message.str().c_str());
+    }
+
     // Update the permission of region with metadata service
     dataitem.perm = permission;
     ret = metadataManager->metadata_modify_dataitem(dataitemId, regionId,
@@ -651,9 +764,28 @@ int Memserver_Allocator::get_dataitem(string itemName, string regionName,
 }
 
 /*
- * dataitem lookup for the given region name and offset.
+ * dataitem lookup for the given dataitem name and region id.
  * Returns the Fam_Dataitem_Metadata for the given name
  */
+int Memserver_Allocator::get_dataitem(string itemName, uint64_t regionId,
+                                      uint32_t uid, uint32_t gid,
+                                      Fam_DataItem_Metadata &dataitem) {
+    ostringstream message;
+    message << "Error While locating dataitem : ";
+    int ret =
+        metadataManager->metadata_find_dataitem(itemName, regionId, dataitem);
+    if (ret != META_NO_ERROR) {
+        message << "could not find the dataitem";
+        throw Memserver_Exception(DATAITEM_NOT_FOUND, message.str().c_str());
+    }
+
+    return ALLOC_NO_ERROR;
+}
+
+/*
+ * dataitem lookup for the given region id and offset.
+ * Returns the Fam_Dataitem_Metadata of the dataitem at that offset
+ */
 int Memserver_Allocator::get_dataitem(uint64_t regionId, uint64_t offset,
                                       uint32_t uid, uint32_t gid,
                                       Fam_DataItem_Metadata &dataitem) {
@@ -670,6 +802,28 @@ int Memserver_Allocator::get_dataitem(uint64_t regionId, uint64_t offset,
     return ALLOC_NO_ERROR;
 }
 
+/*
+ * dataitem lookup for several offsets in the same region, finding the region
+ * once. Returns the Fam_Dataitem_Metadata of the dataitems, indexed like the
+ * offsets; found tells which of them exist.
+ */
+void Memserver_Allocator::get_dataitems(
+    uint64_t regionId, const std::vector<uint64_t> &offsets,
+    std::vector<Fam_DataItem_Metadata> &dataitems, std::vector<bool> &found) {
+    std::vector<uint64_t> dataitemIds;
+    for (auto offset : offsets)
+        dataitemIds.push_back(offset / MIN_OBJ_SIZE);
+
+    std::vector<int> rets;
+    found.assign(offsets.size(), false);
+    int ret = metadataManager->metadata_find_dataitems(regionId, dataitemIds,
+                                                       dataitems, rets);
+    if (ret != META_NO_ERROR)
+        return;
+    for (size_t ndx = 0; ndx < offsets.size(); ndx++)
+        found[ndx] = (rets[ndx] == META_NO_ERROR);
+}
+
 /*
  * Check if the given uid/gid has read or rw permissions for
  * a given dataitem.
@@ -710,6 +864,47 @@ void *Memserver_Allocator::get_local_pointer(uint64_t regionId,
     return heap->OffsetToLocal(offset);
 }
 
+/*
+ * Returns the local address and size of the memory of a region, which must be
+ * mapped contiguously for the region to be registered as a whole, and small
+ * enough for the offsets of its dataitems to fit in a key.
+ */
+void Memserver_Allocator::get_region_memory(uint64_t regionId, void *&base,
+                                            size_t &size) {
+    ostringstream message;
+    message << "Error While getting memory of region : ";
+    Heap *heap = 0;
+    int ret;
+
+    HeapMap::iterator it = get_heap(regionId, heap);
+    if (it == heapMap->end()) {
+        ret = open_heap(regionId);
+        if (ret != ALLOC_NO_ERROR) {
+            message << "Opening of heap failed";
+            throw Memserver_Exception(HEAP_NOT_OPENED, message.str().c_str());
+        }
+        it = get_heap(regionId, heap);
+        if (it == heapMap->end()) {
+            message << "Can not find heap in map";
+            throw Memserver_Exception(NO_LOCAL_POINTER, message.str().c_str());
+        }
+    }
+    base = heap->OffsetToLocal(0);
+    size = heap->Size();
+    // Only the first and last bytes are compared, which does not prove that
+    // the pages in between are mapped in order; the heaps in use are mapped
+    // as a single range when they are.
+    if ((base == NULL) || (size == 0) ||
+        (heap->OffsetToLocal(size - 1) != (char *)base + size - 1)) {
+        message << "Region memory is not mapped contiguously";
+        throw Memserver_Exception(NO_LOCAL_POINTER, message.str().c_str());
+    }
+    if (size > MAX_REGION_MR_SIZE) {
+        message << "Region memory is beyond the range of the keys";
+        throw Memserver_Exception(OUT_OF_RANGE, message.str().c_str());
+    }
+}
+
 int Memserver_Allocator::open_heap(uint64_t regionId) {
     ostringstream message;
     message << "Error While opening heap : ";
@@ -752,43 +947,356 @@ int Memserver_Allocator::open_heap(uint64_t regionId) {
     return ALLOC_NO_ERROR;
 }
 
+/*
+ * Copy a range of a dataitem into a range of another dataitem, possibly in
+ * another region, after checking that the caller may read the source and
+ * write the destination and that both ranges lie within their dataitems.
+ * Returns once the copy is persisted.
+ */
 int Memserver_Allocator::copy(uint64_t regionId, uint64_t srcOffset,
-                              uint64_t srcCopyStart, uint64_t destOffset,
-                              uint64_t destCopyStart, uint32_t uid,
-                              uint32_t gid, size_t nbytes) {
+                              uint64_t srcCopyStart, uint64_t destRegionId,
+                              uint64_t destOffset, uint64_t destCopyStart,
+                              uint32_t uid, uint32_t gid, size_t nbytes) {
+    std::mutex doneLock;
+    std::condition_variable doneCond;
+    bool copied = false;
+    copy_async(regionId, srcOffset, srcCopyStart, destRegionId, destOffset,
+               destCopyStart, uid, gid, nbytes, [&] {
+                   std::lock_guard<std::mutex> lock(doneLock);
+                   copied = true;
+                   doneCond.notify_one();
+               });
+
+    std::unique_lock<std::mutex> lock(doneLock);
+    doneCond.wait(lock, [&] { return copied; });
+    return ALLOC_NO_ERROR;
+}
+
+/*
+ * Start a copy between dataitems, with the same checks as copy(), which throw
+ * before the copy starts. Copies smaller than MEMSERVER_COPY_INLINE_SIZE are
+ * done by the caller; larger ones are handed to the copy engine, so that the
+ * caller can serve other requests meanwhile. done is called once the copy is
+ * persisted, possibly by a thread of the copy engine.
+ */
+void Memserver_Allocator::copy_async(uint64_t regionId, uint64_t srcOffset,
+                                     uint64_t srcCopyStart,
+                                     uint64_t destRegionId,
+                                     uint64_t destOffset,
+                                     uint64_t destCopyStart, uint32_t uid,
+                                     uint32_t gid, size_t nbytes,
+                                     std::function<void()> done) {
+    void *srcStart = get_local_range(regionId, srcOffset, srcCopyStart, nbytes,
+                                     uid, gid);
+    void *destStart = get_local_range(destRegionId, destOffset, destCopyStart,
+                                      nbytes, uid, gid, 1);
+
+    openfam_invalidate(srcStart, nbytes);
+    if (nbytes < MEMSERVER_COPY_INLINE_SIZE) {
+        fam_copy_local(destStart, srcStart, nbytes);
+        openfam_persist(destStart, nbytes);
+        notify_writes();
+        done();
+    } else {
+        copyEngine->submit(destStart, srcStart, nbytes, [this, done] {
+            notify_writes();
+            done();
+        });
+    }
+}
+
+/*
+ * Run a long request on a thread of the copy engine, so that the caller can
+ * serve other requests meanwhile. The task reports its own completion.
+ */
+void Memserver_Allocator::run_async(std::function<void()> task) {
+    copyEngine->run(task);
+}
+
+/*
+ * Returns the local pointer to a range of a dataitem, after checking that the
+ * caller may read (or write, if op is set) the dataitem and that the range
+ * lies within it.
+ */
+void *Memserver_Allocator::get_local_range(uint64_t regionId, uint64_t offset,
+                                           uint64_t rangeOffset, uint64_t size,
+                                           uint32_t uid, uint32_t gid,
+                                           bool op) {
     ostringstream message;
-    message << "Error While copying from dataitem : ";
-    Fam_DataItem_Metadata srcDataitem;
-    Fam_DataItem_Metadata destDataitem;
-    void *srcStart;
-    void *destStart;
+    message << "Error While accessing dataitem : ";
+    Fam_DataItem_Metadata dataitem;
 
-    get_dataitem(regionId, srcOffset, uid, gid, srcDataitem);
+    get_dataitem(regionId, offset, uid, gid, dataitem);
+    if (!check_dataitem_permission(dataitem, op, uid, gid)) {
+        message << "Not permitted to " << (op ? "write" : "read")
+                << " the dataitem";
+        throw Memserver_Exception(NO_PERMISSION, message.str().c_str());
+    }
+    if ((rangeOffset > dataitem.size) || (size > dataitem.size - rangeOffset)) {
+        message << "Offset or size is beyond dataitem boundary";
+        throw Memserver_Exception(OUT_OF_RANGE, message.str().c_str());
+    }
 
-    get_dataitem(regionId, destOffset, uid, gid, destDataitem);
+    void *local = get_local_pointer(regionId, offset + rangeOffset);
+    if (local == NULL) {
+        message << "Failed to get local pointer to dataitem";
+        throw Memserver_Exception(NULL_POINTER_ACCESS, message.str().c_str());
+    }
+    return local;
+}
 
-    if ((srcCopyStart + nbytes) < srcDataitem.size)
-        srcStart = get_local_pointer(regionId, srcOffset + srcCopyStart);
-    else {
-        message << "Source offset or size is beyond dataitem boundary";
+/*
+ * Fill a range of a dataitem with a pattern of patternSize bytes repeated.
+ * Returns once the fill is persisted.
+ */
+void Memserver_Allocator::fill(uint64_t regionId, uint64_t offset,
+                               uint64_t fillOffset, uint64_t nbytes,
+                               uint32_t uid, uint32_t gid, uint64_t pattern,
+                               uint64_t patternSize) {
+    std::mutex doneLock;
+    std::condition_variable doneCond;
+    bool filled = false;
+    fill_async(regionId, offset, fillOffset, nbytes, uid, gid, pattern,
+               patternSize, [&] {
+                   std::lock_guard<std::mutex> lock(doneLock);
+                   filled = true;
+                   doneCond.notify_one();
+               });
+
+    std::unique_lock<std::mutex> lock(doneLock);
+    doneCond.wait(lock, [&] { return filled; });
+}
+
+/*
+ * Start a fill of a range of a dataitem, with the checks throwing before the
+ * fill starts. As for copy_async(), small fills are done by the caller and
+ * larger ones by the copy engine; done is called once the fill is persisted.
+ */
+void Memserver_Allocator::fill_async(uint64_t regionId, uint64_t offset,
+                                     uint64_t fillOffset, uint64_t nbytes,
+                                     uint32_t uid, uint32_t gid,
+                                     uint64_t pattern, uint64_t patternSize,
+                                     std::function<void()> done) {
+    if ((patternSize == 0) || (sizeof(uint64_t) % patternSize)) {
+        throw Memserver_Exception(
+            INVALID_OPTIONS, "Error While filling dataitem : Invalid pattern");
+    }
+    void *dest = get_local_range(regionId, offset, fillOffset, nbytes, uid,
+                                 gid, 1);
+    if (nbytes < MEMSERVER_COPY_INLINE_SIZE) {
+        fam_fill_local(dest, nbytes, pattern, patternSize);
+        openfam_persist(dest, nbytes);
+        notify_writes();
+        done();
+    } else {
+        copyEngine->submit_fill(dest, nbytes, pattern, patternSize,
+                                [this, done] {
+                                    notify_writes();
+                                    done();
+                                });
+    }
+}
+
+/*
+ * Wake the wait_until calls, after this memory server wrote to a dataitem
+ */
+void Memserver_Allocator::notify_writes() {
+    std::lock_guard<std::mutex> lock(writeLock);
+    writeCount++;
+    writeCond.notify_all();
+}
+
+/*
+ * Watch a 64-bit word of a dataitem until it satisfies the given condition or
+ * the timeout (in milliseconds) expires. The word is read from local memory.
+ * Writes done by this memory server (copies, fills, scans) wake the waiter at
+ * once; one-sided writes of PEs are not seen by the memory server, so the
+ * word is also polled with the same backoff as the polling done by PEs.
+ * The timeout is capped at FAM_WAIT_SERVER_TIMEOUT, so that a request holds
+ * a server thread for a bounded time; PEs ask again until the condition is
+ * met. Returns true if the condition was met; current holds the last value
+ * read.
+ */
+bool Memserver_Allocator::wait_until(uint64_t regionId, uint64_t offset,
+                                     uint64_t waitOffset, uint32_t uid,
+                                     uint32_t gid, Fam_Cmp cmp, uint64_t value,
+                                     uint64_t timeout, uint64_t &current) {
+    if (waitOffset % sizeof(uint64_t)) {
+        throw Memserver_Exception(
+            OUT_OF_RANGE, "Error While waiting on dataitem : Offset is not "
+                          "aligned");
+    }
+    uint64_t *word = (uint64_t *)get_local_range(
+        regionId, offset, waitOffset, sizeof(uint64_t), uid, gid);
+
+    timeout = std::min(timeout, (uint64_t)FAM_WAIT_SERVER_TIMEOUT);
+    struct timespec start, now;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    uint64_t delay = FAM_WAIT_MIN_BACKOFF;
+    while (true) {
+        uint64_t writes;
+        {
+            std::lock_guard<std::mutex> lock(writeLock);
+            writes = writeCount;
+        }
+        openfam_invalidate(word, sizeof(uint64_t));
+        current = __atomic_load_n(word, __ATOMIC_ACQUIRE);
+        if (fam_wait_satisfied(current, cmp, value))
+            return true;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        uint64_t elapsed = (now.tv_sec - start.tv_sec) * 1000 +
+                           (now.tv_nsec - start.tv_nsec) / 1000000;
+        if (elapsed >= timeout)
+            return false;
+
+        std::unique_lock<std::mutex> lock(writeLock);
+        writeCond.wait_for(lock, std::chrono::microseconds(delay),
+                           [&] { return writeCount != writes; });
+        delay = std::min(delay * 2, (uint64_t)FAM_WAIT_MAX_BACKOFF);
+    }
+}
+
+/*
+ * Reduce nElements consecutive elements of a dataitem, read from local
+ * memory. Returns the bytes of the result in the low-order bytes of the word.
+ */
+uint64_t Memserver_Allocator::reduce_item(uint64_t regionId, uint64_t offset,
+                                          uint64_t reduceOffset,
+                                          uint64_t nElements, uint32_t uid,
+                                          uint32_t gid, Fam_Type type,
+                                          Fam_Reduce_Op op) {
+    ostringstream message;
+    message << "Error While reducing dataitem : ";
+    size_t typeSize = fam_type_size(type);
+    if ((fam_reduce_result_size(type, op) == 0) || (nElements == 0)) {
+        message << "Invalid data type, operation or number of elements";
+        throw Memserver_Exception(INVALID_OPTIONS, message.str().c_str());
+    }
+    if (nElements > UINT64_MAX / typeSize) {
+        message << "Offset or size is beyond dataitem boundary";
         throw Memserver_Exception(OUT_OF_RANGE, message.str().c_str());
     }
+    uint64_t nbytes = nElements * typeSize;
+    void *data = get_local_range(regionId, offset, reduceOffset, nbytes, uid,
+                                 gid);
+    openfam_invalidate(data, nbytes);
+
+    uint64_t result = 0;
+    fam_reduce_local(data, nElements, type, op, &result);
+    return result;
+}
 
-    if ((destCopyStart + nbytes) < destDataitem.size)
-        destStart = get_local_pointer(regionId, destOffset + destCopyStart);
-    else {
-        message << "Destination offset or size is beyond dataitem boundary";
+/*
+ * Scan the records of a dataitem, read from local memory, and copy the
+ * selected columns of the records matching the query to out, until outSize
+ * bytes are used. Returns the number of records copied; nScanned is set to
+ * the number of records scanned.
+ */
+uint64_t Memserver_Allocator::scan(uint64_t regionId, uint64_t offset,
+                                   uint64_t scanOffset,
+                                   const Fam_Scan_Query &query, uint32_t uid,
+                                   uint32_t gid, void *out, uint64_t outSize,
+                                   uint64_t &nScanned) {
+    ostringstream message;
+    message << "Error While scanning dataitem : ";
+    if ((query.recordSize == 0) || (fam_scan_result_size(query) == 0)) {
+        message << "Invalid record size, predicate or column";
+        throw Memserver_Exception(INVALID_OPTIONS, message.str().c_str());
+    }
+    if (query.nRecords > UINT64_MAX / query.recordSize) {
+        message << "Offset or size is beyond dataitem boundary";
         throw Memserver_Exception(OUT_OF_RANGE, message.str().c_str());
     }
+    uint64_t nbytes = query.nRecords * query.recordSize;
+    void *data = get_local_range(regionId, offset, scanOffset, nbytes, uid,
+                                 gid);
+    openfam_invalidate(data, nbytes);
 
-    if ((srcStart == NULL) || (destStart == NULL)) {
-        message
-            << "Failed to get local pointer to source or destination dataitem";
-        throw Memserver_Exception(NULL_POINTER_ACCESS, message.str().c_str());
+    return fam_scan_local(data, query, out, outSize, nScanned);
+}
+
+/*
+ * Scan the records of a dataitem, and write the selected columns of the
+ * records matching the query to a range of another dataitem. If the range
+ * overlaps the scanned records of the same dataitem, the results are staged
+ * in a local buffer, so that no record is overwritten before it is scanned.
+ */
+uint64_t Memserver_Allocator::scan_to_item(
+    uint64_t regionId, uint64_t offset, uint64_t scanOffset,
+    const Fam_Scan_Query &query, uint64_t destRegionId, uint64_t destOffset,
+    uint64_t destScanOffset, uint64_t destSize, uint32_t uid, uint32_t gid,
+    uint64_t &nScanned) {
+    void *out = get_local_range(destRegionId, destOffset, destScanOffset,
+                                destSize, uid, gid, 1);
+    bool overlap = false;
+    if ((regionId == destRegionId) && (offset == destOffset)) {
+        uint64_t nbytes = UINT64_MAX - scanOffset;
+        if ((query.recordSize != 0) &&
+            (query.nRecords <= nbytes / query.recordSize))
+            nbytes = query.nRecords * query.recordSize;
+        overlap = (destScanOffset < scanOffset + nbytes) &&
+                  (scanOffset < destScanOffset + destSize);
+    }
+
+    uint64_t nMatched;
+    if (overlap) {
+        uint64_t resultSize = fam_scan_result_size(query);
+        uint64_t stageSize = destSize;
+        if ((resultSize != 0) &&
+            (query.nRecords <= stageSize / resultSize))
+            stageSize = query.nRecords * resultSize;
+        std::vector<char> stage(stageSize);
+        nMatched = scan(regionId, offset, scanOffset, query, uid, gid,
+                        stage.data(), stageSize, nScanned);
+        memcpy(out, stage.data(), nMatched * resultSize);
     } else {
-        fam_memcpy(destStart, srcStart, nbytes);
-        return ALLOC_NO_ERROR;
+        nMatched = scan(regionId, offset, scanOffset, query, uid, gid, out,
+                        destSize, nScanned);
     }
+    openfam_persist(out, nMatched * fam_scan_result_size(query));
+    notify_writes();
+    return nMatched;
+}
+
+/*
+ * Compute a digest of a range of a dataitem, read from local memory.
+ */
+uint64_t Memserver_Allocator::checksum(uint64_t regionId, uint64_t offset,
+                                       uint64_t checksumOffset,
+                                       uint64_t nbytes, uint32_t uid,
+                                       uint32_t gid, Fam_Checksum_Algo algo) {
+    ostringstream message;
+    message << "Error While computing checksum of dataitem : ";
+    if ((algo != FAM_CHECKSUM_CRC32C) && (algo != FAM_CHECKSUM_XXH64)) {
+        message << "Invalid checksum algorithm";
+        throw Memserver_Exception(INVALID_OPTIONS, message.str().c_str());
+    }
+    void *data = get_local_range(regionId, offset, checksumOffset, nbytes, uid,
+                                 gid);
+    openfam_invalidate(data, nbytes);
+
+    return fam_checksum_local(data, nbytes, algo);
+}
+
+/*
+ * Compare ranges of two dataitems, read from local memory. Returns true if
+ * they are equal; otherwise diffOffset is set to the offset within the ranges
+ * of the first byte which differs.
+ */
+bool Memserver_Allocator::compare(uint64_t regionId, uint64_t offset,
+                                  uint64_t compareOffset,
+                                  uint64_t otherRegionId, uint64_t otherOffset,
+                                  uint64_t otherCompareOffset, uint64_t nbytes,
+                                  uint32_t uid, uint32_t gid,
+                                  uint64_t &diffOffset) {
+    void *data = get_local_range(regionId, offset, compareOffset, nbytes, uid,
+                                 gid);
+    void *other = get_local_range(otherRegionId, otherOffset,
+                                  otherCompareOffset, nbytes, uid, gid);
+    openfam_invalidate(data, nbytes);
+    openfam_invalidate(other, nbytes);
+
+    return fam_compare_local(data, other, nbytes, &diffOffset);
 }
 
 HeapMap::iterator Memserver_Allocator::get_heap(uint64_t regionId,
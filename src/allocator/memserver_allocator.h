@@ -30,9 +30,14 @@
 #ifndef MEMSERVER_ALLOCATOR_H_
 #define MEMSERVER_ALLOCATOR_H_
 
+#include <chrono>
+#include <condition_variable>
 #include <iostream>
+#include <mutex>
 #include <pthread.h>
 #include <sys/types.h> // needed for mode_t
+#include <time.h>
+#include <vector>
 
 #include <nvmm/error_code.h>
 #include <nvmm/global_ptr.h>
@@ -41,8 +46,15 @@
 #include <nvmm/memory_manager.h>
 #include <nvmm/shelf_id.h>
 
+#include "allocator/memserver_copy_engine.h"
 #include "bitmap-manager/bitmap.h"
+#include "common/fam_checksum.h"
+#include "common/fam_copy.h"
+#include "common/fam_fill.h"
 #include "common/fam_internal.h"
+#include "common/fam_reduce.h"
+#include "common/fam_scan.h"
+#include "common/fam_wait.h"
 #include "common/memserver_exception.h"
 #include "fam/fam.h"
 #include "metadata/fam_metadata_manager.h"
@@ -50,6 +62,10 @@
 #define MIN_OBJ_SIZE 128
 #define MIN_REGION_SIZE (1UL << 20)
 
+// Largest region whose dataitems can be told apart in the keys of its memory
+// registered as a whole
+#define MAX_REGION_MR_SIZE ((1UL << DATAITEMID_BITS) * DATAITEMID_UNIT)
+
 using namespace std;
 using namespace nvmm;
 using namespace metadata;
@@ -64,7 +80,8 @@ class Memserver_Allocator {
     ~Memserver_Allocator();
     void memserver_allocator_finalize();
     int create_region(string name, uint64_t &regionId, size_t nbytes,
-                      mode_t permission, uint32_t uid, uint32_t gid);
+                      mode_t permission, uint32_t uid, uint32_t gid,
+                      bool uniformItems = false);
     int destroy_region(uint64_t regionId, uint32_t uid, uint32_t gid);
     int resize_region(uint64_t regionId, uint32_t uid, uint32_t gid,
                       size_t nbytes);
@@ -72,6 +89,11 @@ class Memserver_Allocator {
                  uint64_t &offset, mode_t permission, uint32_t uid,
                  uint32_t gid, Fam_DataItem_Metadata &dataitem,
                  void *&localPointer);
+    void allocate_batch(uint64_t regionId, const std::vector<string> &names,
+                        const std::vector<size_t> &sizes, mode_t permission,
+                        uint32_t uid, uint32_t gid,
+                        std::vector<Fam_DataItem_Metadata> &dataitems,
+                        std::vector<void *> &localPointers);
     int deallocate(uint64_t regionId, uint64_t offset, uint32_t uid,
                    uint32_t gid);
     int change_region_permission(uint64_t regionId, mode_t permission,
@@ -89,13 +111,57 @@ class Memserver_Allocator {
                      uint32_t gid, Fam_DataItem_Metadata &dataitem);
     int get_dataitem(uint64_t regionId, uint64_t offset, uint32_t uid,
                      uint32_t gid, Fam_DataItem_Metadata &dataitem);
+    int get_dataitem(string itemName, uint64_t regionId, uint32_t uid,
+                     uint32_t gid, Fam_DataItem_Metadata &dataitem);
+    void get_dataitems(uint64_t regionId, const std::vector<uint64_t> &offsets,
+                       std::vector<Fam_DataItem_Metadata> &dataitems,
+                       std::vector<bool> &found);
     bool check_dataitem_permission(Fam_DataItem_Metadata dataitem, bool op,
                                    uint32_t uid, uint32_t gid);
     void *get_local_pointer(uint64_t regionId, uint64_t offset);
+    void get_region_memory(uint64_t regionId, void *&base, size_t &size);
     int open_heap(uint64_t regionId);
     int copy(uint64_t regionId, uint64_t srcOffset, uint64_t srcCopyStart,
-             uint64_t destOffset, uint64_t destCopyStart, uint32_t uid,
-             uint32_t gid, size_t nbytes);
+             uint64_t destRegionId, uint64_t destOffset,
+             uint64_t destCopyStart, uint32_t uid, uint32_t gid,
+             size_t nbytes);
+    void copy_async(uint64_t regionId, uint64_t srcOffset,
+                    uint64_t srcCopyStart, uint64_t destRegionId,
+                    uint64_t destOffset, uint64_t destCopyStart, uint32_t uid,
+                    uint32_t gid, size_t nbytes, std::function<void()> done);
+    void run_async(std::function<void()> task);
+    void *get_local_range(uint64_t regionId, uint64_t offset,
+                          uint64_t rangeOffset, uint64_t size, uint32_t uid,
+                          uint32_t gid, bool op = 0);
+    void fill(uint64_t regionId, uint64_t offset, uint64_t fillOffset,
+              uint64_t nbytes, uint32_t uid, uint32_t gid, uint64_t pattern,
+              uint64_t patternSize);
+    void fill_async(uint64_t regionId, uint64_t offset, uint64_t fillOffset,
+                    uint64_t nbytes, uint32_t uid, uint32_t gid,
+                    uint64_t pattern, uint64_t patternSize,
+                    std::function<void()> done);
+    bool wait_until(uint64_t regionId, uint64_t offset, uint64_t waitOffset,
+                    uint32_t uid, uint32_t gid, Fam_Cmp cmp, uint64_t value,
+                    uint64_t timeout, uint64_t &current);
+    uint64_t reduce_item(uint64_t regionId, uint64_t offset,
+                         uint64_t reduceOffset, uint64_t nElements,
+                         uint32_t uid, uint32_t gid, Fam_Type type,
+                         Fam_Reduce_Op op);
+    uint64_t scan(uint64_t regionId, uint64_t offset, uint64_t scanOffset,
+                  const Fam_Scan_Query &query, uint32_t uid, uint32_t gid,
+                  void *out, uint64_t outSize, uint64_t &nScanned);
+    uint64_t scan_to_item(uint64_t regionId, uint64_t offset,
+                          uint64_t scanOffset, const Fam_Scan_Query &query,
+                          uint64_t destRegionId, uint64_t destOffset,
+                          uint64_t destScanOffset, uint64_t destSize,
+                          uint32_t uid, uint32_t gid, uint64_t &nScanned);
+    uint64_t checksum(uint64_t regionId, uint64_t offset,
+                      uint64_t checksumOffset, uint64_t nbytes, uint32_t uid,
+                      uint32_t gid, Fam_Checksum_Algo algo);
+    bool compare(uint64_t regionId, uint64_t offset, uint64_t compareOffset,
+                 uint64_t otherRegionId, uint64_t otherOffset,
+                 uint64_t otherCompareOffset, uint64_t nbytes, uint32_t uid,
+                 uint32_t gid, uint64_t &diffOffset);
 
   private:
     MemoryManager *memoryManager;
@@ -103,9 +169,24 @@ class Memserver_Allocator {
     HeapMap *heapMap;
     pthread_mutex_t heapMapLock;
     HeapMap::iterator get_heap(uint64_t regionId, Heap *&heap);
+    Heap *get_allocation_heap(uint64_t regionId, mode_t permission,
+                              uint32_t uid, uint32_t gid);
+    void allocate_from_heap(Heap *heap, string name, uint64_t regionId,
+                            size_t nbytes, uint64_t &offset, mode_t permission,
+                            uint32_t uid, uint32_t gid,
+                            Fam_DataItem_Metadata &dataitem,
+                            void *&localPointer);
     PoolId get_free_poolId();
+    // Count of the writes done by this memory server, which wake the
+    // wait_until calls
+    std::mutex writeLock;
+    std::condition_variable writeCond;
+    uint64_t writeCount;
+    void notify_writes();
+    uint64_t itemGeneration;
     bitmap *bmap;
     void init_poolId_bmap();
+    Memserver_Copy_Engine *copyEngine;
 };
 
 } // namespace openfam
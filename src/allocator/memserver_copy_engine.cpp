@@ -0,0 +1,178 @@
+/*
+ * memserver_copy_engine.cpp
+ * Copyright (c) 2020 Hewlett Packard Enterprise Development, LP. All rights
+ * reserved. Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+#include "allocator/memserver_copy_engine.h"
+#include "common/fam_copy.h"
+#include "common/fam_fill.h"
+#include "common/fam_internal.h"
+
+namespace openfam {
+
+Memserver_Copy_Engine::Memserver_Copy_Engine(uint64_t numThreads)
+    : numWorkers(numThreads), shutdown(false) {
+    if (numWorkers == 0)
+        numWorkers = 1;
+}
+
+Memserver_Copy_Engine::~Memserver_Copy_Engine() {
+    {
+        std::lock_guard<std::mutex> lock(chunkLock);
+        shutdown = true;
+    }
+    chunkCond.notify_all();
+    for (auto &thread : workers)
+        thread.join();
+}
+
+/*
+ * Queue a copy of nbytes from src to dest, split into chunks of
+ * MEMSERVER_COPY_CHUNK_SIZE; done is called once all of them are persisted.
+ */
+void Memserver_Copy_Engine::submit(void *dest, const void *src,
+                                   uint64_t nbytes,
+                                   std::function<void()> done) {
+    if (nbytes == 0) {
+        done();
+        return;
+    }
+
+    Copy_Job *job = new Copy_Job();
+    job->dest = (char *)dest;
+    job->src = (const char *)src;
+    job->done = done;
+    queue_job(job, nbytes);
+}
+
+/*
+ * Queue a fill of nbytes at dest with a pattern of patternSize bytes
+ * repeated, split like copies; the chunks start at multiples of the pattern
+ * size, so each of them is filled from the start of the pattern.
+ */
+void Memserver_Copy_Engine::submit_fill(void *dest, uint64_t nbytes,
+                                        uint64_t pattern, uint64_t patternSize,
+                                        std::function<void()> done) {
+    if (nbytes == 0) {
+        done();
+        return;
+    }
+
+    Copy_Job *job = new Copy_Job();
+    job->dest = (char *)dest;
+    job->src = NULL;
+    job->pattern = pattern;
+    job->patternSize = patternSize;
+    job->done = done;
+    queue_job(job, nbytes);
+}
+
+/*
+ * Queue the chunks of a job of nbytes, which is not empty.
+ */
+void Memserver_Copy_Engine::queue_job(Copy_Job *job, uint64_t nbytes) {
+    job->remaining.store((nbytes + MEMSERVER_COPY_CHUNK_SIZE - 1) /
+                         MEMSERVER_COPY_CHUNK_SIZE);
+    {
+        std::lock_guard<std::mutex> lock(chunkLock);
+        start_workers();
+        for (uint64_t start = 0; start < nbytes;
+             start += MEMSERVER_COPY_CHUNK_SIZE) {
+            uint64_t size = nbytes - start;
+            if (size > MEMSERVER_COPY_CHUNK_SIZE)
+                size = MEMSERVER_COPY_CHUNK_SIZE;
+            chunks.push_back({job, start, size});
+        }
+    }
+    chunkCond.notify_all();
+}
+
+/*
+ * Queue a task to be run by one of the workers, after the chunks already
+ * queued.
+ */
+void Memserver_Copy_Engine::run(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(chunkLock);
+        start_workers();
+        tasks.push_back(task);
+    }
+    chunkCond.notify_one();
+}
+
+/*
+ * Start the workers with the first copy or task; called with chunkLock held.
+ */
+void Memserver_Copy_Engine::start_workers() {
+    if (!workers.empty())
+        return;
+    for (uint64_t i = 0; i < numWorkers; i++)
+        workers.push_back(std::thread(&Memserver_Copy_Engine::worker, this));
+}
+
+/*
+ * Copy or fill chunks, and run tasks once no chunk is queued, until the engine
+ * is shut down. Each chunk is persisted with a single flush once it is entirely
+ * written.
+ */
+void Memserver_Copy_Engine::worker() {
+    while (true) {
+        Copy_Chunk chunk;
+        {
+            std::unique_lock<std::mutex> lock(chunkLock);
+            chunkCond.wait(lock, [this] {
+                return shutdown || !chunks.empty() || !tasks.empty();
+            });
+            if (chunks.empty()) {
+                if (tasks.empty())
+                    return;
+                std::function<void()> task = tasks.front();
+                tasks.pop_front();
+                lock.unlock();
+                task();
+                continue;
+            }
+            chunk = chunks.front();
+            chunks.pop_front();
+        }
+
+        Copy_Job *job = chunk.job;
+        char *dest = job->dest + chunk.start;
+        if (job->src)
+            fam_copy_local(dest, job->src + chunk.start, chunk.size);
+        else
+            fam_fill_local(dest, chunk.size, job->pattern, job->patternSize);
+        openfam_persist(dest, chunk.size);
+
+        if (job->remaining.fetch_sub(1) == 1) {
+            job->done();
+            delete job;
+        }
+    }
+}
+
+} // namespace openfam
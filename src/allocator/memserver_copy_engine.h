@@ -0,0 +1,115 @@
+/*
+ * memserver_copy_engine.h
+ * Copyright (c) 2020 Hewlett Packard Enterprise Development, LP. All rights
+ * reserved. Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+#ifndef MEMSERVER_COPY_ENGINE_H_
+#define MEMSERVER_COPY_ENGINE_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <stdint.h>
+#include <thread>
+#include <vector>
+
+/**
+ * Copies smaller than this size are done inline by the caller
+ */
+#define MEMSERVER_COPY_INLINE_SIZE (1UL << 20)
+
+/**
+ * Size of the chunks large copies are split into
+ */
+#define MEMSERVER_COPY_CHUNK_SIZE (4UL << 20)
+
+/**
+ * Default number of worker threads of the copy engine
+ */
+#define MEMSERVER_COPY_THREADS 4
+
+namespace openfam {
+
+/*
+ * Pool of worker threads copying data within the memory server. A copy (or
+ * a fill) is split into chunks, which are copied and persisted by the workers
+ * in parallel; the completion callback is called by the worker finishing the
+ * last chunk. The workers also run other long requests handed to them, so
+ * that these do not hold the threads serving rpcs. The workers are only
+ * started by the first copy or request submitted, so that processes which
+ * never copy do not run them.
+ */
+class Memserver_Copy_Engine {
+  public:
+    Memserver_Copy_Engine(uint64_t numThreads = MEMSERVER_COPY_THREADS);
+    ~Memserver_Copy_Engine();
+
+    void submit(void *dest, const void *src, uint64_t nbytes,
+                std::function<void()> done);
+
+    void submit_fill(void *dest, uint64_t nbytes, uint64_t pattern,
+                     uint64_t patternSize, std::function<void()> done);
+
+    void run(std::function<void()> task);
+
+  private:
+    struct Copy_Job {
+        char *dest;
+        // NULL for a fill of pattern
+        const char *src;
+        uint64_t pattern;
+        uint64_t patternSize;
+        std::atomic<uint64_t> remaining;
+        std::function<void()> done;
+    };
+
+    struct Copy_Chunk {
+        Copy_Job *job;
+        uint64_t start;
+        uint64_t size;
+    };
+
+    void queue_job(Copy_Job *job, uint64_t nbytes);
+
+    void worker();
+
+    void start_workers();
+
+    uint64_t numWorkers;
+    std::vector<std::thread> workers;
+    std::deque<Copy_Chunk> chunks;
+    std::deque<std::function<void()> > tasks;
+    std::mutex chunkLock;
+    std::condition_variable chunkCond;
+    bool shutdown;
+};
+
+} // namespace openfam
+
+#endif /* end of MEMSERVER_COPY_ENGINE_H_ */
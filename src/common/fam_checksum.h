@@ -0,0 +1,223 @@
+/*
+ * fam_checksum.h
+ * Copyright (c) 2020 Hewlett Packard Enterprise Development, LP. All rights
+ * reserved. Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+#ifndef FAM_CHECKSUM_H
+#define FAM_CHECKSUM_H
+
+#include <stdint.h>
+#include <string.h>
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <nmmintrin.h>
+#define FAM_CHECKSUM_X86
+#endif
+
+#include "fam/fam.h"
+
+/**
+ * Size of the blocks compared with memcmp() while looking for the first
+ * difference between two ranges
+ */
+#define FAM_COMPARE_BLOCK_SIZE 4096
+
+namespace openfam {
+
+/*
+ * CRC32C (Castagnoli) lookup table for the reflected polynomial, used when
+ * the CPU lacks the SSE4.2 crc32 instruction
+ */
+struct Fam_Crc32c_Table {
+    uint32_t entries[256];
+    Fam_Crc32c_Table() {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; bit++)
+                crc = (crc >> 1) ^ ((crc & 1) ? 0x82F63B78U : 0);
+            entries[i] = crc;
+        }
+    }
+};
+
+inline uint32_t fam_crc32c_table(uint32_t crc, const unsigned char *data,
+                                 uint64_t nbytes) {
+    static const Fam_Crc32c_Table table;
+    for (uint64_t i = 0; i < nbytes; i++)
+        crc = (crc >> 8) ^ table.entries[(crc ^ data[i]) & 0xFF];
+    return crc;
+}
+
+#ifdef FAM_CHECKSUM_X86
+__attribute__((target("sse4.2"))) inline uint32_t
+fam_crc32c_sse42(uint32_t crc, const unsigned char *data, uint64_t nbytes) {
+    uint64_t crc64 = crc;
+    uint64_t i = 0;
+    for (; i + sizeof(uint64_t) <= nbytes; i += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, data + i, sizeof(word));
+        crc64 = _mm_crc32_u64(crc64, word);
+    }
+    crc = (uint32_t)crc64;
+    for (; i < nbytes; i++)
+        crc = _mm_crc32_u8(crc, data[i]);
+    return crc;
+}
+#endif
+
+/*
+ * CRC32C of nbytes at data, with the SSE4.2 crc32 instruction if the CPU
+ * supports it
+ */
+inline uint32_t fam_crc32c(const void *data, uint64_t nbytes) {
+    const unsigned char *bytes = (const unsigned char *)data;
+#ifdef FAM_CHECKSUM_X86
+    if (__builtin_cpu_supports("sse4.2"))
+        return ~fam_crc32c_sse42(~0U, bytes, nbytes);
+#endif
+    return ~fam_crc32c_table(~0U, bytes, nbytes);
+}
+
+#define FAM_XXH_PRIME64_1 0x9E3779B185EBCA87ULL
+#define FAM_XXH_PRIME64_2 0xC2B2AE3D27D4EB4FULL
+#define FAM_XXH_PRIME64_3 0x165667B19E3779F9ULL
+#define FAM_XXH_PRIME64_4 0x85EBCA77C2B2AE63ULL
+#define FAM_XXH_PRIME64_5 0x27D4EB2F165667C5ULL
+
+inline uint64_t fam_xxh64_rotl(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+inline uint64_t fam_xxh64_round(uint64_t acc, uint64_t input) {
+    acc += input * FAM_XXH_PRIME64_2;
+    acc = fam_xxh64_rotl(acc, 31);
+    return acc * FAM_XXH_PRIME64_1;
+}
+
+inline uint64_t fam_xxh64_merge(uint64_t acc, uint64_t value) {
+    acc ^= fam_xxh64_round(0, value);
+    return acc * FAM_XXH_PRIME64_1 + FAM_XXH_PRIME64_4;
+}
+
+/*
+ * XXH64 of nbytes at data, with a seed of 0
+ */
+inline uint64_t fam_xxh64(const void *data, uint64_t nbytes) {
+    const unsigned char *p = (const unsigned char *)data;
+    const unsigned char *end = p + nbytes;
+    uint64_t h64, word;
+    uint32_t half;
+
+    if (nbytes >= 32) {
+        uint64_t v1 = FAM_XXH_PRIME64_1 + FAM_XXH_PRIME64_2;
+        uint64_t v2 = FAM_XXH_PRIME64_2;
+        uint64_t v3 = 0;
+        uint64_t v4 = 0 - FAM_XXH_PRIME64_1;
+        for (; p + 32 <= end; p += 32) {
+            memcpy(&word, p, sizeof(word));
+            v1 = fam_xxh64_round(v1, word);
+            memcpy(&word, p + 8, sizeof(word));
+            v2 = fam_xxh64_round(v2, word);
+            memcpy(&word, p + 16, sizeof(word));
+            v3 = fam_xxh64_round(v3, word);
+            memcpy(&word, p + 24, sizeof(word));
+            v4 = fam_xxh64_round(v4, word);
+        }
+        h64 = fam_xxh64_rotl(v1, 1) + fam_xxh64_rotl(v2, 7) +
+              fam_xxh64_rotl(v3, 12) + fam_xxh64_rotl(v4, 18);
+        h64 = fam_xxh64_merge(h64, v1);
+        h64 = fam_xxh64_merge(h64, v2);
+        h64 = fam_xxh64_merge(h64, v3);
+        h64 = fam_xxh64_merge(h64, v4);
+    } else {
+        h64 = FAM_XXH_PRIME64_5;
+    }
+    h64 += nbytes;
+
+    for (; p + 8 <= end; p += 8) {
+        memcpy(&word, p, sizeof(word));
+        h64 ^= fam_xxh64_round(0, word);
+        h64 = fam_xxh64_rotl(h64, 27) * FAM_XXH_PRIME64_1 + FAM_XXH_PRIME64_4;
+    }
+    if (p + 4 <= end) {
+        memcpy(&half, p, sizeof(half));
+        h64 ^= (uint64_t)half * FAM_XXH_PRIME64_1;
+        h64 = fam_xxh64_rotl(h64, 23) * FAM_XXH_PRIME64_2 + FAM_XXH_PRIME64_3;
+        p += 4;
+    }
+    for (; p < end; p++) {
+        h64 ^= (*p) * FAM_XXH_PRIME64_5;
+        h64 = fam_xxh64_rotl(h64, 11) * FAM_XXH_PRIME64_1;
+    }
+
+    h64 ^= h64 >> 33;
+    h64 *= FAM_XXH_PRIME64_2;
+    h64 ^= h64 >> 29;
+    h64 *= FAM_XXH_PRIME64_3;
+    h64 ^= h64 >> 32;
+    return h64;
+}
+
+/*
+ * Digest of nbytes at data with the given algorithm; a CRC32C is returned in
+ * the low-order 32 bits
+ */
+inline uint64_t fam_checksum_local(const void *data, uint64_t nbytes,
+                                   Fam_Checksum_Algo algo) {
+    switch (algo) {
+    case FAM_CHECKSUM_CRC32C:
+        return fam_crc32c(data, nbytes);
+    case FAM_CHECKSUM_XXH64:
+        return fam_xxh64(data, nbytes);
+    }
+    return 0;
+}
+
+/*
+ * Compare nbytes at a and b. Returns true if they are equal; otherwise
+ * diffOffset is set to the offset of the first byte which differs.
+ */
+inline bool fam_compare_local(const void *a, const void *b, uint64_t nbytes,
+                              uint64_t *diffOffset) {
+    const unsigned char *bytesA = (const unsigned char *)a;
+    const unsigned char *bytesB = (const unsigned char *)b;
+    for (uint64_t start = 0; start < nbytes; start += FAM_COMPARE_BLOCK_SIZE) {
+        uint64_t size = nbytes - start;
+        if (size > FAM_COMPARE_BLOCK_SIZE)
+            size = FAM_COMPARE_BLOCK_SIZE;
+        if (memcmp(bytesA + start, bytesB + start, size) == 0)
+            continue;
+        uint64_t i = start;
+        while (bytesA[i] == bytesB[i])
+            i++;
+        *diffOffset = i;
+        return false;
+    }
+    return true;
+}
+
+} // namespace openfam
+#endif
@@ -0,0 +1,76 @@
+/*
+ * fam_copy.h
+ * Copyright (c) 2020 Hewlett Packard Enterprise Development, LP. All rights
+ * reserved. Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+#ifndef FAM_COPY_H
+#define FAM_COPY_H
+
+#include <stdint.h>
+#include <string.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/**
+ * Size from which copies are written with non-temporal stores
+ */
+#define FAM_COPY_NT_THRESHOLD (256UL << 10)
+
+namespace openfam {
+
+/*
+ * Copy nbytes from src to dest. Large copies are written with non-temporal
+ * stores where available, so that copying a large data item does not evict
+ * the working set of the memory server from the caches.
+ */
+inline void fam_copy_local(void *dest, const void *src, uint64_t nbytes) {
+#if defined(__SSE2__) && defined(__x86_64__)
+    if (nbytes >= FAM_COPY_NT_THRESHOLD) {
+        char *to = (char *)dest;
+        const char *from = (const char *)src;
+        uint64_t misalign = (uintptr_t)to % sizeof(__m128i);
+        uint64_t head = misalign ? sizeof(__m128i) - misalign : 0;
+        memcpy(to, from, head);
+
+        __m128i *vectors = (__m128i *)(to + head);
+        const __m128i *input = (const __m128i *)(from + head);
+        uint64_t nVectors = (nbytes - head) / sizeof(__m128i);
+        for (uint64_t i = 0; i < nVectors; i++)
+            _mm_stream_si128(&vectors[i], _mm_loadu_si128(&input[i]));
+        _mm_sfence();
+
+        memcpy(&vectors[nVectors], &input[nVectors],
+               nbytes - head - nVectors * sizeof(__m128i));
+        return;
+    }
+#endif
+    memcpy(dest, src, nbytes);
+}
+
+} // namespace openfam
+#endif
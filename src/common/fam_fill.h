@@ -0,0 +1,90 @@
+/*
+ * fam_fill.h
+ * Copyright (c) 2020 Hewlett Packard Enterprise Development, LP. All rights
+ * reserved. Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+#ifndef FAM_FILL_H
+#define FAM_FILL_H
+
+#include <stdint.h>
+#include <string.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace openfam {
+
+/*
+ * Returns the 8-byte word holding the pattern repeated, starting with the
+ * byte at position phase of the pattern. patternSize must divide 8.
+ */
+inline uint64_t fam_fill_word(uint64_t pattern, uint64_t patternSize,
+                              uint64_t phase) {
+    uint64_t word;
+    char *bytes = (char *)&word;
+    const char *patternBytes = (const char *)&pattern;
+    for (uint64_t i = 0; i < sizeof(word); i++)
+        bytes[i] = patternBytes[(phase + i) % patternSize];
+    return word;
+}
+
+/*
+ * Fill nbytes at dest with the pattern repeated. The bulk of the range is
+ * written with non-temporal stores where available, so that filling a large
+ * data item does not evict the working set of the memory server from the
+ * caches.
+ */
+inline void fam_fill_local(void *dest, uint64_t nbytes, uint64_t pattern,
+                           uint64_t patternSize) {
+    char *start = (char *)dest;
+    uint64_t misalign = (uintptr_t)start % sizeof(uint64_t);
+    uint64_t head = misalign ? sizeof(uint64_t) - misalign : 0;
+    if (head > nbytes)
+        head = nbytes;
+    uint64_t word = fam_fill_word(pattern, patternSize, 0);
+    memcpy(start, &word, head);
+
+    word = fam_fill_word(pattern, patternSize, head);
+    uint64_t *words = (uint64_t *)(start + head);
+    uint64_t nWords = (nbytes - head) / sizeof(uint64_t);
+    for (uint64_t i = 0; i < nWords; i++) {
+#if defined(__SSE2__) && defined(__x86_64__)
+        _mm_stream_si64((long long *)&words[i], (long long)word);
+#else
+        words[i] = word;
+#endif
+    }
+#if defined(__SSE2__) && defined(__x86_64__)
+    _mm_sfence();
+#endif
+
+    // The tail starts on a word boundary, so the pattern is in the same phase
+    memcpy(&words[nWords], &word, nbytes - head - nWords * sizeof(uint64_t));
+}
+
+} // namespace openfam
+#endif
@@ -102,6 +102,16 @@ namespace openfam {
 #define DATAITEMID_BITS 33
 #define DATAITEMID_MASK ((1UL << DATAITEMID_BITS) - 1)
 #define DATAITEMID_SHIFT 1
+/*
+ * Keys of data items in a region registered with a single memory region carry
+ * this tag above the region id. Their data item id is then the offset of the
+ * data item in the region, in DATAITEMID_UNIT bytes, and the key of the region
+ * memory region is the key with a data item id of 0.
+ */
+#define FAM_KEY_TAG_SHIFT 48
+#define FAM_KEY_REGION_MR_TAG 1UL
+#define FAM_KEY_REGION_MR (FAM_KEY_REGION_MR_TAG << FAM_KEY_TAG_SHIFT)
+#define DATAITEMID_UNIT 128
 
 inline void openfam_persist(void *addr, uint64_t size) {
     fam_persist(addr, size);
@@ -53,6 +53,27 @@ using namespace std;
 
 namespace openfam {
 
+/*
+ * Data items of a region registered as a whole are accessed with the key of
+ * the region memory region, at their offset in the region.
+ */
+static inline bool fabric_region_key(uint64_t key) {
+    return (key >> FAM_KEY_TAG_SHIFT) == FAM_KEY_REGION_MR_TAG;
+}
+
+static inline uint64_t fabric_mr_key(uint64_t key) {
+    if (fabric_region_key(key))
+        return key & ~(DATAITEMID_MASK << DATAITEMID_SHIFT);
+    return key;
+}
+
+static inline uint64_t fabric_remote_addr(uint64_t key, uint64_t offset) {
+    if (fabric_region_key(key))
+        return ((key >> DATAITEMID_SHIFT) & DATAITEMID_MASK) * DATAITEMID_UNIT +
+               offset;
+    return offset;
+}
+
 #ifdef LIBFABRIC_PROFILE
 using LibFabric_Time = uint64_t;
 
@@ -645,7 +666,9 @@ int fabric_write(uint64_t key, const void *local, size_t nbytes,
 
     struct iovec iov = {.iov_base = (void *)local, .iov_len = nbytes};
 
-    struct fi_rma_iov rma_iov = {.addr = offset, .len = nbytes, .key = key};
+    struct fi_rma_iov rma_iov = {.addr = fabric_remote_addr(key, offset),
+                                 .len = nbytes,
+                                 .key = fabric_mr_key(key)};
 
     struct fi_context *ctx = new struct fi_context();
     struct fi_msg_rma msg = {.msg_iov = &iov,
@@ -703,7 +726,9 @@ int fabric_read(uint64_t key, const void *local, size_t nbytes, uint64_t offset,
 
     struct iovec iov = {.iov_base = (void *)local, .iov_len = nbytes};
 
-    struct fi_rma_iov rma_iov = {.addr = offset, .len = nbytes, .key = key};
+    struct fi_rma_iov rma_iov = {.addr = fabric_remote_addr(key, offset),
+                                 .len = nbytes,
+                                 .key = fabric_mr_key(key)};
 
     struct fi_context *ctx = new struct fi_context();
     struct fi_msg_rma msg = {.msg_iov = &iov,
@@ -846,9 +871,10 @@ int fabric_scatter_stride_blocking(uint64_t key, const void *local,
         iov[i].iov_base = (void *)((uint64_t)local + (i * nbytes));
         iov[i].iov_len = nbytes;
 
-        rma_iov[i].addr = first * nbytes + (i * stride) * nbytes;
+        rma_iov[i].addr =
+            fabric_remote_addr(key, first * nbytes + (i * stride) * nbytes);
         rma_iov[i].len = nbytes;
-        rma_iov[i].key = key;
+        rma_iov[i].key = fabric_mr_key(key);
     }
 
     ret = fabric_read_write_multi_msg(count, iov_limit, fiAddr, famCtx, iov,
@@ -889,9 +915,10 @@ int fabric_gather_stride_blocking(uint64_t key, const void *local,
         iov[i].iov_base = (void *)((uint64_t)local + (i * nbytes));
         iov[i].iov_len = nbytes;
 
-        rma_iov[i].addr = first * nbytes + (i * stride) * nbytes;
+        rma_iov[i].addr =
+            fabric_remote_addr(key, first * nbytes + (i * stride) * nbytes);
         rma_iov[i].len = nbytes;
-        rma_iov[i].key = key;
+        rma_iov[i].key = fabric_mr_key(key);
     }
 
     ret = fabric_read_write_multi_msg(count, iov_limit, fiAddr, famCtx, iov,
@@ -928,9 +955,9 @@ int fabric_scatter_index_blocking(uint64_t key, const void *local,
     for (uint64_t i = 0; i < count; i++) {
         iov[i].iov_base = (void *)((uint64_t)local + (i * nbytes));
         iov[i].iov_len = nbytes;
-        rma_iov[i].addr = index[i] * nbytes;
+        rma_iov[i].addr = fabric_remote_addr(key, index[i] * nbytes);
         rma_iov[i].len = nbytes;
-        rma_iov[i].key = key;
+        rma_iov[i].key = fabric_mr_key(key);
     }
 
     ret = fabric_read_write_multi_msg(count, iov_limit, fiAddr, famCtx, iov,
@@ -968,9 +995,9 @@ int fabric_gather_index_blocking(uint64_t key, const void *local, size_t nbytes,
         iov[i].iov_base = (void *)((uint64_t)local + (i * nbytes));
         iov[i].iov_len = nbytes;
 
-        rma_iov[i].addr = index[i] * nbytes;
+        rma_iov[i].addr = fabric_remote_addr(key, index[i] * nbytes);
         rma_iov[i].len = nbytes;
-        rma_iov[i].key = key;
+        rma_iov[i].key = fabric_mr_key(key);
     }
 
     ret = fabric_read_write_multi_msg(count, iov_limit, fiAddr, famCtx, iov,
@@ -982,6 +1009,48 @@ int fabric_gather_index_blocking(uint64_t key, const void *local, size_t nbytes,
     return ret;
 }
 
+/*
+ *  Fabric read or write of a list of runs of bytes, each run going between
+ *  its own local buffer and its own offset in the memory region
+ *  @param key - key of the memory region
+ *  @param iov - local buffers of the runs
+ *  @param offsets - offsets of the runs in the memory region
+ *  @param count - number of runs
+ *  @param fiAddr - fi_addr_t address
+ *  @param famCtx - Pointer to Fam_Context
+ *  @param iov_limit - maximum number of runs in one message
+ *  @param write - true to write to the memory region, false to read from it
+ *  @param block - true to wait for the completion of the runs
+ *  @return - {true(0), false(1), errNo(<0)}
+ */
+int fabric_read_write_iov(uint64_t key, struct iovec *iov,
+                          const uint64_t *offsets, uint64_t count,
+                          fi_addr_t fiAddr, Fam_Context *famCtx,
+                          size_t iov_limit, bool write, bool block) {
+
+    struct fi_rma_iov *rma_iov = new fi_rma_iov[count];
+
+    int ret = 0;
+
+    for (uint64_t i = 0; i < count; i++) {
+        rma_iov[i].addr = fabric_remote_addr(key, offsets[i]);
+        rma_iov[i].len = iov[i].iov_len;
+        rma_iov[i].key = fabric_mr_key(key);
+    }
+
+    try {
+        ret = fabric_read_write_multi_msg(count, iov_limit, fiAddr, famCtx,
+                                          iov, rma_iov, write, block);
+    } catch (...) {
+        delete[] rma_iov;
+        throw;
+    }
+
+    delete[] rma_iov;
+
+    return ret;
+}
+
 /*
  * fabric write message nonblocking
  * @param key - key of the memory region
@@ -999,7 +1068,9 @@ void fabric_write_nonblocking(uint64_t key, const void *local, size_t nbytes,
 
     struct iovec iov = {.iov_base = (void *)local, .iov_len = nbytes};
 
-    struct fi_rma_iov rma_iov = {.addr = offset, .len = nbytes, .key = key};
+    struct fi_rma_iov rma_iov = {.addr = fabric_remote_addr(key, offset),
+                                 .len = nbytes,
+                                 .key = fabric_mr_key(key)};
 
     struct fi_context *ctx = new struct fi_context();
     struct fi_msg_rma msg = {.msg_iov = &iov,
@@ -1033,6 +1104,96 @@ void fabric_write_nonblocking(uint64_t key, const void *local, size_t nbytes,
     return;
 }
 
+/*
+ * Fabric write message followed by a fenced atomic update of a signal word.
+ * The fence defers the atomic until the write has completed, so both are
+ * issued back to back and only the completion of the atomic is waited for.
+ * @param key - key of the memory region
+ * @param local - pointer to the local memory region
+ * @param nbytes - number of the bytes to be written to memory region
+ * @param offset - offset of the data in the memory region
+ * @param sigKey - key of the memory region holding the signal word
+ * @param sigOffset - offset of the signal word
+ * @param sigValue - value used to update the signal word
+ * @param op - FI_ATOMIC_WRITE or FI_SUM
+ * @param fiAddr - fi_addr_t address of both memory regions
+ * @param famCtx - Pointer to Fam_Context
+ * @return - {true(0), false(1), errNo(<0)}
+ */
+int fabric_write_signal(uint64_t key, const void *local, size_t nbytes,
+                        uint64_t offset, uint64_t sigKey, uint64_t sigOffset,
+                        uint64_t sigValue, enum fi_op op, fi_addr_t fiAddr,
+                        Fam_Context *famCtx) {
+
+    struct iovec iov = {.iov_base = (void *)local, .iov_len = nbytes};
+
+    struct fi_rma_iov rma_iov = {.addr = fabric_remote_addr(key, offset),
+                                 .len = nbytes,
+                                 .key = fabric_mr_key(key)};
+
+    struct fi_msg_rma msg = {.msg_iov = &iov,
+                             .desc = 0,
+                             .iov_count = 1,
+                             .addr = fiAddr,
+                             .rma_iov = &rma_iov,
+                             .rma_iov_count = 1,
+                             .context = NULL,
+                             .data = 0};
+
+    struct fi_ioc sigIov = {.addr = &sigValue, .count = 1};
+
+    struct fi_rma_ioc sigRmaIov = {
+        .addr = fabric_remote_addr(sigKey, sigOffset),
+        .count = 1,
+        .key = fabric_mr_key(sigKey)};
+
+    struct fi_context *ctx = new struct fi_context();
+    struct fi_msg_atomic sigMsg = {.msg_iov = &sigIov,
+                                   .desc = 0,
+                                   .iov_count = 1,
+                                   .addr = fiAddr,
+                                   .rma_iov = &sigRmaIov,
+                                   .rma_iov_count = 1,
+                                   .datatype = FI_UINT64,
+                                   .op = op,
+                                   .context = ctx,
+                                   .data = 0};
+
+    ssize_t ret;
+    uint32_t retry_cnt = 0;
+    uint64_t incr = 0;
+
+    // Take Fam_Context read lock
+    famCtx->aquire_RDLock();
+
+    try {
+        do {
+            FI_CALL(ret, fi_writemsg, famCtx->get_ep(), &msg, 0);
+        } while (fabric_retry(famCtx, ret, &retry_cnt));
+        famCtx->inc_num_tx_ops();
+
+        retry_cnt = 0;
+        do {
+            FI_CALL(ret, fi_atomicmsg, famCtx->get_ep(), &sigMsg,
+                    FI_COMPLETION | FI_DELIVERY_COMPLETE | FI_FENCE);
+        } while (fabric_retry(famCtx, ret, &retry_cnt));
+        famCtx->inc_num_tx_ops();
+        incr++;
+        ret = fabric_completion_wait(famCtx, ctx);
+    } catch (...) {
+        famCtx->inc_num_tx_fail_cnt(incr);
+        // Release Fam_Context read lock
+        famCtx->release_lock();
+        throw;
+    }
+
+    // Release Fam_Context read lock
+    famCtx->release_lock();
+    delete ctx;
+
+    return (int)ret;
+}
+
 /*
  *  Fabric read message nonblocking
  *  @param key - key of the memory region
@@ -1050,7 +1211,9 @@ void fabric_read_nonblocking(uint64_t key, const void *local, size_t nbytes,
 
     struct iovec iov = {.iov_base = (void *)local, .iov_len = nbytes};
 
-    struct fi_rma_iov rma_iov = {.addr = offset, .len = nbytes, .key = key};
+    struct fi_rma_iov rma_iov = {.addr = fabric_remote_addr(key, offset),
+                                 .len = nbytes,
+                                 .key = fabric_mr_key(key)};
 
     struct fi_context *ctx = new struct fi_context();
     struct fi_msg_rma msg = {.msg_iov = &iov,
@@ -1110,9 +1273,10 @@ void fabric_scatter_stride_nonblocking(uint64_t key, const void *local,
         iov[i].iov_base = (void *)((uint64_t)local + (i * nbytes));
         iov[i].iov_len = nbytes;
 
-        rma_iov[i].addr = first * nbytes + (i * stride) * nbytes;
+        rma_iov[i].addr =
+            fabric_remote_addr(key, first * nbytes + (i * stride) * nbytes);
         rma_iov[i].len = nbytes;
-        rma_iov[i].key = key;
+        rma_iov[i].key = fabric_mr_key(key);
     }
 
     fabric_read_write_multi_msg(count, iov_limit, fiAddr, famCtx, iov, rma_iov,
@@ -1153,9 +1317,10 @@ void fabric_gather_stride_nonblocking(uint64_t key, const void *local,
         iov[i].iov_base = (void *)((uint64_t)local + (i * nbytes));
         iov[i].iov_len = nbytes;
 
-        rma_iov[i].addr = first * nbytes + (i * stride) * nbytes;
+        rma_iov[i].addr =
+            fabric_remote_addr(key, first * nbytes + (i * stride) * nbytes);
         rma_iov[i].len = nbytes;
-        rma_iov[i].key = key;
+        rma_iov[i].key = fabric_mr_key(key);
     }
 
     fabric_read_write_multi_msg(count, iov_limit, fiAddr, famCtx, iov, rma_iov,
@@ -1190,9 +1355,9 @@ void fabric_scatter_index_nonblocking(uint64_t key, const void *local,
     for (uint64_t i = 0; i < count; i++) {
         iov[i].iov_base = (void *)((uint64_t)local + (i * nbytes));
         iov[i].iov_len = nbytes;
-        rma_iov[i].addr = index[i] * nbytes;
+        rma_iov[i].addr = fabric_remote_addr(key, index[i] * nbytes);
         rma_iov[i].len = nbytes;
-        rma_iov[i].key = key;
+        rma_iov[i].key = fabric_mr_key(key);
     }
 
     fabric_read_write_multi_msg(count, iov_limit, fiAddr, famCtx, iov, rma_iov,
@@ -1228,9 +1393,9 @@ void fabric_gather_index_nonblocking(uint64_t key, const void *local,
         iov[i].iov_base = (void *)((uint64_t)local + (i * nbytes));
         iov[i].iov_len = nbytes;
 
-        rma_iov[i].addr = index[i] * nbytes;
+        rma_iov[i].addr = fabric_remote_addr(key, index[i] * nbytes);
         rma_iov[i].len = nbytes;
-        rma_iov[i].key = key;
+        rma_iov[i].key = fabric_mr_key(key);
     }
 
     fabric_read_write_multi_msg(count, iov_limit, fiAddr, famCtx, iov, rma_iov,
@@ -1259,7 +1424,9 @@ void fabric_fence(fi_addr_t fiAddr, Fam_Context *famCtx) {
 
     struct iovec iov = {.iov_base = (void *)local, .iov_len = nbytes};
 
-    struct fi_rma_iov rma_iov = {.addr = offset, .len = nbytes, .key = key};
+    struct fi_rma_iov rma_iov = {.addr = fabric_remote_addr(key, offset),
+                                 .len = nbytes,
+                                 .key = fabric_mr_key(key)};
 
     struct fi_context *ctx = new struct fi_context();
 
@@ -1421,7 +1588,9 @@ void fabric_atomic(uint64_t key, void *value, uint64_t offset, enum fi_op op,
                    Fam_Context *famCtx) {
     struct fi_ioc iov = {.addr = value, .count = 1};
 
-    struct fi_rma_ioc rma_iov = {.addr = offset, .count = 1, .key = key};
+    struct fi_rma_ioc rma_iov = {.addr = fabric_remote_addr(key, offset),
+                                 .count = 1,
+                                 .key = fabric_mr_key(key)};
 
     struct fi_context *ctx = new struct fi_context();
     struct fi_msg_atomic msg = {.msg_iov = &iov,
@@ -1464,7 +1633,9 @@ void fabric_fetch_atomic(uint64_t key, void *value, void *result,
                          Fam_Context *famCtx) {
     struct fi_ioc iov = {.addr = value, .count = 1};
 
-    struct fi_rma_ioc rma_iov = {.addr = offset, .count = 1, .key = key};
+    struct fi_rma_ioc rma_iov = {.addr = fabric_remote_addr(key, offset),
+                                 .count = 1,
+                                 .key = fabric_mr_key(key)};
 
     struct fi_ioc result_iov = {.addr = result, .count = 1};
 
@@ -1515,7 +1686,9 @@ void fabric_compare_atomic(uint64_t key, void *compare, void *result,
                            Fam_Context *famCtx) {
     struct fi_ioc iov = {.addr = value, .count = 1};
 
-    struct fi_rma_ioc rma_iov = {.addr = offset, .count = 1, .key = key};
+    struct fi_rma_ioc rma_iov = {.addr = fabric_remote_addr(key, offset),
+                                 .count = 1,
+                                 .key = fabric_mr_key(key)};
 
     struct fi_ioc result_iov = {.addr = result, .count = 1};
 
@@ -103,10 +103,21 @@ int fabric_gather_index_blocking(uint64_t key, const void *local, size_t nbytes,
                                  uint64_t *index, uint64_t count,
                                  fi_addr_t fiAddr, Fam_Context *famCtx,
                                  size_t iov_limit);
+
+int fabric_read_write_iov(uint64_t key, struct iovec *iov,
+                          const uint64_t *offsets, uint64_t count,
+                          fi_addr_t fiAddr, Fam_Context *famCtx,
+                          size_t iov_limit, bool write, bool block);
+
 void fabric_write_nonblocking(uint64_t key, const void *local, size_t nbytes,
                               uint64_t offset, fi_addr_t fiAddr,
                               Fam_Context *famCtx);
 
+int fabric_write_signal(uint64_t key, const void *local, size_t nbytes,
+                        uint64_t offset, uint64_t sigKey, uint64_t sigOffset,
+                        uint64_t sigValue, enum fi_op op, fi_addr_t fiAddr,
+                        Fam_Context *famCtx);
+
 void fabric_read_nonblocking(uint64_t key, const void *local, size_t nbytes,
                              uint64_t offset, fi_addr_t fiAddr,
                              Fam_Context *famCtx);
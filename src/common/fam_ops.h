@@ -38,6 +38,7 @@
 
 #include <iostream>
 #include <sstream>
+#include <sys/uio.h>
 
 using namespace std;
 using namespace openfam;
@@ -131,6 +132,25 @@ class Fam_Ops {
     virtual void put_nonblocking(void *local, Fam_Descriptor *descriptor,
                                  uint64_t offset, uint64_t nbytes) = 0;
 
+    /**
+     * Copy data from local memory to FAM, followed by an update of a signal
+     * word ordered after the data
+     * @param local - pointer to local memory. Must point to valid data in local
+     * memory
+     * @param descriptor - valid descriptor in FAM
+     * @param offset - byte offset within the region defined by the descriptor
+     * to where data should be copied
+     * @param nbytes - number of bytes to be copied from local to FAM
+     * @param sigDescriptor - valid descriptor of the signal word
+     * @param sigOffset - byte offset of the 64-bit signal word
+     * @param sigValue - value used to update the signal word
+     * @param op - update of the signal word, set or add
+     */
+    virtual void put_signal(void *local, Fam_Descriptor *descriptor,
+                            uint64_t offset, uint64_t nbytes,
+                            Fam_Descriptor *sigDescriptor, uint64_t sigOffset,
+                            uint64_t sigValue, Fam_Signal_Op op) = 0;
+
     // GATHER/SCATTER subgroup
 
     /**
@@ -293,6 +313,60 @@ class Fam_Ops {
                                      uint64_t nElements, uint64_t *elementIndex,
                                      uint64_t elementSize) = 0;
 
+    /**
+     * Copy a list of runs of bytes from FAM to local memory, blocking while
+     * the copy is complete.
+     * @param descriptor - valid descriptor containing FAM reference
+     * @param iov - local buffers receiving the runs
+     * @param offsets - byte offsets of the runs within the data item
+     * @param count - number of runs
+     * @return - 0 for normal completion, 1 in case of unsuccessful completion,
+     * negative number in case of exception
+     */
+    virtual int get_iov_blocking(Fam_Descriptor *descriptor,
+                                 struct iovec *iov, const uint64_t *offsets,
+                                 uint64_t count) = 0;
+
+    /**
+     * Copy a list of runs of bytes from local memory to FAM, blocking while
+     * the copy is complete.
+     * @param descriptor - valid descriptor containing FAM reference
+     * @param iov - local buffers containing the runs
+     * @param offsets - byte offsets of the runs within the data item
+     * @param count - number of runs
+     * @return - 0 for normal completion, 1 in case of unsuccessful completion,
+     * negative number in case of exception
+     */
+    virtual int put_iov_blocking(Fam_Descriptor *descriptor,
+                                 struct iovec *iov, const uint64_t *offsets,
+                                 uint64_t count) = 0;
+
+    /**
+     * Initiate a copy of a list of runs of bytes from FAM to local memory,
+     * return before completion.
+     * @param descriptor - valid descriptor containing FAM reference
+     * @param iov - local buffers receiving the runs
+     * @param offsets - byte offsets of the runs within the data item
+     * @param count - number of runs
+     */
+    virtual void get_iov_nonblocking(Fam_Descriptor *descriptor,
+                                     struct iovec *iov,
+                                     const uint64_t *offsets,
+                                     uint64_t count) = 0;
+
+    /**
+     * Initiate a copy of a list of runs of bytes from local memory to FAM,
+     * return before completion.
+     * @param descriptor - valid descriptor containing FAM reference
+     * @param iov - local buffers containing the runs
+     * @param offsets - byte offsets of the runs within the data item
+     * @param count - number of runs
+     */
+    virtual void put_iov_nonblocking(Fam_Descriptor *descriptor,
+                                     struct iovec *iov,
+                                     const uint64_t *offsets,
+                                     uint64_t count) = 0;
+
     // COPY Subgroup
 
     /**
@@ -310,7 +384,38 @@ class Fam_Ops {
                        Fam_Descriptor **dest, uint64_t destOffset,
                        uint64_t nbytes) = 0;
 
+    /**
+     * Copy data from one FAM-resident data item into an existing data item.
+     * The returned object is waited for with wait_for_copy.
+     * @param src - valid descriptor to source data item in FAM.
+     * @param srcOffset - byte offset within src from which memory should be
+     * copied.
+     * @param dest - valid descriptor to the existing destination data item.
+     * @param destOffset - byte offset within dest to which memory should be
+     * copied.
+     * @param nbytes - number of bytes to be copied
+     * @return - wait object of the copy
+     */
+    virtual void *copy(Fam_Descriptor *src, uint64_t srcOffset,
+                       Fam_Descriptor *dest, uint64_t destOffset,
+                       uint64_t nbytes) = 0;
+
     virtual void wait_for_copy(void *waitObj) = 0;
+
+    /**
+     * Fill a range of a data item in FAM with a pattern repeated, without
+     * transferring the data. The returned object is waited for with
+     * wait_for_copy.
+     * @param descriptor - valid descriptor to the data item in FAM
+     * @param offset - byte offset within the data item of the range
+     * @param nbytes - size of the range
+     * @param pattern - value repeated over the range
+     * @param patternSize - size of the pattern in bytes, 1, 2, 4 or 8
+     * @return - wait object of the fill
+     */
+    virtual void *fill(Fam_Descriptor *descriptor, uint64_t offset,
+                       uint64_t nbytes, uint64_t pattern,
+                       uint64_t patternSize) = 0;
     // ATOMICS Group
 
     // NON fetching routines
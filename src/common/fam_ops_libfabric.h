@@ -115,9 +115,25 @@ class Fam_Ops_Libfabric : public Fam_Ops {
                          uint64_t nElements, uint64_t *elementIndex,
                          uint64_t elementSize);
 
+    int get_iov_blocking(Fam_Descriptor *descriptor, struct iovec *iov,
+                         const uint64_t *offsets, uint64_t count);
+
+    int put_iov_blocking(Fam_Descriptor *descriptor, struct iovec *iov,
+                         const uint64_t *offsets, uint64_t count);
+
+    void get_iov_nonblocking(Fam_Descriptor *descriptor, struct iovec *iov,
+                             const uint64_t *offsets, uint64_t count);
+
+    void put_iov_nonblocking(Fam_Descriptor *descriptor, struct iovec *iov,
+                             const uint64_t *offsets, uint64_t count);
+
     void put_nonblocking(void *local, Fam_Descriptor *descriptor,
                          uint64_t offset, uint64_t nbytes);
 
+    void put_signal(void *local, Fam_Descriptor *descriptor, uint64_t offset,
+                    uint64_t nbytes, Fam_Descriptor *sigDescriptor,
+                    uint64_t sigOffset, uint64_t sigValue, Fam_Signal_Op op);
+
     void get_nonblocking(void *local, Fam_Descriptor *descriptor,
                          uint64_t offset, uint64_t nbytes);
 
@@ -140,8 +156,14 @@ class Fam_Ops_Libfabric : public Fam_Ops {
     void *copy(Fam_Descriptor *src, uint64_t srcOffset, Fam_Descriptor **dest,
                uint64_t destOffset, uint64_t nbytes);
 
+    void *copy(Fam_Descriptor *src, uint64_t srcOffset, Fam_Descriptor *dest,
+               uint64_t destOffset, uint64_t nbytes);
+
     void wait_for_copy(void *waitObj);
 
+    void *fill(Fam_Descriptor *descriptor, uint64_t offset, uint64_t nbytes,
+               uint64_t pattern, uint64_t patternSize);
+
     void fence(Fam_Region_Descriptor *descriptor = NULL);
 
     void quiet(Fam_Region_Descriptor *descriptor = NULL);
@@ -314,6 +336,12 @@ class Fam_Ops_Libfabric : public Fam_Ops {
     struct fid_domain *get_domain() {
         return domain;
     };
+    struct fid_av *get_av() {
+        return av;
+    };
+    struct fid_eq *get_eq() {
+        return eq;
+    };
     std::vector<fi_addr_t> *get_fiAddrs() {
         return fiAddrs;
     };
@@ -82,9 +82,25 @@ class Fam_Ops_NVMM : public Fam_Ops {
     int scatter_blocking(void *local, Fam_Descriptor *descriptor,
                          uint64_t nElements, uint64_t *elementIndex,
                          uint64_t elementSize);
+
+    int get_iov_blocking(Fam_Descriptor *descriptor, struct iovec *iov,
+                         const uint64_t *offsets, uint64_t count);
+
+    int put_iov_blocking(Fam_Descriptor *descriptor, struct iovec *iov,
+                         const uint64_t *offsets, uint64_t count);
+
+    void get_iov_nonblocking(Fam_Descriptor *descriptor, struct iovec *iov,
+                             const uint64_t *offsets, uint64_t count);
+
+    void put_iov_nonblocking(Fam_Descriptor *descriptor, struct iovec *iov,
+                             const uint64_t *offsets, uint64_t count);
     void put_nonblocking(void *local, Fam_Descriptor *descriptor,
                          uint64_t offset, uint64_t nbytes);
 
+    void put_signal(void *local, Fam_Descriptor *descriptor, uint64_t offset,
+                    uint64_t nbytes, Fam_Descriptor *sigDescriptor,
+                    uint64_t sigOffset, uint64_t sigValue, Fam_Signal_Op op);
+
     void get_nonblocking(void *local, Fam_Descriptor *descriptor,
                          uint64_t offset, uint64_t nbytes);
 
@@ -107,8 +123,14 @@ class Fam_Ops_NVMM : public Fam_Ops {
     void *copy(Fam_Descriptor *src, uint64_t srcOffset, Fam_Descriptor **dest,
                uint64_t destOffset, uint64_t nbytes);
 
+    void *copy(Fam_Descriptor *src, uint64_t srcOffset, Fam_Descriptor *dest,
+               uint64_t destOffset, uint64_t nbytes);
+
     void wait_for_copy(void *waitObj);
 
+    void *fill(Fam_Descriptor *descriptor, uint64_t offset, uint64_t nbytes,
+               uint64_t pattern, uint64_t patternSize);
+
     void fence(Fam_Region_Descriptor *descriptor = NULL);
 
     void quiet(Fam_Region_Descriptor *descriptor = NULL);
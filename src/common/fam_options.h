@@ -68,6 +68,12 @@ typedef enum {
     RUNTIME,
     /**Number of consumer threads in case of shared memory model**/
     NUM_CONSUMER,
+    /** Mechanism used to obtain memory server fabric addresses */
+    ADDR_EXCHANGE,
+    /** Barrier algorithm used by fam_barrier_all */
+    BARRIER,
+    /** Mechanism used by fam_wait_until to watch a location */
+    WAIT_MODE,
     /** END of Option keys */
     END_OPT = -1
 } Fam_Option_Key;
@@ -88,6 +94,15 @@ typedef enum {
 #define FAM_OPTIONS_RUNTIME_PMI2_STR "PMI2"
 #define FAM_OPTIONS_RUNTIME_NONE_STR "NONE"
 
+#define FAM_OPTIONS_ADDR_EXCHANGE_RPC_STR "RPC"
+#define FAM_OPTIONS_ADDR_EXCHANGE_RUNTIME_STR "RUNTIME"
+
+#define FAM_OPTIONS_BARRIER_RUNTIME_STR "RUNTIME"
+#define FAM_OPTIONS_BARRIER_FAM_STR "FAM"
+
+#define FAM_OPTIONS_WAIT_POLL_STR "POLL"
+#define FAM_OPTIONS_WAIT_SERVER_STR "SERVER"
+
 typedef enum {
     /** For single threaded applicaiton */
     FAM_THREAD_SERIALIZE = 1,
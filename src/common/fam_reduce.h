@@ -0,0 +1,402 @@
+/*
+ * fam_reduce.h
+ * Copyright (c) 2020 Hewlett Packard Enterprise Development, LP. All rights
+ * reserved. Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+#ifndef FAM_REDUCE_H
+#define FAM_REDUCE_H
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define FAM_REDUCE_X86
+#endif
+
+#include "fam/fam.h"
+
+namespace openfam {
+
+/*
+ * Size of an element of the given data type, 0 for an unknown type
+ */
+inline size_t fam_type_size(Fam_Type type) {
+    switch (type) {
+    case FAM_TYPE_INT32:
+        return sizeof(int32_t);
+    case FAM_TYPE_INT64:
+        return sizeof(int64_t);
+    case FAM_TYPE_UINT32:
+        return sizeof(uint32_t);
+    case FAM_TYPE_UINT64:
+        return sizeof(uint64_t);
+    case FAM_TYPE_FLOAT:
+        return sizeof(float);
+    case FAM_TYPE_DOUBLE:
+        return sizeof(double);
+    default:
+        return 0;
+    }
+}
+
+/*
+ * Size of the result of reducing elements of the given type, 0 for an
+ * unknown type or operation. The norm is always a double.
+ */
+inline size_t fam_reduce_result_size(Fam_Type type, Fam_Reduce_Op op) {
+    if ((op < FAM_REDUCE_SUM) || (op > FAM_REDUCE_NORM))
+        return 0;
+    if ((op == FAM_REDUCE_NORM) && (fam_type_size(type) != 0))
+        return sizeof(double);
+    return fam_type_size(type);
+}
+
+/*
+ * Value an accumulator starts from: first is returned for the operations
+ * which have no identity element.
+ */
+template <typename Acc>
+inline Acc fam_reduce_identity(Fam_Reduce_Op op, Acc first) {
+    switch (op) {
+    case FAM_REDUCE_SUM:
+    case FAM_REDUCE_NORM:
+        return 0;
+    case FAM_REDUCE_PROD:
+        return 1;
+    case FAM_REDUCE_MIN:
+    case FAM_REDUCE_MAX:
+        return first;
+    }
+    return first;
+}
+
+/*
+ * Combine an element into an accumulator. The norm accumulates the sum of
+ * the squares.
+ */
+template <typename Acc>
+inline Acc fam_reduce_step(Acc acc, Acc x, Fam_Reduce_Op op) {
+    switch (op) {
+    case FAM_REDUCE_SUM:
+        return acc + x;
+    case FAM_REDUCE_PROD:
+        return acc * x;
+    case FAM_REDUCE_MIN:
+        return (x < acc) ? x : acc;
+    case FAM_REDUCE_MAX:
+        return (x > acc) ? x : acc;
+    case FAM_REDUCE_NORM:
+        return acc + x * x;
+    }
+    return acc;
+}
+
+/*
+ * Combine two accumulators
+ */
+template <typename Acc>
+inline Acc fam_reduce_merge(Acc a, Acc b, Fam_Reduce_Op op) {
+    return (op == FAM_REDUCE_NORM) ? a + b : fam_reduce_step(a, b, op);
+}
+
+/*
+ * Portable kernel: reduce n elements into init. Four independent accumulators
+ * keep several operations in flight, and let the compiler vectorize the loop.
+ */
+template <typename T, typename Acc>
+inline Acc fam_reduce_scalar(const T *data, uint64_t n, Fam_Reduce_Op op,
+                             Acc init) {
+    Acc identity = fam_reduce_identity(op, init);
+    Acc acc[4] = {init, identity, identity, identity};
+    uint64_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        for (int j = 0; j < 4; j++)
+            acc[j] = fam_reduce_step(acc[j], (Acc)data[i + j], op);
+    }
+    for (; i < n; i++)
+        acc[0] = fam_reduce_step(acc[0], (Acc)data[i], op);
+    return fam_reduce_merge(fam_reduce_merge(acc[0], acc[1], op),
+                            fam_reduce_merge(acc[2], acc[3], op), op);
+}
+
+#ifdef FAM_REDUCE_X86
+/*
+ * SIMD kernels for floating point elements, selected at run time from the
+ * instruction sets the CPU supports. Each one reduces the bulk of the
+ * elements with two vector accumulators, and hands the remaining elements
+ * over to the portable kernel. The float kernels do not compute the norm,
+ * which is accumulated in double precision. The AVX-512 minimum and maximum
+ * are written as a compare and blend, since _mm512_min_pd() and friends trip
+ * -Wmaybe-uninitialized with some GCC versions.
+ */
+__attribute__((target("avx512f"))) inline double
+fam_reduce_avx512(const double *data, uint64_t n, Fam_Reduce_Op op,
+                  double init) {
+    __m512d acc0 = _mm512_set1_pd(fam_reduce_identity(op, init));
+    __m512d acc1 = acc0;
+    uint64_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512d x0 = _mm512_loadu_pd(data + i);
+        __m512d x1 = _mm512_loadu_pd(data + i + 8);
+        switch (op) {
+        case FAM_REDUCE_SUM:
+            acc0 = _mm512_add_pd(acc0, x0);
+            acc1 = _mm512_add_pd(acc1, x1);
+            break;
+        case FAM_REDUCE_PROD:
+            acc0 = _mm512_mul_pd(acc0, x0);
+            acc1 = _mm512_mul_pd(acc1, x1);
+            break;
+        case FAM_REDUCE_MIN:
+            acc0 = _mm512_mask_blend_pd(
+                _mm512_cmp_pd_mask(x0, acc0, _CMP_LT_OQ), acc0, x0);
+            acc1 = _mm512_mask_blend_pd(
+                _mm512_cmp_pd_mask(x1, acc1, _CMP_LT_OQ), acc1, x1);
+            break;
+        case FAM_REDUCE_MAX:
+            acc0 = _mm512_mask_blend_pd(
+                _mm512_cmp_pd_mask(x0, acc0, _CMP_GT_OQ), acc0, x0);
+            acc1 = _mm512_mask_blend_pd(
+                _mm512_cmp_pd_mask(x1, acc1, _CMP_GT_OQ), acc1, x1);
+            break;
+        case FAM_REDUCE_NORM:
+            acc0 = _mm512_add_pd(acc0, _mm512_mul_pd(x0, x0));
+            acc1 = _mm512_add_pd(acc1, _mm512_mul_pd(x1, x1));
+            break;
+        }
+    }
+    double lanes[16];
+    _mm512_storeu_pd(lanes, acc0);
+    _mm512_storeu_pd(lanes + 8, acc1);
+    for (int j = 0; j < 16; j++)
+        init = fam_reduce_merge(init, lanes[j], op);
+    return fam_reduce_scalar(data + i, n - i, op, init);
+}
+
+__attribute__((target("avx512f"))) inline float
+fam_reduce_avx512(const float *data, uint64_t n, Fam_Reduce_Op op,
+                  float init) {
+    __m512 acc0 = _mm512_set1_ps(fam_reduce_identity(op, init));
+    __m512 acc1 = acc0;
+    uint64_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m512 x0 = _mm512_loadu_ps(data + i);
+        __m512 x1 = _mm512_loadu_ps(data + i + 16);
+        switch (op) {
+        case FAM_REDUCE_SUM:
+            acc0 = _mm512_add_ps(acc0, x0);
+            acc1 = _mm512_add_ps(acc1, x1);
+            break;
+        case FAM_REDUCE_PROD:
+            acc0 = _mm512_mul_ps(acc0, x0);
+            acc1 = _mm512_mul_ps(acc1, x1);
+            break;
+        case FAM_REDUCE_MIN:
+            acc0 = _mm512_mask_blend_ps(
+                _mm512_cmp_ps_mask(x0, acc0, _CMP_LT_OQ), acc0, x0);
+            acc1 = _mm512_mask_blend_ps(
+                _mm512_cmp_ps_mask(x1, acc1, _CMP_LT_OQ), acc1, x1);
+            break;
+        case FAM_REDUCE_MAX:
+            acc0 = _mm512_mask_blend_ps(
+                _mm512_cmp_ps_mask(x0, acc0, _CMP_GT_OQ), acc0, x0);
+            acc1 = _mm512_mask_blend_ps(
+                _mm512_cmp_ps_mask(x1, acc1, _CMP_GT_OQ), acc1, x1);
+            break;
+        case FAM_REDUCE_NORM:
+            // Accumulated in double precision by the portable kernel
+            break;
+        }
+    }
+    float lanes[32];
+    _mm512_storeu_ps(lanes, acc0);
+    _mm512_storeu_ps(lanes + 16, acc1);
+    for (int j = 0; j < 32; j++)
+        init = fam_reduce_merge(init, lanes[j], op);
+    return fam_reduce_scalar(data + i, n - i, op, init);
+}
+
+__attribute__((target("avx2"))) inline double
+fam_reduce_avx2(const double *data, uint64_t n, Fam_Reduce_Op op,
+                double init) {
+    __m256d acc0 = _mm256_set1_pd(fam_reduce_identity(op, init));
+    __m256d acc1 = acc0;
+    uint64_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256d x0 = _mm256_loadu_pd(data + i);
+        __m256d x1 = _mm256_loadu_pd(data + i + 4);
+        switch (op) {
+        case FAM_REDUCE_SUM:
+            acc0 = _mm256_add_pd(acc0, x0);
+            acc1 = _mm256_add_pd(acc1, x1);
+            break;
+        case FAM_REDUCE_PROD:
+            acc0 = _mm256_mul_pd(acc0, x0);
+            acc1 = _mm256_mul_pd(acc1, x1);
+            break;
+        case FAM_REDUCE_MIN:
+            acc0 = _mm256_min_pd(acc0, x0);
+            acc1 = _mm256_min_pd(acc1, x1);
+            break;
+        case FAM_REDUCE_MAX:
+            acc0 = _mm256_max_pd(acc0, x0);
+            acc1 = _mm256_max_pd(acc1, x1);
+            break;
+        case FAM_REDUCE_NORM:
+            acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(x0, x0));
+            acc1 = _mm256_add_pd(acc1, _mm256_mul_pd(x1, x1));
+            break;
+        }
+    }
+    double lanes[8];
+    _mm256_storeu_pd(lanes, acc0);
+    _mm256_storeu_pd(lanes + 4, acc1);
+    for (int j = 0; j < 8; j++)
+        init = fam_reduce_merge(init, lanes[j], op);
+    return fam_reduce_scalar(data + i, n - i, op, init);
+}
+
+__attribute__((target("avx2"))) inline float
+fam_reduce_avx2(const float *data, uint64_t n, Fam_Reduce_Op op, float init) {
+    __m256 acc0 = _mm256_set1_ps(fam_reduce_identity(op, init));
+    __m256 acc1 = acc0;
+    uint64_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256 x0 = _mm256_loadu_ps(data + i);
+        __m256 x1 = _mm256_loadu_ps(data + i + 8);
+        switch (op) {
+        case FAM_REDUCE_SUM:
+            acc0 = _mm256_add_ps(acc0, x0);
+            acc1 = _mm256_add_ps(acc1, x1);
+            break;
+        case FAM_REDUCE_PROD:
+            acc0 = _mm256_mul_ps(acc0, x0);
+            acc1 = _mm256_mul_ps(acc1, x1);
+            break;
+        case FAM_REDUCE_MIN:
+            acc0 = _mm256_min_ps(acc0, x0);
+            acc1 = _mm256_min_ps(acc1, x1);
+            break;
+        case FAM_REDUCE_MAX:
+            acc0 = _mm256_max_ps(acc0, x0);
+            acc1 = _mm256_max_ps(acc1, x1);
+            break;
+        case FAM_REDUCE_NORM:
+            // Accumulated in double precision by the portable kernel
+            break;
+        }
+    }
+    float lanes[16];
+    _mm256_storeu_ps(lanes, acc0);
+    _mm256_storeu_ps(lanes + 8, acc1);
+    for (int j = 0; j < 16; j++)
+        init = fam_reduce_merge(init, lanes[j], op);
+    return fam_reduce_scalar(data + i, n - i, op, init);
+}
+#endif
+
+/*
+ * Reduce n elements of data, with the widest kernel available for the type
+ */
+template <typename T, typename Acc>
+inline Acc fam_reduce_elements(const T *data, uint64_t n, Fam_Reduce_Op op) {
+    Acc init = fam_reduce_identity(op, (Acc)data[0]);
+    return fam_reduce_scalar(data, n, op, init);
+}
+
+template <>
+inline double fam_reduce_elements<double, double>(const double *data,
+                                                  uint64_t n,
+                                                  Fam_Reduce_Op op) {
+    double init = fam_reduce_identity(op, data[0]);
+#ifdef FAM_REDUCE_X86
+    if (__builtin_cpu_supports("avx512f"))
+        return fam_reduce_avx512(data, n, op, init);
+    if (__builtin_cpu_supports("avx2"))
+        return fam_reduce_avx2(data, n, op, init);
+#endif
+    return fam_reduce_scalar(data, n, op, init);
+}
+
+template <>
+inline float fam_reduce_elements<float, float>(const float *data, uint64_t n,
+                                               Fam_Reduce_Op op) {
+    float init = fam_reduce_identity(op, data[0]);
+#ifdef FAM_REDUCE_X86
+    if (__builtin_cpu_supports("avx512f"))
+        return fam_reduce_avx512(data, n, op, init);
+    if (__builtin_cpu_supports("avx2"))
+        return fam_reduce_avx2(data, n, op, init);
+#endif
+    return fam_reduce_scalar(data, n, op, init);
+}
+
+/*
+ * Reduce nElements (at least one) elements of the given type at data, and
+ * store the result at result: an element of the type, or a double for the
+ * norm. Sums and products of integers wrap around like in C.
+ */
+template <typename T>
+inline void fam_reduce_typed(const void *data, uint64_t nElements,
+                             Fam_Reduce_Op op, void *result) {
+    if (op == FAM_REDUCE_NORM) {
+        double sum =
+            fam_reduce_elements<T, double>((const T *)data, nElements, op);
+        *(double *)result = sqrt(sum);
+    } else {
+        *(T *)result = fam_reduce_elements<T, T>((const T *)data, nElements,
+                                                 op);
+    }
+}
+
+inline void fam_reduce_local(const void *data, uint64_t nElements,
+                             Fam_Type type, Fam_Reduce_Op op, void *result) {
+    switch (type) {
+    case FAM_TYPE_INT32:
+        fam_reduce_typed<int32_t>(data, nElements, op, result);
+        break;
+    case FAM_TYPE_INT64:
+        fam_reduce_typed<int64_t>(data, nElements, op, result);
+        break;
+    case FAM_TYPE_UINT32:
+        fam_reduce_typed<uint32_t>(data, nElements, op, result);
+        break;
+    case FAM_TYPE_UINT64:
+        fam_reduce_typed<uint64_t>(data, nElements, op, result);
+        break;
+    case FAM_TYPE_FLOAT:
+        fam_reduce_typed<float>(data, nElements, op, result);
+        break;
+    case FAM_TYPE_DOUBLE:
+        fam_reduce_typed<double>(data, nElements, op, result);
+        break;
+    }
+}
+
+} // namespace openfam
+#endif
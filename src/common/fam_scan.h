@@ -0,0 +1,168 @@
+/*
+ * fam_scan.h
+ * Copyright (c) 2020 Hewlett Packard Enterprise Development, LP. All rights
+ * reserved. Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+#ifndef FAM_SCAN_H
+#define FAM_SCAN_H
+
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+#include "common/fam_reduce.h"
+#include "fam/fam.h"
+
+/**
+ * Largest result a memory server returns in a single scan response, well
+ * below the default gRPC message size limit. Larger results are fetched with
+ * several requests.
+ */
+#define FAM_SCAN_MAX_RESPONSE (1UL << 20)
+
+namespace openfam {
+
+/*
+ * Records scanned by a memory server, the predicates they must all satisfy,
+ * and the columns copied to the result (whole records if there are none)
+ */
+typedef struct {
+    uint64_t recordSize;
+    uint64_t nRecords;
+    std::vector<Fam_Scan_Predicate> predicates;
+    std::vector<Fam_Scan_Column> columns;
+} Fam_Scan_Query;
+
+/*
+ * Size of a record of the result of the query, 0 if a predicate or a column
+ * does not lie within a record, or uses an unknown type or operation
+ */
+inline uint64_t fam_scan_result_size(const Fam_Scan_Query &query) {
+    uint64_t recordSize = query.recordSize;
+    for (const Fam_Scan_Predicate &predicate : query.predicates) {
+        uint64_t fieldSize = fam_type_size(predicate.type);
+        if ((fieldSize == 0) || (predicate.fieldOffset > recordSize) ||
+            (fieldSize > recordSize - predicate.fieldOffset))
+            return 0;
+        if ((predicate.op != FAM_SCAN_RANGE) &&
+            (predicate.op != FAM_SCAN_EQUAL))
+            return 0;
+    }
+    if (query.columns.empty())
+        return recordSize;
+
+    uint64_t resultSize = 0;
+    for (const Fam_Scan_Column &column : query.columns) {
+        if ((column.size == 0) || (column.offset > recordSize) ||
+            (column.size > recordSize - column.offset))
+            return 0;
+        resultSize += column.size;
+    }
+    return resultSize;
+}
+
+/*
+ * Compare a field of type T with the bounds of the predicate
+ */
+template <typename T>
+inline bool fam_scan_compare(const char *field,
+                             const Fam_Scan_Predicate &predicate) {
+    T value, low, high;
+    memcpy(&value, field, sizeof(T));
+    memcpy(&low, &predicate.low, sizeof(T));
+    if (predicate.op == FAM_SCAN_EQUAL)
+        return value == low;
+    memcpy(&high, &predicate.high, sizeof(T));
+    return (low <= value) && (value <= high);
+}
+
+inline bool fam_scan_match(const char *record,
+                           const Fam_Scan_Predicate &predicate) {
+    const char *field = record + predicate.fieldOffset;
+    switch (predicate.type) {
+    case FAM_TYPE_INT32:
+        return fam_scan_compare<int32_t>(field, predicate);
+    case FAM_TYPE_INT64:
+        return fam_scan_compare<int64_t>(field, predicate);
+    case FAM_TYPE_UINT32:
+        return fam_scan_compare<uint32_t>(field, predicate);
+    case FAM_TYPE_UINT64:
+        return fam_scan_compare<uint64_t>(field, predicate);
+    case FAM_TYPE_FLOAT:
+        return fam_scan_compare<float>(field, predicate);
+    case FAM_TYPE_DOUBLE:
+        return fam_scan_compare<double>(field, predicate);
+    }
+    return false;
+}
+
+/*
+ * Scan the records at data, and copy the selected columns of the records
+ * matching all the predicates one after the other to out. The scan stops
+ * before a matching record whose columns do not fit in the outSize bytes
+ * left. Returns the number of records copied; nScanned is set to the number
+ * of records scanned. The query must have been checked with
+ * fam_scan_result_size(). out must not overlap the records, as a selected
+ * column could overwrite bytes of a record which are still to be read.
+ */
+inline uint64_t fam_scan_local(const void *data, const Fam_Scan_Query &query,
+                               void *out, uint64_t outSize,
+                               uint64_t &nScanned) {
+    uint64_t resultSize = fam_scan_result_size(query);
+    uint64_t nMatched = 0;
+    uint64_t i;
+    for (i = 0; i < query.nRecords; i++) {
+        const char *record = (const char *)data + i * query.recordSize;
+        bool match = true;
+        for (const Fam_Scan_Predicate &predicate : query.predicates) {
+            if (!fam_scan_match(record, predicate)) {
+                match = false;
+                break;
+            }
+        }
+        if (!match)
+            continue;
+        if (outSize - nMatched * resultSize < resultSize)
+            break;
+
+        char *dest = (char *)out + nMatched * resultSize;
+        if (query.columns.empty()) {
+            memmove(dest, record, query.recordSize);
+        } else {
+            for (const Fam_Scan_Column &column : query.columns) {
+                memmove(dest, record + column.offset, column.size);
+                dest += column.size;
+            }
+        }
+        nMatched++;
+    }
+    nScanned = i;
+    return nMatched;
+}
+
+} // namespace openfam
+#endif
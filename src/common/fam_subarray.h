@@ -0,0 +1,117 @@
+/*
+ * fam_subarray.h
+ * Copyright (c) 2020 Hewlett Packard Enterprise Development, LP. All rights
+ * reserved. Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+#ifndef FAM_SUBARRAY_H
+#define FAM_SUBARRAY_H
+
+#include <stdint.h>
+#include <sys/uio.h>
+#include <vector>
+
+/**
+ * Largest number of dimensions of a subarray transfer
+ */
+#define FAM_SUBARRAY_MAX_DIMS 3
+
+namespace openfam {
+
+/*
+ * Add a run of bytes to the transfer, merging it with the previous run when
+ * both the local and the FAM sides are contiguous with it
+ */
+inline void fam_subarray_add_run(char *local, uint64_t offset, uint64_t nbytes,
+                                 std::vector<struct iovec> *iov,
+                                 std::vector<uint64_t> *offsets) {
+    if (!iov->empty()) {
+        struct iovec &last = iov->back();
+        if (((char *)last.iov_base + last.iov_len == local) &&
+            (offsets->back() + last.iov_len == offset)) {
+            last.iov_len += nbytes;
+            return;
+        }
+    }
+    struct iovec run = {(void *)local, nbytes};
+    iov->push_back(run);
+    offsets->push_back(offset);
+}
+
+/*
+ * Build the list of runs transferring a subarray between local memory and a
+ * data item. Dimension 0 is the outermost one; strides are in elements. A NULL
+ * localStrides means the subarray is packed in local memory. Each run is an
+ * iovec in local memory and the byte offset of the matching run in the data
+ * item.
+ */
+inline void fam_subarray_runs(void *local, uint64_t offset,
+                              uint64_t elementSize, uint64_t nDims,
+                              const uint64_t *shape,
+                              const uint64_t *famStrides,
+                              const uint64_t *localStrides,
+                              std::vector<struct iovec> *iov,
+                              std::vector<uint64_t> *offsets) {
+    // Extend the subarray to the maximum number of dimensions with outer
+    // dimensions of a single element
+    uint64_t dimShape[FAM_SUBARRAY_MAX_DIMS];
+    uint64_t famStride[FAM_SUBARRAY_MAX_DIMS];
+    uint64_t localStride[FAM_SUBARRAY_MAX_DIMS];
+    uint64_t packed = 1;
+    for (int dim = FAM_SUBARRAY_MAX_DIMS - 1; dim >= 0; dim--) {
+        int64_t user = dim - (FAM_SUBARRAY_MAX_DIMS - (int64_t)nDims);
+        dimShape[dim] = (user >= 0) ? shape[user] : 1;
+        famStride[dim] = (user >= 0) ? famStrides[user] : 0;
+        localStride[dim] =
+            (user >= 0) ? (localStrides ? localStrides[user] : packed) : 0;
+        packed *= dimShape[dim];
+    }
+
+    bool rowContiguous = (famStride[2] == 1) && (localStride[2] == 1);
+    char *base = (char *)local;
+    for (uint64_t i = 0; i < dimShape[0]; i++) {
+        for (uint64_t j = 0; j < dimShape[1]; j++) {
+            uint64_t famRow =
+                offset + (i * famStride[0] + j * famStride[1]) * elementSize;
+            char *localRow =
+                base + (i * localStride[0] + j * localStride[1]) * elementSize;
+            if (rowContiguous) {
+                fam_subarray_add_run(localRow, famRow,
+                                     dimShape[2] * elementSize, iov, offsets);
+                continue;
+            }
+            for (uint64_t k = 0; k < dimShape[2]; k++) {
+                fam_subarray_add_run(
+                    localRow + k * localStride[2] * elementSize,
+                    famRow + k * famStride[2] * elementSize, elementSize, iov,
+                    offsets);
+            }
+        }
+    }
+}
+
+} // namespace openfam
+#endif
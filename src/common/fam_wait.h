@@ -0,0 +1,84 @@
+/*
+ * fam_wait.h
+ * Copyright (c) 2020 Hewlett Packard Enterprise Development, LP. All rights
+ * reserved. Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+#ifndef FAM_WAIT_H
+#define FAM_WAIT_H
+
+#include <algorithm>
+#include <stdint.h>
+#include <unistd.h>
+
+#include "fam/fam.h"
+
+/**
+ * Bounds in microseconds of the delay between two polls of a FAM location
+ */
+#define FAM_WAIT_MIN_BACKOFF 1
+#define FAM_WAIT_MAX_BACKOFF 1024
+
+/**
+ * Time in milliseconds a memory server watches a location before replying to
+ * a wait request whose condition is not met
+ */
+#define FAM_WAIT_SERVER_TIMEOUT 100
+
+namespace openfam {
+
+/*
+ * Returns true if value compares to target as requested by cmp
+ */
+inline bool fam_wait_satisfied(uint64_t value, Fam_Cmp cmp, uint64_t target) {
+    switch (cmp) {
+    case FAM_CMP_EQ:
+        return value == target;
+    case FAM_CMP_NE:
+        return value != target;
+    case FAM_CMP_GT:
+        return value > target;
+    case FAM_CMP_GE:
+        return value >= target;
+    case FAM_CMP_LT:
+        return value < target;
+    case FAM_CMP_LE:
+        return value <= target;
+    default:
+        return false;
+    }
+}
+
+/*
+ * Sleep for the current delay, and double it for the next poll
+ */
+inline void fam_wait_backoff(uint64_t *delay) {
+    usleep((useconds_t)*delay);
+    *delay = std::min(*delay * 2, (uint64_t)FAM_WAIT_MAX_BACKOFF);
+}
+
+} // namespace openfam
+#endif
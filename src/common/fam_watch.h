@@ -0,0 +1,151 @@
+/*
+ * fam_watch.h
+ * Copyright (c) 2020 Hewlett Packard Enterprise Development, LP. All rights
+ * reserved. Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+#ifndef FAM_WATCH_H
+#define FAM_WATCH_H
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdint.h>
+#include <string.h>
+#include <string>
+
+#include "fam/fam.h"
+#include "fam/fam_exception.h"
+
+/**
+ * Shortest interval in milliseconds at which a watched range is checked for
+ * changes; changes within one interval are reported as a single event
+ */
+#define FAM_WATCH_MIN_INTERVAL 10
+
+/**
+ * Largest range a memory server checks for changes, as it keeps a snapshot
+ * of the range and compares it at every interval
+ */
+#define FAM_WATCH_MAX_SIZE (16UL << 20)
+
+namespace openfam {
+
+/*
+ * Compare the live contents of a watched range with the snapshot taken at the
+ * previous check, and bring the snapshot up to date. Returns true if anything
+ * changed, with [first, last) set to the smallest range covering the changes.
+ */
+inline bool fam_watch_scan(const char *live, char *snapshot, uint64_t size,
+                           uint64_t *first, uint64_t *last) {
+    uint64_t start = 0;
+    while ((start < size) && (live[start] == snapshot[start]))
+        start++;
+    if (start == size)
+        return false;
+    uint64_t end = size;
+    while (live[end - 1] == snapshot[end - 1])
+        end--;
+    memcpy(snapshot + start, live + start, end - start);
+    *first = start;
+    *last = end;
+    return true;
+}
+
+/*
+ * A subscription to the changes of a range of a data item. Notifications
+ * which arrive before the application picks them up are coalesced into the
+ * smallest range covering all of them.
+ */
+class Fam_Watch {
+  public:
+    Fam_Watch() : pending(false), done(false), errorCode(0) {}
+
+    virtual ~Fam_Watch() {}
+
+    /*
+     * Wait for changes to the watched range. Returns false if no change was
+     * notified within timeout milliseconds or the watch has ended.
+     */
+    bool next(uint64_t *offset, uint64_t *nbytes, uint64_t timeout) {
+        std::unique_lock<std::mutex> lock(watchMutex);
+        watchCond.wait_for(lock, std::chrono::milliseconds(timeout),
+                           [this] { return pending || done; });
+        if (pending) {
+            *offset = first;
+            *nbytes = last - first;
+            pending = false;
+            return true;
+        }
+        if (errorCode) {
+            throw Fam_Allocator_Exception((enum Fam_Error)errorCode,
+                                          errorMsg.c_str());
+        }
+        return false;
+    }
+
+  protected:
+    /*
+     * Record a change of [offset, offset + nbytes) of the watched range
+     */
+    void notify(uint64_t offset, uint64_t nbytes) {
+        std::lock_guard<std::mutex> lock(watchMutex);
+        if (pending) {
+            first = std::min(first, offset);
+            last = std::max(last, offset + nbytes);
+        } else {
+            first = offset;
+            last = offset + nbytes;
+            pending = true;
+        }
+        watchCond.notify_all();
+    }
+
+    /*
+     * Mark the watch as ended, with an error if code is not zero
+     */
+    void finish(int code = 0, const std::string &msg = "") {
+        std::lock_guard<std::mutex> lock(watchMutex);
+        done = true;
+        errorCode = code;
+        errorMsg = msg;
+        watchCond.notify_all();
+    }
+
+  private:
+    std::mutex watchMutex;
+    std::condition_variable watchCond;
+    bool pending;
+    uint64_t first;
+    uint64_t last;
+    bool done;
+    int errorCode;
+    std::string errorMsg;
+};
+
+} // namespace openfam
+#endif
@@ -67,6 +67,9 @@ Memserver_Exception::convert_to_famerror(enum Memserver_Error serverErr) {
     case UNIMPLEMENTED:
         return FAM_ERR_UNIMPL;
 
+    case INVALID_OPTIONS:
+        return FAM_ERR_INVALID;
+
     case ALLOC_NO_ERROR:
     case REGION_NOT_INSERTED:
     case DATAITEM_NOT_INSERTED:
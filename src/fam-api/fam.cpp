@@ -27,19 +27,31 @@
  * See https://spdx.org/licenses/BSD-3-Clause
  *
  */
+#include <algorithm>
+#include <climits>
+#include <future>
 #include <iostream>
+#include <sched.h>
 #include <sstream>
 #include <string>
 #include <unistd.h>
+#include <vector>
 
 #include "allocator/fam_allocator.h"
 #include "allocator/fam_allocator_grpc.h"
 #include "allocator/fam_allocator_nvmm.h"
+#include "common/fam_capability.h"
+#include "common/fam_checksum.h"
 #include "common/fam_libfabric.h"
 #include "common/fam_ops.h"
 #include "common/fam_ops_libfabric.h"
 #include "common/fam_ops_nvmm.h"
 #include "common/fam_options.h"
+#include "common/fam_reduce.h"
+#include "common/fam_scan.h"
+#include "common/fam_subarray.h"
+#include "common/fam_wait.h"
+#include "common/fam_watch.h"
 #include "fam/fam.h"
 #include "fam/fam_exception.h"
 #include "pmi/fam_runtime.h"
@@ -68,10 +80,114 @@ const char *supportedOptionList[] = { "VERSION",             // index #0
                                       "PE_ID",               // index #10
                                       "RUNTIME",             // index #11
                                       "NUM_CONSUMER",        // index #12
-                                      NULL                   // index #13
+                                      "ADDR_EXCHANGE",       // index #13
+                                      "BARRIER",             // index #14
+                                      "WAIT_MODE",           // index #15
+                                      NULL                   // index #16
 };
 
 namespace openfam {
+/*
+ * Layout of a data item descriptor serialized by fam_descriptor_serialize()
+ */
+#define FAM_DESCRIPTOR_MAGIC ((uint64_t)0x46414d4445534331)
+typedef struct {
+    uint64_t magic;
+    Fam_Global_Descriptor gDescriptor;
+    uint64_t key;
+    uint64_t size;
+    uint64_t memserverId;
+    Fam_Capability capability;
+} Fam_Serialized_Descriptor;
+static_assert(sizeof(Fam_Serialized_Descriptor) ==
+                  FAM_DESCRIPTOR_SERIALIZED_SIZE,
+              "FAM_DESCRIPTOR_SERIALIZED_SIZE does not match the layout");
+
+/*
+ * Prefix of the name of the regions holding data items used internally by
+ * the library, like the flags of the FAM barrier
+ */
+#define FAM_SYSTEM_REGION_PREFIX "famSystem_"
+
+/*
+ * Size of the per PE slot in the scratch data item of collective operations.
+ * Larger buffers are processed in chunks of this size.
+ */
+#define FAM_COLLECTIVE_SLOT_SIZE 32768
+
+/*
+ * Kinds of flags in the scratch data item of collective operations. Each kind
+ * has its own flag per PE, so that a PE which already started a broadcast
+ * can not be mistaken for one done with a reduction, and the other way round.
+ */
+#define FAM_COLLECTIVE_BROADCAST_FLAG 0
+#define FAM_COLLECTIVE_REDUCE_FLAG 1
+#define FAM_COLLECTIVE_FLAG_KINDS 2
+
+/*
+ * Size below which differing ranges of data items held by different memory
+ * servers are read and compared locally, instead of being halved again
+ */
+#define FAM_COMPARE_LOCAL_SIZE 65536
+
+/*
+ * Combine nElements of src into dest with the given reduction operation
+ */
+template <typename T>
+static void fam_reduce_buffer(T *dest, const T *src, uint64_t nElements,
+                              Fam_Reduce_Op op) {
+    uint64_t i;
+    switch (op) {
+    case FAM_REDUCE_SUM:
+        for (i = 0; i < nElements; i++)
+            dest[i] += src[i];
+        break;
+    case FAM_REDUCE_PROD:
+        for (i = 0; i < nElements; i++)
+            dest[i] *= src[i];
+        break;
+    case FAM_REDUCE_MIN:
+        for (i = 0; i < nElements; i++)
+            dest[i] = (src[i] < dest[i]) ? src[i] : dest[i];
+        break;
+    case FAM_REDUCE_MAX:
+        for (i = 0; i < nElements; i++)
+            dest[i] = (src[i] > dest[i]) ? src[i] : dest[i];
+        break;
+    case FAM_REDUCE_NORM:
+        // Not a collective operation, rejected by fam_reduce()
+        break;
+    }
+}
+
+static void fam_reduce_buffer(void *dest, const void *src, uint64_t nElements,
+                              Fam_Type type, Fam_Reduce_Op op) {
+    switch (type) {
+    case FAM_TYPE_INT32:
+        fam_reduce_buffer((int32_t *)dest, (const int32_t *)src, nElements,
+                          op);
+        break;
+    case FAM_TYPE_INT64:
+        fam_reduce_buffer((int64_t *)dest, (const int64_t *)src, nElements,
+                          op);
+        break;
+    case FAM_TYPE_UINT32:
+        fam_reduce_buffer((uint32_t *)dest, (const uint32_t *)src, nElements,
+                          op);
+        break;
+    case FAM_TYPE_UINT64:
+        fam_reduce_buffer((uint64_t *)dest, (const uint64_t *)src, nElements,
+                          op);
+        break;
+    case FAM_TYPE_FLOAT:
+        fam_reduce_buffer((float *)dest, (const float *)src, nElements, op);
+        break;
+    case FAM_TYPE_DOUBLE:
+        fam_reduce_buffer((double *)dest, (const double *)src, nElements, op);
+        break;
+    }
+}
+
 /*
  * Internal implementation of fam
  */
@@ -86,6 +202,16 @@ class fam::Impl_ {
         famOps = NULL;
         famAllocator = NULL;
         famRuntime = NULL;
+        broadcastCount = 0;
+        barrierRegion = NULL;
+        barrierItem = NULL;
+        barrierCount = 0;
+        collectiveRegion = NULL;
+        collectiveItem = NULL;
+        collectiveCount = 0;
+        collectiveSlotReads = 0;
+        famPe = 0;
+        famPeCount = 1;
         memset((void *)&famOptions, 0, sizeof(Fam_Options));
     }
 
@@ -116,6 +242,19 @@ class fam::Impl_ {
 
     Fam_Descriptor *fam_lookup(const char *itemName, const char *regionName);
 
+    void fam_lookup_batch(const char **itemNames, uint64_t nItems,
+                          const char *regionName, Fam_Descriptor **descriptors);
+
+    void fam_prepare(Fam_Descriptor **descriptors, uint64_t nItems);
+
+    void fam_descriptor_serialize(Fam_Descriptor *descriptor, void *buffer,
+                                  size_t *len);
+
+    Fam_Descriptor *fam_descriptor_deserialize(const void *buffer, size_t len);
+
+    Fam_Descriptor *fam_broadcast_descriptor(int root,
+                                             Fam_Descriptor *descriptor);
+
     Fam_Region_Descriptor *
     fam_create_region(const char *name, uint64_t size, mode_t permissions,
                       Fam_Redundancy_Level redundancyLevel, ...);
@@ -132,6 +271,13 @@ class fam::Impl_ {
 
     void fam_deallocate(Fam_Descriptor *descriptor);
 
+    void fam_allocate_batch(uint64_t nItems, const uint64_t *sizes,
+                            const char **names, mode_t accessPermissions,
+                            Fam_Region_Descriptor *region,
+                            Fam_Descriptor **descriptors);
+
+    void fam_deallocate_batch(Fam_Descriptor **descriptors, uint64_t nItems);
+
     int fam_change_permissions(Fam_Descriptor *descriptor,
                                mode_t accessPermissions);
 
@@ -154,6 +300,11 @@ class fam::Impl_ {
     void fam_put_nonblocking(void *local, Fam_Descriptor *descriptor,
                              uint64_t offset, uint64_t nbytes);
 
+    void fam_put_signal(void *local, Fam_Descriptor *descriptor,
+                        uint64_t offset, uint64_t nbytes,
+                        Fam_Descriptor *sigDescriptor, uint64_t sigOffset,
+                        uint64_t sigValue, Fam_Signal_Op op);
+
     void *fam_map(Fam_Descriptor *descriptor);
 
     void fam_unmap(void *local, Fam_Descriptor *descriptor);
@@ -190,11 +341,86 @@ class fam::Impl_ {
                                  uint64_t nElements, uint64_t *elementIndex,
                                  uint64_t elementSize);
 
+    int fam_get_subarray(void *local, Fam_Descriptor *descriptor,
+                         uint64_t offset, uint64_t elementSize, uint64_t nDims,
+                         const uint64_t *shape, const uint64_t *famStrides,
+                         const uint64_t *localStrides);
+
+    int fam_put_subarray(void *local, Fam_Descriptor *descriptor,
+                         uint64_t offset, uint64_t elementSize, uint64_t nDims,
+                         const uint64_t *shape, const uint64_t *famStrides,
+                         const uint64_t *localStrides);
+
+    int fam_gather_iov_blocking(struct iovec *localIov,
+                                Fam_Descriptor *descriptor,
+                                uint64_t *offsets, uint64_t nIov);
+
+    void fam_gather_iov_nonblocking(struct iovec *localIov,
+                                    Fam_Descriptor *descriptor,
+                                    uint64_t *offsets, uint64_t nIov);
+
+    int fam_scatter_iov_blocking(struct iovec *localIov,
+                                 Fam_Descriptor *descriptor,
+                                 uint64_t *offsets, uint64_t nIov);
+
+    void fam_scatter_iov_nonblocking(struct iovec *localIov,
+                                     Fam_Descriptor *descriptor,
+                                     uint64_t *offsets, uint64_t nIov);
+
+    void validate_subarray(void *local, Fam_Descriptor *descriptor,
+                           uint64_t elementSize, uint64_t nDims,
+                           const uint64_t *shape, const uint64_t *famStrides);
+    void validate_subarray_extent(Fam_Descriptor *descriptor, uint64_t offset,
+                                  uint64_t elementSize, uint64_t nDims,
+                                  const uint64_t *shape,
+                                  const uint64_t *famStrides);
+    void validate_iov_extent(Fam_Descriptor *descriptor,
+                             const struct iovec *localIov,
+                             const uint64_t *offsets, uint64_t nIov);
+
     void *fam_copy(Fam_Descriptor *src, uint64_t srcOffset,
                    Fam_Descriptor **dest, uint64_t destOffset, uint64_t nbytes);
+    void *fam_copy(Fam_Descriptor *src, uint64_t srcOffset,
+                   Fam_Descriptor *dest, uint64_t destOffset, uint64_t nbytes);
 
     void fam_copy_wait(void *waitObj);
 
+    void *fam_memset(Fam_Descriptor *descriptor, uint64_t offset, int value,
+                     uint64_t nbytes);
+    void *fam_fill(Fam_Descriptor *descriptor, uint64_t offset,
+                   const void *value, uint64_t elementSize, uint64_t nElements);
+    void fam_fill_wait(void *waitObj);
+
+    void fam_reduce_item(Fam_Descriptor *descriptor, uint64_t offset,
+                         uint64_t nElements, Fam_Type type, Fam_Reduce_Op op,
+                         void *result);
+
+    uint64_t validate_scan(Fam_Descriptor *descriptor, uint64_t recordSize,
+                           uint64_t nRecords, Fam_Scan_Predicate *predicates,
+                           uint64_t nPredicates, Fam_Scan_Column *columns,
+                           uint64_t nColumns, Fam_Scan_Query &query);
+    uint64_t fam_scan(Fam_Descriptor *descriptor, uint64_t offset,
+                      uint64_t recordSize, uint64_t nRecords,
+                      Fam_Scan_Predicate *predicates, uint64_t nPredicates,
+                      Fam_Scan_Column *columns, uint64_t nColumns, void *local,
+                      uint64_t localSize, uint64_t *nScanned);
+    uint64_t fam_scan_to_item(Fam_Descriptor *descriptor, uint64_t offset,
+                              uint64_t recordSize, uint64_t nRecords,
+                              Fam_Scan_Predicate *predicates,
+                              uint64_t nPredicates, Fam_Scan_Column *columns,
+                              uint64_t nColumns, Fam_Descriptor *dest,
+                              uint64_t destOffset, uint64_t destSize,
+                              uint64_t *nScanned);
+
+    uint64_t fam_checksum(Fam_Descriptor *descriptor, uint64_t offset,
+                          uint64_t nbytes, Fam_Checksum_Algo algo);
+    bool checksums_differ(Fam_Descriptor *a, Fam_Descriptor *b,
+                          uint64_t start, uint64_t nbytes);
+    bool compare_digests(Fam_Descriptor *a, Fam_Descriptor *b,
+                         uint64_t nbytes, uint64_t *diffOffset);
+    bool fam_compare_items(Fam_Descriptor *a, Fam_Descriptor *b,
+                           uint64_t *diffOffset);
+
     void fam_set(Fam_Descriptor *descriptor, uint64_t offset, int32_t value);
     void fam_set(Fam_Descriptor *descriptor, uint64_t offset, int64_t value);
     void fam_set(Fam_Descriptor *descriptor, uint64_t offset, int128_t value);
@@ -345,10 +571,52 @@ class fam::Impl_ {
     void fam_fence(Fam_Region_Descriptor *descriptor = NULL);
     void fam_quiet(Fam_Region_Descriptor *descriptor = NULL);
 
+    uint64_t fam_wait_until(Fam_Descriptor *descriptor, uint64_t offset,
+                            Fam_Cmp cmp, uint64_t value);
+    uint64_t fam_wait_until_any(Fam_Descriptor *descriptor,
+                                const uint64_t *offsets, uint64_t nOffsets,
+                                Fam_Cmp cmp, uint64_t value);
+    void fam_wait_until_all(Fam_Descriptor *descriptor,
+                            const uint64_t *offsets, uint64_t nOffsets,
+                            Fam_Cmp cmp, uint64_t value);
+    Fam_Watch *fam_watch(Fam_Descriptor *descriptor, uint64_t offset,
+                         uint64_t nbytes, uint64_t interval);
+    bool fam_watch_next(Fam_Watch *watch, uint64_t *offset, uint64_t *nbytes,
+                        uint64_t timeout);
+    void fam_unwatch(Fam_Watch *watch);
+    void validate_wait(Fam_Descriptor *descriptor, Fam_Cmp cmp);
+    uint64_t wait_word(Fam_Descriptor *descriptor, uint64_t offset,
+                       Fam_Cmp cmp, uint64_t value);
+
     int validate_fam_options(Fam_Options *options);
     void clean_fam_options();
     int validate_item(Fam_Descriptor *descriptor);
 
+    Fam_Descriptor *allocate_system_item(const char *name, uint64_t nbytes,
+                                         Fam_Region_Descriptor **region);
+    void deallocate_system_item(Fam_Descriptor *item,
+                                Fam_Region_Descriptor *region);
+    void fam_barrier_initialize();
+    void fam_barrier_finalize();
+    void fam_barrier_fam();
+
+    void fam_broadcast(void *data, uint64_t nbytes, int root);
+
+    void fam_reduce(void *dest, const void *src, uint64_t nElements,
+                    Fam_Type type, Fam_Reduce_Op op, int root);
+
+    void fam_allreduce(void *dest, const void *src, uint64_t nElements,
+                       Fam_Type type, Fam_Reduce_Op op);
+
+    void fam_collective_initialize();
+    void fam_collective_finalize();
+    void collective_publish(void *local, uint64_t nbytes, uint64_t readers);
+    void collective_wait_flag(int kind, int pe, uint64_t value);
+    void broadcast_chunk(void *data, uint64_t nbytes, int root);
+    void reduce_chunk(void *dest, const void *src, uint64_t nElements,
+                      Fam_Type type, Fam_Reduce_Op op, int root,
+                      void *partial, void *received);
+
   private:
     uid_t uid;
     gid_t gid;
@@ -362,6 +630,40 @@ class fam::Impl_ {
     Fam_Context_Model famContextModel;
     Fam_Runtime *famRuntime;
     uint64_t memoryServerCount;
+    // PE id and number of PEs
+    int famPe;
+    int famPeCount;
+    // Number of fam_broadcast_descriptor calls, used to make the runtime
+    // key of each broadcast unique
+    uint64_t broadcastCount;
+    // State of the FAM barrier: flags[round][pe] counts the number of
+    // barriers in which PE pe was notified in the given round
+    Fam_Region_Descriptor *barrierRegion;
+    Fam_Descriptor *barrierItem;
+    uint64_t barrierCount;
+    uint64_t barrierRounds;
+    // State of collective operations. The scratch data item holds a flag of
+    // each kind and a count of completed reads per PE, followed by a data
+    // slot per PE.
+    // collectiveCount numbers the steps of collective operations, and
+    // collectiveSlotReads is the number of reads of the slot of this PE
+    // requested so far.
+    Fam_Region_Descriptor *collectiveRegion;
+    Fam_Descriptor *collectiveItem;
+    uint64_t collectiveCount;
+    uint64_t collectiveSlotReads;
+    uint64_t collective_flag_offset(int kind, int pe) {
+        return (kind * famPeCount + pe) * sizeof(uint64_t);
+    }
+    uint64_t collective_done_offset(int pe) {
+        return (FAM_COLLECTIVE_FLAG_KINDS * famPeCount + pe) *
+               sizeof(uint64_t);
+    }
+    uint64_t collective_slot_offset(int pe) {
+        return (FAM_COLLECTIVE_FLAG_KINDS + 1) * famPeCount *
+                   sizeof(uint64_t) +
+               pe * FAM_COLLECTIVE_SLOT_SIZE;
+    }
     uint64_t generate_memory_server_id(const char *name) {
         std::uint64_t hashVal = std::hash<std::string> {}
         (name);
@@ -666,6 +968,8 @@ int fam::Impl_::fam_initialize(const char *grpName, Fam_Options *options) {
         optValueMap->insert({ supportedOptionList[PE_COUNT], peCnt });
         optValueMap->insert({ supportedOptionList[PE_ID], peId });
     }
+    famPe = *peId;
+    famPeCount = *peCnt;
 
     if (strcmp(famOptions.allocator, FAM_OPTIONS_NVMM_STR) == 0) {
         // initialize NVMM client
@@ -696,8 +1000,13 @@ int fam::Impl_::fam_initialize(const char *grpName, Fam_Options *options) {
                 throw Fam_InvalidOption_Exception(message.str().c_str());
             }
         }
-        famAllocator =
-            new Fam_Allocator_Grpc(memoryServerList, atoi(famOptions.grpcPort));
+        if (strcmp(famOptions.addrExchange,
+                   FAM_OPTIONS_ADDR_EXCHANGE_RUNTIME_STR) == 0)
+            famAllocator = new Fam_Allocator_Grpc(
+                memoryServerList, atoi(famOptions.grpcPort), famRuntime);
+        else
+            famAllocator = new Fam_Allocator_Grpc(memoryServerList,
+                                                  atoi(famOptions.grpcPort));
         famOps = new Fam_Ops_Libfabric(
             memoryServerList, famOptions.libfabricPort, false,
             famOptions.libfabricProvider, famThreadModel, famAllocator,
@@ -712,10 +1021,126 @@ int fam::Impl_::fam_initialize(const char *grpName, Fam_Options *options) {
             throw Fam_Datapath_Exception(message.str().c_str());
         }
     }
+
+    if (strcmp(famOptions.barrier, FAM_OPTIONS_BARRIER_FAM_STR) == 0)
+        fam_barrier_initialize();
     FAM_PROFILE_START_TIME();
     return ret;
 }
 
+/**
+ * Collective call which allocates a data item used internally by the library.
+ * PE 0 allocates and zeroes the data item in a region private to the job, and
+ * broadcasts its descriptor to the other PEs.
+ * @param name - name of the data item
+ * @param nbytes - size of the data item
+ * @param region - set to the region holding the data item on PE 0, NULL on
+ * other PEs
+ * @return - descriptor of the data item
+ * @throws Fam_Allocator_Exception - if the data item can not be allocated
+ * @throws Fam_Pmi_Exception - if the descriptor can not be broadcast
+ */
+Fam_Descriptor *
+fam::Impl_::allocate_system_item(const char *name, uint64_t nbytes,
+                                 Fam_Region_Descriptor **region) {
+    Fam_Descriptor *item = NULL;
+    *region = NULL;
+    if (famPe == 0) {
+        // Region name is made unique to the job, so that concurrent jobs of
+        // the same group do not share the data item
+        char hostName[HOST_NAME_MAX + 1] = { 0 };
+        gethostname(hostName, HOST_NAME_MAX);
+        std::string regionName = std::string(FAM_SYSTEM_REGION_PREFIX) +
+                                 name + "_" + groupName + "_" + hostName +
+                                 "_" + std::to_string(getpid());
+        *region = famAllocator->create_region(
+            regionName.c_str(), 2 * nbytes, 0600, NONE,
+            generate_memory_server_id(regionName.c_str()));
+        item = famAllocator->allocate(name, nbytes, 0600, *region);
+
+        void *zero = calloc(1, nbytes);
+        validate_item(item);
+        famOps->put_blocking(zero, item, 0, nbytes);
+        free(zero);
+    }
+    item = fam_broadcast_descriptor(0, item);
+    validate_item(item);
+    return item;
+}
+
+/**
+ * Release a data item allocated by allocate_system_item(). The caller must
+ * ensure that no PE uses the data item any more.
+ */
+void fam::Impl_::deallocate_system_item(Fam_Descriptor *item,
+                                        Fam_Region_Descriptor *region) {
+    if (region != NULL) {
+        famAllocator->deallocate(item);
+        famAllocator->destroy_region(region);
+        delete region;
+    }
+    delete item;
+}
+
+/**
+ * Set up the FAM barrier, allocating the data item which holds the barrier
+ * flags.
+ */
+void fam::Impl_::fam_barrier_initialize() {
+    barrierRounds = 0;
+    while ((1L << barrierRounds) < famPeCount)
+        barrierRounds++;
+
+    // Nothing to synchronize with a single PE
+    if (barrierRounds == 0)
+        return;
+
+    barrierItem = allocate_system_item(
+        "barrier", barrierRounds * famPeCount * sizeof(uint64_t),
+        &barrierRegion);
+}
+
+/**
+ * Release the data item used by the FAM barrier, once all the PEs are done
+ * with it. PEs leave a FAM barrier while others may still poll or update
+ * their flags, so the runtime barrier is used before releasing it.
+ */
+void fam::Impl_::fam_barrier_finalize() {
+    if (barrierItem == NULL)
+        return;
+    famOps->quiet();
+    famRuntime->runtime_barrier_all();
+    deallocate_system_item(barrierItem, barrierRegion);
+    barrierItem = NULL;
+    barrierRegion = NULL;
+}
+
+/**
+ * Dissemination barrier over FAM. In round r, each PE notifies PE
+ * (pe + 2^r) % n by incrementing its flag for the round, and then waits for
+ * its own flag to reach the current barrier count. Flags are never reset, as
+ * every PE is notified exactly once per round in each barrier.
+ */
+void fam::Impl_::fam_barrier_fam() {
+    if (barrierItem == NULL)
+        return;
+
+    // Updates made before the barrier must be visible after it
+    famOps->quiet();
+    uint64_t count = ++barrierCount;
+    for (uint64_t round = 0; round < barrierRounds; round++) {
+        uint64_t partner = (famPe + (1UL << round)) % famPeCount;
+        uint64_t roundOffset = round * famPeCount * sizeof(uint64_t);
+        famOps->atomic_fetch_add(barrierItem,
+                                 roundOffset + partner * sizeof(uint64_t),
+                                 (uint64_t)1);
+        while (famOps->atomic_fetch_uint64(
+                   barrierItem, roundOffset + famPe * sizeof(uint64_t)) <
+               count)
+            sched_yield();
+    }
+}
+
 /**
  * Validate the input Fam_Options and update the option values
  * @return - {true(0), false(1), errNo(<0)}
@@ -833,6 +1258,53 @@ int fam::Impl_::validate_fam_options(Fam_Options *options) {
     optValueMap->insert(
         { supportedOptionList[NUM_CONSUMER], famOptions.numConsumer });
 
+    if (options && options->addrExchange)
+        famOptions.addrExchange = strdup(options->addrExchange);
+    else
+        famOptions.addrExchange = strdup(FAM_OPTIONS_ADDR_EXCHANGE_RPC_STR);
+    if ((strcmp(famOptions.addrExchange, FAM_OPTIONS_ADDR_EXCHANGE_RPC_STR) !=
+         0) &&
+        (strcmp(famOptions.addrExchange,
+                FAM_OPTIONS_ADDR_EXCHANGE_RUNTIME_STR) != 0)) {
+        message << "Invalid value specified for addrExchange: "
+                << famOptions.addrExchange;
+        throw Fam_InvalidOption_Exception(message.str().c_str());
+    }
+    if ((strcmp(famOptions.addrExchange,
+                FAM_OPTIONS_ADDR_EXCHANGE_RUNTIME_STR) == 0) &&
+        (strcmp(famOptions.runtime, FAM_OPTIONS_RUNTIME_NONE_STR) == 0)) {
+        message << "addrExchange " << famOptions.addrExchange
+                << " requires a PMI runtime";
+        throw Fam_InvalidOption_Exception(message.str().c_str());
+    }
+    optValueMap->insert(
+        { supportedOptionList[ADDR_EXCHANGE], famOptions.addrExchange });
+
+    if (options && options->barrier)
+        famOptions.barrier = strdup(options->barrier);
+    else
+        famOptions.barrier = strdup(FAM_OPTIONS_BARRIER_RUNTIME_STR);
+    if ((strcmp(famOptions.barrier, FAM_OPTIONS_BARRIER_RUNTIME_STR) != 0) &&
+        (strcmp(famOptions.barrier, FAM_OPTIONS_BARRIER_FAM_STR) != 0)) {
+        message << "Invalid value specified for barrier: "
+                << famOptions.barrier;
+        throw Fam_InvalidOption_Exception(message.str().c_str());
+    }
+    optValueMap->insert({ supportedOptionList[BARRIER], famOptions.barrier });
+
+    if (options && options->waitMode)
+        famOptions.waitMode = strdup(options->waitMode);
+    else
+        famOptions.waitMode = strdup(FAM_OPTIONS_WAIT_POLL_STR);
+    if ((strcmp(famOptions.waitMode, FAM_OPTIONS_WAIT_POLL_STR) != 0) &&
+        (strcmp(famOptions.waitMode, FAM_OPTIONS_WAIT_SERVER_STR) != 0)) {
+        message << "Invalid value specified for waitMode: "
+                << famOptions.waitMode;
+        throw Fam_InvalidOption_Exception(message.str().c_str());
+    }
+    optValueMap->insert(
+        { supportedOptionList[WAIT_MODE], famOptions.waitMode });
+
     return ret;
 }
 
@@ -864,11 +1336,19 @@ int fam::Impl_::validate_item(Fam_Descriptor *descriptor) {
     Fam_Region_Item_Info itemInfo;
 
     if (key == FAM_KEY_UNINITIALIZED) {
-        itemInfo = famAllocator->check_permission_get_info(descriptor);
-        descriptor->bind_key(itemInfo.key);
-        descriptor->set_size(itemInfo.size);
-        if (strcmp(famOptions.allocator, FAM_OPTIONS_NVMM_STR) == 0) {
-            descriptor->set_base_address(itemInfo.base);
+        Fam_Capability cap = descriptor->get_capability();
+        if (fam_capability_valid(cap, uid, gid)) {
+            // The memory server checked the permission of this user when
+            // handing out the capability; no need to check it again
+            descriptor->bind_key(cap.key);
+            descriptor->set_size(cap.size);
+        } else {
+            itemInfo = famAllocator->check_permission_get_info(descriptor);
+            descriptor->bind_key(itemInfo.key);
+            descriptor->set_size(itemInfo.size);
+            if (strcmp(famOptions.allocator, FAM_OPTIONS_NVMM_STR) == 0) {
+                descriptor->set_base_address(itemInfo.base);
+            }
         }
     }
 
@@ -888,6 +1368,9 @@ int fam::Impl_::validate_item(Fam_Descriptor *descriptor) {
 void fam::Impl_::fam_finalize(const char *groupName) {
     FAM_PROFILE_END();
 
+    fam_collective_finalize();
+    fam_barrier_finalize();
+
     // Calling destructor for allocator
     if (famAllocator != NULL)
         famAllocator->allocator_finalize();
@@ -916,11 +1399,279 @@ void fam::Impl_::fam_abort(int status) {
  * a call to this particular fam_barrier_all() statement
  */
 void fam::Impl_::fam_barrier_all(void) {
-    if (famRuntime != NULL)
+    if (barrierItem != NULL)
+        fam_barrier_fam();
+    else if (famRuntime != NULL)
         famRuntime->runtime_barrier_all();
     return;
 }
 
+/**
+ * Allocate the scratch data item of collective operations, on the first
+ * collective operation called by the PEs.
+ */
+void fam::Impl_::fam_collective_initialize() {
+    if (collectiveItem != NULL)
+        return;
+    collectiveItem = allocate_system_item(
+        "collective",
+        (FAM_COLLECTIVE_FLAG_KINDS + 1) * famPeCount * sizeof(uint64_t) +
+            famPeCount * FAM_COLLECTIVE_SLOT_SIZE,
+        &collectiveRegion);
+}
+
+/**
+ * Release the scratch data item of collective operations, once all the PEs
+ * are done with it. The runtime barrier is used, as a FAM barrier does not
+ * tell when the other PEs stop polling FAM.
+ */
+void fam::Impl_::fam_collective_finalize() {
+    if (collectiveItem == NULL)
+        return;
+    famOps->quiet();
+    famRuntime->runtime_barrier_all();
+    deallocate_system_item(collectiveItem, collectiveRegion);
+    collectiveItem = NULL;
+    collectiveRegion = NULL;
+}
+
+/**
+ * Write a buffer into the slot of the calling PE, once the readers of the
+ * previous contents of the slot are done.
+ * @param local - buffer to be written
+ * @param nbytes - size of the buffer
+ * @param readers - number of PEs which will read the buffer
+ */
+void fam::Impl_::collective_publish(void *local, uint64_t nbytes,
+                                    uint64_t readers) {
+    while (famOps->atomic_fetch_uint64(collectiveItem,
+                                       collective_done_offset(famPe)) <
+           collectiveSlotReads)
+        sched_yield();
+    famOps->put_nonblocking(local, collectiveItem,
+                            collective_slot_offset(famPe), nbytes);
+    famOps->quiet();
+    collectiveSlotReads += readers;
+}
+
+/**
+ * Wait until the flag of the given kind of a PE reaches the given value.
+ * Flags are only updated with atomic max, so that they never go backwards.
+ */
+void fam::Impl_::collective_wait_flag(int kind, int pe, uint64_t value) {
+    while (famOps->atomic_fetch_uint64(
+               collectiveItem, collective_flag_offset(kind, pe)) < value)
+        sched_yield();
+}
+
+/**
+ * Broadcast a buffer of at most FAM_COLLECTIVE_SLOT_SIZE bytes. The root
+ * writes the buffer into its slot, and the notification travels along a
+ * binomial tree rooted at the root, so that no flag is polled by more than
+ * one PE. Every PE reads the buffer from the slot of the root.
+ */
+void fam::Impl_::broadcast_chunk(void *data, uint64_t nbytes, int root) {
+    uint64_t step = ++collectiveCount;
+    int vpe = (famPe - root + famPeCount) % famPeCount;
+
+    if (vpe == 0)
+        collective_publish(data, nbytes, famPeCount - 1);
+    else
+        collective_wait_flag(FAM_COLLECTIVE_BROADCAST_FLAG, famPe, step);
+
+    // Notify the children in the tree, which are vpe + mask for every power
+    // of two mask below the lowest bit set in vpe
+    int mask = 1;
+    while ((mask < famPeCount) && !(vpe & mask))
+        mask <<= 1;
+    for (mask >>= 1; mask > 0; mask >>= 1) {
+        if (vpe + mask < famPeCount) {
+            int child = (vpe + mask + root) % famPeCount;
+            famOps->atomic_max(
+                collectiveItem,
+                collective_flag_offset(FAM_COLLECTIVE_BROADCAST_FLAG, child),
+                step);
+        }
+    }
+
+    if (vpe != 0) {
+        famOps->get_blocking(data, collectiveItem,
+                             collective_slot_offset(root), nbytes);
+        famOps->atomic_add(collectiveItem, collective_done_offset(root),
+                           (uint64_t)1);
+    }
+}
+
+/**
+ * Reduce a buffer of at most FAM_COLLECTIVE_SLOT_SIZE bytes along a binomial
+ * tree rooted at the root. Each PE combines the partial results of its
+ * children with its own elements, and hands the result over to its parent
+ * through its slot.
+ */
+void fam::Impl_::reduce_chunk(void *dest, const void *src, uint64_t nElements,
+                              Fam_Type type, Fam_Reduce_Op op, int root,
+                              void *partial, void *received) {
+    uint64_t step = ++collectiveCount;
+    uint64_t nbytes = nElements * fam_type_size(type);
+    int vpe = (famPe - root + famPeCount) % famPeCount;
+
+    memcpy(partial, src, nbytes);
+    for (int mask = 1; mask < famPeCount; mask <<= 1) {
+        if (vpe & mask) {
+            collective_publish(partial, nbytes, 1);
+            famOps->atomic_max(
+                collectiveItem,
+                collective_flag_offset(FAM_COLLECTIVE_REDUCE_FLAG, famPe),
+                step);
+            break;
+        }
+        if (vpe + mask < famPeCount) {
+            int child = (vpe + mask + root) % famPeCount;
+            collective_wait_flag(FAM_COLLECTIVE_REDUCE_FLAG, child, step);
+            famOps->get_blocking(received, collectiveItem,
+                                 collective_slot_offset(child), nbytes);
+            famOps->atomic_add(collectiveItem, collective_done_offset(child),
+                               (uint64_t)1);
+            fam_reduce_buffer(partial, received, nElements, type, op);
+        }
+    }
+
+    if (vpe == 0)
+        memcpy(dest, partial, nbytes);
+}
+
+/**
+ * Collective call which copies a buffer of the root PE into the buffer of
+ * every other PE, staging the data in a scratch data item in FAM.
+ * @param data - buffer holding the data on the root PE, and receiving it on
+ * other PEs
+ * @param nbytes - size of the buffer
+ * @param root - PE broadcasting the data
+ * @throws Fam_InvalidOption_Exception - if root is not a valid PE
+ */
+void fam::Impl_::fam_broadcast(void *data, uint64_t nbytes, int root) {
+    std::ostringstream message;
+    FAM_CNTR_INC_API(fam_broadcast);
+    FAM_PROFILE_START_OPS(fam_broadcast);
+    if ((root < 0) || (root >= famPeCount)) {
+        message << "Invalid root PE: " << root;
+        throw Fam_InvalidOption_Exception(message.str().c_str());
+    }
+
+    if (famPeCount > 1) {
+        fam_collective_initialize();
+        for (uint64_t start = 0; start < nbytes;
+             start += FAM_COLLECTIVE_SLOT_SIZE) {
+            uint64_t chunk =
+                std::min((uint64_t)FAM_COLLECTIVE_SLOT_SIZE, nbytes - start);
+            broadcast_chunk((char *)data + start, chunk, root);
+        }
+    }
+    FAM_PROFILE_END_OPS(fam_broadcast);
+    return;
+}
+
+/**
+ * Collective call which combines the elements of the source buffers of all
+ * PEs, and stores the result in the destination buffer of the root PE.
+ * @param dest - buffer receiving the result on the root PE
+ * @param src - buffer holding the elements of the calling PE
+ * @param nElements - number of elements in the buffers
+ * @param type - data type of the elements
+ * @param op - reduction operation
+ * @param root - PE receiving the result
+ * @throws Fam_InvalidOption_Exception - if root is not a valid PE, or type or
+ * op is not supported
+ * @see #fam_allreduce
+ */
+void fam::Impl_::fam_reduce(void *dest, const void *src, uint64_t nElements,
+                            Fam_Type type, Fam_Reduce_Op op, int root) {
+    std::ostringstream message;
+    FAM_CNTR_INC_API(fam_reduce);
+    FAM_PROFILE_START_OPS(fam_reduce);
+    size_t typeSize = fam_type_size(type);
+    if (typeSize == 0) {
+        message << "Invalid data type: " << type;
+        throw Fam_InvalidOption_Exception(message.str().c_str());
+    }
+    if ((op < FAM_REDUCE_SUM) || (op > FAM_REDUCE_MAX)) {
+        message << "Invalid reduction operation: " << op;
+        throw Fam_InvalidOption_Exception(message.str().c_str());
+    }
+    if ((root < 0) || (root >= famPeCount)) {
+        message << "Invalid root PE: " << root;
+        throw Fam_InvalidOption_Exception(message.str().c_str());
+    }
+
+    if (famPeCount > 1) {
+        fam_collective_initialize();
+        uint64_t chunkElements = FAM_COLLECTIVE_SLOT_SIZE / typeSize;
+        void *partial = malloc(FAM_COLLECTIVE_SLOT_SIZE);
+        void *received = malloc(FAM_COLLECTIVE_SLOT_SIZE);
+        for (uint64_t start = 0; start < nElements; start += chunkElements) {
+            uint64_t count = std::min(chunkElements, nElements - start);
+            reduce_chunk((char *)dest + start * typeSize,
+                         (const char *)src + start * typeSize, count, type,
+                         op, root, partial, received);
+        }
+        free(partial);
+        free(received);
+    } else if (dest != src) {
+        memcpy(dest, src, nElements * typeSize);
+    }
+    FAM_PROFILE_END_OPS(fam_reduce);
+    return;
+}
+
+/**
+ * Collective call which combines the elements of the source buffers of all
+ * PEs, and stores the result in the destination buffer of every PE. Each
+ * chunk is reduced to PE 0 and broadcast back from it.
+ * @param dest - buffer receiving the result
+ * @param src - buffer holding the elements of the calling PE
+ * @param nElements - number of elements in the buffers
+ * @param type - data type of the elements
+ * @param op - reduction operation
+ * @throws Fam_InvalidOption_Exception - if type or op is not supported
+ * @see #fam_reduce
+ */
+void fam::Impl_::fam_allreduce(void *dest, const void *src,
+                               uint64_t nElements, Fam_Type type,
+                               Fam_Reduce_Op op) {
+    std::ostringstream message;
+    FAM_CNTR_INC_API(fam_allreduce);
+    FAM_PROFILE_START_OPS(fam_allreduce);
+    size_t typeSize = fam_type_size(type);
+    if (typeSize == 0) {
+        message << "Invalid data type: " << type;
+        throw Fam_InvalidOption_Exception(message.str().c_str());
+    }
+    if ((op < FAM_REDUCE_SUM) || (op > FAM_REDUCE_MAX)) {
+        message << "Invalid reduction operation: " << op;
+        throw Fam_InvalidOption_Exception(message.str().c_str());
+    }
+
+    if (famPeCount > 1) {
+        fam_collective_initialize();
+        uint64_t chunkElements = FAM_COLLECTIVE_SLOT_SIZE / typeSize;
+        void *partial = malloc(FAM_COLLECTIVE_SLOT_SIZE);
+        void *received = malloc(FAM_COLLECTIVE_SLOT_SIZE);
+        for (uint64_t start = 0; start < nElements; start += chunkElements) {
+            uint64_t count = std::min(chunkElements, nElements - start);
+            char *chunkDest = (char *)dest + start * typeSize;
+            reduce_chunk(chunkDest, (const char *)src + start * typeSize,
+                         count, type, op, 0, partial, received);
+            broadcast_chunk(chunkDest, count * typeSize, 0);
+        }
+        free(partial);
+        free(received);
+    } else if (dest != src) {
+        memcpy(dest, src, nElements * typeSize);
+    }
+    FAM_PROFILE_END_OPS(fam_allreduce);
+    return;
+}
+
 /**
  * List known options for this version of the library. Provides a way for
  * programs to check which options are known to the library.
@@ -1012,6 +1763,225 @@ Fam_Descriptor *fam::Impl_::fam_lookup(const char *itemName,
     return ret;
 }
 
+/**
+ * look up multiple data items of a region in FAM by name in the name service.
+ * All the items are resolved with a single request to the memory server
+ * hosting the region.
+ * @param itemNames - array of names of the data items
+ * @param nItems - number of data items
+ * @param regionName - name of the region containing the data items
+ * @param descriptors - array of nItems, filled with descriptors to the data
+ * items
+ * @throws Fam_Allocator_Exception - excptObj->fam_error() may return:
+ *         FAM_ERR_NOPERM, FAM_ERR_NOTFOUND, FAM_ERR_GRPC
+ * @see #fam_lookup
+ */
+void fam::Impl_::fam_lookup_batch(const char **itemNames, uint64_t nItems,
+                                   const char *regionName,
+                                   Fam_Descriptor **descriptors) {
+    FAM_CNTR_INC_API(fam_lookup_batch);
+    FAM_PROFILE_START_ALLOCATOR(fam_lookup_batch);
+    uint64_t memoryServerId = generate_memory_server_id(regionName);
+    famAllocator->lookup_batch(itemNames, nItems, regionName, memoryServerId,
+                               descriptors);
+    FAM_PROFILE_END_ALLOCATOR(fam_lookup_batch);
+}
+
+/**
+ * Resolve the access key and size of multiple data item descriptors ahead of
+ * their first use, with a single request per memory server. Descriptors
+ * which already hold a valid key are left unchanged.
+ * @param descriptors - array of data item descriptors
+ * @param nItems - number of descriptors
+ * @throws Fam_InvalidOption_Exception - if a descriptor has an invalid key
+ * @throws Fam_Allocator_Exception - excptObj->fam_error() may return:
+ *         FAM_ERR_NOPERM, FAM_ERR_NOTFOUND, FAM_ERR_GRPC
+ * @see #fam_lookup_batch
+ */
+void fam::Impl_::fam_prepare(Fam_Descriptor **descriptors, uint64_t nItems) {
+    std::ostringstream message;
+    FAM_CNTR_INC_API(fam_prepare);
+    FAM_PROFILE_START_ALLOCATOR(fam_prepare);
+    std::vector<Fam_Descriptor *> pending;
+    for (uint64_t ndx = 0; ndx < nItems; ndx++) {
+        uint64_t key = descriptors[ndx]->get_key();
+        if (key == FAM_KEY_INVALID) {
+            message << "Invalid Key Passed" << endl;
+            throw Fam_InvalidOption_Exception(message.str().c_str());
+        }
+        if (key != FAM_KEY_UNINITIALIZED)
+            continue;
+        Fam_Capability cap = descriptors[ndx]->get_capability();
+        if (fam_capability_valid(cap, uid, gid)) {
+            descriptors[ndx]->bind_key(cap.key);
+            descriptors[ndx]->set_size(cap.size);
+        } else {
+            pending.push_back(descriptors[ndx]);
+        }
+    }
+
+    if (pending.size() > 0) {
+        std::vector<Fam_Region_Item_Info> itemInfo(pending.size());
+        famAllocator->check_permission_get_info_batch(
+            pending.data(), pending.size(), itemInfo.data());
+        for (size_t ndx = 0; ndx < pending.size(); ndx++) {
+            pending[ndx]->bind_key(itemInfo[ndx].key);
+            pending[ndx]->set_size(itemInfo[ndx].size);
+            if (strcmp(famOptions.allocator, FAM_OPTIONS_NVMM_STR) == 0) {
+                pending[ndx]->set_base_address(itemInfo[ndx].base);
+            }
+        }
+    }
+    FAM_PROFILE_END_ALLOCATOR(fam_prepare);
+}
+
+/**
+ * Serialize a data item descriptor into a buffer, so that it can be sent to
+ * other PEs.
+ * @param descriptor - descriptor associated with some data item
+ * @param buffer - buffer of at least FAM_DESCRIPTOR_SERIALIZED_SIZE bytes
+ * @param len - on input the size of buffer, on return the number of bytes
+ * written
+ * @throws Fam_InvalidOption_Exception - if the buffer is too small
+ * @see #fam_descriptor_deserialize
+ */
+void fam::Impl_::fam_descriptor_serialize(Fam_Descriptor *descriptor,
+                                          void *buffer, size_t *len) {
+    std::ostringstream message;
+    if ((descriptor == NULL) || (buffer == NULL) || (len == NULL)) {
+        message << "Invalid arguments to fam_descriptor_serialize";
+        throw Fam_InvalidOption_Exception(message.str().c_str());
+    }
+    if (*len < sizeof(Fam_Serialized_Descriptor)) {
+        message << "Buffer too small for serialized descriptor: " << *len;
+        throw Fam_InvalidOption_Exception(message.str().c_str());
+    }
+
+    Fam_Serialized_Descriptor serialized;
+    serialized.magic = FAM_DESCRIPTOR_MAGIC;
+    serialized.gDescriptor = descriptor->get_global_descriptor();
+    serialized.key = descriptor->get_key();
+    serialized.size = descriptor->get_size();
+    serialized.memserverId = descriptor->get_memserver_id();
+    serialized.capability = descriptor->get_capability();
+    memcpy(buffer, &serialized, sizeof(serialized));
+    *len = sizeof(serialized);
+}
+
+/**
+ * Create a data item descriptor from a buffer filled by
+ * fam_descriptor_serialize(). The access key is bound to the new descriptor
+ * if the capability was handed out for the user of this PE, so that it can be
+ * used without checking permission with the memory server; otherwise the
+ * permission is checked on first access.
+ * @param buffer - serialized descriptor
+ * @param len - size of the serialized descriptor
+ * @return - data item descriptor
+ * @throws Fam_InvalidOption_Exception - if the buffer does not hold a
+ * serialized descriptor
+ * @see #fam_descriptor_serialize
+ */
+Fam_Descriptor *fam::Impl_::fam_descriptor_deserialize(const void *buffer,
+                                                       size_t len) {
+    std::ostringstream message;
+    Fam_Serialized_Descriptor serialized;
+    if ((buffer == NULL) || (len < sizeof(serialized))) {
+        message << "Invalid serialized descriptor";
+        throw Fam_InvalidOption_Exception(message.str().c_str());
+    }
+    memcpy(&serialized, buffer, sizeof(serialized));
+    if (serialized.magic != FAM_DESCRIPTOR_MAGIC) {
+        message << "Invalid serialized descriptor";
+        throw Fam_InvalidOption_Exception(message.str().c_str());
+    }
+
+    Fam_Descriptor *descriptor = new Fam_Descriptor(serialized.gDescriptor);
+    if (descriptor->get_memserver_id() != serialized.memserverId) {
+        delete descriptor;
+        message << "Invalid memory server id in serialized descriptor: "
+                << serialized.memserverId;
+        throw Fam_InvalidOption_Exception(message.str().c_str());
+    }
+    descriptor->set_capability(serialized.capability);
+
+    // NVMM allocator needs the local base address of the data item, which
+    // is set when the descriptor is first used
+    if ((strcmp(famOptions.allocator, FAM_OPTIONS_NVMM_STR) != 0) &&
+        fam_capability_valid(serialized.capability, uid, gid) &&
+        (serialized.key != FAM_KEY_UNINITIALIZED) &&
+        (serialized.key != FAM_KEY_INVALID)) {
+        descriptor->bind_key(serialized.key);
+        descriptor->set_size(serialized.size);
+    }
+    return descriptor;
+}
+
+/**
+ * Collective call which broadcasts a data item descriptor from the root PE to
+ * all the PEs through the PMI runtime. The root resolves the access key
+ * before broadcasting it, so that no PE has to check permission with the
+ * memory server.
+ * @param root - PE holding the descriptor
+ * @param descriptor - descriptor associated with some data item on the root
+ * PE, ignored on other PEs
+ * @return - descriptor on the root PE, a new data item descriptor on other PEs
+ * @throws Fam_InvalidOption_Exception - if the runtime is NONE or root is not
+ * a valid PE
+ * @throws Fam_Pmi_Exception - if the runtime fails to exchange the descriptor
+ * @see #fam_descriptor_serialize
+ */
+Fam_Descriptor *
+fam::Impl_::fam_broadcast_descriptor(int root, Fam_Descriptor *descriptor) {
+    std::ostringstream message;
+    FAM_CNTR_INC_API(fam_broadcast_descriptor);
+    FAM_PROFILE_START_ALLOCATOR(fam_broadcast_descriptor);
+    if (famRuntime == NULL) {
+        message << "fam_broadcast_descriptor is not supported with runtime "
+                << FAM_OPTIONS_RUNTIME_NONE_STR;
+        throw Fam_InvalidOption_Exception(message.str().c_str());
+    }
+    if ((root < 0) || (root >= famRuntime->num_pes())) {
+        message << "Invalid root PE: " << root;
+        throw Fam_InvalidOption_Exception(message.str().c_str());
+    }
+
+    std::string kvsKey = "fam_desc_bcast_" + std::to_string(broadcastCount++);
+    char buffer[FAM_DESCRIPTOR_SERIALIZED_SIZE];
+    size_t len = sizeof(buffer);
+    Fam_Descriptor *result = descriptor;
+    int ret;
+
+    if (famRuntime->my_pe() == root) {
+        if (descriptor == NULL) {
+            message << "Invalid descriptor on root PE";
+            throw Fam_InvalidOption_Exception(message.str().c_str());
+        }
+        validate_item(descriptor);
+        fam_descriptor_serialize(descriptor, buffer, &len);
+        if ((ret = famRuntime->runtime_kvs_put(kvsKey.c_str(), buffer,
+                                               len)) != 0) {
+            message << "Failed to publish descriptor: " << ret;
+            throw Fam_Pmi_Exception(message.str().c_str());
+        }
+    }
+
+    if ((ret = famRuntime->runtime_kvs_fence()) != 0) {
+        message << "Failed to broadcast descriptor: " << ret;
+        throw Fam_Pmi_Exception(message.str().c_str());
+    }
+
+    if (famRuntime->my_pe() != root) {
+        if ((ret = famRuntime->runtime_kvs_get(root, kvsKey.c_str(), buffer,
+                                               &len)) != 0) {
+            message << "Failed to read descriptor: " << ret;
+            throw Fam_Pmi_Exception(message.str().c_str());
+        }
+        result = fam_descriptor_deserialize(buffer, len);
+    }
+    FAM_PROFILE_END_ALLOCATOR(fam_broadcast_descriptor);
+    return result;
+}
+
 // ALLOCATION Group
 
 /**
@@ -1130,6 +2100,56 @@ void fam::Impl_::fam_deallocate(Fam_Descriptor *descriptor) {
     return;
 }
 
+/**
+ * Allocate multiple data items within a region, with a single request to the
+ * memory server holding the region.
+ * @param nItems - number of data items
+ * @param sizes - array of nItems sizes, in bytes
+ * @param names - (optional) array of nItems names of the data items
+ * @param accessPermissions - permissions associated with the data items
+ * @param region - descriptor of the region within which the data items are
+ * allocated
+ * @param descriptors - array of nItems, filled with descriptors to the data
+ * items
+ * @see #fam_deallocate_batch()
+ */
+void fam::Impl_::fam_allocate_batch(uint64_t nItems, const uint64_t *sizes,
+                                    const char **names,
+                                    mode_t accessPermissions,
+                                    Fam_Region_Descriptor *region,
+                                    Fam_Descriptor **descriptors) {
+    std::ostringstream message;
+    FAM_CNTR_INC_API(fam_allocate_batch);
+    FAM_PROFILE_START_ALLOCATOR(fam_allocate_batch);
+    if ((nItems > 0) &&
+        ((sizes == NULL) || (region == NULL) || (descriptors == NULL))) {
+        message << "Invalid Options";
+        throw Fam_InvalidOption_Exception(message.str().c_str());
+    }
+    famAllocator->allocate_batch(names, sizes, nItems, accessPermissions,
+                                 region, descriptors);
+    FAM_PROFILE_END_ALLOCATOR(fam_allocate_batch);
+}
+
+/**
+ * Deallocate multiple data items, with a single request per memory server.
+ * @param descriptors - array of descriptors associated with the data items
+ * @param nItems - number of data items
+ * @see #fam_allocate_batch()
+ */
+void fam::Impl_::fam_deallocate_batch(Fam_Descriptor **descriptors,
+                                      uint64_t nItems) {
+    std::ostringstream message;
+    FAM_CNTR_INC_API(fam_deallocate_batch);
+    FAM_PROFILE_START_ALLOCATOR(fam_deallocate_batch);
+    if ((nItems > 0) && (descriptors == NULL)) {
+        message << "Invalid Options";
+        throw Fam_InvalidOption_Exception(message.str().c_str());
+    }
+    famAllocator->deallocate_batch(descriptors, nItems);
+    FAM_PROFILE_END_ALLOCATOR(fam_deallocate_batch);
+}
+
 /**
  * Change permissions associated with a data item descriptor.
  * @param descriptor - descriptor associated with some data item
@@ -1387,22 +2407,64 @@ void fam::Impl_::fam_put_nonblocking(void *local, Fam_Descriptor *descriptor,
     return;
 }
 
-// LOAD/STORE sub-group
-
-// GATHER/SCATTER subgroup
-
 /**
- * Gather data from FAM to local memory, blocking while the copy is complete
- * Gathers disjoint elements within a data item in FAM to a contiguous array in
- * local memory. Currently constrained to gather data from a single FAM
- * descriptor, but can be extended if data needs to be gathered from multiple
- * data items.
- * @param local - pointer to local memory array. Must be large enough to contain
- * returned data
- * @param descriptor - valid descriptor containing FAM reference
- * @param nElements - number of elements to be gathered in local memory
- * @param firstElement - first element in FAM to include in the strided access
- * @param stride - stride in elements
+ * Copy data from local memory to FAM and then update a signal word, ordering
+ * the update after the data without a separate fence.
+ * @param local - pointer to local memory. Must point to valid data in local
+ * memory
+ * @param descriptor - valid descriptor in FAM
+ * @param offset - byte offset within the region defined by the descriptor to
+ * where data should be copied
+ * @param nbytes - number of bytes to be copied from local to FAM
+ * @param sigDescriptor - valid descriptor of the data item holding the signal
+ * word
+ * @param sigOffset - byte offset of the 64-bit signal word
+ * @param sigValue - value used to update the signal word
+ * @param op - update of the signal word, set or add
+ * @throws : Fam_InvalidOption_Exception if incorrect parameters are passed.
+ */
+void fam::Impl_::fam_put_signal(void *local, Fam_Descriptor *descriptor,
+                                uint64_t offset, uint64_t nbytes,
+                                Fam_Descriptor *sigDescriptor,
+                                uint64_t sigOffset, uint64_t sigValue,
+                                Fam_Signal_Op op) {
+    FAM_CNTR_INC_API(fam_put_signal);
+    FAM_PROFILE_START_ALLOCATOR(fam_put_signal);
+    if ((local == NULL) || (descriptor == NULL) || (nbytes == 0) ||
+        (sigDescriptor == NULL) ||
+        ((op != FAM_SIGNAL_SET) && (op != FAM_SIGNAL_ADD))) {
+        throw Fam_InvalidOption_Exception("Invalid Options");
+    }
+
+    int ret = validate_item(descriptor);
+    if (ret == 0)
+        ret = validate_item(sigDescriptor);
+    FAM_PROFILE_END_ALLOCATOR(fam_put_signal);
+    FAM_PROFILE_START_OPS(fam_put_signal);
+    if (ret == 0) {
+        famOps->put_signal(local, descriptor, offset, nbytes, sigDescriptor,
+                           sigOffset, sigValue, op);
+    }
+    FAM_PROFILE_END_OPS(fam_put_signal);
+    return;
+}
+
+// LOAD/STORE sub-group
+
+// GATHER/SCATTER subgroup
+
+/**
+ * Gather data from FAM to local memory, blocking while the copy is complete
+ * Gathers disjoint elements within a data item in FAM to a contiguous array in
+ * local memory. Currently constrained to gather data from a single FAM
+ * descriptor, but can be extended if data needs to be gathered from multiple
+ * data items.
+ * @param local - pointer to local memory array. Must be large enough to contain
+ * returned data
+ * @param descriptor - valid descriptor containing FAM reference
+ * @param nElements - number of elements to be gathered in local memory
+ * @param firstElement - first element in FAM to include in the strided access
+ * @param stride - stride in elements
  * @param elementSize - size of the element in bytes
  * @return - 0 for normal completion, 1 in case of unsuccessful completion,
  * negative number in case of exception
@@ -1685,6 +2747,289 @@ void fam::Impl_::fam_scatter_nonblocking(void *local,
     return;
 }
 
+void fam::Impl_::validate_subarray(void *local, Fam_Descriptor *descriptor,
+                                   uint64_t elementSize, uint64_t nDims,
+                                   const uint64_t *shape,
+                                   const uint64_t *famStrides) {
+    std::ostringstream message;
+    if ((local == NULL) || (descriptor == NULL) || (shape == NULL) ||
+        (famStrides == NULL) || (elementSize == 0)) {
+        throw Fam_InvalidOption_Exception("Invalid Options");
+    }
+    if ((nDims == 0) || (nDims > FAM_SUBARRAY_MAX_DIMS)) {
+        message << "Invalid number of dimensions: " << nDims;
+        throw Fam_InvalidOption_Exception(message.str().c_str());
+    }
+    for (uint64_t dim = 0; dim < nDims; dim++) {
+        if (shape[dim] == 0) {
+            throw Fam_InvalidOption_Exception("Invalid Options");
+        }
+    }
+}
+
+/*
+ * Check that all the elements of a subarray lie within the data item, once
+ * the size of the data item is known. The last element is at
+ * offset + sum((shape[d] - 1) * famStrides[d]) * elementSize.
+ */
+void fam::Impl_::validate_subarray_extent(Fam_Descriptor *descriptor,
+                                          uint64_t offset,
+                                          uint64_t elementSize, uint64_t nDims,
+                                          const uint64_t *shape,
+                                          const uint64_t *famStrides) {
+    uint64_t itemSize = descriptor->get_size();
+    uint64_t last = 0;
+    bool overflow = false;
+    for (uint64_t dim = 0; dim < nDims; dim++) {
+        if ((famStrides[dim] != 0) &&
+            (shape[dim] - 1 > UINT64_MAX / famStrides[dim])) {
+            overflow = true;
+            break;
+        }
+        uint64_t span = (shape[dim] - 1) * famStrides[dim];
+        if (span > UINT64_MAX - last) {
+            overflow = true;
+            break;
+        }
+        last += span;
+    }
+    if (overflow || (last > UINT64_MAX / elementSize - 1) ||
+        (offset > itemSize) ||
+        ((last + 1) * elementSize > itemSize - offset)) {
+        throw Fam_Datapath_Exception(FAM_ERR_OUTOFRANGE,
+                                     "Subarray is beyond dataitem");
+    }
+}
+
+/*
+ * Check that all the records of an iovec transfer lie within the data item,
+ * once the size of the data item is known.
+ */
+void fam::Impl_::validate_iov_extent(Fam_Descriptor *descriptor,
+                                     const struct iovec *localIov,
+                                     const uint64_t *offsets, uint64_t nIov) {
+    uint64_t itemSize = descriptor->get_size();
+    for (uint64_t ndx = 0; ndx < nIov; ndx++) {
+        if ((offsets[ndx] > itemSize) ||
+            (localIov[ndx].iov_len > itemSize - offsets[ndx])) {
+            std::ostringstream message;
+            message << "Record " << ndx << " is beyond dataitem";
+            throw Fam_Datapath_Exception(FAM_ERR_OUTOFRANGE,
+                                         message.str().c_str());
+        }
+    }
+}
+
+/**
+ * Copy a subarray of up to FAM_SUBARRAY_MAX_DIMS dimensions from FAM to local
+ * memory, blocking while the copy is complete. Rows which are contiguous on
+ * both sides are transferred as a single run.
+ * @param local - pointer to local memory receiving the subarray
+ * @param descriptor - valid descriptor containing FAM reference
+ * @param offset - byte offset within the data item of the first element
+ * @param elementSize - size of the element in bytes
+ * @param nDims - number of dimensions of the subarray
+ * @param shape - number of elements along each dimension, outermost first
+ * @param famStrides - distance in elements between consecutive elements
+ * along each dimension in FAM
+ * @param localStrides - distance in elements between consecutive elements
+ * along each dimension in local memory; NULL if the subarray is packed
+ * @return - 0 for normal completion, 1 in case of unsuccessful completion,
+ * negative number in case errors
+ * @throws Fam_Datapath_Exception - if the subarray is beyond the data item
+ */
+int fam::Impl_::fam_get_subarray(void *local, Fam_Descriptor *descriptor,
+                                 uint64_t offset, uint64_t elementSize,
+                                 uint64_t nDims, const uint64_t *shape,
+                                 const uint64_t *famStrides,
+                                 const uint64_t *localStrides) {
+    FAM_CNTR_INC_API(fam_get_subarray);
+    FAM_PROFILE_START_ALLOCATOR(fam_get_subarray);
+    validate_subarray(local, descriptor, elementSize, nDims, shape,
+                      famStrides);
+
+    int ret = validate_item(descriptor);
+    validate_subarray_extent(descriptor, offset, elementSize, nDims, shape,
+                             famStrides);
+    FAM_PROFILE_END_ALLOCATOR(fam_get_subarray);
+    FAM_PROFILE_START_OPS(fam_get_subarray);
+    if (ret == 0) {
+        std::vector<struct iovec> iov;
+        std::vector<uint64_t> offsets;
+        fam_subarray_runs(local, offset, elementSize, nDims, shape, famStrides,
+                          localStrides, &iov, &offsets);
+        ret = famOps->get_iov_blocking(descriptor, iov.data(), offsets.data(),
+                                       iov.size());
+    }
+    FAM_PROFILE_END_OPS(fam_get_subarray);
+    return ret;
+}
+
+/**
+ * Copy a subarray of up to FAM_SUBARRAY_MAX_DIMS dimensions from local memory
+ * to FAM, blocking while the copy is complete. Rows which are contiguous on
+ * both sides are transferred as a single run.
+ * @param local - pointer to local memory containing the subarray
+ * @param descriptor - valid descriptor containing FAM reference
+ * @param offset - byte offset within the data item of the first element
+ * @param elementSize - size of the element in bytes
+ * @param nDims - number of dimensions of the subarray
+ * @param shape - number of elements along each dimension, outermost first
+ * @param famStrides - distance in elements between consecutive elements
+ * along each dimension in FAM
+ * @param localStrides - distance in elements between consecutive elements
+ * along each dimension in local memory; NULL if the subarray is packed
+ * @return - 0 for normal completion, 1 in case of unsuccessful completion,
+ * negative number in case errors
+ * @throws Fam_Datapath_Exception - if the subarray is beyond the data item
+ */
+int fam::Impl_::fam_put_subarray(void *local, Fam_Descriptor *descriptor,
+                                 uint64_t offset, uint64_t elementSize,
+                                 uint64_t nDims, const uint64_t *shape,
+                                 const uint64_t *famStrides,
+                                 const uint64_t *localStrides) {
+    FAM_CNTR_INC_API(fam_put_subarray);
+    FAM_PROFILE_START_ALLOCATOR(fam_put_subarray);
+    validate_subarray(local, descriptor, elementSize, nDims, shape,
+                      famStrides);
+
+    int ret = validate_item(descriptor);
+    validate_subarray_extent(descriptor, offset, elementSize, nDims, shape,
+                             famStrides);
+    FAM_PROFILE_END_ALLOCATOR(fam_put_subarray);
+    FAM_PROFILE_START_OPS(fam_put_subarray);
+    if (ret == 0) {
+        std::vector<struct iovec> iov;
+        std::vector<uint64_t> offsets;
+        fam_subarray_runs(local, offset, elementSize, nDims, shape, famStrides,
+                          localStrides, &iov, &offsets);
+        ret = famOps->put_iov_blocking(descriptor, iov.data(), offsets.data(),
+                                       iov.size());
+    }
+    FAM_PROFILE_END_OPS(fam_put_subarray);
+    return ret;
+}
+
+/**
+ * Copy variable-length records of a data item from FAM to local buffers,
+ * blocking while the copy is complete.
+ * @param localIov - local buffers receiving the records
+ * @param descriptor - valid descriptor containing FAM reference
+ * @param offsets - byte offsets of the records within the data item
+ * @param nIov - number of records
+ * @return - 0 for normal completion, 1 in case of unsuccessful completion,
+ * negative number in case errors
+ */
+int fam::Impl_::fam_gather_iov_blocking(struct iovec *localIov,
+                                        Fam_Descriptor *descriptor,
+                                        uint64_t *offsets, uint64_t nIov) {
+    FAM_CNTR_INC_API(fam_gather_iov_blocking);
+    FAM_PROFILE_START_ALLOCATOR(fam_gather_iov_blocking);
+    if ((localIov == NULL) || (descriptor == NULL) || (offsets == NULL) ||
+        (nIov == 0)) {
+        throw Fam_InvalidOption_Exception("Invalid Options");
+    }
+
+    int ret = validate_item(descriptor);
+    validate_iov_extent(descriptor, localIov, offsets, nIov);
+    FAM_PROFILE_END_ALLOCATOR(fam_gather_iov_blocking);
+    FAM_PROFILE_START_OPS(fam_gather_iov_blocking);
+    if (ret == 0) {
+        ret = famOps->get_iov_blocking(descriptor, localIov, offsets, nIov);
+    }
+    FAM_PROFILE_END_OPS(fam_gather_iov_blocking);
+    return ret;
+}
+
+/**
+ * Initiate a copy of variable-length records of a data item from FAM to local
+ * buffers, return before completion.
+ * @param localIov - local buffers receiving the records
+ * @param descriptor - valid descriptor containing FAM reference
+ * @param offsets - byte offsets of the records within the data item
+ * @param nIov - number of records
+ */
+void fam::Impl_::fam_gather_iov_nonblocking(struct iovec *localIov,
+                                            Fam_Descriptor *descriptor,
+                                            uint64_t *offsets, uint64_t nIov) {
+    FAM_CNTR_INC_API(fam_gather_iov_nonblocking);
+    FAM_PROFILE_START_ALLOCATOR(fam_gather_iov_nonblocking);
+    if ((localIov == NULL) || (descriptor == NULL) || (offsets == NULL) ||
+        (nIov == 0)) {
+        throw Fam_InvalidOption_Exception("Invalid Options");
+    }
+
+    int ret = validate_item(descriptor);
+    validate_iov_extent(descriptor, localIov, offsets, nIov);
+    FAM_PROFILE_END_ALLOCATOR(fam_gather_iov_nonblocking);
+    FAM_PROFILE_START_OPS(fam_gather_iov_nonblocking);
+    if (ret == 0) {
+        famOps->get_iov_nonblocking(descriptor, localIov, offsets, nIov);
+    }
+    FAM_PROFILE_END_OPS(fam_gather_iov_nonblocking);
+    return;
+}
+
+/**
+ * Copy variable-length records of a data item from local buffers to FAM,
+ * blocking while the copy is complete.
+ * @param localIov - local buffers containing the records
+ * @param descriptor - valid descriptor containing FAM reference
+ * @param offsets - byte offsets of the records within the data item
+ * @param nIov - number of records
+ * @return - 0 for normal completion, 1 in case of unsuccessful completion,
+ * negative number in case errors
+ */
+int fam::Impl_::fam_scatter_iov_blocking(struct iovec *localIov,
+                                         Fam_Descriptor *descriptor,
+                                         uint64_t *offsets, uint64_t nIov) {
+    FAM_CNTR_INC_API(fam_scatter_iov_blocking);
+    FAM_PROFILE_START_ALLOCATOR(fam_scatter_iov_blocking);
+    if ((localIov == NULL) || (descriptor == NULL) || (offsets == NULL) ||
+        (nIov == 0)) {
+        throw Fam_InvalidOption_Exception("Invalid Options");
+    }
+
+    int ret = validate_item(descriptor);
+    validate_iov_extent(descriptor, localIov, offsets, nIov);
+    FAM_PROFILE_END_ALLOCATOR(fam_scatter_iov_blocking);
+    FAM_PROFILE_START_OPS(fam_scatter_iov_blocking);
+    if (ret == 0) {
+        ret = famOps->put_iov_blocking(descriptor, localIov, offsets, nIov);
+    }
+    FAM_PROFILE_END_OPS(fam_scatter_iov_blocking);
+    return ret;
+}
+
+/**
+ * Initiate a copy of variable-length records of a data item from local
+ * buffers to FAM, return before completion.
+ * @param localIov - local buffers containing the records
+ * @param descriptor - valid descriptor containing FAM reference
+ * @param offsets - byte offsets of the records within the data item
+ * @param nIov - number of records
+ */
+void fam::Impl_::fam_scatter_iov_nonblocking(struct iovec *localIov,
+                                             Fam_Descriptor *descriptor,
+                                             uint64_t *offsets, uint64_t nIov) {
+    FAM_CNTR_INC_API(fam_scatter_iov_nonblocking);
+    FAM_PROFILE_START_ALLOCATOR(fam_scatter_iov_nonblocking);
+    if ((localIov == NULL) || (descriptor == NULL) || (offsets == NULL) ||
+        (nIov == 0)) {
+        throw Fam_InvalidOption_Exception("Invalid Options");
+    }
+
+    int ret = validate_item(descriptor);
+    validate_iov_extent(descriptor, localIov, offsets, nIov);
+    FAM_PROFILE_END_ALLOCATOR(fam_scatter_iov_nonblocking);
+    FAM_PROFILE_START_OPS(fam_scatter_iov_nonblocking);
+    if (ret == 0) {
+        famOps->put_iov_nonblocking(descriptor, localIov, offsets, nIov);
+    }
+    FAM_PROFILE_END_OPS(fam_scatter_iov_nonblocking);
+    return;
+}
+
 // COPY Subgroup
 
 /**
@@ -1718,6 +3063,39 @@ void *fam::Impl_::fam_copy(Fam_Descriptor *src, uint64_t srcOffset,
     return result;
 }
 
+/**
+ * Copy data from one FAM-resident data item into an existing data item,
+ * possibly held by another memory server.
+ * @param src - valid descriptor to source data item in FAM.
+ * @param srcOffset - byte offset within the space defined by the src descriptor
+ * from which memory should be copied.
+ * @param dest - valid descriptor to the existing destination data item.
+ * @param destOffset - byte offset within the space defined by the dest
+ * descriptor to which memory should be copied.
+ * @param nbytes - number of bytes to be copied
+ */
+void *fam::Impl_::fam_copy(Fam_Descriptor *src, uint64_t srcOffset,
+                           Fam_Descriptor *dest, uint64_t destOffset,
+                           uint64_t nbytes) {
+    void *result = NULL;
+    FAM_CNTR_INC_API(fam_copy);
+    FAM_PROFILE_START_ALLOCATOR(fam_copy);
+    if ((src == NULL) || (dest == NULL) || (nbytes == 0)) {
+        throw Fam_InvalidOption_Exception("Invalid Options");
+    }
+
+    int ret = validate_item(src);
+    if (ret == 0)
+        ret = validate_item(dest);
+    FAM_PROFILE_END_ALLOCATOR(fam_copy);
+    FAM_PROFILE_START_OPS(fam_copy);
+    if (ret == 0) {
+        result = famOps->copy(src, srcOffset, dest, destOffset, nbytes);
+    }
+    FAM_PROFILE_END_OPS(fam_copy);
+    return result;
+}
+
 void fam::Impl_::fam_copy_wait(void *waitObj) {
     FAM_CNTR_INC_API(fam_copy_wait);
     FAM_PROFILE_START_ALLOCATOR(fam_copy_wait);
@@ -1730,6 +3108,338 @@ void fam::Impl_::fam_copy_wait(void *waitObj) {
     return;
 }
 
+/**
+ * Set a range of a data item in FAM to a byte value on the memory server.
+ * @param descriptor - valid descriptor to data item in FAM
+ * @param offset - byte offset within the data item of the range
+ * @param value - value of the bytes, converted to unsigned char
+ * @param nbytes - size of the range
+ * @return - wait object to pass to fam_fill_wait()
+ */
+void *fam::Impl_::fam_memset(Fam_Descriptor *descriptor, uint64_t offset,
+                             int value, uint64_t nbytes) {
+    FAM_CNTR_INC_API(fam_memset);
+    FAM_PROFILE_START_ALLOCATOR(fam_memset);
+    if (descriptor == NULL) {
+        throw Fam_InvalidOption_Exception("Invalid Options");
+    }
+
+    int ret = validate_item(descriptor);
+    FAM_PROFILE_END_ALLOCATOR(fam_memset);
+    FAM_PROFILE_START_OPS(fam_memset);
+    void *result = NULL;
+    if (ret == 0) {
+        result = famOps->fill(descriptor, offset, nbytes,
+                              (uint64_t)(unsigned char)value, 1);
+    }
+    FAM_PROFILE_END_OPS(fam_memset);
+    return result;
+}
+
+/**
+ * Set consecutive elements of a data item in FAM to a value on the memory
+ * server.
+ * @param descriptor - valid descriptor to data item in FAM
+ * @param offset - byte offset within the data item of the first element
+ * @param value - pointer to the value the elements are set to
+ * @param elementSize - size of the element in bytes, 1, 2, 4 or 8
+ * @param nElements - number of elements
+ * @return - wait object to pass to fam_fill_wait()
+ */
+void *fam::Impl_::fam_fill(Fam_Descriptor *descriptor, uint64_t offset,
+                           const void *value, uint64_t elementSize,
+                           uint64_t nElements) {
+    FAM_CNTR_INC_API(fam_fill);
+    FAM_PROFILE_START_ALLOCATOR(fam_fill);
+    if ((descriptor == NULL) || (value == NULL)) {
+        throw Fam_InvalidOption_Exception("Invalid Options");
+    }
+    if ((elementSize == 0) || (sizeof(uint64_t) % elementSize) ||
+        (nElements > UINT64_MAX / elementSize)) {
+        throw Fam_InvalidOption_Exception("Invalid Options");
+    }
+
+    int ret = validate_item(descriptor);
+    FAM_PROFILE_END_ALLOCATOR(fam_fill);
+    FAM_PROFILE_START_OPS(fam_fill);
+    void *result = NULL;
+    if (ret == 0) {
+        uint64_t pattern = 0;
+        memcpy(&pattern, value, elementSize);
+        result = famOps->fill(descriptor, offset, nElements * elementSize,
+                              pattern, elementSize);
+    }
+    FAM_PROFILE_END_OPS(fam_fill);
+    return result;
+}
+
+void fam::Impl_::fam_fill_wait(void *waitObj) {
+    FAM_CNTR_INC_API(fam_fill_wait);
+    FAM_PROFILE_START_ALLOCATOR(fam_fill_wait);
+    if (waitObj == NULL) {
+        throw Fam_InvalidOption_Exception("Invalid Options");
+    }
+
+    famOps->wait_for_copy(waitObj);
+    FAM_PROFILE_END_ALLOCATOR(fam_fill_wait);
+    return;
+}
+
+/**
+ * Reduce consecutive elements of a data item on the memory server.
+ * @param descriptor - valid descriptor to data item in FAM
+ * @param offset - byte offset within the data item of the first element
+ * @param nElements - number of elements, at least one
+ * @param type - data type of the elements
+ * @param op - reduction operation
+ * @param result - receives the result
+ */
+void fam::Impl_::fam_reduce_item(Fam_Descriptor *descriptor, uint64_t offset,
+                                 uint64_t nElements, Fam_Type type,
+                                 Fam_Reduce_Op op, void *result) {
+    std::ostringstream message;
+    FAM_CNTR_INC_API(fam_reduce_item);
+    FAM_PROFILE_START_ALLOCATOR(fam_reduce_item);
+    if ((descriptor == NULL) || (result == NULL) || (nElements == 0)) {
+        throw Fam_InvalidOption_Exception("Invalid Options");
+    }
+    size_t resultSize = fam_reduce_result_size(type, op);
+    if (resultSize == 0) {
+        message << "Invalid data type or reduction operation: " << type
+                << ", " << op;
+        throw Fam_InvalidOption_Exception(message.str().c_str());
+    }
+
+    int ret = validate_item(descriptor);
+    if (ret == 0) {
+        uint64_t value =
+            famAllocator->reduce_item(descriptor, offset, nElements, type, op);
+        memcpy(result, &value, resultSize);
+    }
+    FAM_PROFILE_END_ALLOCATOR(fam_reduce_item);
+    return;
+}
+
+/*
+ * Check the arguments of a scan, and build its query.
+ * Returns the size of a record of the result.
+ */
+uint64_t fam::Impl_::validate_scan(Fam_Descriptor *descriptor,
+                                   uint64_t recordSize, uint64_t nRecords,
+                                   Fam_Scan_Predicate *predicates,
+                                   uint64_t nPredicates,
+                                   Fam_Scan_Column *columns, uint64_t nColumns,
+                                   Fam_Scan_Query &query) {
+    if ((descriptor == NULL) || (recordSize == 0) ||
+        ((predicates == NULL) && (nPredicates != 0)) ||
+        ((columns == NULL) && (nColumns != 0))) {
+        throw Fam_InvalidOption_Exception("Invalid Options");
+    }
+
+    query.recordSize = recordSize;
+    query.nRecords = nRecords;
+    query.predicates.assign(predicates, predicates + nPredicates);
+    query.columns.assign(columns, columns + nColumns);
+    uint64_t resultSize = fam_scan_result_size(query);
+    if (resultSize == 0) {
+        throw Fam_InvalidOption_Exception("Invalid scan predicate or column");
+    }
+    return resultSize;
+}
+
+/**
+ * Scan fixed-size records of a data item on the memory server, and copy the
+ * matching records into a local buffer. Results larger than
+ * FAM_SCAN_MAX_RESPONSE are fetched with several requests, each resuming
+ * after the last record scanned by the previous one.
+ * @return - number of records copied into the buffer
+ */
+uint64_t fam::Impl_::fam_scan(Fam_Descriptor *descriptor, uint64_t offset,
+                              uint64_t recordSize, uint64_t nRecords,
+                              Fam_Scan_Predicate *predicates,
+                              uint64_t nPredicates, Fam_Scan_Column *columns,
+                              uint64_t nColumns, void *local,
+                              uint64_t localSize, uint64_t *nScanned) {
+    FAM_CNTR_INC_API(fam_scan);
+    FAM_PROFILE_START_ALLOCATOR(fam_scan);
+    Fam_Scan_Query query;
+    uint64_t resultSize =
+        validate_scan(descriptor, recordSize, nRecords, predicates,
+                      nPredicates, columns, nColumns, query);
+    if ((local == NULL) || (resultSize > FAM_SCAN_MAX_RESPONSE)) {
+        throw Fam_InvalidOption_Exception("Invalid Options");
+    }
+
+    int ret = validate_item(descriptor);
+    uint64_t nMatched = 0;
+    uint64_t scanned = 0;
+    while ((ret == 0) && (scanned < nRecords)) {
+        uint64_t size = std::min(localSize - nMatched * resultSize,
+                                 (uint64_t)FAM_SCAN_MAX_RESPONSE);
+        if (size < resultSize)
+            break;
+        uint64_t chunkScanned = 0;
+        query.nRecords = nRecords - scanned;
+        nMatched += famAllocator->scan(
+            descriptor, offset + scanned * recordSize, query,
+            (char *)local + nMatched * resultSize, size, &chunkScanned);
+        scanned += chunkScanned;
+    }
+    if (nScanned != NULL)
+        *nScanned = scanned;
+    FAM_PROFILE_END_ALLOCATOR(fam_scan);
+    return nMatched;
+}
+
+/**
+ * Scan fixed-size records of a data item on the memory server, and copy the
+ * matching records into another data item held by the same memory server.
+ * @return - number of records copied into dest
+ */
+uint64_t fam::Impl_::fam_scan_to_item(
+    Fam_Descriptor *descriptor, uint64_t offset, uint64_t recordSize,
+    uint64_t nRecords, Fam_Scan_Predicate *predicates, uint64_t nPredicates,
+    Fam_Scan_Column *columns, uint64_t nColumns, Fam_Descriptor *dest,
+    uint64_t destOffset, uint64_t destSize, uint64_t *nScanned) {
+    FAM_CNTR_INC_API(fam_scan_to_item);
+    FAM_PROFILE_START_ALLOCATOR(fam_scan_to_item);
+    Fam_Scan_Query query;
+    validate_scan(descriptor, recordSize, nRecords, predicates, nPredicates,
+                  columns, nColumns, query);
+    if (dest == NULL) {
+        throw Fam_InvalidOption_Exception("Invalid Options");
+    }
+
+    int ret = validate_item(descriptor);
+    if (ret == 0)
+        ret = validate_item(dest);
+    if (dest->get_memserver_id() != descriptor->get_memserver_id()) {
+        throw Fam_InvalidOption_Exception(
+            "Destination is not on the memory server of the source");
+    }
+    uint64_t nMatched = 0;
+    uint64_t scanned = 0;
+    if (ret == 0) {
+        nMatched =
+            famAllocator->scan_to_item(descriptor, offset, query, dest,
+                                       destOffset, destSize, &scanned);
+    }
+    if (nScanned != NULL)
+        *nScanned = scanned;
+    FAM_PROFILE_END_ALLOCATOR(fam_scan_to_item);
+    return nMatched;
+}
+
+/**
+ * Compute a digest of a range of a data item on the memory server.
+ * @param descriptor - valid descriptor to data item in FAM
+ * @param offset - byte offset within the data item of the range
+ * @param nbytes - size of the range
+ * @param algo - digest algorithm
+ * @return - digest of the range
+ */
+uint64_t fam::Impl_::fam_checksum(Fam_Descriptor *descriptor, uint64_t offset,
+                                  uint64_t nbytes, Fam_Checksum_Algo algo) {
+    FAM_CNTR_INC_API(fam_checksum);
+    FAM_PROFILE_START_ALLOCATOR(fam_checksum);
+    if ((descriptor == NULL) ||
+        ((algo != FAM_CHECKSUM_CRC32C) && (algo != FAM_CHECKSUM_XXH64))) {
+        throw Fam_InvalidOption_Exception("Invalid Options");
+    }
+
+    int ret = validate_item(descriptor);
+    uint64_t digest = 0;
+    if (ret == 0) {
+        digest = famAllocator->checksum(descriptor, offset, nbytes, algo);
+    }
+    FAM_PROFILE_END_ALLOCATOR(fam_checksum);
+    return digest;
+}
+
+/*
+ * Check whether the XXH64 digests of the same range of two data items differ.
+ * Both memory servers compute their digest concurrently.
+ */
+bool fam::Impl_::checksums_differ(Fam_Descriptor *a, Fam_Descriptor *b,
+                                  uint64_t start, uint64_t nbytes) {
+    std::future<uint64_t> otherDigest =
+        std::async(std::launch::async, &Fam_Allocator::checksum, famAllocator,
+                   b, start, nbytes, FAM_CHECKSUM_XXH64);
+    uint64_t digest =
+        famAllocator->checksum(a, start, nbytes, FAM_CHECKSUM_XXH64);
+    return digest != otherDigest.get();
+}
+
+/*
+ * Compare the first nbytes of two data items held by different memory
+ * servers. While the digests of a range differ, it is halved, keeping the
+ * half holding the first difference, so only a range of at most
+ * FAM_COMPARE_LOCAL_SIZE bytes of each item is read.
+ */
+bool fam::Impl_::compare_digests(Fam_Descriptor *a, Fam_Descriptor *b,
+                                 uint64_t nbytes, uint64_t *diffOffset) {
+    if (!checksums_differ(a, b, 0, nbytes))
+        return true;
+
+    uint64_t start = 0;
+    uint64_t size = nbytes;
+    while (size > FAM_COMPARE_LOCAL_SIZE) {
+        uint64_t half = size / 2;
+        if (checksums_differ(a, b, start, half)) {
+            size = half;
+        } else {
+            start += half;
+            size -= half;
+        }
+    }
+
+    std::vector<char> localA(size), localB(size);
+    famOps->get_blocking(localA.data(), a, start, size);
+    famOps->get_blocking(localB.data(), b, start, size);
+    if (fam_compare_local(localA.data(), localB.data(), size, diffOffset))
+        return true;
+    *diffOffset += start;
+    return false;
+}
+
+/**
+ * Compare the contents of two data items on the memory server(s). Items held
+ * by the same memory server are compared there; otherwise the memory servers
+ * only exchange digests until the differing range is small.
+ * @return - true if the items have the same size and contents
+ */
+bool fam::Impl_::fam_compare_items(Fam_Descriptor *a, Fam_Descriptor *b,
+                                   uint64_t *diffOffset) {
+    FAM_CNTR_INC_API(fam_compare_items);
+    FAM_PROFILE_START_ALLOCATOR(fam_compare_items);
+    if ((a == NULL) || (b == NULL)) {
+        throw Fam_InvalidOption_Exception("Invalid Options");
+    }
+
+    int ret = validate_item(a);
+    if (ret == 0)
+        ret = validate_item(b);
+    bool equal = false;
+    uint64_t diff = 0;
+    if (ret == 0) {
+        uint64_t nbytes = std::min(a->get_size(), b->get_size());
+        if (nbytes == 0)
+            equal = true;
+        else if (a->get_memserver_id() == b->get_memserver_id())
+            equal = famAllocator->compare(a, 0, b, 0, nbytes, &diff);
+        else
+            equal = compare_digests(a, b, nbytes, &diff);
+        if (equal && (a->get_size() != b->get_size())) {
+            equal = false;
+            diff = nbytes;
+        }
+    }
+    if (!equal && (diffOffset != NULL))
+        *diffOffset = diff;
+    FAM_PROFILE_END_ALLOCATOR(fam_compare_items);
+    return equal;
+}
+
 // ATOMICS Group
 
 // NON fetching routines
@@ -3590,25 +5300,246 @@ uint64_t fam::Impl_::fam_fetch_xor(Fam_Descriptor *descriptor, uint64_t offset,
  * issued by the calling thread after the fence Note that method this does NOT
  * order load/store accesses by the processor to FAM enabled by fam_map().
  */
-void fam::Impl_::fam_fence(Fam_Region_Descriptor *descriptor) {
-    FAM_CNTR_INC_API(fam_fence);
-    FAM_PROFILE_START_OPS(fam_fence);
-    famOps->fence(descriptor);
-    FAM_PROFILE_END_OPS(fam_fence);
-    return;
+void fam::Impl_::fam_fence(Fam_Region_Descriptor *descriptor) {
+    FAM_CNTR_INC_API(fam_fence);
+    FAM_PROFILE_START_OPS(fam_fence);
+    famOps->fence(descriptor);
+    FAM_PROFILE_END_OPS(fam_fence);
+    return;
+}
+
+/**
+ * fam_quiet - blocks the calling PE thread until all its pending FAM operations
+ * (put, scatter, atomics, copy) are completed. Note that method this does NOT
+ * order or wait for completion of load/store accesses by the processor to FAM
+ * enabled by fam_map().
+ */
+void fam::Impl_::fam_quiet(Fam_Region_Descriptor *descriptor) {
+    FAM_CNTR_INC_API(fam_quiet);
+    FAM_PROFILE_START_OPS(fam_quiet);
+    famOps->quiet(descriptor);
+    FAM_PROFILE_END_OPS(fam_quiet);
+    return;
+}
+
+void fam::Impl_::validate_wait(Fam_Descriptor *descriptor, Fam_Cmp cmp) {
+    std::ostringstream message;
+    if (descriptor == NULL) {
+        throw Fam_InvalidOption_Exception("Invalid Options");
+    }
+    if ((cmp < FAM_CMP_EQ) || (cmp > FAM_CMP_LE)) {
+        message << "Invalid comparison: " << cmp;
+        throw Fam_InvalidOption_Exception(message.str().c_str());
+    }
+}
+
+/*
+ * Wait on a single word. With the SERVER wait mode the memory server watches
+ * the word, and is asked again each time it replies without the condition
+ * being met. Otherwise the word is polled with exponential backoff.
+ */
+uint64_t fam::Impl_::wait_word(Fam_Descriptor *descriptor, uint64_t offset,
+                               Fam_Cmp cmp, uint64_t value) {
+    uint64_t current = 0;
+    if (strcmp(famOptions.waitMode, FAM_OPTIONS_WAIT_SERVER_STR) == 0) {
+        while (!famAllocator->wait_until(descriptor, offset, cmp, value,
+                                         FAM_WAIT_SERVER_TIMEOUT, &current))
+            ;
+        return current;
+    }
+
+    uint64_t delay = FAM_WAIT_MIN_BACKOFF;
+    while (true) {
+        current = famOps->atomic_fetch_uint64(descriptor, offset);
+        if (fam_wait_satisfied(current, cmp, value))
+            return current;
+        fam_wait_backoff(&delay);
+    }
+}
+
+/**
+ * Wait until a 64-bit word in FAM compares to a value as requested.
+ * @param descriptor - valid descriptor to data item in FAM
+ * @param offset - byte offset within the data item of the word
+ * @param cmp - comparison of the word to the value
+ * @param value - value the word is compared to
+ * @return - value of the word which satisfied the condition
+ * @throws Fam_InvalidOption_Exception - if cmp is not supported
+ */
+uint64_t fam::Impl_::fam_wait_until(Fam_Descriptor *descriptor,
+                                    uint64_t offset, Fam_Cmp cmp,
+                                    uint64_t value) {
+    FAM_CNTR_INC_API(fam_wait_until);
+    FAM_PROFILE_START_ALLOCATOR(fam_wait_until);
+    validate_wait(descriptor, cmp);
+    int ret = validate_item(descriptor);
+    FAM_PROFILE_END_ALLOCATOR(fam_wait_until);
+
+    FAM_PROFILE_START_OPS(fam_wait_until);
+    uint64_t current = 0;
+    if (ret == 0) {
+        current = wait_word(descriptor, offset, cmp, value);
+    }
+    FAM_PROFILE_END_OPS(fam_wait_until);
+    return current;
+}
+
+/**
+ * Wait until any of several 64-bit words in a data item compares to a value
+ * as requested. The words are polled in turn, backing off after each pass in
+ * which none of them met the condition.
+ * @param descriptor - valid descriptor to data item in FAM
+ * @param offsets - byte offsets within the data item of the words
+ * @param nOffsets - number of words
+ * @param cmp - comparison of the words to the value
+ * @param value - value the words are compared to
+ * @return - index in offsets of a word which satisfied the condition
+ * @throws Fam_InvalidOption_Exception - if cmp is not supported
+ */
+uint64_t fam::Impl_::fam_wait_until_any(Fam_Descriptor *descriptor,
+                                        const uint64_t *offsets,
+                                        uint64_t nOffsets, Fam_Cmp cmp,
+                                        uint64_t value) {
+    FAM_CNTR_INC_API(fam_wait_until_any);
+    FAM_PROFILE_START_ALLOCATOR(fam_wait_until_any);
+    validate_wait(descriptor, cmp);
+    if ((offsets == NULL) || (nOffsets == 0)) {
+        throw Fam_InvalidOption_Exception("Invalid Options");
+    }
+    int ret = validate_item(descriptor);
+    FAM_PROFILE_END_ALLOCATOR(fam_wait_until_any);
+
+    FAM_PROFILE_START_OPS(fam_wait_until_any);
+    uint64_t delay = FAM_WAIT_MIN_BACKOFF;
+    uint64_t found = 0;
+    while (ret == 0) {
+        for (found = 0; found < nOffsets; found++) {
+            uint64_t current =
+                famOps->atomic_fetch_uint64(descriptor, offsets[found]);
+            if (fam_wait_satisfied(current, cmp, value))
+                break;
+        }
+        if (found < nOffsets)
+            break;
+        fam_wait_backoff(&delay);
+    }
+    FAM_PROFILE_END_OPS(fam_wait_until_any);
+    return found;
+}
+
+/**
+ * Wait until all of several 64-bit words in a data item have compared to a
+ * value as requested. Words are not polled again once they met the condition.
+ * @param descriptor - valid descriptor to data item in FAM
+ * @param offsets - byte offsets within the data item of the words
+ * @param nOffsets - number of words
+ * @param cmp - comparison of the words to the value
+ * @param value - value the words are compared to
+ * @throws Fam_InvalidOption_Exception - if cmp is not supported
+ */
+void fam::Impl_::fam_wait_until_all(Fam_Descriptor *descriptor,
+                                    const uint64_t *offsets, uint64_t nOffsets,
+                                    Fam_Cmp cmp, uint64_t value) {
+    FAM_CNTR_INC_API(fam_wait_until_all);
+    FAM_PROFILE_START_ALLOCATOR(fam_wait_until_all);
+    validate_wait(descriptor, cmp);
+    if ((offsets == NULL) && (nOffsets != 0)) {
+        throw Fam_InvalidOption_Exception("Invalid Options");
+    }
+    int ret = validate_item(descriptor);
+    FAM_PROFILE_END_ALLOCATOR(fam_wait_until_all);
+
+    FAM_PROFILE_START_OPS(fam_wait_until_all);
+    if ((ret == 0) &&
+        (strcmp(famOptions.waitMode, FAM_OPTIONS_WAIT_SERVER_STR) == 0)) {
+        for (uint64_t ndx = 0; ndx < nOffsets; ndx++)
+            wait_word(descriptor, offsets[ndx], cmp, value);
+    } else if (ret == 0) {
+        std::vector<uint64_t> pending(offsets, offsets + nOffsets);
+        uint64_t delay = FAM_WAIT_MIN_BACKOFF;
+        while (!pending.empty()) {
+            size_t before = pending.size();
+            for (size_t ndx = 0; ndx < pending.size();) {
+                uint64_t current =
+                    famOps->atomic_fetch_uint64(descriptor, pending[ndx]);
+                if (fam_wait_satisfied(current, cmp, value)) {
+                    pending[ndx] = pending.back();
+                    pending.pop_back();
+                } else {
+                    ndx++;
+                }
+            }
+            if (pending.empty())
+                break;
+            // Poll eagerly again while words keep meeting the condition
+            if (pending.size() < before)
+                delay = FAM_WAIT_MIN_BACKOFF;
+            else
+                fam_wait_backoff(&delay);
+        }
+    }
+    FAM_PROFILE_END_OPS(fam_wait_until_all);
+    return;
+}
+
+/**
+ * Subscribe to the changes of a range of a data item.
+ * @param descriptor - valid descriptor to data item in FAM
+ * @param offset - byte offset within the data item of the range
+ * @param nbytes - size of the range
+ * @param interval - time in milliseconds between two checks of the range
+ * @return - watch to pass to fam_watch_next() and fam_unwatch()
+ * @throws Fam_InvalidOption_Exception - if the range is empty
+ */
+Fam_Watch *fam::Impl_::fam_watch(Fam_Descriptor *descriptor, uint64_t offset,
+                                 uint64_t nbytes, uint64_t interval) {
+    FAM_CNTR_INC_API(fam_watch);
+    FAM_PROFILE_START_ALLOCATOR(fam_watch);
+    if ((descriptor == NULL) || (nbytes == 0)) {
+        throw Fam_InvalidOption_Exception("Invalid Options");
+    }
+    validate_item(descriptor);
+    uint64_t itemSize = descriptor->get_size();
+    if ((offset > itemSize) || (nbytes > itemSize - offset)) {
+        throw Fam_Allocator_Exception(FAM_ERR_OUTOFRANGE,
+                                      "Watched range is beyond dataitem");
+    }
+    Fam_Watch *watch =
+        famAllocator->watch(descriptor, offset, nbytes, interval);
+    FAM_PROFILE_END_ALLOCATOR(fam_watch);
+    return watch;
+}
+
+/**
+ * Wait for the next change of a watched range.
+ * @param watch - watch returned by fam_watch()
+ * @param offset - set to the byte offset of the changed bytes
+ * @param nbytes - set to the size of the range covering the changed bytes
+ * @param timeout - time in milliseconds to wait for a change
+ * @return - true if a change was reported, false on timeout
+ * @throws Fam_InvalidOption_Exception - if watch is NULL
+ */
+bool fam::Impl_::fam_watch_next(Fam_Watch *watch, uint64_t *offset,
+                                uint64_t *nbytes, uint64_t timeout) {
+    FAM_CNTR_INC_API(fam_watch_next);
+    FAM_PROFILE_START_ALLOCATOR(fam_watch_next);
+    if ((watch == NULL) || (offset == NULL) || (nbytes == NULL)) {
+        throw Fam_InvalidOption_Exception("Invalid Options");
+    }
+    bool changed = watch->next(offset, nbytes, timeout);
+    FAM_PROFILE_END_ALLOCATOR(fam_watch_next);
+    return changed;
 }
 
 /**
- * fam_quiet - blocks the calling PE thread until all its pending FAM operations
- * (put, scatter, atomics, copy) are completed. Note that method this does NOT
- * order or wait for completion of load/store accesses by the processor to FAM
- * enabled by fam_map().
+ * Cancel a watch and release its resources.
+ * @param watch - watch returned by fam_watch()
  */
-void fam::Impl_::fam_quiet(Fam_Region_Descriptor *descriptor) {
-    FAM_CNTR_INC_API(fam_quiet);
-    FAM_PROFILE_START_OPS(fam_quiet);
-    famOps->quiet(descriptor);
-    FAM_PROFILE_END_OPS(fam_quiet);
+void fam::Impl_::fam_unwatch(Fam_Watch *watch) {
+    FAM_CNTR_INC_API(fam_unwatch);
+    FAM_PROFILE_START_ALLOCATOR(fam_unwatch);
+    delete watch;
+    FAM_PROFILE_END_ALLOCATOR(fam_unwatch);
     return;
 }
 
@@ -3651,6 +5582,53 @@ void fam::fam_abort(int status) { pimpl_->fam_abort(status); }
  */
 void fam::fam_barrier_all(void) { pimpl_->fam_barrier_all(); }
 
+/**
+ * Collective call which copies a buffer of the root PE into the buffer of
+ * every other PE.
+ * @param data - buffer holding the data on the root PE, and receiving it on
+ * other PEs
+ * @param nbytes - size of the buffer
+ * @param root - PE broadcasting the data
+ * @throws Fam_InvalidOption_Exception - if root is not a valid PE
+ */
+void fam::fam_broadcast(void *data, uint64_t nbytes, int root) {
+    pimpl_->fam_broadcast(data, nbytes, root);
+}
+
+/**
+ * Collective call which combines the elements of the source buffers of all
+ * PEs, and stores the result in the destination buffer of the root PE.
+ * @param dest - buffer receiving the result on the root PE
+ * @param src - buffer holding the elements of the calling PE
+ * @param nElements - number of elements in the buffers
+ * @param type - data type of the elements
+ * @param op - reduction operation
+ * @param root - PE receiving the result
+ * @throws Fam_InvalidOption_Exception - if root is not a valid PE, or type or
+ * op is not supported
+ * @see #fam_allreduce
+ */
+void fam::fam_reduce(void *dest, const void *src, uint64_t nElements,
+                     Fam_Type type, Fam_Reduce_Op op, int root) {
+    pimpl_->fam_reduce(dest, src, nElements, type, op, root);
+}
+
+/**
+ * Collective call which combines the elements of the source buffers of all
+ * PEs, and stores the result in the destination buffer of every PE.
+ * @param dest - buffer receiving the result
+ * @param src - buffer holding the elements of the calling PE
+ * @param nElements - number of elements in the buffers
+ * @param type - data type of the elements
+ * @param op - reduction operation
+ * @throws Fam_InvalidOption_Exception - if type or op is not supported
+ * @see #fam_reduce
+ */
+void fam::fam_allreduce(void *dest, const void *src, uint64_t nElements,
+                        Fam_Type type, Fam_Reduce_Op op) {
+    pimpl_->fam_allreduce(dest, src, nElements, type, op);
+}
+
 /**
  * List known options for this version of the library. Provides a way for
  * programs to check which options are known to the library.
@@ -3698,6 +5676,87 @@ Fam_Descriptor *fam::fam_lookup(const char *itemName, const char *regionName) {
     return pimpl_->fam_lookup(itemName, regionName);
 }
 
+/**
+ * look up multiple data items of a region in FAM by name in the name service.
+ * All the items are resolved with a single request to the memory server
+ * hosting the region.
+ * @param itemNames - array of names of the data items
+ * @param nItems - number of data items
+ * @param regionName - name of the region containing the data items
+ * @param descriptors - array of nItems, filled with descriptors to the data
+ * items
+ * @throws Fam_Allocator_Exception - excptObj->fam_error() may return:
+ *         FAM_ERR_NOPERM, FAM_ERR_NOTFOUND, FAM_ERR_GRPC
+ * @see #fam_lookup
+ */
+void fam::fam_lookup_batch(const char **itemNames, uint64_t nItems,
+                           const char *regionName,
+                           Fam_Descriptor **descriptors) {
+    pimpl_->fam_lookup_batch(itemNames, nItems, regionName, descriptors);
+}
+
+/**
+ * Resolve the access key and size of multiple data item descriptors ahead of
+ * their first use, with a single request per memory server. Descriptors
+ * which already hold a valid key are left unchanged.
+ * @param descriptors - array of data item descriptors
+ * @param nItems - number of descriptors
+ * @throws Fam_InvalidOption_Exception - if a descriptor has an invalid key
+ * @throws Fam_Allocator_Exception - excptObj->fam_error() may return:
+ *         FAM_ERR_NOPERM, FAM_ERR_NOTFOUND, FAM_ERR_GRPC
+ * @see #fam_lookup_batch
+ */
+void fam::fam_prepare(Fam_Descriptor **descriptors, uint64_t nItems) {
+    pimpl_->fam_prepare(descriptors, nItems);
+}
+
+/**
+ * Serialize a data item descriptor into a buffer, so that it can be sent to
+ * other PEs.
+ * @param descriptor - descriptor associated with some data item
+ * @param buffer - buffer of at least FAM_DESCRIPTOR_SERIALIZED_SIZE bytes
+ * @param len - on input the size of buffer, on return the number of bytes
+ * written
+ * @throws Fam_InvalidOption_Exception - if the buffer is too small
+ * @see #fam_descriptor_deserialize
+ */
+void fam::fam_descriptor_serialize(Fam_Descriptor *descriptor, void *buffer,
+                                   size_t *len) {
+    pimpl_->fam_descriptor_serialize(descriptor, buffer, len);
+}
+
+/**
+ * Create a data item descriptor from a buffer filled by
+ * fam_descriptor_serialize().
+ * @param buffer - serialized descriptor
+ * @param len - size of the serialized descriptor
+ * @return - data item descriptor
+ * @throws Fam_InvalidOption_Exception - if the buffer does not hold a
+ * serialized descriptor
+ * @see #fam_descriptor_serialize
+ */
+Fam_Descriptor *fam::fam_descriptor_deserialize(const void *buffer,
+                                                size_t len) {
+    return pimpl_->fam_descriptor_deserialize(buffer, len);
+}
+
+/**
+ * Collective call which broadcasts a data item descriptor from the root PE to
+ * all the PEs.
+ * @param root - PE holding the descriptor
+ * @param descriptor - descriptor associated with some data item on the root
+ * PE, ignored on other PEs
+ * @return - descriptor on the root PE, a new data item descriptor on other PEs
+ * @throws Fam_InvalidOption_Exception - if the runtime is NONE or root is not
+ * a valid PE
+ * @throws Fam_Pmi_Exception - if the runtime fails to exchange the descriptor
+ * @see #fam_descriptor_serialize
+ */
+Fam_Descriptor *fam::fam_broadcast_descriptor(int root,
+                                              Fam_Descriptor *descriptor) {
+    return pimpl_->fam_broadcast_descriptor(root, descriptor);
+}
+
 // ALLOCATION Group
 
 /**
@@ -3789,6 +5848,46 @@ void fam::fam_deallocate(Fam_Descriptor *descriptor) {
     pimpl_->fam_deallocate(descriptor);
 }
 
+/**
+ * Allocate multiple data items within a region, with a single request to the
+ * memory server holding the region. Either all the data items are allocated,
+ * or none of them.
+ * @param nItems - number of data items
+ * @param sizes - array of nItems sizes, in bytes
+ * @param names - (optional) array of nItems names of the data items; null,
+ * or null entries, for unnamed data items
+ * @param accessPermissions - permissions associated with the data items
+ * @param region - descriptor of the region within which the data items are
+ * allocated
+ * @param descriptors - array of nItems, filled with descriptors to the data
+ * items
+ * @throws Fam_InvalidOption_Exception - if an array argument is null
+ * @throws Fam_Allocator_Exception - exceptionObj->fam_error() may return:
+ *         FAM_ERR_NOPERM, FAM_ERR_ALREADYEXIST, FAM_ERR_GRPC
+ * @see #fam_deallocate_batch()
+ */
+void fam::fam_allocate_batch(uint64_t nItems, const uint64_t *sizes,
+                             const char **names, mode_t accessPermissions,
+                             Fam_Region_Descriptor *region,
+                             Fam_Descriptor **descriptors) {
+    pimpl_->fam_allocate_batch(nItems, sizes, names, accessPermissions, region,
+                               descriptors);
+}
+
+/**
+ * Deallocate multiple data items, with a single request per memory server.
+ * All the data items are processed before the first error is reported.
+ * @param descriptors - array of descriptors associated with the data items
+ * @param nItems - number of data items
+ * @throws Fam_InvalidOption_Exception - if descriptors is null
+ * @throws Fam_Allocator_Exception - exceptionObj->fam_error() may return:
+ *         FAM_ERR_NOPERM, FAM_ERR_NOTFOUND, FAM_ERR_GRPC
+ * @see #fam_allocate_batch()
+ */
+void fam::fam_deallocate_batch(Fam_Descriptor **descriptors, uint64_t nItems) {
+    pimpl_->fam_deallocate_batch(descriptors, nItems);
+}
+
 /**
  * Change permissions associated with a data item descriptor.
  * @param descriptor - descriptor associated with some data item
@@ -3921,6 +6020,34 @@ void fam::fam_put_nonblocking(void *local, Fam_Descriptor *descriptor,
     pimpl_->fam_put_nonblocking(local, descriptor, offset, nbytes);
 }
 
+/**
+ * Copy data from local memory to FAM and then update a signal word, so that a
+ * PE which observes the signal update also observes the data. Blocks until
+ * the data is written.
+ * @param local - pointer to local memory. Must point to valid data in local
+ * memory
+ * @param descriptor - valid descriptor in FAM
+ * @param offset - byte offset within the region defined by the descriptor to
+ * where data should be copied
+ * @param nbytes - number of bytes to be copied from local to FAM
+ * @param sigDescriptor - valid descriptor of the data item holding the signal
+ * word
+ * @param sigOffset - byte offset of the 64-bit signal word
+ * @param sigValue - value used to update the signal word
+ * @param op - update of the signal word, set or add
+ * @throws Fam_InvalidOption_Exception.
+ * @throws Fam_Datapath_Exception.
+ * @throws Fam_Allocator_Exception - exceptionObj->fam_error() may return:
+ *         FAM_ERR_NOPERM, FAM_ERR_NOTFOUND, FAM_ERR_GRPC
+ */
+void fam::fam_put_signal(void *local, Fam_Descriptor *descriptor,
+                         uint64_t offset, uint64_t nbytes,
+                         Fam_Descriptor *sigDescriptor, uint64_t sigOffset,
+                         uint64_t sigValue, Fam_Signal_Op op) {
+    pimpl_->fam_put_signal(local, descriptor, offset, nbytes, sigDescriptor,
+                           sigOffset, sigValue, op);
+}
+
 // LOAD/STORE sub-group
 
 /**
@@ -4166,6 +6293,131 @@ void fam::fam_scatter_nonblocking(void *local, Fam_Descriptor *descriptor,
                                     elementSize);
 }
 
+/**
+ * Copy a subarray of up to FAM_SUBARRAY_MAX_DIMS dimensions, e.g. a tile of
+ * a matrix, from FAM to local memory, blocking while the copy is complete.
+ * @param local - pointer to local memory receiving the subarray
+ * @param descriptor - valid descriptor containing FAM reference
+ * @param offset - byte offset within the data item of the first element
+ * @param elementSize - size of the element in bytes
+ * @param nDims - number of dimensions of the subarray
+ * @param shape - number of elements along each dimension, outermost first
+ * @param famStrides - distance in elements between consecutive elements
+ * along each dimension in FAM
+ * @param localStrides - distance in elements between consecutive elements
+ * along each dimension in local memory; NULL if the subarray is packed
+ * @return - 0 for normal completion, 1 in case of unsuccessful completion,
+ * negative number in case errors
+ * @throws Fam_InvalidOption_Exception.
+ * @throws Fam_Datapath_Exception.
+ * @see #fam_put_subarray
+ */
+int fam::fam_get_subarray(void *local, Fam_Descriptor *descriptor,
+                          uint64_t offset, uint64_t elementSize,
+                          uint64_t nDims, const uint64_t *shape,
+                          const uint64_t *famStrides,
+                          const uint64_t *localStrides) {
+    return pimpl_->fam_get_subarray(local, descriptor, offset, elementSize,
+                                    nDims, shape, famStrides, localStrides);
+}
+
+/**
+ * Copy a subarray of up to FAM_SUBARRAY_MAX_DIMS dimensions, e.g. a tile of
+ * a matrix, from local memory to FAM, blocking while the copy is complete.
+ * @param local - pointer to local memory containing the subarray
+ * @param descriptor - valid descriptor containing FAM reference
+ * @param offset - byte offset within the data item of the first element
+ * @param elementSize - size of the element in bytes
+ * @param nDims - number of dimensions of the subarray
+ * @param shape - number of elements along each dimension, outermost first
+ * @param famStrides - distance in elements between consecutive elements
+ * along each dimension in FAM
+ * @param localStrides - distance in elements between consecutive elements
+ * along each dimension in local memory; NULL if the subarray is packed
+ * @return - 0 for normal completion, 1 in case of unsuccessful completion,
+ * negative number in case errors
+ * @throws Fam_InvalidOption_Exception.
+ * @throws Fam_Datapath_Exception.
+ * @see #fam_get_subarray
+ */
+int fam::fam_put_subarray(void *local, Fam_Descriptor *descriptor,
+                          uint64_t offset, uint64_t elementSize,
+                          uint64_t nDims, const uint64_t *shape,
+                          const uint64_t *famStrides,
+                          const uint64_t *localStrides) {
+    return pimpl_->fam_put_subarray(local, descriptor, offset, elementSize,
+                                    nDims, shape, famStrides, localStrides);
+}
+
+/**
+ * Copy variable-length records of a data item from FAM to local buffers,
+ * blocking while the copy is complete.
+ * @param localIov - local buffers receiving the records
+ * @param descriptor - valid descriptor containing FAM reference
+ * @param offsets - byte offsets of the records within the data item
+ * @param nIov - number of records
+ * @return - 0 for normal completion, 1 in case of unsuccessful completion,
+ * negative number in case errors
+ * @throws Fam_InvalidOption_Exception.
+ * @throws Fam_Datapath_Exception.
+ */
+int fam::fam_gather_iov_blocking(struct iovec *localIov,
+                                 Fam_Descriptor *descriptor,
+                                 uint64_t *offsets, uint64_t nIov) {
+    return pimpl_->fam_gather_iov_blocking(localIov, descriptor, offsets, nIov);
+}
+
+/**
+ * Initiate a copy of variable-length records of a data item from FAM to local
+ * buffers, return before completion.
+ * @param localIov - local buffers receiving the records
+ * @param descriptor - valid descriptor containing FAM reference
+ * @param offsets - byte offsets of the records within the data item
+ * @param nIov - number of records
+ * @throws Fam_InvalidOption_Exception.
+ * @throws Fam_Datapath_Exception.
+ */
+void fam::fam_gather_iov_nonblocking(struct iovec *localIov,
+                                     Fam_Descriptor *descriptor,
+                                     uint64_t *offsets, uint64_t nIov) {
+    pimpl_->fam_gather_iov_nonblocking(localIov, descriptor, offsets, nIov);
+}
+
+/**
+ * Copy variable-length records of a data item from local buffers to FAM,
+ * blocking while the copy is complete.
+ * @param localIov - local buffers containing the records
+ * @param descriptor - valid descriptor containing FAM reference
+ * @param offsets - byte offsets of the records within the data item
+ * @param nIov - number of records
+ * @return - 0 for normal completion, 1 in case of unsuccessful completion,
+ * negative number in case errors
+ * @throws Fam_InvalidOption_Exception.
+ * @throws Fam_Datapath_Exception.
+ */
+int fam::fam_scatter_iov_blocking(struct iovec *localIov,
+                                  Fam_Descriptor *descriptor,
+                                  uint64_t *offsets, uint64_t nIov) {
+    return pimpl_->fam_scatter_iov_blocking(localIov, descriptor, offsets,
+                                            nIov);
+}
+
+/**
+ * Initiate a copy of variable-length records of a data item from local
+ * buffers to FAM, return before completion.
+ * @param localIov - local buffers containing the records
+ * @param descriptor - valid descriptor containing FAM reference
+ * @param offsets - byte offsets of the records within the data item
+ * @param nIov - number of records
+ * @throws Fam_InvalidOption_Exception.
+ * @throws Fam_Datapath_Exception.
+ */
+void fam::fam_scatter_iov_nonblocking(struct iovec *localIov,
+                                      Fam_Descriptor *descriptor,
+                                      uint64_t *offsets, uint64_t nIov) {
+    pimpl_->fam_scatter_iov_nonblocking(localIov, descriptor, offsets, nIov);
+}
+
 // COPY Subgroup
 
 /**
@@ -4188,8 +6440,232 @@ void *fam::fam_copy(Fam_Descriptor *src, uint64_t srcOffset,
     return pimpl_->fam_copy(src, srcOffset, dest, destOffset, nbytes);
 }
 
+/**
+ * Copy data from one FAM-resident data item into an existing data item. No
+ * data item is allocated, so repeated copies into the same destination, like
+ * double-buffered checkpoints, do not grow the heap. If the destination is
+ * held by another memory server, the memory server of the source writes the
+ * data to it directly, without going through the client. The memory server
+ * of the source must then be started with the list of memory servers.
+ * @param src - valid descriptor to source data item in FAM.
+ * @param srcOffset - byte offset within the space defined by the src descriptor
+ * from which memory should be copied.
+ * @param dest - valid descriptor to the existing destination data item.
+ * @param destOffset - byte offset within the space defined by the dest
+ * descriptor to which memory should be copied.
+ * @param nbytes - number of bytes to be copied
+ * @return - wait object of the copy, see fam_copy_wait()
+ * @throws Fam_InvalidOption_Exception.
+ * @throws Fam_Allocator_Exception - exceptionObj->fam_error() may return:
+ *         FAM_ERR_NOPERM, FAM_ERR_NOTFOUND, FAM_ERR_OUTOFRANGE, FAM_ERR_GRPC
+ */
+void *fam::fam_copy(Fam_Descriptor *src, uint64_t srcOffset,
+                    Fam_Descriptor *dest, uint64_t destOffset,
+                    uint64_t nbytes) {
+    return pimpl_->fam_copy(src, srcOffset, dest, destOffset, nbytes);
+}
+
 void fam::fam_copy_wait(void *waitObj) { pimpl_->fam_copy_wait(waitObj); }
 
+/**
+ * Set a range of a data item in FAM to a byte value. The memory server fills
+ * the range locally with non-temporal stores, so the bytes are not sent over
+ * the fabric.
+ * @param descriptor - valid descriptor to data item in FAM
+ * @param offset - byte offset within the data item of the range
+ * @param value - value of the bytes, converted to unsigned char
+ * @param nbytes - size of the range
+ * @return - wait object to pass to fam_fill_wait()
+ * @throws Fam_InvalidOption_Exception.
+ * @throws Fam_Allocator_Exception - exceptionObj->fam_error() may return:
+ *         FAM_ERR_NOPERM, FAM_ERR_NOTFOUND, FAM_ERR_OUTOFRANGE, FAM_ERR_GRPC
+ *         (reported by fam_fill_wait())
+ */
+void *fam::fam_memset(Fam_Descriptor *descriptor, uint64_t offset, int value,
+                      uint64_t nbytes) {
+    return pimpl_->fam_memset(descriptor, offset, value, nbytes);
+}
+
+/**
+ * Set consecutive elements of a data item in FAM to a value. The memory
+ * server fills the elements locally, so the data is not sent over the fabric.
+ * @param descriptor - valid descriptor to data item in FAM
+ * @param offset - byte offset within the data item of the first element
+ * @param value - value the elements are set to
+ * @param nElements - number of elements
+ * @return - wait object to pass to fam_fill_wait()
+ * @throws Fam_InvalidOption_Exception.
+ * @throws Fam_Allocator_Exception - exceptionObj->fam_error() may return:
+ *         FAM_ERR_NOPERM, FAM_ERR_NOTFOUND, FAM_ERR_OUTOFRANGE, FAM_ERR_GRPC
+ *         (reported by fam_fill_wait())
+ */
+void *fam::fam_fill(Fam_Descriptor *descriptor, uint64_t offset, int32_t value,
+                    uint64_t nElements) {
+    return pimpl_->fam_fill(descriptor, offset, &value, sizeof(value),
+                            nElements);
+}
+
+void *fam::fam_fill(Fam_Descriptor *descriptor, uint64_t offset, int64_t value,
+                    uint64_t nElements) {
+    return pimpl_->fam_fill(descriptor, offset, &value, sizeof(value),
+                            nElements);
+}
+
+void *fam::fam_fill(Fam_Descriptor *descriptor, uint64_t offset, uint32_t value,
+                    uint64_t nElements) {
+    return pimpl_->fam_fill(descriptor, offset, &value, sizeof(value),
+                            nElements);
+}
+
+void *fam::fam_fill(Fam_Descriptor *descriptor, uint64_t offset, uint64_t value,
+                    uint64_t nElements) {
+    return pimpl_->fam_fill(descriptor, offset, &value, sizeof(value),
+                            nElements);
+}
+
+void *fam::fam_fill(Fam_Descriptor *descriptor, uint64_t offset, float value,
+                    uint64_t nElements) {
+    return pimpl_->fam_fill(descriptor, offset, &value, sizeof(value),
+                            nElements);
+}
+
+void *fam::fam_fill(Fam_Descriptor *descriptor, uint64_t offset, double value,
+                    uint64_t nElements) {
+    return pimpl_->fam_fill(descriptor, offset, &value, sizeof(value),
+                            nElements);
+}
+
+/**
+ * Wait for a fam_memset() or fam_fill() to complete
+ * @param waitObj - wait object returned by fam_memset() or fam_fill()
+ * @throws Fam_InvalidOption_Exception.
+ * @throws Fam_Allocator_Exception.
+ */
+void fam::fam_fill_wait(void *waitObj) { pimpl_->fam_fill_wait(waitObj); }
+
+/**
+ * Reduce consecutive elements of a data item in FAM. The memory server runs
+ * the reduction over its local memory, with SIMD kernels where the CPU
+ * supports them, and only returns the result.
+ * @param descriptor - valid descriptor to data item in FAM
+ * @param offset - byte offset within the data item of the first element
+ * @param nElements - number of elements, at least one
+ * @param type - data type of the elements
+ * @param op - reduction operation
+ * @param result - receives the result, an element of the data type, or a
+ * double for FAM_REDUCE_NORM
+ * @throws Fam_InvalidOption_Exception - if type or op is not supported
+ * @throws Fam_Allocator_Exception - exceptionObj->fam_error() may return:
+ *         FAM_ERR_NOPERM, FAM_ERR_NOTFOUND, FAM_ERR_OUTOFRANGE, FAM_ERR_GRPC
+ */
+void fam::fam_reduce_item(Fam_Descriptor *descriptor, uint64_t offset,
+                          uint64_t nElements, Fam_Type type, Fam_Reduce_Op op,
+                          void *result) {
+    pimpl_->fam_reduce_item(descriptor, offset, nElements, type, op, result);
+}
+
+/**
+ * Scan fixed-size records of a data item in FAM on the memory server, and
+ * copy the records which satisfy all the predicates into a local buffer.
+ * Only the matching records cross the fabric.
+ * @param descriptor - valid descriptor to data item in FAM
+ * @param offset - byte offset within the data item of the first record
+ * @param recordSize - size of a record
+ * @param nRecords - number of records to scan
+ * @param predicates - array of predicates, may be NULL if nPredicates is 0
+ * @param nPredicates - number of predicates; with none all records match
+ * @param columns - array of columns, may be NULL if nColumns is 0
+ * @param nColumns - number of columns; with none whole records are copied
+ * @param local - buffer receiving the matching records
+ * @param localSize - size of the buffer
+ * @param nScanned - if not NULL, set to the number of records scanned,
+ * smaller than nRecords if the buffer filled up
+ * @return - number of records copied into the buffer
+ * @throws Fam_InvalidOption_Exception - if a predicate or column does not lie
+ * within a record, or uses an unknown type or comparison
+ * @throws Fam_Allocator_Exception - exceptionObj->fam_error() may return:
+ *         FAM_ERR_NOPERM, FAM_ERR_NOTFOUND, FAM_ERR_OUTOFRANGE, FAM_ERR_GRPC
+ */
+uint64_t fam::fam_scan(Fam_Descriptor *descriptor, uint64_t offset,
+                       uint64_t recordSize, uint64_t nRecords,
+                       Fam_Scan_Predicate *predicates, uint64_t nPredicates,
+                       Fam_Scan_Column *columns, uint64_t nColumns,
+                       void *local, uint64_t localSize, uint64_t *nScanned) {
+    return pimpl_->fam_scan(descriptor, offset, recordSize, nRecords,
+                            predicates, nPredicates, columns, nColumns, local,
+                            localSize, nScanned);
+}
+
+/**
+ * Scan fixed-size records of a data item in FAM on the memory server, and
+ * copy the records which satisfy all the predicates into another data item
+ * held by the same memory server. No record crosses the fabric.
+ * @param descriptor - valid descriptor to data item in FAM
+ * @param offset - byte offset within the data item of the first record
+ * @param recordSize - size of a record
+ * @param nRecords - number of records to scan
+ * @param predicates - array of predicates, may be NULL if nPredicates is 0
+ * @param nPredicates - number of predicates; with none all records match
+ * @param columns - array of columns, may be NULL if nColumns is 0
+ * @param nColumns - number of columns; with none whole records are copied
+ * @param dest - valid descriptor to the data item receiving the records
+ * @param destOffset - byte offset within dest of the first record
+ * @param destSize - size of the range of dest receiving the records
+ * @param nScanned - if not NULL, set to the number of records scanned,
+ * smaller than nRecords if the range filled up
+ * @return - number of records copied into dest
+ * @throws Fam_InvalidOption_Exception - if a predicate or column is not
+ * valid, or dest is held by another memory server
+ * @throws Fam_Allocator_Exception - exceptionObj->fam_error() may return:
+ *         FAM_ERR_NOPERM, FAM_ERR_NOTFOUND, FAM_ERR_OUTOFRANGE, FAM_ERR_GRPC
+ */
+uint64_t fam::fam_scan_to_item(Fam_Descriptor *descriptor, uint64_t offset,
+                               uint64_t recordSize, uint64_t nRecords,
+                               Fam_Scan_Predicate *predicates,
+                               uint64_t nPredicates, Fam_Scan_Column *columns,
+                               uint64_t nColumns, Fam_Descriptor *dest,
+                               uint64_t destOffset, uint64_t destSize,
+                               uint64_t *nScanned) {
+    return pimpl_->fam_scan_to_item(descriptor, offset, recordSize, nRecords,
+                                    predicates, nPredicates, columns,
+                                    nColumns, dest, destOffset, destSize,
+                                    nScanned);
+}
+
+/**
+ * Compute a digest of a range of a data item in FAM on the memory server,
+ * which only returns the digest.
+ * @param descriptor - valid descriptor to data item in FAM
+ * @param offset - byte offset within the data item of the range
+ * @param nbytes - size of the range
+ * @param algo - digest algorithm
+ * @return - digest of the range; a CRC32C is in the low-order 32 bits
+ * @throws Fam_InvalidOption_Exception - if algo is not supported
+ * @throws Fam_Allocator_Exception - exceptionObj->fam_error() may return:
+ *         FAM_ERR_NOPERM, FAM_ERR_NOTFOUND, FAM_ERR_OUTOFRANGE, FAM_ERR_GRPC
+ */
+uint64_t fam::fam_checksum(Fam_Descriptor *descriptor, uint64_t offset,
+                           uint64_t nbytes, Fam_Checksum_Algo algo) {
+    return pimpl_->fam_checksum(descriptor, offset, nbytes, algo);
+}
+
+/**
+ * Compare the contents of two data items in FAM on the memory server(s).
+ * @param a - valid descriptor to data item in FAM
+ * @param b - valid descriptor to data item in FAM
+ * @param diffOffset - if not NULL and the items differ, set to the offset of
+ * the first byte which differs, or to the size of the smaller item if it is a
+ * prefix of the other one
+ * @return - true if the items have the same size and contents
+ * @throws Fam_InvalidOption_Exception - if a or b is NULL
+ * @throws Fam_Allocator_Exception - exceptionObj->fam_error() may return:
+ *         FAM_ERR_NOPERM, FAM_ERR_NOTFOUND, FAM_ERR_GRPC
+ */
+bool fam::fam_compare_items(Fam_Descriptor *a, Fam_Descriptor *b,
+                            uint64_t *diffOffset) {
+    return pimpl_->fam_compare_items(a, b, diffOffset);
+}
+
 // ATOMICS Group
 
 // NON fetching routines
@@ -4783,6 +7259,105 @@ void fam::fam_fence() { pimpl_->fam_fence(); }
  */
 void fam::fam_quiet() { pimpl_->fam_quiet(); }
 
+/**
+ * Wait until a 64-bit word in FAM compares to a value as requested. The word
+ * is polled with exponential backoff, or watched by the memory server if the
+ * WAIT_MODE option is SERVER.
+ * @param descriptor - valid descriptor to data item in FAM
+ * @param offset - byte offset within the data item of the word
+ * @param cmp - comparison of the word to the value
+ * @param value - value the word is compared to
+ * @return - value of the word which satisfied the condition
+ * @throws Fam_InvalidOption_Exception.
+ * @throws Fam_Datapath_Exception.
+ * @throws Fam_Allocator_Exception - exceptionObj->fam_error() may return:
+ *         FAM_ERR_NOPERM, FAM_ERR_NOTFOUND, FAM_ERR_OUTOFRANGE, FAM_ERR_GRPC
+ */
+uint64_t fam::fam_wait_until(Fam_Descriptor *descriptor, uint64_t offset,
+                             Fam_Cmp cmp, uint64_t value) {
+    return pimpl_->fam_wait_until(descriptor, offset, cmp, value);
+}
+
+/**
+ * Wait until any of several 64-bit words in a data item compares to a value
+ * as requested. The words are always polled by the PE.
+ * @param descriptor - valid descriptor to data item in FAM
+ * @param offsets - byte offsets within the data item of the words
+ * @param nOffsets - number of words
+ * @param cmp - comparison of the words to the value
+ * @param value - value the words are compared to
+ * @return - index in offsets of a word which satisfied the condition
+ * @throws Fam_InvalidOption_Exception.
+ * @throws Fam_Datapath_Exception.
+ */
+uint64_t fam::fam_wait_until_any(Fam_Descriptor *descriptor,
+                                 const uint64_t *offsets, uint64_t nOffsets,
+                                 Fam_Cmp cmp, uint64_t value) {
+    return pimpl_->fam_wait_until_any(descriptor, offsets, nOffsets, cmp,
+                                      value);
+}
+
+/**
+ * Wait until all of several 64-bit words in a data item have compared to a
+ * value as requested.
+ * @param descriptor - valid descriptor to data item in FAM
+ * @param offsets - byte offsets within the data item of the words
+ * @param nOffsets - number of words
+ * @param cmp - comparison of the words to the value
+ * @param value - value the words are compared to
+ * @throws Fam_InvalidOption_Exception.
+ * @throws Fam_Datapath_Exception.
+ * @throws Fam_Allocator_Exception - exceptionObj->fam_error() may return:
+ *         FAM_ERR_NOPERM, FAM_ERR_NOTFOUND, FAM_ERR_OUTOFRANGE, FAM_ERR_GRPC
+ */
+void fam::fam_wait_until_all(Fam_Descriptor *descriptor,
+                             const uint64_t *offsets, uint64_t nOffsets,
+                             Fam_Cmp cmp, uint64_t value) {
+    pimpl_->fam_wait_until_all(descriptor, offsets, nOffsets, cmp, value);
+}
+
+/**
+ * Subscribe to the changes of a range of a data item. The memory server
+ * checks the range every interval milliseconds, and reports all the writes
+ * and atomics which landed in between as one change.
+ * @param descriptor - valid descriptor to data item in FAM
+ * @param offset - byte offset within the data item of the range
+ * @param nbytes - size of the range
+ * @param interval - time in milliseconds between two checks of the range
+ * @return - watch to pass to fam_watch_next() and fam_unwatch()
+ * @throws Fam_InvalidOption_Exception.
+ * @throws Fam_Allocator_Exception - exceptionObj->fam_error() may return:
+ *         FAM_ERR_NOPERM, FAM_ERR_NOTFOUND, FAM_ERR_OUTOFRANGE, FAM_ERR_GRPC
+ */
+Fam_Watch *fam::fam_watch(Fam_Descriptor *descriptor, uint64_t offset,
+                          uint64_t nbytes, uint64_t interval) {
+    return pimpl_->fam_watch(descriptor, offset, nbytes, interval);
+}
+
+/**
+ * Wait for the next change of a watched range. Changes which happened since
+ * the previous call are reported as the smallest range covering them.
+ * @param watch - watch returned by fam_watch()
+ * @param offset - set to the byte offset of the changed bytes
+ * @param nbytes - set to the size of the range covering the changed bytes
+ * @param timeout - time in milliseconds to wait for a change
+ * @return - true if a change was reported, false on timeout
+ * @throws Fam_InvalidOption_Exception.
+ * @throws Fam_Allocator_Exception - if the memory server ended the watch;
+ *         exceptionObj->fam_error() may return FAM_ERR_NOPERM,
+ *         FAM_ERR_NOTFOUND, FAM_ERR_OUTOFRANGE, FAM_ERR_GRPC
+ */
+bool fam::fam_watch_next(Fam_Watch *watch, uint64_t *offset, uint64_t *nbytes,
+                         uint64_t timeout) {
+    return pimpl_->fam_watch_next(watch, offset, nbytes, timeout);
+}
+
+/**
+ * Cancel a watch and release its resources.
+ * @param watch - watch returned by fam_watch()
+ */
+void fam::fam_unwatch(Fam_Watch *watch) { pimpl_->fam_unwatch(watch); }
+
 /**
  * fam() - constructor for fam class
  */
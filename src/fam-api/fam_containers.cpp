@@ -0,0 +1,609 @@
+/*
+ * fam_containers.cpp
+ * Copyright (c) 2020 Hewlett Packard Enterprise Development, LP. All rights
+ * reserved. Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+#include <algorithm>
+#include <sched.h>
+#include <sstream>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fam/fam_containers.h"
+#include "fam/fam_exception.h"
+
+namespace openfam {
+
+/*
+ * Elements and records are padded to 8 bytes so that the words updated with
+ * atomics stay aligned
+ */
+#define FAM_CONTAINER_ALIGN(n) (((n) + 7) & ~7UL)
+
+/*
+ * Size of the buffers used to initialize a container
+ */
+#define FAM_CONTAINER_CHUNK_SIZE 65536
+
+/*
+ * Number of buckets read at once while probing the hash map
+ */
+#define FAM_HASH_MAP_PROBE_BATCH 8
+
+/*
+ * Zero a range of a data item with nonblocking puts of a single buffer
+ */
+static void fam_container_zero(fam *famObj, Fam_Descriptor *descriptor,
+                               uint64_t offset, uint64_t nbytes) {
+    void *zero = calloc(1, FAM_CONTAINER_CHUNK_SIZE);
+    for (uint64_t pos = 0; pos < nbytes; pos += FAM_CONTAINER_CHUNK_SIZE) {
+        uint64_t chunk =
+            std::min((uint64_t)FAM_CONTAINER_CHUNK_SIZE, nbytes - pos);
+        famObj->fam_put_nonblocking(zero, descriptor, offset + pos, chunk);
+    }
+    famObj->fam_quiet();
+    free(zero);
+}
+
+/*
+ * Layout of a Fam_Queue: capacity, element size, head and tail positions,
+ * followed by the cells. A cell holds a sequence number and an element. The
+ * cell of position pos is free for a producer when its sequence number is
+ * pos, and filled for a consumer when it is pos + 1.
+ */
+#define FAM_QUEUE_CAPACITY 0
+#define FAM_QUEUE_ELEMENT_SIZE 8
+#define FAM_QUEUE_HEAD 16
+#define FAM_QUEUE_TAIL 24
+#define FAM_QUEUE_CELLS 32
+
+uint64_t Fam_Queue::size(uint64_t capacity, uint64_t elementSize) {
+    return FAM_QUEUE_CELLS +
+           capacity * (sizeof(uint64_t) + FAM_CONTAINER_ALIGN(elementSize));
+}
+
+void Fam_Queue::initialize(fam *famObj, Fam_Descriptor *descriptor,
+                           uint64_t capacity, uint64_t elementSize) {
+    uint64_t cellSize = sizeof(uint64_t) + FAM_CONTAINER_ALIGN(elementSize);
+    uint64_t header[4] = { capacity, elementSize, 0, 0 };
+    famObj->fam_put_blocking(header, descriptor, 0, sizeof(header));
+
+    uint64_t cellsPerChunk =
+        std::max((uint64_t)1, FAM_CONTAINER_CHUNK_SIZE / cellSize);
+    char *cells = (char *)calloc(cellsPerChunk, cellSize);
+    for (uint64_t first = 0; first < capacity; first += cellsPerChunk) {
+        uint64_t count = std::min(cellsPerChunk, capacity - first);
+        for (uint64_t i = 0; i < count; i++)
+            *(uint64_t *)(cells + i * cellSize) = first + i;
+        famObj->fam_put_blocking(cells, descriptor,
+                                 FAM_QUEUE_CELLS + first * cellSize,
+                                 count * cellSize);
+    }
+    free(cells);
+}
+
+Fam_Queue::Fam_Queue(fam *famObj_, Fam_Descriptor *descriptor_) {
+    uint64_t header[2];
+    famObj = famObj_;
+    descriptor = descriptor_;
+    famObj->fam_get_blocking(header, descriptor, 0, sizeof(header));
+    capacity = header[0];
+    elementSize = header[1];
+}
+
+uint64_t Fam_Queue::cell_offset(uint64_t position) {
+    uint64_t cellSize = sizeof(uint64_t) + FAM_CONTAINER_ALIGN(elementSize);
+    return FAM_QUEUE_CELLS + (position % capacity) * cellSize;
+}
+
+bool Fam_Queue::enqueue(const void *element) {
+    uint64_t pos = famObj->fam_fetch_uint64(descriptor, FAM_QUEUE_TAIL);
+    while (true) {
+        uint64_t seq = famObj->fam_fetch_uint64(descriptor, cell_offset(pos));
+        int64_t diff = (int64_t)(seq - pos);
+        if (diff == 0) {
+            uint64_t old = famObj->fam_compare_swap(descriptor, FAM_QUEUE_TAIL,
+                                                    pos, pos + 1);
+            if (old == pos)
+                break;
+            pos = old;
+        } else if (diff < 0) {
+            // Cell still holds the element of the previous round
+            return false;
+        } else {
+            pos = famObj->fam_fetch_uint64(descriptor, FAM_QUEUE_TAIL);
+        }
+    }
+
+    famObj->fam_put_blocking((void *)element, descriptor,
+                             cell_offset(pos) + sizeof(uint64_t), elementSize);
+    // Hand the cell over to consumers
+    famObj->fam_set(descriptor, cell_offset(pos), pos + 1);
+    return true;
+}
+
+bool Fam_Queue::dequeue(void *element) {
+    uint64_t pos = famObj->fam_fetch_uint64(descriptor, FAM_QUEUE_HEAD);
+    while (true) {
+        uint64_t seq = famObj->fam_fetch_uint64(descriptor, cell_offset(pos));
+        int64_t diff = (int64_t)(seq - (pos + 1));
+        if (diff == 0) {
+            uint64_t old = famObj->fam_compare_swap(descriptor, FAM_QUEUE_HEAD,
+                                                    pos, pos + 1);
+            if (old == pos)
+                break;
+            pos = old;
+        } else if (diff < 0) {
+            // Cell has not been filled yet
+            return false;
+        } else {
+            pos = famObj->fam_fetch_uint64(descriptor, FAM_QUEUE_HEAD);
+        }
+    }
+
+    famObj->fam_get_blocking(element, descriptor,
+                             cell_offset(pos) + sizeof(uint64_t), elementSize);
+    // Hand the cell over to the producer of the next round
+    famObj->fam_set(descriptor, cell_offset(pos), pos + capacity);
+    return true;
+}
+
+/*
+ * Layout of a Fam_Log: capacity and tail, followed by the records. A record
+ * holds its length, written once its contents are complete, followed by its
+ * contents. Positions are relative to the first record.
+ */
+#define FAM_LOG_CAPACITY 0
+#define FAM_LOG_TAIL 8
+#define FAM_LOG_RECORDS 16
+#define FAM_LOG_RECORD_SIZE(n) (sizeof(uint64_t) + FAM_CONTAINER_ALIGN(n))
+
+uint64_t Fam_Log::size(uint64_t capacity) {
+    return FAM_LOG_RECORDS + capacity;
+}
+
+void Fam_Log::initialize(fam *famObj, Fam_Descriptor *descriptor,
+                         uint64_t capacity) {
+    fam_container_zero(famObj, descriptor, FAM_LOG_RECORDS, capacity);
+    uint64_t header[2] = { capacity, 0 };
+    famObj->fam_put_blocking(header, descriptor, 0, sizeof(header));
+}
+
+Fam_Log::Fam_Log(fam *famObj_, Fam_Descriptor *descriptor_) {
+    famObj = famObj_;
+    descriptor = descriptor_;
+    capacity = famObj->fam_fetch_uint64(descriptor, FAM_LOG_CAPACITY);
+}
+
+uint64_t Fam_Log::append(const void *record, uint64_t nbytes) {
+    return append_batch(&record, &nbytes, 1);
+}
+
+uint64_t Fam_Log::append_batch(const void **records, const uint64_t *nbytes,
+                               uint64_t nRecords) {
+    std::ostringstream message;
+    uint64_t total = 0;
+    for (uint64_t i = 0; i < nRecords; i++) {
+        if (nbytes[i] == 0) {
+            message << "Invalid record size: 0";
+            throw Fam_InvalidOption_Exception(message.str().c_str());
+        }
+        total += FAM_LOG_RECORD_SIZE(nbytes[i]);
+    }
+
+    // Reserve the space of the records, advancing the tail only if all of
+    // them fit, so that a failed append does not waste the space left
+    uint64_t first = famObj->fam_fetch_uint64(descriptor, FAM_LOG_TAIL);
+    while (true) {
+        if ((total > capacity) || (first > capacity - total)) {
+            message << "Log is full";
+            throw Fam_Exception(FAM_ERR_RESOURCE, message.str().c_str());
+        }
+        uint64_t old = famObj->fam_compare_swap(descriptor, FAM_LOG_TAIL,
+                                                first, first + total);
+        if (old == first)
+            break;
+        first = old;
+    }
+
+    // Write the contents of all the records, then commit them
+    uint64_t pos = first;
+    for (uint64_t i = 0; i < nRecords; i++) {
+        famObj->fam_put_nonblocking((void *)records[i], descriptor,
+                                    FAM_LOG_RECORDS + pos + sizeof(uint64_t),
+                                    nbytes[i]);
+        pos += FAM_LOG_RECORD_SIZE(nbytes[i]);
+    }
+    famObj->fam_quiet();
+
+    pos = first;
+    for (uint64_t i = 0; i < nRecords; i++) {
+        famObj->fam_set(descriptor, FAM_LOG_RECORDS + pos, nbytes[i]);
+        pos += FAM_LOG_RECORD_SIZE(nbytes[i]);
+    }
+    return first;
+}
+
+uint64_t Fam_Log::read(uint64_t position, void *record, uint64_t maxBytes,
+                       uint64_t *next) {
+    std::ostringstream message;
+    if (position + sizeof(uint64_t) > capacity)
+        return 0;
+    uint64_t length =
+        famObj->fam_fetch_uint64(descriptor, FAM_LOG_RECORDS + position);
+    if (length == 0)
+        return 0;
+    if (length > maxBytes) {
+        message << "Buffer too small for record of size " << length;
+        throw Fam_InvalidOption_Exception(message.str().c_str());
+    }
+    famObj->fam_get_blocking(record, descriptor,
+                             FAM_LOG_RECORDS + position + sizeof(uint64_t),
+                             length);
+    *next = position + FAM_LOG_RECORD_SIZE(length);
+    return length;
+}
+
+uint64_t Fam_Log::tail() {
+    return std::min(capacity,
+                    famObj->fam_fetch_uint64(descriptor, FAM_LOG_TAIL));
+}
+
+/*
+ * Layout of a Fam_Hash_Map: capacity and value size, followed by the
+ * buckets. A bucket holds its key (0 if free), a flag set once the value is
+ * written, and the value.
+ */
+#define FAM_HASH_MAP_CAPACITY 0
+#define FAM_HASH_MAP_VALUE_SIZE 8
+#define FAM_HASH_MAP_BUCKETS 16
+#define FAM_HASH_MAP_KEY 0
+#define FAM_HASH_MAP_READY 8
+#define FAM_HASH_MAP_VALUE 16
+
+/*
+ * 64-bit mixing function, so that consecutive keys spread over the buckets
+ */
+static uint64_t fam_hash_map_hash(uint64_t key) {
+    key ^= key >> 30;
+    key *= 0xbf58476d1ce4e5b9ULL;
+    key ^= key >> 27;
+    key *= 0x94d049bb133111ebULL;
+    key ^= key >> 31;
+    return key;
+}
+
+uint64_t Fam_Hash_Map::size(uint64_t capacity, uint64_t valueSize) {
+    return FAM_HASH_MAP_BUCKETS +
+           capacity * (FAM_HASH_MAP_VALUE + FAM_CONTAINER_ALIGN(valueSize));
+}
+
+void Fam_Hash_Map::initialize(fam *famObj, Fam_Descriptor *descriptor,
+                              uint64_t capacity, uint64_t valueSize) {
+    fam_container_zero(famObj, descriptor, FAM_HASH_MAP_BUCKETS,
+                       size(capacity, valueSize) - FAM_HASH_MAP_BUCKETS);
+    uint64_t header[2] = { capacity, valueSize };
+    famObj->fam_put_blocking(header, descriptor, 0, sizeof(header));
+}
+
+Fam_Hash_Map::Fam_Hash_Map(fam *famObj_, Fam_Descriptor *descriptor_) {
+    uint64_t header[2];
+    famObj = famObj_;
+    descriptor = descriptor_;
+    famObj->fam_get_blocking(header, descriptor, 0, sizeof(header));
+    capacity = header[0];
+    valueSize = header[1];
+}
+
+uint64_t Fam_Hash_Map::bucket_size() {
+    return FAM_HASH_MAP_VALUE + FAM_CONTAINER_ALIGN(valueSize);
+}
+
+uint64_t Fam_Hash_Map::bucket_offset(uint64_t bucket) {
+    return FAM_HASH_MAP_BUCKETS + bucket * bucket_size();
+}
+
+/*
+ * Read up to FAM_HASH_MAP_PROBE_BATCH consecutive buckets, stopping at the
+ * end of the table. Returns the number of buckets read.
+ */
+uint64_t Fam_Hash_Map::read_buckets(uint64_t first, void *buckets) {
+    uint64_t count =
+        std::min((uint64_t)FAM_HASH_MAP_PROBE_BATCH, capacity - first);
+    famObj->fam_get_blocking(buckets, descriptor, bucket_offset(first),
+                             count * bucket_size());
+    return count;
+}
+
+bool Fam_Hash_Map::insert(uint64_t key, const void *value) {
+    std::ostringstream message;
+    if (key == 0) {
+        message << "Invalid key: 0";
+        throw Fam_InvalidOption_Exception(message.str().c_str());
+    }
+
+    char *buckets = (char *)malloc(FAM_HASH_MAP_PROBE_BATCH * bucket_size());
+    uint64_t bucket = fam_hash_map_hash(key) % capacity;
+    uint64_t probed = 0;
+    while (probed < capacity) {
+        uint64_t count = read_buckets(bucket, buckets);
+        for (uint64_t i = 0; (i < count) && (probed < capacity);
+             i++, probed++) {
+            uint64_t bucketKey =
+                *(uint64_t *)(buckets + i * bucket_size() + FAM_HASH_MAP_KEY);
+            if (bucketKey == key) {
+                free(buckets);
+                return false;
+            }
+            if (bucketKey != 0)
+                continue;
+
+            uint64_t offset = bucket_offset(bucket + i);
+            uint64_t old = famObj->fam_compare_swap(
+                descriptor, offset + FAM_HASH_MAP_KEY, (uint64_t)0, key);
+            if (old == 0) {
+                famObj->fam_put_blocking((void *)value, descriptor,
+                                         offset + FAM_HASH_MAP_VALUE,
+                                         valueSize);
+                famObj->fam_set(descriptor, offset + FAM_HASH_MAP_READY,
+                                (uint64_t)1);
+                free(buckets);
+                return true;
+            }
+            if (old == key) {
+                free(buckets);
+                return false;
+            }
+        }
+        bucket = (bucket + count) % capacity;
+    }
+    free(buckets);
+    message << "Hash map is full";
+    throw Fam_Exception(FAM_ERR_RESOURCE, message.str().c_str());
+}
+
+bool Fam_Hash_Map::find(uint64_t key, void *value) {
+    if (key == 0)
+        return false;
+
+    char *buckets = (char *)malloc(FAM_HASH_MAP_PROBE_BATCH * bucket_size());
+    uint64_t bucket = fam_hash_map_hash(key) % capacity;
+    uint64_t probed = 0;
+    while (probed < capacity) {
+        uint64_t count = read_buckets(bucket, buckets);
+        for (uint64_t i = 0; (i < count) && (probed < capacity);
+             i++, probed++) {
+            uint64_t bucketKey =
+                *(uint64_t *)(buckets + i * bucket_size() + FAM_HASH_MAP_KEY);
+            if (bucketKey == 0) {
+                free(buckets);
+                return false;
+            }
+            if (bucketKey != key)
+                continue;
+
+            // Key is claimed before its value is written
+            uint64_t offset = bucket_offset(bucket + i);
+            while (famObj->fam_fetch_uint64(
+                       descriptor, offset + FAM_HASH_MAP_READY) == 0)
+                sched_yield();
+            famObj->fam_get_blocking(value, descriptor,
+                                     offset + FAM_HASH_MAP_VALUE, valueSize);
+            free(buckets);
+            return true;
+        }
+        bucket = (bucket + count) % capacity;
+    }
+    free(buckets);
+    return false;
+}
+
+/*
+ * Layout of a Fam_Task_Pool: number of PEs, capacity of a deque, task size
+ * and number of pending tasks, followed by a word per PE holding the top and
+ * bottom positions of its deque, and by the tasks of each deque. Positions
+ * only grow and wrap around at 2^32, so the capacity is rounded up to a power
+ * of two and a take can not succeed on a word which has been updated since
+ * its tasks were read.
+ */
+#define FAM_TASK_POOL_NUM_PES 0
+#define FAM_TASK_POOL_CAPACITY 8
+#define FAM_TASK_POOL_TASK_SIZE 16
+#define FAM_TASK_POOL_PENDING 24
+#define FAM_TASK_POOL_DEQUES 32
+#define FAM_TASK_POOL_TOP(word) ((uint32_t)((word) >> 32))
+#define FAM_TASK_POOL_BOTTOM(word) ((uint32_t)(word))
+#define FAM_TASK_POOL_WORD(top, bottom)                                        \
+    (((uint64_t)(uint32_t)(top) << 32) | (uint32_t)(bottom))
+#define FAM_TASK_POOL_MAX_CAPACITY (1UL << 31)
+
+static uint64_t fam_task_pool_capacity(uint64_t capacity) {
+    uint64_t rounded = 1;
+    while ((rounded < capacity) && (rounded < FAM_TASK_POOL_MAX_CAPACITY))
+        rounded <<= 1;
+    return rounded;
+}
+
+uint64_t Fam_Task_Pool::size(uint64_t numPEs, uint64_t capacity,
+                             uint64_t taskSize) {
+    return FAM_TASK_POOL_DEQUES + numPEs * sizeof(uint64_t) +
+           numPEs * fam_task_pool_capacity(capacity) *
+               FAM_CONTAINER_ALIGN(taskSize);
+}
+
+void Fam_Task_Pool::initialize(fam *famObj, Fam_Descriptor *descriptor,
+                               uint64_t numPEs, uint64_t capacity,
+                               uint64_t taskSize) {
+    fam_container_zero(famObj, descriptor, FAM_TASK_POOL_DEQUES,
+                       numPEs * sizeof(uint64_t));
+    uint64_t header[4] = { numPEs, fam_task_pool_capacity(capacity), taskSize,
+                           0 };
+    famObj->fam_put_blocking(header, descriptor, 0, sizeof(header));
+}
+
+Fam_Task_Pool::Fam_Task_Pool(fam *famObj_, Fam_Descriptor *descriptor_,
+                             uint64_t stealBatch_) {
+    uint64_t header[3];
+    famObj = famObj_;
+    descriptor = descriptor_;
+    famObj->fam_get_blocking(header, descriptor, 0, sizeof(header));
+    numPEs = header[0];
+    capacity = header[1];
+    taskSize = header[2];
+    stealBatch = std::max((uint64_t)1, stealBatch_);
+    stolen.resize(stealBatch * taskSize);
+    stolenCount = 0;
+    doneCount = 0;
+    running = false;
+
+    char optName[] = "PE_ID";
+    int *pe = (int *)famObj->fam_get_option(optName);
+    myPE = *pe;
+    free(pe);
+    seed = (unsigned int)myPE;
+}
+
+uint64_t Fam_Task_Pool::deque_offset(uint64_t pe) {
+    return FAM_TASK_POOL_DEQUES + pe * sizeof(uint64_t);
+}
+
+uint64_t Fam_Task_Pool::task_offset(uint64_t pe, uint64_t position) {
+    return FAM_TASK_POOL_DEQUES + numPEs * sizeof(uint64_t) +
+           (pe * capacity + position % capacity) *
+               FAM_CONTAINER_ALIGN(taskSize);
+}
+
+bool Fam_Task_Pool::add(const void *task) { return add_batch(task, 1); }
+
+bool Fam_Task_Pool::add_batch(const void *tasks, uint64_t nTasks) {
+    if (nTasks == 0)
+        return true;
+    uint64_t word = famObj->fam_fetch_uint64(descriptor, deque_offset(myPE));
+    uint32_t bottom = FAM_TASK_POOL_BOTTOM(word);
+    uint32_t used = bottom - FAM_TASK_POOL_TOP(word);
+    if (used + nTasks > capacity)
+        return false;
+
+    for (uint64_t i = 0; i < nTasks; i++)
+        famObj->fam_put_nonblocking((char *)tasks + i * taskSize, descriptor,
+                                    task_offset(myPE, (uint32_t)(bottom + i)),
+                                    taskSize);
+    // Tasks are counted before they can be taken, so that the count never
+    // drops to 0 while some of them are not done
+    famObj->fam_add(descriptor, FAM_TASK_POOL_PENDING, nTasks);
+    famObj->fam_quiet();
+
+    // Only the owner moves the bottom, stealers may move the top meanwhile
+    while (true) {
+        uint64_t newWord =
+            FAM_TASK_POOL_WORD(FAM_TASK_POOL_TOP(word), bottom + nTasks);
+        uint64_t old = famObj->fam_compare_swap(
+            descriptor, deque_offset(myPE), word, newWord);
+        if (old == word)
+            break;
+        word = old;
+    }
+    return true;
+}
+
+uint64_t Fam_Task_Pool::take(uint64_t pe, uint64_t maxTasks, void *tasks) {
+    uint64_t word = famObj->fam_fetch_uint64(descriptor, deque_offset(pe));
+    while (true) {
+        uint32_t top = FAM_TASK_POOL_TOP(word);
+        uint32_t used = FAM_TASK_POOL_BOTTOM(word) - top;
+        if (used == 0)
+            return 0;
+        uint64_t count = std::min(maxTasks, (uint64_t)used);
+        if (pe != myPE)
+            count = std::min(count, (uint64_t)(used + 1) / 2);
+
+        // Read the tasks first, they are only ours if the top has not moved
+        for (uint64_t i = 0; i < count; i++)
+            famObj->fam_get_nonblocking((char *)tasks + i * taskSize,
+                                        descriptor,
+                                        task_offset(pe, (uint32_t)(top + i)),
+                                        taskSize);
+        famObj->fam_quiet();
+        uint64_t newWord =
+            FAM_TASK_POOL_WORD(top + count, FAM_TASK_POOL_BOTTOM(word));
+        uint64_t old = famObj->fam_compare_swap(descriptor, deque_offset(pe),
+                                                word, newWord);
+        if (old == word)
+            return count;
+        word = old;
+    }
+}
+
+bool Fam_Task_Pool::get(void *task) {
+    if (running)
+        doneCount++;
+    running = true;
+
+    if (stolenCount > 0) {
+        stolenCount--;
+        memcpy(task, stolen.data() + stolenCount * taskSize, taskSize);
+        return true;
+    }
+
+    while (true) {
+        if (take(myPE, 1, task) == 1)
+            return true;
+
+        uint64_t first = rand_r(&seed) % numPEs;
+        for (uint64_t i = 0; i < numPEs; i++) {
+            uint64_t victim = (first + i) % numPEs;
+            if (victim == myPE)
+                continue;
+            uint64_t count = take(victim, stealBatch, stolen.data());
+            if (count > 0) {
+                stolenCount = count - 1;
+                memcpy(task, stolen.data() + stolenCount * taskSize,
+                       taskSize);
+                return true;
+            }
+        }
+
+        // Nothing to take: the work is over once no PE runs a task
+        uint64_t pending;
+        if (doneCount > 0) {
+            pending = famObj->fam_fetch_subtract(
+                          descriptor, FAM_TASK_POOL_PENDING, doneCount) -
+                      doneCount;
+            doneCount = 0;
+        } else {
+            pending =
+                famObj->fam_fetch_uint64(descriptor, FAM_TASK_POOL_PENDING);
+        }
+        if (pending == 0) {
+            running = false;
+            return false;
+        }
+        sched_yield();
+    }
+}
+
+} // namespace openfam
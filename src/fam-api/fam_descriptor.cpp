@@ -48,6 +48,7 @@ class Fam_Descriptor::FamDescriptorImpl_ {
         context = NULL;
         base = NULL;
         size = itemSize;
+        capability = {0, 0, 0, 0, 0, 0};
     }
 
     FamDescriptorImpl_(Fam_Global_Descriptor globalDesc) {
@@ -56,6 +57,7 @@ class Fam_Descriptor::FamDescriptorImpl_ {
         context = NULL;
         base = NULL;
         size = 0;
+        capability = {0, 0, 0, 0, 0, 0};
     }
 
     FamDescriptorImpl_() {
@@ -64,6 +66,7 @@ class Fam_Descriptor::FamDescriptorImpl_ {
         context = NULL;
         base = NULL;
         size = 0;
+        capability = {0, 0, 0, 0, 0, 0};
     }
 
     ~FamDescriptorImpl_() {
@@ -72,6 +75,7 @@ class Fam_Descriptor::FamDescriptorImpl_ {
         context = NULL;
         base = NULL;
         size = 0;
+        capability = {0, 0, 0, 0, 0, 0};
     }
 
     Fam_Global_Descriptor get_global_descriptor() { return this->gDescriptor; }
@@ -104,6 +108,10 @@ class Fam_Descriptor::FamDescriptorImpl_ {
         return (gDescriptor.regionId) >> MEMSERVERID_SHIFT;
     }
 
+    void set_capability(Fam_Capability cap) { capability = cap; }
+
+    Fam_Capability get_capability() { return capability; }
+
   private:
     Fam_Global_Descriptor gDescriptor;
     /* libfabric access key*/
@@ -111,6 +119,8 @@ class Fam_Descriptor::FamDescriptorImpl_ {
     void *context;
     void *base;
     uint64_t size;
+    /* capability minted by the memory server */
+    Fam_Capability capability;
 };
 
 Fam_Descriptor::Fam_Descriptor(Fam_Global_Descriptor gDescriptor,
@@ -153,6 +163,14 @@ uint64_t Fam_Descriptor::get_size() { return fdimpl_->get_size(); }
 uint64_t Fam_Descriptor::get_memserver_id() {
     return fdimpl_->get_memserver_id();
 }
+
+void Fam_Descriptor::set_capability(Fam_Capability cap) {
+    fdimpl_->set_capability(cap);
+}
+
+Fam_Capability Fam_Descriptor::get_capability() {
+    return fdimpl_->get_capability();
+}
 /*
  * Internal implementation of Fam_Region_Descriptor
  */
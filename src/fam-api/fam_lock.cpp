@@ -0,0 +1,155 @@
+/*
+ * fam_lock.cpp
+ * Copyright (c) 2020 Hewlett Packard Enterprise Development, LP. All rights
+ * reserved. Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+#include <sched.h>
+#include <stdlib.h>
+
+#include "fam/fam_lock.h"
+
+namespace openfam {
+
+/*
+ * Layout of a Fam_Lock: the tail of the queue, followed by a queue node per
+ * PE holding the next PE in the queue and a flag set while the PE waits.
+ * PEs are identified by PE_ID + 1 so that 0 means no PE.
+ */
+#define FAM_LOCK_NODE_SIZE (2 * sizeof(uint64_t))
+
+uint64_t Fam_Lock::size(int numPEs) {
+    return sizeof(uint64_t) + numPEs * FAM_LOCK_NODE_SIZE;
+}
+
+Fam_Lock::Fam_Lock(fam *famObj_, Fam_Descriptor *descriptor_,
+                   uint64_t offset_) {
+    famObj = famObj_;
+    descriptor = descriptor_;
+    offset = offset_;
+    char optName[] = "PE_ID";
+    int *myPE = (int *)famObj->fam_get_option(optName);
+    myId = *myPE + 1;
+    free(myPE);
+}
+
+uint64_t Fam_Lock::next_offset(uint64_t id) {
+    return offset + sizeof(uint64_t) + (id - 1) * FAM_LOCK_NODE_SIZE;
+}
+
+uint64_t Fam_Lock::locked_offset(uint64_t id) {
+    return next_offset(id) + sizeof(uint64_t);
+}
+
+void Fam_Lock::lock() {
+    // Reset the queue node before it becomes visible to other PEs
+    famObj->fam_set(descriptor, next_offset(myId), (uint64_t)0);
+    famObj->fam_set(descriptor, locked_offset(myId), (uint64_t)1);
+    famObj->fam_quiet();
+
+    uint64_t pred = famObj->fam_swap(descriptor, tail_offset(), myId);
+    if (pred == 0)
+        return;
+
+    // Link behind the predecessor, and wait for it to clear our flag
+    famObj->fam_set(descriptor, next_offset(pred), myId);
+    famObj->fam_quiet();
+    while (famObj->fam_fetch_uint64(descriptor, locked_offset(myId)) != 0)
+        sched_yield();
+}
+
+bool Fam_Lock::try_lock() {
+    famObj->fam_set(descriptor, next_offset(myId), (uint64_t)0);
+    famObj->fam_quiet();
+    return (famObj->fam_compare_swap(descriptor, tail_offset(), (uint64_t)0,
+                                     myId) == 0);
+}
+
+void Fam_Lock::unlock() {
+    // Updates made under the lock must be visible to the next holder
+    famObj->fam_quiet();
+
+    uint64_t next = famObj->fam_fetch_uint64(descriptor, next_offset(myId));
+    if (next == 0) {
+        if (famObj->fam_compare_swap(descriptor, tail_offset(), myId,
+                                     (uint64_t)0) == myId)
+            return;
+        // A PE has swapped itself into the tail, wait for it to link
+        while ((next = famObj->fam_fetch_uint64(descriptor,
+                                                next_offset(myId))) == 0)
+            sched_yield();
+    }
+    famObj->fam_set(descriptor, locked_offset(next), (uint64_t)0);
+    famObj->fam_quiet();
+}
+
+/*
+ * Layout of a Fam_RW_Lock: the number of active readers, the writer flag,
+ * followed by the Fam_Lock queueing the writers.
+ */
+uint64_t Fam_RW_Lock::size(int numPEs) {
+    return 2 * sizeof(uint64_t) + Fam_Lock::size(numPEs);
+}
+
+Fam_RW_Lock::Fam_RW_Lock(fam *famObj_, Fam_Descriptor *descriptor_,
+                         uint64_t offset_)
+    : writerLock(famObj_, descriptor_, offset_ + 2 * sizeof(uint64_t)) {
+    famObj = famObj_;
+    descriptor = descriptor_;
+    offset = offset_;
+}
+
+void Fam_RW_Lock::read_lock() {
+    while (true) {
+        while (famObj->fam_fetch_uint64(descriptor, writer_offset()) != 0)
+            sched_yield();
+        famObj->fam_fetch_add(descriptor, readers_offset(), (uint64_t)1);
+        if (famObj->fam_fetch_uint64(descriptor, writer_offset()) == 0)
+            return;
+        // A writer came in, let it go first
+        famObj->fam_fetch_subtract(descriptor, readers_offset(), (uint64_t)1);
+    }
+}
+
+void Fam_RW_Lock::read_unlock() {
+    famObj->fam_quiet();
+    famObj->fam_fetch_subtract(descriptor, readers_offset(), (uint64_t)1);
+}
+
+void Fam_RW_Lock::write_lock() {
+    writerLock.lock();
+    famObj->fam_swap(descriptor, writer_offset(), (uint64_t)1);
+    while (famObj->fam_fetch_uint64(descriptor, readers_offset()) != 0)
+        sched_yield();
+}
+
+void Fam_RW_Lock::write_unlock() {
+    famObj->fam_quiet();
+    famObj->fam_swap(descriptor, writer_offset(), (uint64_t)0);
+    writerLock.unlock();
+}
+
+} // namespace openfam
@@ -46,6 +46,66 @@ using namespace std;
 
 namespace openfam {
 
+/*
+ * The key of a data item of a region registered as a whole reaches the whole
+ * region, so the accesses made with it are checked here against the data
+ * item, as the memory region of the data item does otherwise.
+ */
+static inline bool region_key(Fam_Descriptor *descriptor) {
+    return (descriptor->get_key() >> FAM_KEY_TAG_SHIFT) ==
+           FAM_KEY_REGION_MR_TAG;
+}
+
+static void check_range(Fam_Descriptor *descriptor, uint64_t offset,
+                        uint64_t nbytes) {
+    if (!region_key(descriptor))
+        return;
+    uint64_t size = descriptor->get_size();
+    if ((offset > size) || (nbytes > size - offset)) {
+        throw Fam_Datapath_Exception(FAM_ERR_OUTOFRANGE,
+                                     "Access is beyond dataitem");
+    }
+}
+
+static void check_stride_range(Fam_Descriptor *descriptor, uint64_t nElements,
+                               uint64_t firstElement, uint64_t stride,
+                               uint64_t elementSize) {
+    if (!region_key(descriptor) || (nElements == 0))
+        return;
+    uint64_t maxElements = (elementSize == 0)
+                               ? UINT64_MAX
+                               : descriptor->get_size() / elementSize;
+    if ((firstElement >= maxElements) ||
+        ((stride != 0) &&
+         (nElements - 1 > (maxElements - 1 - firstElement) / stride))) {
+        throw Fam_Datapath_Exception(FAM_ERR_OUTOFRANGE,
+                                     "Element is beyond dataitem");
+    }
+}
+
+static void check_index_range(Fam_Descriptor *descriptor, uint64_t nElements,
+                              const uint64_t *elementIndex,
+                              uint64_t elementSize) {
+    if (!region_key(descriptor) || (elementSize == 0))
+        return;
+    uint64_t maxElements = descriptor->get_size() / elementSize;
+    for (uint64_t i = 0; i < nElements; i++) {
+        if (elementIndex[i] >= maxElements) {
+            throw Fam_Datapath_Exception(FAM_ERR_OUTOFRANGE,
+                                         "Element is beyond dataitem");
+        }
+    }
+}
+
+static void check_iov_range(Fam_Descriptor *descriptor,
+                            const struct iovec *iov, const uint64_t *offsets,
+                            uint64_t count) {
+    if (!region_key(descriptor))
+        return;
+    for (uint64_t i = 0; i < count; i++)
+        check_range(descriptor, offsets[i], iov[i].iov_len);
+}
+
 Fam_Ops_Libfabric::~Fam_Ops_Libfabric() {
 
     delete contexts;
@@ -331,6 +391,7 @@ int Fam_Ops_Libfabric::put_blocking(void *local, Fam_Descriptor *descriptor,
     // Write data into memory region with this key
     uint64_t key;
     key = descriptor->get_key();
+    check_range(descriptor, offset, nbytes);
     uint64_t nodeId = descriptor->get_memserver_id();
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
     int ret = fabric_write(key, local, nbytes, offset, (*fiAddr)[nodeId],
@@ -344,6 +405,7 @@ int Fam_Ops_Libfabric::get_blocking(void *local, Fam_Descriptor *descriptor,
     // Write data into memory region with this key
     uint64_t key;
     key = descriptor->get_key();
+    check_range(descriptor, offset, nbytes);
     uint64_t nodeId = descriptor->get_memserver_id();
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
     int ret = fabric_read(key, local, nbytes, offset, (*fiAddr)[nodeId],
@@ -360,6 +422,8 @@ int Fam_Ops_Libfabric::gather_blocking(void *local, Fam_Descriptor *descriptor,
     uint64_t key;
 
     key = descriptor->get_key();
+    check_stride_range(descriptor, nElements, firstElement, stride,
+                       elementSize);
     uint64_t nodeId = descriptor->get_memserver_id();
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
     int ret = fabric_gather_stride_blocking(
@@ -375,6 +439,7 @@ int Fam_Ops_Libfabric::gather_blocking(void *local, Fam_Descriptor *descriptor,
     uint64_t key;
 
     key = descriptor->get_key();
+    check_index_range(descriptor, nElements, elementIndex, elementSize);
     uint64_t nodeId = descriptor->get_memserver_id();
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
     int ret = fabric_gather_index_blocking(
@@ -391,6 +456,8 @@ int Fam_Ops_Libfabric::scatter_blocking(void *local, Fam_Descriptor *descriptor,
     uint64_t key;
 
     key = descriptor->get_key();
+    check_stride_range(descriptor, nElements, firstElement, stride,
+                       elementSize);
     uint64_t nodeId = descriptor->get_memserver_id();
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
     int ret = fabric_scatter_stride_blocking(
@@ -406,6 +473,7 @@ int Fam_Ops_Libfabric::scatter_blocking(void *local, Fam_Descriptor *descriptor,
     uint64_t key;
 
     key = descriptor->get_key();
+    check_index_range(descriptor, nElements, elementIndex, elementSize);
     uint64_t nodeId = descriptor->get_memserver_id();
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
     int ret = fabric_scatter_index_blocking(
@@ -414,12 +482,75 @@ int Fam_Ops_Libfabric::scatter_blocking(void *local, Fam_Descriptor *descriptor,
     return ret;
 }
 
+int Fam_Ops_Libfabric::get_iov_blocking(Fam_Descriptor *descriptor,
+                                        struct iovec *iov,
+                                        const uint64_t *offsets,
+                                        uint64_t count) {
+    uint64_t key;
+
+    key = descriptor->get_key();
+    check_iov_range(descriptor, iov, offsets, count);
+    uint64_t nodeId = descriptor->get_memserver_id();
+    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    int ret = fabric_read_write_iov(key, iov, offsets, count, (*fiAddr)[nodeId],
+                                    get_context(descriptor), fabric_iov_limit,
+                                    0, 1);
+    return ret;
+}
+
+int Fam_Ops_Libfabric::put_iov_blocking(Fam_Descriptor *descriptor,
+                                        struct iovec *iov,
+                                        const uint64_t *offsets,
+                                        uint64_t count) {
+    uint64_t key;
+
+    key = descriptor->get_key();
+    check_iov_range(descriptor, iov, offsets, count);
+    uint64_t nodeId = descriptor->get_memserver_id();
+    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    int ret = fabric_read_write_iov(key, iov, offsets, count, (*fiAddr)[nodeId],
+                                    get_context(descriptor), fabric_iov_limit,
+                                    1, 1);
+    return ret;
+}
+
+void Fam_Ops_Libfabric::get_iov_nonblocking(Fam_Descriptor *descriptor,
+                                            struct iovec *iov,
+                                            const uint64_t *offsets,
+                                            uint64_t count) {
+    uint64_t key;
+
+    key = descriptor->get_key();
+    check_iov_range(descriptor, iov, offsets, count);
+    uint64_t nodeId = descriptor->get_memserver_id();
+    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    fabric_read_write_iov(key, iov, offsets, count, (*fiAddr)[nodeId],
+                          get_context(descriptor), fabric_iov_limit, 0, 0);
+    return;
+}
+
+void Fam_Ops_Libfabric::put_iov_nonblocking(Fam_Descriptor *descriptor,
+                                            struct iovec *iov,
+                                            const uint64_t *offsets,
+                                            uint64_t count) {
+    uint64_t key;
+
+    key = descriptor->get_key();
+    check_iov_range(descriptor, iov, offsets, count);
+    uint64_t nodeId = descriptor->get_memserver_id();
+    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    fabric_read_write_iov(key, iov, offsets, count, (*fiAddr)[nodeId],
+                          get_context(descriptor), fabric_iov_limit, 1, 0);
+    return;
+}
+
 void Fam_Ops_Libfabric::put_nonblocking(void *local, Fam_Descriptor *descriptor,
                                         uint64_t offset, uint64_t nbytes) {
 
     uint64_t key;
 
     key = descriptor->get_key();
+    check_range(descriptor, offset, nbytes);
     uint64_t nodeId = descriptor->get_memserver_id();
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
     fabric_write_nonblocking(key, local, nbytes, offset, (*fiAddr)[nodeId],
@@ -427,11 +558,41 @@ void Fam_Ops_Libfabric::put_nonblocking(void *local, Fam_Descriptor *descriptor,
     return;
 }
 
+void Fam_Ops_Libfabric::put_signal(void *local, Fam_Descriptor *descriptor,
+                                   uint64_t offset, uint64_t nbytes,
+                                   Fam_Descriptor *sigDescriptor,
+                                   uint64_t sigOffset, uint64_t sigValue,
+                                   Fam_Signal_Op op) {
+    uint64_t nodeId = descriptor->get_memserver_id();
+    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Context *ctx = get_context(descriptor);
+
+    // A fence only orders operations on the same endpoint and peer
+    if ((sigDescriptor->get_memserver_id() == nodeId) &&
+        (get_context(sigDescriptor) == ctx)) {
+        check_range(descriptor, offset, nbytes);
+        check_range(sigDescriptor, sigOffset, sizeof(uint64_t));
+        fabric_write_signal(descriptor->get_key(), local, nbytes, offset,
+                            sigDescriptor->get_key(), sigOffset, sigValue,
+                            (op == FAM_SIGNAL_ADD) ? FI_SUM : FI_ATOMIC_WRITE,
+                            (*fiAddr)[nodeId], ctx);
+        return;
+    }
+
+    put_blocking(local, descriptor, offset, nbytes);
+    if (op == FAM_SIGNAL_ADD)
+        atomic_add(sigDescriptor, sigOffset, sigValue);
+    else
+        atomic_set(sigDescriptor, sigOffset, sigValue);
+    return;
+}
+
 void Fam_Ops_Libfabric::get_nonblocking(void *local, Fam_Descriptor *descriptor,
                                         uint64_t offset, uint64_t nbytes) {
     uint64_t key;
 
     key = descriptor->get_key();
+    check_range(descriptor, offset, nbytes);
     uint64_t nodeId = descriptor->get_memserver_id();
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
     fabric_read_nonblocking(key, local, nbytes, offset, (*fiAddr)[nodeId],
@@ -446,6 +607,8 @@ void Fam_Ops_Libfabric::gather_nonblocking(
     uint64_t key;
 
     key = descriptor->get_key();
+    check_stride_range(descriptor, nElements, firstElement, stride,
+                       elementSize);
     uint64_t nodeId = descriptor->get_memserver_id();
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
     fabric_gather_stride_nonblocking(key, local, elementSize, firstElement,
@@ -462,6 +625,7 @@ void Fam_Ops_Libfabric::gather_nonblocking(void *local,
     uint64_t key;
 
     key = descriptor->get_key();
+    check_index_range(descriptor, nElements, elementIndex, elementSize);
     uint64_t nodeId = descriptor->get_memserver_id();
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
     fabric_gather_index_nonblocking(key, local, elementSize, elementIndex,
@@ -477,6 +641,8 @@ void Fam_Ops_Libfabric::scatter_nonblocking(
     uint64_t key;
 
     key = descriptor->get_key();
+    check_stride_range(descriptor, nElements, firstElement, stride,
+                       elementSize);
     uint64_t nodeId = descriptor->get_memserver_id();
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
     fabric_scatter_stride_nonblocking(
@@ -493,6 +659,7 @@ void Fam_Ops_Libfabric::scatter_nonblocking(void *local,
     uint64_t key;
 
     key = descriptor->get_key();
+    check_index_range(descriptor, nElements, elementIndex, elementSize);
     uint64_t nodeId = descriptor->get_memserver_id();
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
     fabric_scatter_index_nonblocking(key, local, elementSize, elementIndex,
@@ -507,10 +674,23 @@ void *Fam_Ops_Libfabric::copy(Fam_Descriptor *src, uint64_t srcOffset,
     return famAllocator->copy(src, srcOffset, dest, destOffset, nbytes);
 }
 
+void *Fam_Ops_Libfabric::copy(Fam_Descriptor *src, uint64_t srcOffset,
+                              Fam_Descriptor *dest, uint64_t destOffset,
+                              uint64_t nbytes) {
+    return famAllocator->copy(src, srcOffset, dest, destOffset, nbytes);
+}
+
 void Fam_Ops_Libfabric::wait_for_copy(void *waitObj) {
     return famAllocator->wait_for_copy(waitObj);
 }
 
+void *Fam_Ops_Libfabric::fill(Fam_Descriptor *descriptor, uint64_t offset,
+                              uint64_t nbytes, uint64_t pattern,
+                              uint64_t patternSize) {
+    return famAllocator->fill(descriptor, offset, nbytes, pattern,
+                              patternSize);
+}
+
 void Fam_Ops_Libfabric::fence(Fam_Region_Descriptor *descriptor) {
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
 
@@ -607,6 +787,7 @@ void Fam_Ops_Libfabric::atomic_set(Fam_Descriptor *descriptor, uint64_t offset,
                                    int32_t value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(int32_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -619,6 +800,7 @@ void Fam_Ops_Libfabric::atomic_set(Fam_Descriptor *descriptor, uint64_t offset,
                                    int64_t value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(int64_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -631,6 +813,7 @@ void Fam_Ops_Libfabric::atomic_set(Fam_Descriptor *descriptor, uint64_t offset,
                                    uint32_t value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(uint32_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -643,6 +826,7 @@ void Fam_Ops_Libfabric::atomic_set(Fam_Descriptor *descriptor, uint64_t offset,
                                    uint64_t value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(uint64_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -655,6 +839,7 @@ void Fam_Ops_Libfabric::atomic_set(Fam_Descriptor *descriptor, uint64_t offset,
                                    float value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(float));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -667,6 +852,7 @@ void Fam_Ops_Libfabric::atomic_set(Fam_Descriptor *descriptor, uint64_t offset,
                                    double value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(double));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -679,6 +865,7 @@ void Fam_Ops_Libfabric::atomic_add(Fam_Descriptor *descriptor, uint64_t offset,
                                    int32_t value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(int32_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -691,6 +878,7 @@ void Fam_Ops_Libfabric::atomic_add(Fam_Descriptor *descriptor, uint64_t offset,
                                    int64_t value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(int64_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -703,6 +891,7 @@ void Fam_Ops_Libfabric::atomic_add(Fam_Descriptor *descriptor, uint64_t offset,
                                    uint32_t value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(uint32_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -715,6 +904,7 @@ void Fam_Ops_Libfabric::atomic_add(Fam_Descriptor *descriptor, uint64_t offset,
                                    uint64_t value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(uint64_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -727,6 +917,7 @@ void Fam_Ops_Libfabric::atomic_add(Fam_Descriptor *descriptor, uint64_t offset,
                                    float value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(float));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -739,6 +930,7 @@ void Fam_Ops_Libfabric::atomic_add(Fam_Descriptor *descriptor, uint64_t offset,
                                    double value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(double));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -787,6 +979,7 @@ void Fam_Ops_Libfabric::atomic_min(Fam_Descriptor *descriptor, uint64_t offset,
                                    int32_t value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(int32_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -799,6 +992,7 @@ void Fam_Ops_Libfabric::atomic_min(Fam_Descriptor *descriptor, uint64_t offset,
                                    int64_t value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(int64_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -811,6 +1005,7 @@ void Fam_Ops_Libfabric::atomic_min(Fam_Descriptor *descriptor, uint64_t offset,
                                    uint32_t value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(uint32_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -823,6 +1018,7 @@ void Fam_Ops_Libfabric::atomic_min(Fam_Descriptor *descriptor, uint64_t offset,
                                    uint64_t value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(uint64_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -835,6 +1031,7 @@ void Fam_Ops_Libfabric::atomic_min(Fam_Descriptor *descriptor, uint64_t offset,
                                    float value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(float));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -847,6 +1044,7 @@ void Fam_Ops_Libfabric::atomic_min(Fam_Descriptor *descriptor, uint64_t offset,
                                    double value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(double));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -859,6 +1057,7 @@ void Fam_Ops_Libfabric::atomic_max(Fam_Descriptor *descriptor, uint64_t offset,
                                    int32_t value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(int32_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -871,6 +1070,7 @@ void Fam_Ops_Libfabric::atomic_max(Fam_Descriptor *descriptor, uint64_t offset,
                                    int64_t value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(int64_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -883,6 +1083,7 @@ void Fam_Ops_Libfabric::atomic_max(Fam_Descriptor *descriptor, uint64_t offset,
                                    uint32_t value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(uint32_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -895,6 +1096,7 @@ void Fam_Ops_Libfabric::atomic_max(Fam_Descriptor *descriptor, uint64_t offset,
                                    uint64_t value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(uint64_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -907,6 +1109,7 @@ void Fam_Ops_Libfabric::atomic_max(Fam_Descriptor *descriptor, uint64_t offset,
                                    float value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(float));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -919,6 +1122,7 @@ void Fam_Ops_Libfabric::atomic_max(Fam_Descriptor *descriptor, uint64_t offset,
                                    double value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(double));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -931,6 +1135,7 @@ void Fam_Ops_Libfabric::atomic_and(Fam_Descriptor *descriptor, uint64_t offset,
                                    uint32_t value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(uint32_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -943,6 +1148,7 @@ void Fam_Ops_Libfabric::atomic_and(Fam_Descriptor *descriptor, uint64_t offset,
                                    uint64_t value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(uint64_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -955,6 +1161,7 @@ void Fam_Ops_Libfabric::atomic_or(Fam_Descriptor *descriptor, uint64_t offset,
                                   uint32_t value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(uint32_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -967,6 +1174,7 @@ void Fam_Ops_Libfabric::atomic_or(Fam_Descriptor *descriptor, uint64_t offset,
                                   uint64_t value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(uint64_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -979,6 +1187,7 @@ void Fam_Ops_Libfabric::atomic_xor(Fam_Descriptor *descriptor, uint64_t offset,
                                    uint32_t value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(uint32_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -991,6 +1200,7 @@ void Fam_Ops_Libfabric::atomic_xor(Fam_Descriptor *descriptor, uint64_t offset,
                                    uint64_t value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(uint64_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -1003,6 +1213,7 @@ int32_t Fam_Ops_Libfabric::swap(Fam_Descriptor *descriptor, uint64_t offset,
                                 int32_t value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(int32_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -1017,6 +1228,7 @@ int64_t Fam_Ops_Libfabric::swap(Fam_Descriptor *descriptor, uint64_t offset,
                                 int64_t value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(int64_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -1031,6 +1243,7 @@ uint32_t Fam_Ops_Libfabric::swap(Fam_Descriptor *descriptor, uint64_t offset,
                                  uint32_t value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(uint32_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -1045,6 +1258,7 @@ uint64_t Fam_Ops_Libfabric::swap(Fam_Descriptor *descriptor, uint64_t offset,
                                  uint64_t value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(uint64_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -1059,6 +1273,7 @@ float Fam_Ops_Libfabric::swap(Fam_Descriptor *descriptor, uint64_t offset,
                               float value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(float));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -1073,6 +1288,7 @@ double Fam_Ops_Libfabric::swap(Fam_Descriptor *descriptor, uint64_t offset,
                                double value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(double));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -1088,6 +1304,7 @@ int32_t Fam_Ops_Libfabric::compare_swap(Fam_Descriptor *descriptor,
                                         int32_t newValue) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(int32_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -1103,6 +1320,7 @@ int64_t Fam_Ops_Libfabric::compare_swap(Fam_Descriptor *descriptor,
                                         int64_t newValue) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(int64_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -1118,6 +1336,7 @@ uint32_t Fam_Ops_Libfabric::compare_swap(Fam_Descriptor *descriptor,
                                          uint32_t newValue) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(uint32_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -1133,6 +1352,7 @@ uint64_t Fam_Ops_Libfabric::compare_swap(Fam_Descriptor *descriptor,
                                          uint64_t newValue) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(uint64_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -1148,6 +1368,7 @@ int128_t Fam_Ops_Libfabric::compare_swap(Fam_Descriptor *descriptor,
                                          int128_t newValue) {
 
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(int128_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -1179,6 +1400,7 @@ int32_t Fam_Ops_Libfabric::atomic_fetch_int32(Fam_Descriptor *descriptor,
                                               uint64_t offset) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(int32_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -1193,6 +1415,7 @@ int64_t Fam_Ops_Libfabric::atomic_fetch_int64(Fam_Descriptor *descriptor,
                                               uint64_t offset) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(int64_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -1207,6 +1430,7 @@ uint32_t Fam_Ops_Libfabric::atomic_fetch_uint32(Fam_Descriptor *descriptor,
                                                 uint64_t offset) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(uint32_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -1221,6 +1445,7 @@ uint64_t Fam_Ops_Libfabric::atomic_fetch_uint64(Fam_Descriptor *descriptor,
                                                 uint64_t offset) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(uint64_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -1235,6 +1460,7 @@ float Fam_Ops_Libfabric::atomic_fetch_float(Fam_Descriptor *descriptor,
                                             uint64_t offset) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(float));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -1249,6 +1475,7 @@ double Fam_Ops_Libfabric::atomic_fetch_double(Fam_Descriptor *descriptor,
                                               uint64_t offset) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(double));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -1263,6 +1490,7 @@ int32_t Fam_Ops_Libfabric::atomic_fetch_add(Fam_Descriptor *descriptor,
                                             uint64_t offset, int32_t value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(int32_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -1276,6 +1504,7 @@ int64_t Fam_Ops_Libfabric::atomic_fetch_add(Fam_Descriptor *descriptor,
                                             uint64_t offset, int64_t value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(int64_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -1289,6 +1518,7 @@ uint32_t Fam_Ops_Libfabric::atomic_fetch_add(Fam_Descriptor *descriptor,
                                              uint64_t offset, uint32_t value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(uint32_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -1302,6 +1532,7 @@ uint64_t Fam_Ops_Libfabric::atomic_fetch_add(Fam_Descriptor *descriptor,
                                              uint64_t offset, uint64_t value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(uint64_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -1315,6 +1546,7 @@ float Fam_Ops_Libfabric::atomic_fetch_add(Fam_Descriptor *descriptor,
                                           uint64_t offset, float value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(float));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -1328,6 +1560,7 @@ double Fam_Ops_Libfabric::atomic_fetch_add(Fam_Descriptor *descriptor,
                                            uint64_t offset, double value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(double));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -1375,6 +1608,7 @@ int32_t Fam_Ops_Libfabric::atomic_fetch_min(Fam_Descriptor *descriptor,
                                             uint64_t offset, int32_t value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(int32_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -1388,6 +1622,7 @@ int64_t Fam_Ops_Libfabric::atomic_fetch_min(Fam_Descriptor *descriptor,
                                             uint64_t offset, int64_t value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(int64_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -1401,6 +1636,7 @@ uint32_t Fam_Ops_Libfabric::atomic_fetch_min(Fam_Descriptor *descriptor,
                                              uint64_t offset, uint32_t value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(uint32_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -1414,6 +1650,7 @@ uint64_t Fam_Ops_Libfabric::atomic_fetch_min(Fam_Descriptor *descriptor,
                                              uint64_t offset, uint64_t value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(uint64_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -1427,6 +1664,7 @@ float Fam_Ops_Libfabric::atomic_fetch_min(Fam_Descriptor *descriptor,
                                           uint64_t offset, float value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(float));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -1440,6 +1678,7 @@ double Fam_Ops_Libfabric::atomic_fetch_min(Fam_Descriptor *descriptor,
                                            uint64_t offset, double value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(double));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -1453,6 +1692,7 @@ int32_t Fam_Ops_Libfabric::atomic_fetch_max(Fam_Descriptor *descriptor,
                                             uint64_t offset, int32_t value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(int32_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -1466,6 +1706,7 @@ int64_t Fam_Ops_Libfabric::atomic_fetch_max(Fam_Descriptor *descriptor,
                                             uint64_t offset, int64_t value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(int64_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -1479,6 +1720,7 @@ uint32_t Fam_Ops_Libfabric::atomic_fetch_max(Fam_Descriptor *descriptor,
                                              uint64_t offset, uint32_t value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(uint32_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -1492,6 +1734,7 @@ uint64_t Fam_Ops_Libfabric::atomic_fetch_max(Fam_Descriptor *descriptor,
                                              uint64_t offset, uint64_t value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(uint64_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -1505,6 +1748,7 @@ float Fam_Ops_Libfabric::atomic_fetch_max(Fam_Descriptor *descriptor,
                                           uint64_t offset, float value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(float));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -1518,6 +1762,7 @@ double Fam_Ops_Libfabric::atomic_fetch_max(Fam_Descriptor *descriptor,
                                            uint64_t offset, double value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(double));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -1531,6 +1776,7 @@ uint32_t Fam_Ops_Libfabric::atomic_fetch_and(Fam_Descriptor *descriptor,
                                              uint64_t offset, uint32_t value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(uint32_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -1544,6 +1790,7 @@ uint64_t Fam_Ops_Libfabric::atomic_fetch_and(Fam_Descriptor *descriptor,
                                              uint64_t offset, uint64_t value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(uint64_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -1557,6 +1804,7 @@ uint32_t Fam_Ops_Libfabric::atomic_fetch_or(Fam_Descriptor *descriptor,
                                             uint64_t offset, uint32_t value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(uint32_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -1570,6 +1818,7 @@ uint64_t Fam_Ops_Libfabric::atomic_fetch_or(Fam_Descriptor *descriptor,
                                             uint64_t offset, uint64_t value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(uint64_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -1583,6 +1832,7 @@ uint32_t Fam_Ops_Libfabric::atomic_fetch_xor(Fam_Descriptor *descriptor,
                                              uint64_t offset, uint32_t value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(uint32_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -1596,6 +1846,7 @@ uint64_t Fam_Ops_Libfabric::atomic_fetch_xor(Fam_Descriptor *descriptor,
                                              uint64_t offset, uint64_t value) {
     std::ostringstream message;
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(uint64_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -1610,6 +1861,7 @@ void Fam_Ops_Libfabric::abort(int status) FAM_OPS_UNIMPLEMENTED(void_);
 void Fam_Ops_Libfabric::atomic_set(Fam_Descriptor *descriptor, uint64_t offset,
                                    int128_t value) {
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(int128_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
@@ -1627,6 +1879,7 @@ void Fam_Ops_Libfabric::atomic_set(Fam_Descriptor *descriptor, uint64_t offset,
 int128_t Fam_Ops_Libfabric::atomic_fetch_int128(Fam_Descriptor *descriptor,
                                                 uint64_t offset) {
     uint64_t key = descriptor->get_key();
+    check_range(descriptor, offset, sizeof(int128_t));
     uint64_t nodeId = descriptor->get_memserver_id();
 
     int128_t local;
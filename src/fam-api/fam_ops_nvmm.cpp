@@ -38,6 +38,7 @@
 
 #include "allocator/fam_allocator_nvmm.h"
 #include "common/fam_context.h"
+#include "common/fam_fill.h"
 #include "common/fam_ops.h"
 #include "common/fam_ops_nvmm.h"
 #include "common/fam_util_atomic.h"
@@ -352,6 +353,46 @@ int Fam_Ops_NVMM::scatter_blocking(void *local, Fam_Descriptor *descriptor,
     return FAM_SUCCESS;
 }
 
+int Fam_Ops_NVMM::get_iov_blocking(Fam_Descriptor *descriptor,
+                                   struct iovec *iov, const uint64_t *offsets,
+                                   uint64_t count) {
+    for (uint64_t i = 0; i < count; i++) {
+        get_blocking(iov[i].iov_base, descriptor, offsets[i], iov[i].iov_len);
+    }
+    return FAM_SUCCESS;
+}
+
+int Fam_Ops_NVMM::put_iov_blocking(Fam_Descriptor *descriptor,
+                                   struct iovec *iov, const uint64_t *offsets,
+                                   uint64_t count) {
+    for (uint64_t i = 0; i < count; i++) {
+        put_blocking(iov[i].iov_base, descriptor, offsets[i], iov[i].iov_len);
+    }
+    return FAM_SUCCESS;
+}
+
+void Fam_Ops_NVMM::get_iov_nonblocking(Fam_Descriptor *descriptor,
+                                       struct iovec *iov,
+                                       const uint64_t *offsets,
+                                       uint64_t count) {
+    for (uint64_t i = 0; i < count; i++) {
+        get_nonblocking(iov[i].iov_base, descriptor, offsets[i],
+                        iov[i].iov_len);
+    }
+    return;
+}
+
+void Fam_Ops_NVMM::put_iov_nonblocking(Fam_Descriptor *descriptor,
+                                       struct iovec *iov,
+                                       const uint64_t *offsets,
+                                       uint64_t count) {
+    for (uint64_t i = 0; i < count; i++) {
+        put_nonblocking(iov[i].iov_base, descriptor, offsets[i],
+                        iov[i].iov_len);
+    }
+    return;
+}
+
 void Fam_Ops_NVMM::put_nonblocking(void *local, Fam_Descriptor *descriptor,
                                    uint64_t offset, uint64_t nbytes) {
     void *base = descriptor->get_base_address();
@@ -376,6 +417,20 @@ void Fam_Ops_NVMM::put_nonblocking(void *local, Fam_Descriptor *descriptor,
     return;
 }
 
+void Fam_Ops_NVMM::put_signal(void *local, Fam_Descriptor *descriptor,
+                              uint64_t offset, uint64_t nbytes,
+                              Fam_Descriptor *sigDescriptor,
+                              uint64_t sigOffset, uint64_t sigValue,
+                              Fam_Signal_Op op) {
+    // The data is stored and persisted before the atomic update of the signal
+    put_blocking(local, descriptor, offset, nbytes);
+    if (op == FAM_SIGNAL_ADD)
+        atomic_add(sigDescriptor, sigOffset, sigValue);
+    else
+        atomic_set(sigDescriptor, sigOffset, sigValue);
+    return;
+}
+
 void Fam_Ops_NVMM::get_nonblocking(void *local, Fam_Descriptor *descriptor,
                                    uint64_t offset, uint64_t nbytes) {
     void *base = descriptor->get_base_address();
@@ -621,10 +676,94 @@ void *Fam_Ops_NVMM::copy(Fam_Descriptor *src, uint64_t srcOffset,
     return (void *)tag;
 }
 
+/*
+ * Both data items are in local shared memory; the copy is queued to the
+ * asynchronous handler like the one into a new data item.
+ */
+void *Fam_Ops_NVMM::copy(Fam_Descriptor *src, uint64_t srcOffset,
+                         Fam_Descriptor *dest, uint64_t destOffset,
+                         uint64_t nbytes) {
+    uint64_t srcSize = src->get_size();
+    uint64_t destSize = dest->get_size();
+
+    if ((srcOffset > srcSize) || ((srcOffset + nbytes) > srcSize)) {
+        throw Fam_Allocator_Exception(
+            FAM_ERR_OUTOFRANGE,
+            "Source offset or size is beyond dataitem boundary");
+    }
+
+    if ((destOffset > destSize) || ((destOffset + nbytes) > destSize)) {
+        throw Fam_Allocator_Exception(
+            FAM_ERR_OUTOFRANGE,
+            "Destination offset or size is beyond dataitem boundary");
+    }
+
+    if ((src->get_key() & FAM_READ_KEY_SHM) != FAM_READ_KEY_SHM) {
+        throw Fam_Datapath_Exception(FAM_ERR_NOPERM,
+                                     "not permitted to read from dataitem");
+    }
+
+    if ((dest->get_key() & FAM_WRITE_KEY_SHM) != FAM_WRITE_KEY_SHM) {
+        throw Fam_Datapath_Exception(FAM_ERR_NOPERM,
+                                     "not permitted to write into dataitem");
+    }
+
+    void *srcStart = (void *)((uint64_t)src->get_base_address() + srcOffset);
+    void *destStart =
+        (void *)((uint64_t)dest->get_base_address() + destOffset);
+    Copy_Tag *tag = new Copy_Tag();
+    tag->copyDone.store(false, boost::memory_order_seq_cst);
+
+    Fam_Ops_Info opsInfo = {COPY, srcStart, destStart, nbytes, 0,
+                            0,    0,        destSize,  tag};
+    asyncQHandler->initiate_operation(opsInfo);
+
+    return (void *)tag;
+}
+
 void Fam_Ops_NVMM::wait_for_copy(void *waitObj) {
     asyncQHandler->wait_for_copy(waitObj);
 }
 
+/*
+ * The data item is in local shared memory, so it is filled in place; the
+ * returned tag is already complete.
+ */
+void *Fam_Ops_NVMM::fill(Fam_Descriptor *descriptor, uint64_t offset,
+                         uint64_t nbytes, uint64_t pattern,
+                         uint64_t patternSize) {
+    void *base = descriptor->get_base_address();
+    uint64_t size = descriptor->get_size();
+    uint64_t key = descriptor->get_key();
+
+    if ((offset > size) || ((offset + nbytes) > size)) {
+        throw Fam_Datapath_Exception(FAM_ERR_OUTOFRANGE,
+                                     "offset or data size is out of bound");
+    }
+
+    if ((key & FAM_WRITE_KEY_SHM) != FAM_WRITE_KEY_SHM) {
+        throw Fam_Datapath_Exception(FAM_ERR_NOPERM,
+                                     "not permitted to write into dataitem");
+    }
+
+    void *dest = (void *)((uint64_t)base + offset);
+
+    Fam_Context *famCtx = get_context(descriptor);
+
+    // Take Fam_Context read lock
+    famCtx->aquire_RDLock();
+
+    fam_fill_local(dest, nbytes, pattern, patternSize);
+    openfam_persist(dest, nbytes);
+
+    // Release Fam_Context read lock
+    famCtx->release_lock();
+
+    Copy_Tag *tag = new Copy_Tag();
+    tag->copyDone.store(true, boost::memory_order_seq_cst);
+    return (void *)tag;
+}
+
 void Fam_Ops_NVMM::fence(Fam_Region_Descriptor *descriptor)
     FAM_OPS_UNIMPLEMENTED(void_);
 
@@ -54,6 +54,9 @@ int main(int argc, char *argv[]) {
     char *name = strdup("127.0.0.1");
     char *libfabricPort = strdup("7500");
     char *provider = strdup("sockets");
+    uint64_t rpcThreads = 0;
+    bool regionMr = false;
+    MemServerMap peers;
 
     for (int i = 1; i < argc; i++) {
         if ((std::string(argv[i]) == "-h") ||
@@ -73,6 +76,31 @@ int main(int argc, char *argv[]) {
                  << "\t-p/--provider       : Libfabric provider (default value "
                     "is \"sockets\") \n"
                  << "\n"
+                 << "\t-t/--rpcthreads     : Number of threads serving RPCs, "
+                    "each with its own \n"
+                 << "\t                      completion queue (default value "
+                    "is the number of cores) \n"
+                 << "\n"
+                 << "\t-g/--mrgranularity  : Granularity of the memory "
+                    "registrations, item or \n"
+                 << "\t                      region (default value is item). A "
+                    "key of a region \n"
+                 << "\t                      registered as a whole reaches all "
+                    "its data items, \n"
+                 << "\t                      so the data items of regions "
+                    "created in region \n"
+                 << "\t                      mode must have the owner and "
+                    "permission of their \n"
+                 << "\t                      region, which can not be "
+                    "changed \n"
+                 << "\n"
+                 << "\t-s/--memservers     : Memory servers copies may be "
+                    "pushed to, as a comma \n"
+                 << "\t                      separated list of id:address, "
+                    "like the memory server \n"
+                 << "\t                      option of the clients (default "
+                    "value is none) \n"
+                 << "\n"
                  << endl;
             exit(0);
         } else if ((std::string(argv[i]) == "-m") ||
@@ -87,6 +115,27 @@ int main(int argc, char *argv[]) {
         } else if ((std::string(argv[i]) == "-p") ||
                    (std::string(argv[i]) == "--provider")) {
             provider = strdup(argv[++i]);
+        } else if ((std::string(argv[i]) == "-t") ||
+                   (std::string(argv[i]) == "--rpcthreads")) {
+            rpcThreads = atoi(argv[++i]);
+        } else if ((std::string(argv[i]) == "-g") ||
+                   (std::string(argv[i]) == "--mrgranularity")) {
+            regionMr = (std::string(argv[++i]) == "region");
+        } else if ((std::string(argv[i]) == "-s") ||
+                   (std::string(argv[i]) == "--memservers")) {
+            std::string list(argv[++i]);
+            size_t start = 0;
+            while (start < list.length()) {
+                size_t end = list.find(',', start);
+                if (end == std::string::npos)
+                    end = list.length();
+                std::string server = list.substr(start, end - start);
+                size_t sep = server.find(':');
+                if (sep != std::string::npos)
+                    peers.insert({stoull(server.substr(0, sep)),
+                                  server.substr(sep + 1)});
+                start = end + 1;
+            }
         }
     }
 
@@ -98,7 +147,8 @@ int main(int argc, char *argv[]) {
 
     Fam_Rpc_Server *rpcService = NULL;
     try {
-        rpcService = new Fam_Rpc_Server(rpcPort, name, libfabricPort, provider);
+        rpcService = new Fam_Rpc_Server(rpcPort, name, libfabricPort, provider,
+                                        rpcThreads, regionMr, peers);
         rpcService->run();
     } catch (Memserver_Exception &e) {
         if (rpcService) {
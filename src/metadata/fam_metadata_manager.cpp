@@ -129,6 +129,11 @@ class FAM_Metadata_Manager::Impl_ {
                                const std::string regionName,
                                Fam_DataItem_Metadata &dataitem);
 
+    int metadata_find_dataitems(const uint64_t regionId,
+                                const std::vector<uint64_t> &dataitemIds,
+                                std::vector<Fam_DataItem_Metadata> &dataitems,
+                                std::vector<int> &rets);
+
     int metadata_modify_dataitem(const uint64_t dataitemId,
                                  const uint64_t regionId,
                                  Fam_DataItem_Metadata *dataitem);
@@ -1521,6 +1526,60 @@ int FAM_Metadata_Manager::Impl_::metadata_find_dataitem(
     return ret;
 }
 
+/**
+ * metadata_find_dataitems - Lookup several dataitem ids of a region in
+ *   	metadata region KVS, finding the region and its KVS once
+ * @param regionId - Region Id to which the dataitems belong.
+ * @param dataitemIds - dataitem Ids
+ * @param &dataitems - returns the descriptors of the dataitems, indexed like
+ *dataitemIds
+ * @param &rets - returns META_NO_ERROR for each dataitem found, the error of
+ *its lookup otherwise
+ * @return - META_NO_ERROR if the region exists, META_KEY_DOES_NOT_EXIST if
+ *not found
+ *
+ */
+int FAM_Metadata_Manager::Impl_::metadata_find_dataitems(
+    const uint64_t regionId, const std::vector<uint64_t> &dataitemIds,
+    std::vector<Fam_DataItem_Metadata> &dataitems, std::vector<int> &rets) {
+
+    int ret;
+    char val_buf[max_val_len];
+    size_t val_len;
+
+    Fam_Region_Metadata regNode;
+
+    ret = metadata_find_region(regionId, regNode);
+    if (ret != META_NO_ERROR) {
+        DEBUG_STDOUT(regionId, "Region not found");
+        return ret;
+    }
+
+    KeyValueStore *dataitemIdKVS, *dataitemNameKVS;
+    ret = get_dataitem_KVS(regionId, dataitemIdKVS, dataitemNameKVS);
+    if (ret != META_NO_ERROR) {
+        return ret;
+    }
+
+    dataitems.resize(dataitemIds.size());
+    rets.resize(dataitemIds.size());
+    for (size_t ndx = 0; ndx < dataitemIds.size(); ndx++) {
+        std::string dataitemKey = std::to_string(dataitemIds[ndx]);
+
+        ResetBuf(val_buf, val_len, max_val_len);
+
+        rets[ndx] = dataitemIdKVS->Get(dataitemKey.c_str(), dataitemKey.size(),
+                                       val_buf, val_len);
+        if (rets[ndx] == META_NO_ERROR) {
+            memcpy((char *)&dataitems[ndx], (char const *)val_buf,
+                   sizeof(Fam_DataItem_Metadata));
+        } else {
+            DEBUG_STDERR(dataitemIds[ndx], "Get failed.");
+        }
+    }
+    return META_NO_ERROR;
+}
+
 /**
  * metadata_find_dataitem - Lookup a dataitem name in metadata region KVS
  * @param dataitemId - dataitem Id
@@ -1993,6 +2052,14 @@ FAM_Metadata_Manager::metadata_find_dataitem(const uint64_t dataitemId,
     return pimpl_->metadata_find_dataitem(dataitemId, regionName, dataitem);
 }
 
+int FAM_Metadata_Manager::metadata_find_dataitems(
+    const uint64_t regionId, const std::vector<uint64_t> &dataitemIds,
+    std::vector<Fam_DataItem_Metadata> &dataitems, std::vector<int> &rets) {
+
+    return pimpl_->metadata_find_dataitems(regionId, dataitemIds, dataitems,
+                                           rets);
+}
+
 int
 FAM_Metadata_Manager::metadata_find_dataitem(const std::string dataitemName,
                                              const uint64_t regionId,
@@ -41,6 +41,7 @@
 #include <string>
 #include <unistd.h>
 #include <map>
+#include <vector>
 
 #include "radixtree/kvs.h"
 #include "radixtree/radix_tree.h"
@@ -101,6 +102,11 @@ typedef struct {
     //   Fam_Redundancy_Level redundancyLevel;
     GlobalPtr dataItemIdRoot;
     GlobalPtr dataItemNameRoot;
+    /**
+     * Set for regions whose memory is registered as a whole: all the data
+     * items of such a region have the owner and the permission of the region
+     */
+    bool uniformItems;
 } Fam_Region_Metadata;
 
 /**
@@ -118,6 +124,11 @@ typedef struct {
     mode_t perm;
     char name[RadixTree::MAX_KEY_LEN];
     uint64_t size;
+    /**
+     * Nonce set at allocation, which tells apart dataitems allocated at
+     * the same offset one after the other
+     */
+    uint64_t generation;
 } Fam_DataItem_Metadata;
 
 typedef enum metadata_region_item_op {
@@ -192,6 +203,11 @@ class FAM_Metadata_Manager {
                                const std::string regionName,
                                Fam_DataItem_Metadata &dataitem);
 
+    int metadata_find_dataitems(const uint64_t regionId,
+                                const std::vector<uint64_t> &dataitemIds,
+                                std::vector<Fam_DataItem_Metadata> &dataitems,
+                                std::vector<int> &rets);
+
     int metadata_modify_dataitem(const uint64_t dataitemId,
                                  const uint64_t regionId,
                                  Fam_DataItem_Metadata *dataitem);
@@ -35,6 +35,11 @@
 #ifndef RUNTIME_H
 #define RUNTIME_H
 
+/*
+ * Maximum size of a value exchanged through the runtime key-value store
+ */
+#define RUNTIME_KVS_MAX_VALUE_LEN 512
+
 class Fam_Runtime {
 
   public:
@@ -44,6 +49,24 @@ class Fam_Runtime {
     virtual int num_pes(void) = 0;
     virtual int runtime_abort(int exitCode, const char msg[]) = 0;
     virtual int runtime_barrier_all() = 0;
+    /*
+     * Publish a key-value pair from the calling PE. The value becomes
+     * visible to other PEs only after runtime_kvs_fence() is called by all
+     * PEs.
+     */
+    virtual int runtime_kvs_put(const char *key, const void *value,
+                                size_t len) = 0;
+    /*
+     * Collective call which makes all published key-value pairs visible to
+     * every PE.
+     */
+    virtual int runtime_kvs_fence() = 0;
+    /*
+     * Read the value published by PE pe against the given key. On input
+     * len holds the size of value buffer, on return the size of the value.
+     */
+    virtual int runtime_kvs_get(int pe, const char *key, void *value,
+                                size_t *len) = 0;
     virtual ~Fam_Runtime() {}
 };
 #endif
@@ -42,6 +42,7 @@ class Pmi2_Runtime : public Fam_Runtime {
     int mInitrc;
     int mRank = -1;
     int mNumPEs = 0;
+    char mJobId[PMI2_MAX_VALLEN];
 
   public:
     /*
@@ -63,6 +64,9 @@ class Pmi2_Runtime : public Fam_Runtime {
             return rc;
         }
         mInitrc = rc;
+        if (PMI2_SUCCESS != (rc = PMI2_Job_GetId(mJobId, PMI2_MAX_VALLEN))) {
+            mInitrc = rc;
+        }
         return mInitrc;
     }
     /*
@@ -121,6 +125,53 @@ class Pmi2_Runtime : public Fam_Runtime {
         return rc;
     }
 
+    /*
+     * Publish a key-value pair. PMI2 values are strings, so the value is
+     * hex encoded before it is put into the KVS.
+     **/
+    int runtime_kvs_put(const char *key, const void *value, size_t len) {
+        char encoded[PMI2_MAX_VALLEN];
+        const unsigned char *bytes = (const unsigned char *)value;
+
+        if (2 * len + 1 > PMI2_MAX_VALLEN)
+            return -1;
+        for (size_t ndx = 0; ndx < len; ndx++) {
+            snprintf(&encoded[2 * ndx], 3, "%02x", bytes[ndx]);
+        }
+        encoded[2 * len] = '\0';
+        return PMI2_KVS_Put(key, encoded);
+    }
+
+    /*
+     * Fence across all PEs, making the published key-value pairs visible.
+     **/
+    int runtime_kvs_fence() { return PMI2_KVS_Fence(); }
+
+    /*
+     * Read and decode the value published by the given PE against the key.
+     **/
+    int runtime_kvs_get(int pe, const char *key, void *value, size_t *len) {
+        int rc;
+        int vallen = 0;
+        char encoded[PMI2_MAX_VALLEN];
+        unsigned char *bytes = (unsigned char *)value;
+
+        if (PMI2_SUCCESS != (rc = PMI2_KVS_Get(mJobId, pe, key, encoded,
+                                               PMI2_MAX_VALLEN, &vallen))) {
+            return rc;
+        }
+        if (vallen < 0 || (size_t)(vallen / 2) > *len)
+            return -1;
+        for (int ndx = 0; ndx < vallen / 2; ndx++) {
+            unsigned int byte;
+            if (sscanf(&encoded[2 * ndx], "%2x", &byte) != 1)
+                return -1;
+            bytes[ndx] = (unsigned char)byte;
+        }
+        *len = (size_t)(vallen / 2);
+        return 0;
+    }
+
     /*
      * Adding a dummy destructor
      */
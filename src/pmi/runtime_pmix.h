@@ -139,6 +139,71 @@ class Pmix_Runtime : public Fam_Runtime {
         return 0;
     }
 
+    /*
+     * Publish a key-value pair with global scope and commit it to the
+     * PMIx server.
+     **/
+    int runtime_kvs_put(const char *key, const void *value, size_t len) {
+        pmix_status_t rc;
+        pmix_value_t val;
+
+        PMIX_VALUE_CONSTRUCT(&val);
+        val.type = PMIX_BYTE_OBJECT;
+        val.data.bo.bytes = (char *)value;
+        val.data.bo.size = len;
+
+        if (PMIX_SUCCESS != (rc = PMIx_Put(PMIX_GLOBAL, key, &val))) {
+            return rc;
+        }
+        rc = PMIx_Commit();
+        return rc;
+    }
+
+    /*
+     * Fence across all PEs, collecting the committed key-value pairs.
+     **/
+    int runtime_kvs_fence() {
+        pmix_status_t rc;
+        pmix_proc_t proc;
+        pmix_info_t info;
+        bool collect = true;
+
+        PMIX_PROC_CONSTRUCT(&proc);
+        (void)strncpy(proc.nspace, mProc.nspace, PMIX_MAX_NSLEN);
+        proc.rank = PMIX_RANK_WILDCARD;
+
+        PMIX_INFO_CONSTRUCT(&info);
+        PMIX_INFO_LOAD(&info, PMIX_COLLECT_DATA, &collect, PMIX_BOOL);
+        rc = PMIx_Fence(&proc, 1, &info, 1);
+        PMIX_INFO_DESTRUCT(&info);
+        return rc;
+    }
+
+    /*
+     * Read the value published by the given PE against the key.
+     **/
+    int runtime_kvs_get(int pe, const char *key, void *value, size_t *len) {
+        pmix_status_t rc;
+        pmix_proc_t proc;
+        pmix_value_t *val;
+
+        PMIX_PROC_CONSTRUCT(&proc);
+        (void)strncpy(proc.nspace, mProc.nspace, PMIX_MAX_NSLEN);
+        proc.rank = pe;
+
+        if (PMIX_SUCCESS != (rc = PMIx_Get(&proc, key, NULL, 0, &val))) {
+            return rc;
+        }
+        if (val->type != PMIX_BYTE_OBJECT || val->data.bo.size > *len) {
+            PMIX_VALUE_RELEASE(val);
+            return -1;
+        }
+        memcpy(value, val->data.bo.bytes, val->data.bo.size);
+        *len = val->data.bo.size;
+        PMIX_VALUE_RELEASE(val);
+        return 0;
+    }
+
     /*
      * Adding a dummy destructor
      */
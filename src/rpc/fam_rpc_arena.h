@@ -0,0 +1,108 @@
+/*
+ * fam_rpc_arena.h
+ * Copyright (c) 2019 Hewlett Packard Enterprise Development, LP. All rights
+ * reserved. Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+
+#ifndef FAM_RPC_ARENA_H
+#define FAM_RPC_ARENA_H
+
+#include <google/protobuf/arena.h>
+
+/**
+ * Size of the block embedded in each arena; it holds the request and response
+ * messages of the control RPCs without any further allocation.
+ */
+#define FAM_RPC_ARENA_BLOCK_SIZE 4096
+
+namespace openfam {
+
+/**
+ * Protobuf arena for the messages of an RPC. Messages are allocated from a
+ * block embedded in the arena, and are all freed together when the arena is
+ * reset or destroyed.
+ */
+class Fam_Rpc_Arena {
+  public:
+    Fam_Rpc_Arena() : arena(arena_options(block)) {}
+
+    template <class Message> Message *create() {
+        return google::protobuf::Arena::CreateMessage<Message>(&arena);
+    }
+
+    void reset() { arena.Reset(); }
+
+  private:
+    static google::protobuf::ArenaOptions arena_options(char *initialBlock) {
+        google::protobuf::ArenaOptions options;
+        options.initial_block = initialBlock;
+        options.initial_block_size = FAM_RPC_ARENA_BLOCK_SIZE;
+        return options;
+    }
+
+    char block[FAM_RPC_ARENA_BLOCK_SIZE];
+    google::protobuf::Arena arena;
+};
+
+/**
+ * Scope of a synchronous client call. Its messages are created on an arena
+ * owned by the calling thread, which is reset when the outermost scope of the
+ * thread ends, so that the arena is reused by the next call.
+ */
+class Fam_Rpc_Arena_Scope {
+  public:
+    Fam_Rpc_Arena_Scope() : arena(thread_state().arena) {
+        thread_state().depth++;
+    }
+
+    ~Fam_Rpc_Arena_Scope() {
+        if (--thread_state().depth == 0)
+            arena.reset();
+    }
+
+    template <class Message> Message *create() {
+        return arena.template create<Message>();
+    }
+
+  private:
+    struct Thread_State {
+        Thread_State() : depth(0) {}
+        Fam_Rpc_Arena arena;
+        int depth;
+    };
+
+    static Thread_State &thread_state() {
+        static thread_local Thread_State state;
+        return state;
+    }
+
+    Fam_Rpc_Arena &arena;
+};
+
+} // namespace openfam
+
+#endif /* end of FAM_RPC_ARENA_H */
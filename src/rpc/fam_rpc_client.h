@@ -37,11 +37,17 @@
 #include <sstream>
 #include <string.h>
 #include <sys/types.h>
+#include <thread>
 #include <unistd.h>
+#include <vector>
 
+#include "common/fam_capability.h"
+#include "common/fam_scan.h"
+#include "common/fam_watch.h"
 #include "fam/fam.h"
 #include "fam/fam_exception.h"
 #include "rpc/fam_rpc.grpc.pb.h"
+#include "rpc/fam_rpc_arena.h"
 
 using namespace std;
 
@@ -50,6 +56,13 @@ using namespace std;
         cout << "returned from server..." << __func__                          \
              << " is Not Yet Implemented...!!!" << endl;                       \
     }
+
+/**
+ * Maximum number of items sent in a single batched RPC; keeps the messages
+ * well below the default grpc message size limit.
+ */
+#define FAM_RPC_MAX_BATCH_ITEMS 8192
+
 namespace openfam {
 
 /**
@@ -75,15 +88,64 @@ typedef struct {
         responseReader;
 } Fam_Copy_Tag;
 
+/**
+ * Watch served by a memory server; a thread reads the event stream and
+ * records the changes until the watch is cancelled or the stream ends.
+ */
+class Fam_Watch_Grpc : public Fam_Watch {
+  public:
+    Fam_Watch_Grpc(Fam_Rpc::Stub *stub, const Fam_Watch_Request &req) {
+        reader = stub->watch(&ctx, req);
+        readerThread = std::thread(&Fam_Watch_Grpc::read_events, this);
+    }
+
+    ~Fam_Watch_Grpc() {
+        ctx.TryCancel();
+        readerThread.join();
+    }
+
+  private:
+    void read_events() {
+        Fam_Watch_Event event;
+        while (reader->Read(&event)) {
+            if (event.errorcode()) {
+                finish(event.errorcode(), event.errormsg());
+                reader->Finish();
+                return;
+            }
+            notify(event.watchoffset(), event.size());
+        }
+        ::grpc::Status status = reader->Finish();
+        if (status.ok() || (status.error_code() == ::grpc::CANCELLED))
+            finish();
+        else
+            finish(FAM_ERR_GRPC, status.error_message());
+    }
+
+    ::grpc::ClientContext ctx;
+    std::unique_ptr<::grpc::ClientReader<Fam_Watch_Event>> reader;
+    std::thread readerThread;
+};
+
 class Fam_Rpc_Client {
   public:
-    Fam_Rpc_Client(const char *name, uint64_t port) {
+    /**
+     * @param name - memory server name
+     * @param port - grpc port of the memory server
+     * @param fetchAddr - when false the memory server fabric address is not
+     * requested through signal_start; it is expected to be provided later by
+     * set_addr(), e.g. from the PMI runtime.
+     **/
+    Fam_Rpc_Client(const char *name, uint64_t port, bool fetchAddr = true) {
         std::ostringstream message;
         std::string name_s(name);
         name_s += ":" + std::to_string(port);
 
         uid = (uint32_t)getuid();
         gid = (uint32_t)getgid();
+        memServerFabricAddrSize = 0;
+        memServerFabricAddr = NULL;
+        isStarted = false;
 
         /** Creating a channel and stub **/
         this->stub = Fam_Rpc::NewStub(
@@ -94,8 +156,18 @@ class Fam_Rpc_Client {
             throw Fam_Allocator_Exception(FAM_ERR_GRPC, message.str().c_str());
         }
 
-        Fam_Request req;
-        Fam_Start_Response res;
+        if (fetchAddr)
+            signal_start();
+    }
+
+    /**
+     * Sends a start signal to the memory server and reads its fabric address
+     * from the response.
+     **/
+    void signal_start() {
+        Fam_Rpc_Arena_Scope scope;
+        Fam_Request &req = *scope.create<Fam_Request>();
+        Fam_Start_Response &res = *scope.create<Fam_Start_Response>();
 
         ::grpc::ClientContext ctx;
         /** sending a start signal to server **/
@@ -104,6 +176,8 @@ class Fam_Rpc_Client {
             throw Fam_Allocator_Exception(FAM_ERR_GRPC,
                                           (status.error_message()).c_str());
         }
+        isStarted = true;
+        free(memServerFabricAddr);
         memServerFabricAddrSize = res.addrnamelen();
         memServerFabricAddr = (char *)calloc(1, memServerFabricAddrSize);
 
@@ -131,7 +205,9 @@ class Fam_Rpc_Client {
 
         ::grpc::ClientContext ctx;
 
-        ::grpc::Status status = stub->signal_termination(&ctx, req, &res);
+        if (isStarted) {
+            ::grpc::Status status = stub->signal_termination(&ctx, req, &res);
+        }
 
         free(memServerFabricAddr);
     }
@@ -149,8 +225,9 @@ class Fam_Rpc_Client {
                                          mode_t permission,
                                          Fam_Redundancy_Level redundancyLevel,
                                          uint64_t memoryServerId) {
-        Fam_Region_Request req;
-        Fam_Region_Response res;
+        Fam_Rpc_Arena_Scope scope;
+        Fam_Region_Request &req = *scope.create<Fam_Region_Request>();
+        Fam_Region_Response &res = *scope.create<Fam_Region_Response>();
         ::grpc::ClientContext ctx;
 
         req.set_name(name);
@@ -186,8 +263,9 @@ class Fam_Rpc_Client {
      * @see fam_rpc.proto
      **/
     void destroy_region(Fam_Region_Descriptor *region) {
-        Fam_Region_Request req;
-        Fam_Region_Response res;
+        Fam_Rpc_Arena_Scope scope;
+        Fam_Region_Request &req = *scope.create<Fam_Region_Request>();
+        Fam_Region_Response &res = *scope.create<Fam_Region_Response>();
         ::grpc::ClientContext ctx;
 
         Fam_Global_Descriptor globalDescriptor =
@@ -220,8 +298,9 @@ class Fam_Rpc_Client {
      * @see fam_rpc.proto
      **/
     int resize_region(Fam_Region_Descriptor *region, size_t nbytes) {
-        Fam_Region_Request req;
-        Fam_Region_Response res;
+        Fam_Rpc_Arena_Scope scope;
+        Fam_Region_Request &req = *scope.create<Fam_Region_Request>();
+        Fam_Region_Response &res = *scope.create<Fam_Region_Response>();
         ::grpc::ClientContext ctx;
 
         Fam_Global_Descriptor globalDescriptor =
@@ -258,8 +337,9 @@ class Fam_Rpc_Client {
      **/
     Fam_Descriptor *allocate(const char *name, size_t nbytes, mode_t permission,
                              Fam_Region_Descriptor *region) {
-        Fam_Dataitem_Request req;
-        Fam_Dataitem_Response res;
+        Fam_Rpc_Arena_Scope scope;
+        Fam_Dataitem_Request &req = *scope.create<Fam_Dataitem_Request>();
+        Fam_Dataitem_Response &res = *scope.create<Fam_Dataitem_Response>();
         ::grpc::ClientContext ctx;
 
         Fam_Global_Descriptor globalDescriptor =
@@ -286,6 +366,7 @@ class Fam_Rpc_Client {
                 Fam_Descriptor *dataItem =
                     new Fam_Descriptor(globalDescriptor, nbytes);
                 dataItem->bind_key(res.key());
+                dataItem->set_capability(get_capability(res.capability()));
                 return dataItem;
             }
         } else {
@@ -301,8 +382,9 @@ class Fam_Rpc_Client {
      * @see fam_rpc.proto
      **/
     void deallocate(Fam_Descriptor *dataitem) {
-        Fam_Dataitem_Request req;
-        Fam_Dataitem_Response res;
+        Fam_Rpc_Arena_Scope scope;
+        Fam_Dataitem_Request &req = *scope.create<Fam_Dataitem_Request>();
+        Fam_Dataitem_Response &res = *scope.create<Fam_Dataitem_Response>();
         ::grpc::ClientContext ctx;
 
         Fam_Global_Descriptor globalDescriptor =
@@ -335,8 +417,9 @@ class Fam_Rpc_Client {
      * @param permission - new permission
      **/
     int change_permission(Fam_Region_Descriptor *region, mode_t permission) {
-        Fam_Region_Request req;
-        Fam_Region_Response res;
+        Fam_Rpc_Arena_Scope scope;
+        Fam_Region_Request &req = *scope.create<Fam_Region_Request>();
+        Fam_Region_Response &res = *scope.create<Fam_Region_Response>();
         ::grpc::ClientContext ctx;
 
         Fam_Global_Descriptor globalDescriptor =
@@ -368,8 +451,9 @@ class Fam_Rpc_Client {
      * @param permission - new permission
      **/
     int change_permission(Fam_Descriptor *dataitem, mode_t permission) {
-        Fam_Dataitem_Request req;
-        Fam_Dataitem_Response res;
+        Fam_Rpc_Arena_Scope scope;
+        Fam_Dataitem_Request &req = *scope.create<Fam_Dataitem_Request>();
+        Fam_Dataitem_Response &res = *scope.create<Fam_Dataitem_Response>();
         ::grpc::ClientContext ctx;
 
         Fam_Global_Descriptor globalDescriptor =
@@ -398,8 +482,9 @@ class Fam_Rpc_Client {
 
     Fam_Region_Descriptor *lookup_region(const char *name,
                                          uint64_t memoryServerId) {
-        Fam_Region_Request req;
-        Fam_Region_Response res;
+        Fam_Rpc_Arena_Scope scope;
+        Fam_Region_Request &req = *scope.create<Fam_Region_Request>();
+        Fam_Region_Response &res = *scope.create<Fam_Region_Response>();
         ::grpc::ClientContext ctx;
 
         req.set_name(name);
@@ -429,8 +514,9 @@ class Fam_Rpc_Client {
 
     Fam_Descriptor *lookup(const char *itemName, const char *regionName,
                            uint64_t memoryServerId) {
-        Fam_Dataitem_Request req;
-        Fam_Dataitem_Response res;
+        Fam_Rpc_Arena_Scope scope;
+        Fam_Dataitem_Request &req = *scope.create<Fam_Dataitem_Request>();
+        Fam_Dataitem_Response &res = *scope.create<Fam_Dataitem_Response>();
         ::grpc::ClientContext ctx;
 
         req.set_name(itemName);
@@ -451,7 +537,13 @@ class Fam_Rpc_Client {
                 globalDescriptor.offset = res.offset();
                 Fam_Descriptor *dataItem =
                     new Fam_Descriptor(globalDescriptor, res.size());
-                dataItem->bind_key(FAM_KEY_UNINITIALIZED);
+                if (res.has_capability()) {
+                    dataItem->bind_key(res.key());
+                    dataItem->set_capability(
+                        get_capability(res.capability()));
+                } else {
+                    dataItem->bind_key(FAM_KEY_UNINITIALIZED);
+                }
                 return dataItem;
             }
         } else {
@@ -460,10 +552,195 @@ class Fam_Rpc_Client {
         }
     }
 
+    /**
+     * Allocate nItems data items in a region, with one request to the memory
+     * server per FAM_RPC_MAX_BATCH_ITEMS items. If any item can not be
+     * allocated, the items allocated so far are released.
+     **/
+    void allocate_batch(const char **names, const uint64_t *sizes,
+                        uint64_t nItems, mode_t permission,
+                        Fam_Region_Descriptor *region,
+                        Fam_Descriptor **descriptors) {
+        Fam_Global_Descriptor regionDescriptor =
+            region->get_global_descriptor();
+        uint64_t nodeId = region->get_memserver_id();
+        for (uint64_t start = 0; start < nItems;
+             start += FAM_RPC_MAX_BATCH_ITEMS) {
+            uint64_t count = nItems - start;
+            if (count > FAM_RPC_MAX_BATCH_ITEMS)
+                count = FAM_RPC_MAX_BATCH_ITEMS;
+
+            Fam_Rpc_Arena_Scope scope;
+            Fam_Dataitem_Batch_Request &req =
+                *scope.create<Fam_Dataitem_Batch_Request>();
+            Fam_Dataitem_Batch_Response &res =
+                *scope.create<Fam_Dataitem_Batch_Response>();
+            ::grpc::ClientContext ctx;
+
+            req.set_uid(uid);
+            req.set_gid(gid);
+            req.set_regionid(regionDescriptor.regionId & REGIONID_MASK);
+            req.set_perm(permission);
+            for (uint64_t ndx = start; ndx < start + count; ndx++) {
+                Fam_Dataitem_Request *item = req.add_items();
+                if (names && names[ndx])
+                    item->set_name(names[ndx]);
+                item->set_size(sizes[ndx]);
+            }
+
+            ::grpc::Status status = stub->allocate_batch(&ctx, req, &res);
+
+            if (!status.ok()) {
+                release_descriptors(descriptors, start);
+                throw Fam_Allocator_Exception(FAM_ERR_GRPC,
+                                              (status.error_message()).c_str());
+            }
+            if (res.errorcode()) {
+                release_descriptors(descriptors, start);
+                throw Fam_Allocator_Exception((enum Fam_Error)res.errorcode(),
+                                              (res.errormsg()).c_str());
+            }
+            for (uint64_t ndx = 0; ndx < count; ndx++) {
+                const Fam_Dataitem_Response &item = res.items((int)ndx);
+                Fam_Global_Descriptor globalDescriptor;
+                globalDescriptor.regionId =
+                    item.regionid() | (nodeId << MEMSERVERID_SHIFT);
+                globalDescriptor.offset = item.offset();
+                descriptors[start + ndx] =
+                    new Fam_Descriptor(globalDescriptor, sizes[start + ndx]);
+                descriptors[start + ndx]->bind_key(item.key());
+                descriptors[start + ndx]->set_capability(
+                    get_capability(item.capability()));
+            }
+        }
+    }
+
+    /**
+     * Deallocate the data items at the given indices of descriptors, with one
+     * request to the memory server per FAM_RPC_MAX_BATCH_ITEMS items. All the
+     * items are processed; the first error encountered is then reported.
+     **/
+    void deallocate_batch(Fam_Descriptor **descriptors,
+                          std::vector<uint64_t> &index) {
+        int errorCode = 0;
+        std::string errorMsg;
+        for (size_t start = 0; start < index.size();
+             start += FAM_RPC_MAX_BATCH_ITEMS) {
+            size_t count = index.size() - start;
+            if (count > FAM_RPC_MAX_BATCH_ITEMS)
+                count = FAM_RPC_MAX_BATCH_ITEMS;
+
+            Fam_Rpc_Arena_Scope scope;
+            Fam_Dataitem_Batch_Request &req =
+                *scope.create<Fam_Dataitem_Batch_Request>();
+            Fam_Dataitem_Batch_Response &res =
+                *scope.create<Fam_Dataitem_Batch_Response>();
+            ::grpc::ClientContext ctx;
+
+            req.set_uid(uid);
+            req.set_gid(gid);
+            for (size_t ndx = start; ndx < start + count; ndx++) {
+                Fam_Global_Descriptor globalDescriptor =
+                    descriptors[index[ndx]]->get_global_descriptor();
+                Fam_Dataitem_Request *item = req.add_items();
+                item->set_regionid(globalDescriptor.regionId & REGIONID_MASK);
+                item->set_offset(globalDescriptor.offset);
+            }
+
+            ::grpc::Status status = stub->deallocate_batch(&ctx, req, &res);
+
+            if (!status.ok()) {
+                throw Fam_Allocator_Exception(FAM_ERR_GRPC,
+                                              (status.error_message()).c_str());
+            }
+            for (int ndx = 0; ndx < res.items_size(); ndx++) {
+                const Fam_Dataitem_Response &item = res.items(ndx);
+                if (item.errorcode() && !errorCode) {
+                    errorCode = item.errorcode();
+                    errorMsg = item.errormsg();
+                }
+            }
+        }
+        if (errorCode) {
+            throw Fam_Allocator_Exception((enum Fam_Error)errorCode,
+                                          errorMsg.c_str());
+        }
+    }
+
+    /**
+     * Looks up multiple data items of a region, one RPC per
+     * FAM_RPC_MAX_BATCH_ITEMS items.
+     * @param itemNames - names of the data items
+     * @param nItems - number of data items
+     * @param regionName - name of the region containing the data items
+     * @param memoryServerId - memory server hosting the region
+     * @param descriptors - array of nItems, filled with the descriptors
+     **/
+    void lookup_batch(const char **itemNames, uint64_t nItems,
+                      const char *regionName, uint64_t memoryServerId,
+                      Fam_Descriptor **descriptors) {
+        for (uint64_t start = 0; start < nItems;
+             start += FAM_RPC_MAX_BATCH_ITEMS) {
+            uint64_t count = nItems - start;
+            if (count > FAM_RPC_MAX_BATCH_ITEMS)
+                count = FAM_RPC_MAX_BATCH_ITEMS;
+
+            Fam_Rpc_Arena_Scope scope;
+            Fam_Dataitem_Batch_Request &req =
+                *scope.create<Fam_Dataitem_Batch_Request>();
+            Fam_Dataitem_Batch_Response &res =
+                *scope.create<Fam_Dataitem_Batch_Response>();
+            ::grpc::ClientContext ctx;
+
+            req.set_uid(uid);
+            req.set_gid(gid);
+            req.set_regionname(regionName);
+            for (uint64_t ndx = start; ndx < start + count; ndx++) {
+                req.add_items()->set_name(itemNames[ndx]);
+            }
+
+            ::grpc::Status status = stub->lookup_batch(&ctx, req, &res);
+
+            if (!status.ok()) {
+                free_descriptors(descriptors, start);
+                throw Fam_Allocator_Exception(FAM_ERR_GRPC,
+                                              (status.error_message()).c_str());
+            }
+            if (res.errorcode()) {
+                free_descriptors(descriptors, start);
+                throw Fam_Allocator_Exception((enum Fam_Error)res.errorcode(),
+                                              (res.errormsg()).c_str());
+            }
+            for (uint64_t ndx = 0; ndx < count; ndx++) {
+                const Fam_Dataitem_Response &item = res.items((int)ndx);
+                if (item.errorcode()) {
+                    free_descriptors(descriptors, start + ndx);
+                    throw Fam_Allocator_Exception(
+                        (enum Fam_Error)item.errorcode(),
+                        (item.errormsg()).c_str());
+                }
+                Fam_Global_Descriptor globalDescriptor;
+                globalDescriptor.regionId =
+                    item.regionid() | (memoryServerId << MEMSERVERID_SHIFT);
+                globalDescriptor.offset = item.offset();
+                descriptors[start + ndx] =
+                    new Fam_Descriptor(globalDescriptor, item.size());
+                if (item.has_capability()) {
+                    descriptors[start + ndx]->bind_key(item.key());
+                    descriptors[start + ndx]->set_capability(
+                        get_capability(item.capability()));
+                } else {
+                    descriptors[start + ndx]->bind_key(FAM_KEY_UNINITIALIZED);
+                }
+            }
+        }
+    }
+
     Fam_Region_Item_Info
     check_permission_get_info(Fam_Region_Descriptor *region) {
-        Fam_Region_Request req;
-        Fam_Region_Response res;
+        Fam_Rpc_Arena_Scope scope;
+        Fam_Region_Request &req = *scope.create<Fam_Region_Request>();
+        Fam_Region_Response &res = *scope.create<Fam_Region_Response>();
         ::grpc::ClientContext ctx;
         Fam_Region_Item_Info regionInfo;
 
@@ -491,8 +768,9 @@ class Fam_Rpc_Client {
     }
 
     Fam_Region_Item_Info check_permission_get_info(Fam_Descriptor *dataitem) {
-        Fam_Dataitem_Request req;
-        Fam_Dataitem_Response res;
+        Fam_Rpc_Arena_Scope scope;
+        Fam_Dataitem_Request &req = *scope.create<Fam_Dataitem_Request>();
+        Fam_Dataitem_Response &res = *scope.create<Fam_Dataitem_Response>();
         ::grpc::ClientContext ctx;
         Fam_Region_Item_Info itemInfo;
 
@@ -513,6 +791,7 @@ class Fam_Rpc_Client {
             } else {
                 itemInfo.key = res.key();
                 itemInfo.size = res.size();
+                dataitem->set_capability(get_capability(res.capability()));
                 return itemInfo;
             }
         } else {
@@ -521,12 +800,70 @@ class Fam_Rpc_Client {
         }
     }
 
+    /**
+     * Checks permission and gets key and size of multiple data items hosted
+     * by this memory server, one RPC per FAM_RPC_MAX_BATCH_ITEMS items.
+     * @param descriptors - array of data item descriptors
+     * @param index - indices into descriptors of the items to be resolved
+     * @param itemInfo - array indexed like descriptors, filled with the info
+     **/
+    void check_permission_get_info_batch(Fam_Descriptor **descriptors,
+                                         std::vector<uint64_t> &index,
+                                         Fam_Region_Item_Info *itemInfo) {
+        for (size_t start = 0; start < index.size();
+             start += FAM_RPC_MAX_BATCH_ITEMS) {
+            size_t count = index.size() - start;
+            if (count > FAM_RPC_MAX_BATCH_ITEMS)
+                count = FAM_RPC_MAX_BATCH_ITEMS;
+
+            Fam_Rpc_Arena_Scope scope;
+            Fam_Dataitem_Batch_Request &req =
+                *scope.create<Fam_Dataitem_Batch_Request>();
+            Fam_Dataitem_Batch_Response &res =
+                *scope.create<Fam_Dataitem_Batch_Response>();
+            ::grpc::ClientContext ctx;
+
+            req.set_uid(uid);
+            req.set_gid(gid);
+            for (size_t ndx = start; ndx < start + count; ndx++) {
+                Fam_Global_Descriptor globalDescriptor =
+                    descriptors[index[ndx]]->get_global_descriptor();
+                Fam_Dataitem_Request *item = req.add_items();
+                item->set_regionid(globalDescriptor.regionId & REGIONID_MASK);
+                item->set_offset(globalDescriptor.offset);
+            }
+
+            ::grpc::Status status =
+                stub->check_permission_get_item_info_batch(&ctx, req, &res);
+
+            if (!status.ok()) {
+                throw Fam_Allocator_Exception(FAM_ERR_GRPC,
+                                              (status.error_message()).c_str());
+            }
+            if (res.errorcode()) {
+                throw Fam_Allocator_Exception((enum Fam_Error)res.errorcode(),
+                                              (res.errormsg()).c_str());
+            }
+            for (size_t ndx = 0; ndx < count; ndx++) {
+                const Fam_Dataitem_Response &item = res.items((int)ndx);
+                if (item.errorcode()) {
+                    throw Fam_Allocator_Exception(
+                        (enum Fam_Error)item.errorcode(),
+                        (item.errormsg()).c_str());
+                }
+                itemInfo[index[start + ndx]].key = item.key();
+                itemInfo[index[start + ndx]].size = item.size();
+                descriptors[index[start + ndx]]->set_capability(
+                    get_capability(item.capability()));
+            }
+        }
+    }
+
     void *copy(Fam_Descriptor *src, uint64_t srcOffset, Fam_Descriptor **dest,
                uint64_t destOffset, uint64_t nbytes) {
-        Fam_Dataitem_Request req;
-        Fam_Dataitem_Response res;
-        Fam_Copy_Request copyReq;
-        Fam_Copy_Response copyRes;
+        Fam_Rpc_Arena_Scope scope;
+        Fam_Dataitem_Request &req = *scope.create<Fam_Dataitem_Request>();
+        Fam_Dataitem_Response &res = *scope.create<Fam_Dataitem_Response>();
         ::grpc::ClientContext ctx;
 
         Fam_Global_Descriptor srcGlobalDescriptor =
@@ -572,19 +909,54 @@ class Fam_Rpc_Client {
                                           (status.error_message()).c_str());
         }
 
+        return copy(src, srcOffset, *dest, destOffset, nbytes);
+    }
+
+    /**
+     * Copy into an existing data item. If remoteDest is set, the data item is
+     * held by another memory server, which this memory server pushes the
+     * data to.
+     */
+    void *copy(Fam_Descriptor *src, uint64_t srcOffset, Fam_Descriptor *dest,
+               uint64_t destOffset, uint64_t nbytes, bool remoteDest = false) {
+        Fam_Rpc_Arena_Scope scope;
+        Fam_Copy_Request &copyReq = *scope.create<Fam_Copy_Request>();
+
+        if ((srcOffset + nbytes) > src->get_size()) {
+            throw Fam_Allocator_Exception(
+                FAM_ERR_OUTOFRANGE,
+                "Source offset or size is beyond dataitem boundary");
+        }
+
+        if ((destOffset + nbytes) > dest->get_size()) {
+            throw Fam_Allocator_Exception(
+                FAM_ERR_OUTOFRANGE,
+                "Destination offset or size is beyond dataitem boundary");
+        }
+
+        Fam_Global_Descriptor srcGlobalDescriptor =
+            src->get_global_descriptor();
+        Fam_Global_Descriptor destGlobalDescriptor =
+            dest->get_global_descriptor();
         copyReq.set_regionid(srcGlobalDescriptor.regionId & REGIONID_MASK);
         copyReq.set_srcoffset(srcGlobalDescriptor.offset);
+        copyReq.set_destregionid(destGlobalDescriptor.regionId &
+                                 REGIONID_MASK);
         copyReq.set_destoffset(destGlobalDescriptor.offset);
         copyReq.set_srccopystart(srcOffset);
         copyReq.set_destcopystart(destOffset);
         copyReq.set_gid(gid);
         copyReq.set_uid(uid);
         copyReq.set_copysize(nbytes);
+        if (remoteDest) {
+            copyReq.set_remotedest(true);
+            copyReq.set_destmemserverid(dest->get_memserver_id());
+        }
 
         Fam_Copy_Tag *tag = new Fam_Copy_Tag();
 
         tag->isCompleted = false;
-        tag->memServerId = nodeId;
+        tag->memServerId = src->get_memserver_id();
 
         tag->responseReader = stub->PrepareAsynccopy(&tag->ctx, copyReq, &cq);
 
@@ -596,6 +968,37 @@ class Fam_Rpc_Client {
         return (void *)tag;
     }
 
+    void *fill(Fam_Descriptor *dataitem, uint64_t offset, uint64_t nbytes,
+               uint64_t pattern, uint64_t patternSize) {
+        Fam_Rpc_Arena_Scope scope;
+        Fam_Fill_Request &req = *scope.create<Fam_Fill_Request>();
+
+        Fam_Global_Descriptor globalDescriptor =
+            dataitem->get_global_descriptor();
+        req.set_regionid(globalDescriptor.regionId & REGIONID_MASK);
+        req.set_offset(globalDescriptor.offset);
+        req.set_uid(uid);
+        req.set_gid(gid);
+        req.set_filloffset(offset);
+        req.set_size(nbytes);
+        req.set_pattern(pattern);
+        req.set_patternsize((uint32_t)patternSize);
+
+        Fam_Copy_Tag *tag = new Fam_Copy_Tag();
+
+        tag->isCompleted = false;
+        tag->memServerId = dataitem->get_memserver_id();
+
+        tag->responseReader = stub->PrepareAsyncfill(&tag->ctx, req, &cq);
+
+        // StartCall initiates the RPC call
+        tag->responseReader->StartCall();
+
+        tag->responseReader->Finish(&tag->res, &tag->status, (void *)tag);
+
+        return (void *)tag;
+    }
+
     void wait_for_copy(void *waitObj) {
         void *got_tag;
         bool ok = false;
@@ -665,8 +1068,9 @@ class Fam_Rpc_Client {
     }
 
     void acquire_CAS_lock(Fam_Descriptor *dataitem) {
-        Fam_Dataitem_Request req;
-        Fam_Dataitem_Response res;
+        Fam_Rpc_Arena_Scope scope;
+        Fam_Dataitem_Request &req = *scope.create<Fam_Dataitem_Request>();
+        Fam_Dataitem_Response &res = *scope.create<Fam_Dataitem_Response>();
         ::grpc::ClientContext ctx;
 
         Fam_Global_Descriptor globalDescriptor =
@@ -689,8 +1093,9 @@ class Fam_Rpc_Client {
     }
 
     void release_CAS_lock(Fam_Descriptor *dataitem) {
-        Fam_Dataitem_Request req;
-        Fam_Dataitem_Response res;
+        Fam_Rpc_Arena_Scope scope;
+        Fam_Dataitem_Request &req = *scope.create<Fam_Dataitem_Request>();
+        Fam_Dataitem_Response &res = *scope.create<Fam_Dataitem_Response>();
         ::grpc::ClientContext ctx;
 
         Fam_Global_Descriptor globalDescriptor =
@@ -712,16 +1117,304 @@ class Fam_Rpc_Client {
         }
     }
 
+    bool wait_until(Fam_Descriptor *dataitem, uint64_t offset, Fam_Cmp cmp,
+                    uint64_t value, uint64_t timeout, uint64_t *current) {
+        Fam_Rpc_Arena_Scope scope;
+        Fam_Wait_Request &req = *scope.create<Fam_Wait_Request>();
+        Fam_Wait_Response &res = *scope.create<Fam_Wait_Response>();
+        ::grpc::ClientContext ctx;
+
+        Fam_Global_Descriptor globalDescriptor =
+            dataitem->get_global_descriptor();
+        req.set_regionid(globalDescriptor.regionId & REGIONID_MASK);
+        req.set_offset(globalDescriptor.offset);
+        req.set_uid(uid);
+        req.set_gid(gid);
+        req.set_waitoffset(offset);
+        req.set_cmp(cmp);
+        req.set_value(value);
+        req.set_timeout(timeout);
+
+        ::grpc::Status status = stub->wait_until(&ctx, req, &res);
+
+        if (status.ok()) {
+            if (res.errorcode()) {
+                throw Fam_Allocator_Exception((enum Fam_Error)res.errorcode(),
+                                              (res.errormsg()).c_str());
+            } else {
+                *current = res.value();
+                return res.satisfied();
+            }
+        } else {
+            throw Fam_Allocator_Exception(FAM_ERR_GRPC,
+                                          (status.error_message()).c_str());
+        }
+    }
+
+    Fam_Watch *watch(Fam_Descriptor *dataitem, uint64_t offset,
+                     uint64_t nbytes, uint64_t interval) {
+        Fam_Watch_Request req;
+
+        Fam_Global_Descriptor globalDescriptor =
+            dataitem->get_global_descriptor();
+        req.set_regionid(globalDescriptor.regionId & REGIONID_MASK);
+        req.set_offset(globalDescriptor.offset);
+        req.set_uid(uid);
+        req.set_gid(gid);
+        req.set_watchoffset(offset);
+        req.set_size(nbytes);
+        req.set_interval(interval);
+
+        return new Fam_Watch_Grpc(stub.get(), req);
+    }
+
+    uint64_t reduce_item(Fam_Descriptor *dataitem, uint64_t offset,
+                         uint64_t nElements, Fam_Type type, Fam_Reduce_Op op) {
+        Fam_Rpc_Arena_Scope scope;
+        Fam_Reduce_Request &req = *scope.create<Fam_Reduce_Request>();
+        Fam_Reduce_Response &res = *scope.create<Fam_Reduce_Response>();
+        ::grpc::ClientContext ctx;
+
+        Fam_Global_Descriptor globalDescriptor =
+            dataitem->get_global_descriptor();
+        req.set_regionid(globalDescriptor.regionId & REGIONID_MASK);
+        req.set_offset(globalDescriptor.offset);
+        req.set_uid(uid);
+        req.set_gid(gid);
+        req.set_reduceoffset(offset);
+        req.set_nelements(nElements);
+        req.set_type(type);
+        req.set_op(op);
+
+        ::grpc::Status status = stub->reduce_item(&ctx, req, &res);
+
+        if (status.ok()) {
+            if (res.errorcode()) {
+                throw Fam_Allocator_Exception((enum Fam_Error)res.errorcode(),
+                                              (res.errormsg()).c_str());
+            }
+            return res.result();
+        } else {
+            throw Fam_Allocator_Exception(FAM_ERR_GRPC,
+                                          (status.error_message()).c_str());
+        }
+    }
+
+    uint64_t scan(Fam_Descriptor *dataitem, uint64_t offset,
+                  const Fam_Scan_Query &query, void *local, uint64_t localSize,
+                  uint64_t *nScanned) {
+        Fam_Rpc_Arena_Scope scope;
+        Fam_Scan_Request &req = *scope.create<Fam_Scan_Request>();
+        Fam_Scan_Response &res = *scope.create<Fam_Scan_Response>();
+        ::grpc::ClientContext ctx;
+
+        set_scan_request(&req, dataitem, offset, query);
+        req.set_maxsize(localSize);
+
+        ::grpc::Status status = stub->scan(&ctx, req, &res);
+
+        if (status.ok()) {
+            if (res.errorcode()) {
+                throw Fam_Allocator_Exception((enum Fam_Error)res.errorcode(),
+                                              (res.errormsg()).c_str());
+            }
+            memcpy(local, res.data().data(),
+                   std::min((uint64_t)res.data().size(), localSize));
+            *nScanned = res.nscanned();
+            return res.nmatched();
+        } else {
+            throw Fam_Allocator_Exception(FAM_ERR_GRPC,
+                                          (status.error_message()).c_str());
+        }
+    }
+
+    uint64_t scan_to_item(Fam_Descriptor *dataitem, uint64_t offset,
+                          const Fam_Scan_Query &query, Fam_Descriptor *dest,
+                          uint64_t destOffset, uint64_t destSize,
+                          uint64_t *nScanned) {
+        Fam_Rpc_Arena_Scope scope;
+        Fam_Scan_Request &req = *scope.create<Fam_Scan_Request>();
+        Fam_Scan_Response &res = *scope.create<Fam_Scan_Response>();
+        ::grpc::ClientContext ctx;
+
+        Fam_Global_Descriptor destGlobalDescriptor =
+            dest->get_global_descriptor();
+        set_scan_request(&req, dataitem, offset, query);
+        req.set_maxsize(destSize);
+        req.set_todest(true);
+        req.set_destregionid(destGlobalDescriptor.regionId & REGIONID_MASK);
+        req.set_destoffset(destGlobalDescriptor.offset);
+        req.set_destscanoffset(destOffset);
+
+        ::grpc::Status status = stub->scan(&ctx, req, &res);
+
+        if (status.ok()) {
+            if (res.errorcode()) {
+                throw Fam_Allocator_Exception((enum Fam_Error)res.errorcode(),
+                                              (res.errormsg()).c_str());
+            }
+            *nScanned = res.nscanned();
+            return res.nmatched();
+        } else {
+            throw Fam_Allocator_Exception(FAM_ERR_GRPC,
+                                          (status.error_message()).c_str());
+        }
+    }
+
+    uint64_t checksum(Fam_Descriptor *dataitem, uint64_t offset,
+                      uint64_t nbytes, Fam_Checksum_Algo algo) {
+        Fam_Rpc_Arena_Scope scope;
+        Fam_Checksum_Request &req = *scope.create<Fam_Checksum_Request>();
+        Fam_Checksum_Response &res = *scope.create<Fam_Checksum_Response>();
+        ::grpc::ClientContext ctx;
+
+        Fam_Global_Descriptor globalDescriptor =
+            dataitem->get_global_descriptor();
+        req.set_regionid(globalDescriptor.regionId & REGIONID_MASK);
+        req.set_offset(globalDescriptor.offset);
+        req.set_uid(uid);
+        req.set_gid(gid);
+        req.set_checksumoffset(offset);
+        req.set_size(nbytes);
+        req.set_algo(algo);
+
+        ::grpc::Status status = stub->checksum(&ctx, req, &res);
+
+        if (status.ok()) {
+            if (res.errorcode()) {
+                throw Fam_Allocator_Exception((enum Fam_Error)res.errorcode(),
+                                              (res.errormsg()).c_str());
+            }
+            return res.digest();
+        } else {
+            throw Fam_Allocator_Exception(FAM_ERR_GRPC,
+                                          (status.error_message()).c_str());
+        }
+    }
+
+    bool compare(Fam_Descriptor *dataitem, uint64_t offset,
+                 Fam_Descriptor *other, uint64_t otherOffset, uint64_t nbytes,
+                 uint64_t *diffOffset) {
+        Fam_Rpc_Arena_Scope scope;
+        Fam_Compare_Request &req = *scope.create<Fam_Compare_Request>();
+        Fam_Compare_Response &res = *scope.create<Fam_Compare_Response>();
+        ::grpc::ClientContext ctx;
+
+        Fam_Global_Descriptor globalDescriptor =
+            dataitem->get_global_descriptor();
+        Fam_Global_Descriptor otherGlobalDescriptor =
+            other->get_global_descriptor();
+        req.set_regionid(globalDescriptor.regionId & REGIONID_MASK);
+        req.set_offset(globalDescriptor.offset);
+        req.set_uid(uid);
+        req.set_gid(gid);
+        req.set_compareoffset(offset);
+        req.set_otherregionid(otherGlobalDescriptor.regionId & REGIONID_MASK);
+        req.set_otheroffset(otherGlobalDescriptor.offset);
+        req.set_othercompareoffset(otherOffset);
+        req.set_size(nbytes);
+
+        ::grpc::Status status = stub->compare(&ctx, req, &res);
+
+        if (status.ok()) {
+            if (res.errorcode()) {
+                throw Fam_Allocator_Exception((enum Fam_Error)res.errorcode(),
+                                              (res.errormsg()).c_str());
+            }
+            *diffOffset = res.diffoffset();
+            return res.equal();
+        } else {
+            throw Fam_Allocator_Exception(FAM_ERR_GRPC,
+                                          (status.error_message()).c_str());
+        }
+    }
+
     size_t get_addr_size() { return memServerFabricAddrSize; };
     char *get_addr() { return memServerFabricAddr; };
 
+    /**
+     * Set the memory server fabric address obtained out of band, without
+     * contacting the memory server.
+     **/
+    void set_addr(const void *addr, size_t addrSize) {
+        free(memServerFabricAddr);
+        memServerFabricAddrSize = addrSize;
+        memServerFabricAddr = (char *)calloc(1, addrSize);
+        memcpy(memServerFabricAddr, addr, addrSize);
+    };
+
   private:
+    Fam_Capability get_capability(const Fam_Capability_Token &token) {
+        Fam_Capability cap;
+        cap.key = token.key();
+        cap.size = token.size();
+        cap.perm = token.perm();
+        cap.expiry = token.expiry();
+        cap.uid = token.uid();
+        cap.gid = token.gid();
+        return cap;
+    }
+
+    void set_scan_request(Fam_Scan_Request *req, Fam_Descriptor *dataitem,
+                          uint64_t offset, const Fam_Scan_Query &query) {
+        Fam_Global_Descriptor globalDescriptor =
+            dataitem->get_global_descriptor();
+        req->set_regionid(globalDescriptor.regionId & REGIONID_MASK);
+        req->set_offset(globalDescriptor.offset);
+        req->set_uid(uid);
+        req->set_gid(gid);
+        req->set_scanoffset(offset);
+        req->set_recordsize(query.recordSize);
+        req->set_nrecords(query.nRecords);
+        for (const Fam_Scan_Predicate &predicate : query.predicates) {
+            Fam_Scan_Filter *filter = req->add_filters();
+            uint64_t low, high;
+            memcpy(&low, &predicate.low, sizeof(low));
+            memcpy(&high, &predicate.high, sizeof(high));
+            filter->set_fieldoffset(predicate.fieldOffset);
+            filter->set_type(predicate.type);
+            filter->set_op(predicate.op);
+            filter->set_low(low);
+            filter->set_high(high);
+        }
+        for (const Fam_Scan_Column &column : query.columns) {
+            Fam_Scan_Projection *projection = req->add_projections();
+            projection->set_offset(column.offset);
+            projection->set_size(column.size);
+        }
+    }
+
+    void free_descriptors(Fam_Descriptor **descriptors, uint64_t count) {
+        for (uint64_t ndx = 0; ndx < count; ndx++) {
+            delete descriptors[ndx];
+            descriptors[ndx] = NULL;
+        }
+    }
+
+    /**
+     * Deallocate the first count data items of a failed allocate_batch and
+     * free their descriptors.
+     **/
+    void release_descriptors(Fam_Descriptor **descriptors, uint64_t count) {
+        std::vector<uint64_t> index;
+        for (uint64_t ndx = 0; ndx < count; ndx++)
+            index.push_back(ndx);
+        try {
+            deallocate_batch(descriptors, index);
+        } catch (Fam_Allocator_Exception &e) {
+            cout << "error: release of batch dataitems failed: "
+                 << e.fam_error_msg() << endl;
+        }
+        free_descriptors(descriptors, count);
+    }
+
     std::unique_ptr<Fam_Rpc::Stub> stub;
     uint32_t uid;
     uint32_t gid;
 
     size_t memServerFabricAddrSize;
     char *memServerFabricAddr;
+    bool isStarted;
 
     ::grpc::CompletionQueue cq;
 };
@@ -28,7 +28,9 @@
  *
  */
 #include "fam_rpc_service_impl.h"
+#include "rpc/fam_rpc_arena.h"
 #include <unistd.h>
+#include <vector>
 
 #define ADDR_SIZE 20
 
@@ -36,17 +38,75 @@ using namespace std;
 
 namespace openfam {
 
-typedef Fam_Rpc::WithAsyncMethod_copy<Fam_Rpc_Service_Impl> sType;
+// All unary RPCs are served asynchronously from the completion queues of the
+// server. The RPCs making a full pass over a dataitem (copy, fill, reduce_item,
+// scan, checksum and compare) are handed to the threads of the copy engine, so
+// that they do not hold the threads draining the queues; large copies and
+// fills are split into chunks written by all of these threads. wait_until and
+// the CAS lock RPCs may block for a long time (or until another RPC arrives),
+// and watch is a streaming RPC, so they are left on the synchronous thread
+// pool of gRPC.
+typedef Fam_Rpc::WithAsyncMethod_signal_start<
+    Fam_Rpc::WithAsyncMethod_signal_termination<
+    Fam_Rpc::WithAsyncMethod_create_region<
+    Fam_Rpc::WithAsyncMethod_destroy_region<
+    Fam_Rpc::WithAsyncMethod_resize_region<
+    Fam_Rpc::WithAsyncMethod_allocate<
+    Fam_Rpc::WithAsyncMethod_deallocate<
+    Fam_Rpc::WithAsyncMethod_allocate_batch<
+    Fam_Rpc::WithAsyncMethod_deallocate_batch<
+    Fam_Rpc::WithAsyncMethod_change_region_permission<
+    Fam_Rpc::WithAsyncMethod_change_dataitem_permission<
+    Fam_Rpc::WithAsyncMethod_lookup_region<
+    Fam_Rpc::WithAsyncMethod_lookup<
+    Fam_Rpc::WithAsyncMethod_lookup_batch<
+    Fam_Rpc::WithAsyncMethod_check_permission_get_region_info<
+    Fam_Rpc::WithAsyncMethod_check_permission_get_item_info<
+    Fam_Rpc::WithAsyncMethod_check_permission_get_item_info_batch<
+    Fam_Rpc::WithAsyncMethod_copy<
+    Fam_Rpc::WithAsyncMethod_fill<
+    Fam_Rpc::WithAsyncMethod_reduce_item<
+    Fam_Rpc::WithAsyncMethod_scan<
+    Fam_Rpc::WithAsyncMethod_checksum<
+    Fam_Rpc::WithAsyncMethod_compare<
+    Fam_Rpc_Service_Impl> > > > > > > > > > > > > > > > > > > > > > >
+    sType;
+
+// Start serving an RPC handled by the Fam_Rpc_Service_Impl method of the same
+// name on the completion queue "cq". The handler is called by its qualified
+// name, as sType overrides the synchronous methods of the service.
+#define FAM_RPC_ASYNC_CALL(method, Request, Response)                          \
+    new Fam_Rpc_Call<Request, Response>(                                       \
+        service, cq, &sType::Request##method,                                  \
+        [](sType *s, ServerContext *c, const Request *q, Response *r) {        \
+            return s->Fam_Rpc_Service_Impl::method(c, q, r);                   \
+        })
+
+// Same as FAM_RPC_ASYNC_CALL, with the handler run on a thread of the copy
+// engine of "allocator".
+#define FAM_RPC_OFFLOAD_CALL(method, Request, Response)                        \
+    new Fam_Rpc_Call<Request, Response>(                                       \
+        service, cq, &sType::Request##method,                                  \
+        [](sType *s, ServerContext *c, const Request *q, Response *r) {        \
+            return s->Fam_Rpc_Service_Impl::method(c, q, r);                   \
+        },                                                                     \
+        allocator)
 
 class Fam_Rpc_Server {
   public:
     Fam_Rpc_Server(uint64_t rpcPort, char *name, char *libfabricPort,
-                   char *provider)
-        : serverAddress(name), port(rpcPort) {
+                   char *provider, uint64_t rpcThreads = 0,
+                   bool regionMr = false, MemServerMap peers = MemServerMap())
+        : serverAddress(name), port(rpcPort), numThreads(rpcThreads) {
+        // By default, drain one completion queue per core
+        if (numThreads == 0)
+            numThreads = std::thread::hardware_concurrency();
+        if (numThreads == 0)
+            numThreads = 1;
         allocator = new Memserver_Allocator();
         service = new sType();
         service->rpc_service_initialize(name, libfabricPort, provider,
-                                        allocator);
+                                        allocator, regionMr, peers, rpcPort);
     }
 
     ~Fam_Rpc_Server() { delete service; }
@@ -63,44 +123,192 @@ class Fam_Rpc_Server {
         builder.AddListeningPort(serverAddress,
                                  grpc::InsecureServerCredentials());
         // Register "service" as the instance through which we'll communicate
-        // with clients. In this case it corresponds to an *synchronous*
-        // service.
+        // with clients. Most of its methods are *asynchronous*, the rest are
+        // served by the synchronous thread pool.
         builder.RegisterService(service);
 
-        // Add completion queue
-        cq = builder.AddCompletionQueue();
+        // Add one completion queue per handler thread
+        for (uint64_t i = 0; i < numThreads; i++)
+            cqs.push_back(builder.AddCompletionQueue());
 
         // Finally assemble the server.
         server = builder.BuildAndStart();
 #if defined(FAM_DEBUG)
-        cout << "Server listening on " << serverAddress << endl;
+        cout << "Server listening on " << serverAddress << " with "
+             << numThreads << " completion queues" << endl;
 #endif
 
-        // Spawn a seperate thread to handle asynchronous service
-        std::thread async_service_handler(&Fam_Rpc_Server::HandleRpcs<sType>,
-                                          this, service, cq.get(), allocator);
+        // Spawn a seperate thread to drain each completion queue
+        std::vector<std::thread> async_service_handlers;
+        for (uint64_t i = 0; i < numThreads; i++)
+            async_service_handlers.push_back(
+                std::thread(&Fam_Rpc_Server::HandleRpcs, this, service,
+                            cqs[i].get(), allocator));
 
         server->Wait();
-        async_service_handler.join();
+        for (uint64_t i = 0; i < numThreads; i++)
+            async_service_handlers[i].join();
     }
 
   private:
     Memserver_Allocator *allocator;
-    class CallData {
+
+    // State of an asynchronous RPC, used as the tag of its completion queue
+    // events.
+    class Fam_Rpc_Call_Base {
+      public:
+        virtual ~Fam_Rpc_Call_Base() {}
+        virtual void Proceed() = 0;
+    };
+
+    // Serves one unary RPC by calling the synchronous handler of the service
+    // from the thread draining the completion queue, or from a thread of the
+    // copy engine of "offload" if set.
+    template <class Request, class Response>
+    class Fam_Rpc_Call : public Fam_Rpc_Call_Base {
+      public:
+        typedef void (sType::*RequestFn)(
+            ServerContext *, Request *, ServerAsyncResponseWriter<Response> *,
+            ::grpc::CompletionQueue *, ServerCompletionQueue *, void *);
+        typedef Status (*HandlerFn)(sType *, ServerContext *, const Request *,
+                                    Response *);
+
+        Fam_Rpc_Call(sType *service, ServerCompletionQueue *cq,
+                     RequestFn requestFn, HandlerFn handlerFn,
+                     Memserver_Allocator *offload = NULL)
+            : service(service), cq(cq), requestFn(requestFn),
+              handlerFn(handlerFn), offload(offload),
+              request(*arena.create<Request>()),
+              response(*arena.create<Response>()), responder(&ctx),
+              status(CREATE) {
+            // Invoke the serving logic right away.
+            Proceed();
+        }
+
+        void Proceed() override {
+            if (status == CREATE) {
+                // Request that the system start processing requests of this
+                // method, with "this" as the tag uniquely identifying the
+                // request.
+                status = PROCESS;
+                (service->*requestFn)(&ctx, &request, &responder, cq, cq,
+                                      this);
+            } else if (status == PROCESS) {
+                // Spawn a new instance to serve new clients of this method
+                // while we process the one for this instance.
+                new Fam_Rpc_Call<Request, Response>(service, cq, requestFn,
+                                                    handlerFn, offload);
+                status = FINISH;
+                if (offload) {
+                    offload->run_async([this] {
+                        Status grpcStatus =
+                            handlerFn(service, &ctx, &request, &response);
+                        responder.Finish(response, grpcStatus, this);
+                    });
+                    return;
+                }
+                Status grpcStatus = handlerFn(service, &ctx, &request,
+                                              &response);
+                responder.Finish(response, grpcStatus, this);
+            } else {
+                GPR_ASSERT(status == FINISH);
+                delete this;
+            }
+        }
+
+      private:
+        sType *service;
+        ServerCompletionQueue *cq;
+        RequestFn requestFn;
+        HandlerFn handlerFn;
+        Memserver_Allocator *offload;
+        ServerContext ctx;
+        // Arena holding the messages of this call.
+        Fam_Rpc_Arena arena;
+        Request &request;
+        Response &response;
+        ServerAsyncResponseWriter<Response> responder;
+        enum CallStatus { CREATE, PROCESS, FINISH };
+        CallStatus status;
+    };
+
+    // Fills complete on the threads of the copy engine like copies, which
+    // split large fills into chunks; small fills are done inline.
+    class Fam_Fill_Call : public Fam_Rpc_Call_Base {
+      public:
+        Fam_Fill_Call(sType *service, ServerCompletionQueue *cq,
+                      Memserver_Allocator *allocator)
+            : service(service), cq(cq), allocator(allocator),
+              request(*arena.create<Fam_Fill_Request>()),
+              response(*arena.create<Fam_Copy_Response>()), responder(&ctx),
+              status(CREATE) {
+            // Invoke the serving logic right away.
+            Proceed();
+        }
+
+        void Proceed() override {
+            if (status == CREATE) {
+                status = PROCESS;
+                service->Requestfill(&ctx, &request, &responder, cq, cq, this);
+            } else if (status == PROCESS) {
+                // Spawn a new instance to serve new clients while we process
+                // the one for this instance.
+                new Fam_Fill_Call(service, cq, allocator);
+                status = FINISH;
+                try {
+                    allocator->fill_async(
+                        request.regionid(), request.offset(),
+                        request.filloffset(), request.size(), request.uid(),
+                        request.gid(), request.pattern(),
+                        request.patternsize(), [this] {
+                            responder.Finish(response, Status::OK, this);
+                        });
+                    return;
+                } catch (Memserver_Exception &e) {
+                    response.set_errorcode(e.fam_error());
+                    response.set_errormsg(e.fam_error_msg());
+                }
+                responder.Finish(response, Status::OK, this);
+            } else {
+                GPR_ASSERT(status == FINISH);
+                delete this;
+            }
+        }
+
+      private:
+        sType *service;
+        ServerCompletionQueue *cq;
+        Memserver_Allocator *allocator;
+        ServerContext ctx;
+        // Arena holding the messages of this call.
+        Fam_Rpc_Arena arena;
+        Fam_Fill_Request &request;
+        Fam_Copy_Response &response;
+        ServerAsyncResponseWriter<Fam_Copy_Response> responder;
+        enum CallStatus { CREATE, PROCESS, FINISH };
+        CallStatus status;
+    };
+
+    // Copies complete on the threads of the copy engine instead of the thread
+    // draining the completion queue, both within this memory server and when
+    // pushed to another one.
+    class CallData : public Fam_Rpc_Call_Base {
       public:
         // Take in the "service" instance (in this case representing an
         // asynchronous server) and the completion queue "cq" used for
         // asynchronous communication with the gRPC runtime.
         CallData(sType *service, ServerCompletionQueue *cq,
                  Memserver_Allocator *memAlloc)
-            : ret(0), service(service), cq(cq), responder(&ctx),
+            : ret(0), service(service), cq(cq),
+              request(*arena.create<Fam_Copy_Request>()),
+              response(*arena.create<Fam_Copy_Response>()), responder(&ctx),
               status(CREATE) {
             allocator = memAlloc;
             // Invoke the serving logic right away.
             Proceed();
         }
 
-        void Proceed() {
+        void Proceed() override {
             if (status == CREATE) {
                 // Make this instance progress to the PROCESS state.
                 status = PROCESS;
@@ -117,24 +325,41 @@ class Fam_Rpc_Server {
                 // deallocate itself as part of its FINISH state.
 
                 new CallData(service, cq, allocator);
-                // copy the data from source dataitem to target dataitem
+                status = FINISH;
                 grpcStatus = Status::OK;
-                try {
-                    ret = allocator->copy(
-                        request.regionid(), request.srcoffset(),
-                        request.srccopystart(), request.destoffset(),
-                        request.destcopystart(), request.uid(), request.gid(),
-                        (size_t)request.copysize());
-                } catch (Memserver_Exception &e) {
-                    response.set_errorcode(e.fam_error());
-                    response.set_errormsg(e.fam_error_msg());
-                    grpcStatus = Status::OK;
+                if (!request.remotedest()) {
+                    // copy the data from source dataitem to target dataitem;
+                    // large copies complete on the threads of the copy
+                    // engine, which let the gRPC runtime know we've finished
+                    try {
+                        allocator->copy_async(
+                            request.regionid(), request.srcoffset(),
+                            request.srccopystart(), request.destregionid(),
+                            request.destoffset(), request.destcopystart(),
+                            request.uid(), request.gid(),
+                            (size_t)request.copysize(), [this] {
+                                responder.Finish(response, grpcStatus, this);
+                            });
+                        return;
+                    } catch (Memserver_Exception &e) {
+                        response.set_errorcode(e.fam_error());
+                        response.set_errormsg(e.fam_error_msg());
+                    }
+                } else {
+                    // push the data to the memory server holding the target
+                    // dataitem from a thread of the copy engine, as it waits
+                    // for that memory server
+                    allocator->run_async([this] {
+                        grpcStatus = service->Fam_Rpc_Service_Impl::copy(
+                            &ctx, &request, &response);
+                        responder.Finish(response, grpcStatus, this);
+                    });
+                    return;
                 }
 
                 // And we are done! Let the gRPC runtime know we've finished,
                 // using the memory address of this instance as the uniquely
                 // identifying tag for the event.
-                status = FINISH;
                 responder.Finish(response, grpcStatus, this);
             } else {
                 GPR_ASSERT(status == FINISH);
@@ -158,10 +383,12 @@ class Fam_Rpc_Server {
         ServerContext ctx;
 
         Memserver_Allocator *allocator;
+        // Arena holding the messages of this call.
+        Fam_Rpc_Arena arena;
         // What we get from the client.
-        Fam_Copy_Request request;
+        Fam_Copy_Request &request;
         // What we send back to the client.
-        Fam_Copy_Response response;
+        Fam_Copy_Response &response;
 
         Status grpcStatus;
         // The means to get back to the client.
@@ -172,29 +399,71 @@ class Fam_Rpc_Server {
         CallStatus status; // The current serving state.
     };
 
-    // This can be run in multiple threads if needed.
-    template <class Service>
-    void HandleRpcs(Service *service, ServerCompletionQueue *cq,
+    // Run by one thread per completion queue.
+    void HandleRpcs(sType *service, ServerCompletionQueue *cq,
                     Memserver_Allocator *allocator) {
-        // Spawn a new CallData instance to serve new clients.
+        // Spawn an instance of each asynchronous RPC to serve new clients.
+        FAM_RPC_ASYNC_CALL(signal_start, Fam_Request, Fam_Start_Response);
+        FAM_RPC_ASYNC_CALL(signal_termination, Fam_Request, Fam_Response);
+        FAM_RPC_ASYNC_CALL(create_region, Fam_Region_Request,
+                           Fam_Region_Response);
+        FAM_RPC_ASYNC_CALL(destroy_region, Fam_Region_Request,
+                           Fam_Region_Response);
+        FAM_RPC_ASYNC_CALL(resize_region, Fam_Region_Request,
+                           Fam_Region_Response);
+        FAM_RPC_ASYNC_CALL(allocate, Fam_Dataitem_Request,
+                           Fam_Dataitem_Response);
+        FAM_RPC_ASYNC_CALL(deallocate, Fam_Dataitem_Request,
+                           Fam_Dataitem_Response);
+        FAM_RPC_ASYNC_CALL(allocate_batch, Fam_Dataitem_Batch_Request,
+                           Fam_Dataitem_Batch_Response);
+        FAM_RPC_ASYNC_CALL(deallocate_batch, Fam_Dataitem_Batch_Request,
+                           Fam_Dataitem_Batch_Response);
+        FAM_RPC_ASYNC_CALL(change_region_permission, Fam_Region_Request,
+                           Fam_Region_Response);
+        FAM_RPC_ASYNC_CALL(change_dataitem_permission, Fam_Dataitem_Request,
+                           Fam_Dataitem_Response);
+        FAM_RPC_ASYNC_CALL(lookup_region, Fam_Region_Request,
+                           Fam_Region_Response);
+        FAM_RPC_ASYNC_CALL(lookup, Fam_Dataitem_Request,
+                           Fam_Dataitem_Response);
+        FAM_RPC_ASYNC_CALL(lookup_batch, Fam_Dataitem_Batch_Request,
+                           Fam_Dataitem_Batch_Response);
+        FAM_RPC_ASYNC_CALL(check_permission_get_region_info,
+                           Fam_Region_Request, Fam_Region_Response);
+        FAM_RPC_ASYNC_CALL(check_permission_get_item_info,
+                           Fam_Dataitem_Request, Fam_Dataitem_Response);
+        FAM_RPC_ASYNC_CALL(check_permission_get_item_info_batch,
+                           Fam_Dataitem_Batch_Request,
+                           Fam_Dataitem_Batch_Response);
+        FAM_RPC_OFFLOAD_CALL(reduce_item, Fam_Reduce_Request,
+                             Fam_Reduce_Response);
+        FAM_RPC_OFFLOAD_CALL(scan, Fam_Scan_Request, Fam_Scan_Response);
+        FAM_RPC_OFFLOAD_CALL(checksum, Fam_Checksum_Request,
+                             Fam_Checksum_Response);
+        FAM_RPC_OFFLOAD_CALL(compare, Fam_Compare_Request,
+                             Fam_Compare_Response);
+        new Fam_Fill_Call(service, cq, allocator);
         new CallData(service, cq, allocator);
         void *tag; // uniquely identifies a request.
         bool ok;
         while (true) {
             // Block waiting to read the next event from the completion queue.
             // The event is uniquely identified by its tag, which in this case
-            // is the memory address of a CallData instance. The return value of
-            // Next should always be checked. This return value tells us whether
-            // there is any kind of event or cq is shutting down.
+            // is the memory address of a Fam_Rpc_Call_Base instance. The
+            // return value of Next should always be checked. This return value
+            // tells us whether there is any kind of event or cq is shutting
+            // down.
             GPR_ASSERT(cq->Next(&tag, &ok));
             GPR_ASSERT(ok);
-            static_cast<CallData *>(tag)->Proceed();
+            static_cast<Fam_Rpc_Call_Base *>(tag)->Proceed();
         }
     }
     char *serverAddress;
     uint64_t port;
+    uint64_t numThreads;
     // Fam_Rpc_Service_Impl* sericeImpl;
-    std::unique_ptr<ServerCompletionQueue> cq;
+    std::vector<std::unique_ptr<ServerCompletionQueue> > cqs;
     sType *service;
     std::unique_ptr<Server> server;
 };
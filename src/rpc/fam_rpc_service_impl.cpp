@@ -28,8 +28,10 @@
  *
  */
 #include "fam_rpc_service_impl.h"
+#include <algorithm>
 #include <thread>
 #include <unistd.h>
+#include <vector>
 
 namespace openfam {
 
@@ -44,11 +46,15 @@ void Fam_Rpc_Service_Impl::progress_thread() {
     }
 }
 void Fam_Rpc_Service_Impl::rpc_service_initialize(
-    char *name, char *service, char *provider, Memserver_Allocator *memAlloc) {
+    char *name, char *service, char *provider, Memserver_Allocator *memAlloc,
+    bool regionMr, MemServerMap peerList, uint64_t peerPort) {
     ostringstream message;
     message << "Error while initializing RPC service : ";
     numClients = 0;
     shouldShutdown = false;
+    regionMrMode = regionMr;
+    peerNames = peerList;
+    peerRpcPort = peerPort;
     allocator = memAlloc;
     famOps =
         new Fam_Ops_Libfabric(name, service, true, provider,
@@ -71,6 +77,7 @@ void Fam_Rpc_Service_Impl::rpc_service_initialize(
     for (int i = 0; i < CAS_LOCK_CNT; i++) {
         (void)pthread_mutex_init(&casLock[i], NULL);
     }
+    (void)pthread_mutex_init(&peerLock, NULL);
     if (libfabricProgressMode == FI_PROGRESS_MANUAL) {
         haltProgress = false;
         progressThread =
@@ -84,6 +91,17 @@ void Fam_Rpc_Service_Impl::rpc_service_finalize() {
     for (int i = 0; i < CAS_LOCK_CNT; i++) {
         (void)pthread_mutex_destroy(&casLock[i]);
     }
+    for (auto peer : peers) {
+        Fam_Request req;
+        Fam_Response res;
+        ::grpc::ClientContext ctx;
+        ctx.set_deadline(std::chrono::system_clock::now() +
+                         std::chrono::seconds(FAM_PEER_RPC_TIMEOUT));
+        peer.second->stub->signal_termination(&ctx, req, &res);
+        delete peer.second;
+    }
+    peers.clear();
+    (void)pthread_mutex_destroy(&peerLock);
     famOps->finalize();
 }
 
@@ -138,9 +156,10 @@ Fam_Rpc_Service_Impl::create_region(::grpc::ServerContext *context,
                                     ::Fam_Region_Response *response) {
     uint64_t regionId;
     try {
-        allocator->create_region(
-            request->name(), regionId, (size_t)request->size(),
-            (mode_t)request->perm(), request->uid(), request->gid());
+        allocator->create_region(request->name(), regionId,
+                                 (size_t)request->size(),
+                                 (mode_t)request->perm(), request->uid(),
+                                 request->gid(), regionMrMode);
     } catch (Memserver_Exception &e) {
         response->set_errorcode(e.fam_error());
         response->set_errormsg(e.fam_error_msg());
@@ -166,6 +185,10 @@ Fam_Rpc_Service_Impl::destroy_region(::grpc::ServerContext *context,
         return ::grpc::Status::OK;
     }
 
+    // Release the registrations of the region memory, if any
+    deregister_region_memory(request->regionid(), 0);
+    deregister_region_memory(request->regionid(), 1);
+
     // Return status OK
     return ::grpc::Status::OK;
 }
@@ -178,6 +201,7 @@ Fam_Rpc_Service_Impl::resize_region(::grpc::ServerContext *context,
     try {
         allocator->resize_region(request->regionid(), request->uid(),
                                  request->gid(), request->size());
+        refresh_region_memory(request->regionid());
     } catch (Memserver_Exception &e) {
         response->set_errorcode(e.fam_error());
         response->set_errormsg(e.fam_error_msg());
@@ -259,6 +283,8 @@ Fam_Rpc_Service_Impl::allocate(::grpc::ServerContext *context,
     response->set_key(key);
     response->set_regionid(request->regionid());
     response->set_offset(offset);
+    mint_capability(dataitem, key, request->uid(), request->gid(),
+                    response->mutable_capability());
 
     // Return status OK
     return ::grpc::Status::OK;
@@ -292,6 +318,119 @@ Fam_Rpc_Service_Impl::deallocate(::grpc::ServerContext *context,
     return ::grpc::Status::OK;
 }
 
+::grpc::Status Fam_Rpc_Service_Impl::allocate_batch(
+    ::grpc::ServerContext *context, const ::Fam_Dataitem_Batch_Request *request,
+    ::Fam_Dataitem_Batch_Response *response) {
+    ostringstream message;
+    std::vector<string> names;
+    std::vector<size_t> sizes;
+    std::vector<Fam_DataItem_Metadata> dataitems;
+    std::vector<void *> localPointers;
+    for (int ndx = 0; ndx < request->items_size(); ndx++) {
+        names.push_back(request->items(ndx).name());
+        sizes.push_back((size_t)request->items(ndx).size());
+    }
+
+    // Allocate all the items from the heap of the region at once
+    try {
+        allocator->allocate_batch(request->regionid(), names, sizes,
+                                  (mode_t)request->perm(), request->uid(),
+                                  request->gid(), dataitems, localPointers);
+    } catch (Memserver_Exception &e) {
+        response->set_errorcode(e.fam_error());
+        response->set_errormsg(e.fam_error_msg());
+        return ::grpc::Status::OK;
+    }
+
+    // Generate and register keys for datapath access
+    for (size_t ndx = 0; ndx < dataitems.size(); ndx++) {
+        uint64_t key;
+        int ret;
+        try {
+            ret = register_memory(dataitems[ndx], localPointers[ndx],
+                                  request->uid(), request->gid(), key);
+        } catch (Memserver_Exception &e) {
+            release_items(dataitems, request->uid(), request->gid());
+            response->clear_items();
+            response->set_errorcode(e.fam_error());
+            response->set_errormsg(e.fam_error_msg());
+            return ::grpc::Status::OK;
+        }
+
+        if (ret < 0) {
+            release_items(dataitems, request->uid(), request->gid());
+            response->clear_items();
+            message << "Error while allocating dataitem : ";
+            if (ret == NOT_PERMITTED) {
+                response->set_errorcode(FAM_ERR_NOPERM);
+                message << "No permission, dataitem registration failed";
+            } else {
+                response->set_errorcode(FAM_ERR_RESOURCE);
+                message << "dataitem registration failed";
+            }
+            response->set_errormsg(message.str());
+            return ::grpc::Status::OK;
+        }
+
+        ::Fam_Dataitem_Response *itemResponse = response->add_items();
+        itemResponse->set_key(key);
+        itemResponse->set_regionid(request->regionid());
+        itemResponse->set_offset(dataitems[ndx].offset);
+        itemResponse->set_size(dataitems[ndx].size);
+        mint_capability(dataitems[ndx], key, request->uid(), request->gid(),
+                        itemResponse->mutable_capability());
+    }
+
+    // Return status OK
+    return ::grpc::Status::OK;
+}
+
+::grpc::Status Fam_Rpc_Service_Impl::deallocate_batch(
+    ::grpc::ServerContext *context, const ::Fam_Dataitem_Batch_Request *request,
+    ::Fam_Dataitem_Batch_Response *response) {
+    for (int ndx = 0; ndx < request->items_size(); ndx++) {
+        const ::Fam_Dataitem_Request &item = request->items(ndx);
+        ::Fam_Dataitem_Response *itemResponse = response->add_items();
+        try {
+            allocator->deallocate(item.regionid(), item.offset(),
+                                  request->uid(), request->gid());
+        } catch (Memserver_Exception &e) {
+            itemResponse->set_errorcode(e.fam_error());
+            itemResponse->set_errormsg(e.fam_error_msg());
+            continue;
+        }
+
+        if (deregister_memory(item.regionid(), item.offset()) < 0) {
+            ostringstream message;
+            itemResponse->set_errorcode(FAM_ERR_RESOURCE);
+            message << "Error while deallocating dataitem : ";
+            message << "dataitem deregistration failed";
+            itemResponse->set_errormsg(message.str());
+        }
+    }
+
+    // Return status OK
+    return ::grpc::Status::OK;
+}
+
+/*
+ * Release dataitems allocated by a batch which could not be completed.
+ */
+void Fam_Rpc_Service_Impl::release_items(
+    std::vector<Fam_DataItem_Metadata> &dataitems, uint32_t uid,
+    uint32_t gid) {
+    for (size_t ndx = 0; ndx < dataitems.size(); ndx++) {
+        deregister_memory(dataitems[ndx].regionId, dataitems[ndx].offset);
+        try {
+            allocator->deallocate(dataitems[ndx].regionId,
+                                  dataitems[ndx].offset, uid, gid);
+        } catch (Memserver_Exception &e) {
+            cout << "error: release of batch dataitem failed: "
+                 << e.fam_error_msg() << endl;
+        }
+    }
+}
+
 ::grpc::Status Fam_Rpc_Service_Impl::change_region_permission(
     ::grpc::ServerContext *context, const ::Fam_Region_Request *request,
     ::Fam_Region_Response *response) {
@@ -376,16 +515,34 @@ Fam_Rpc_Service_Impl::lookup(::grpc::ServerContext *context,
         return ::grpc::Status::OK;
     }
 
-    if (request->uid() == dataitem.uid) {
-        response->set_regionid(dataitem.regionId);
-        response->set_offset(dataitem.offset);
-        response->set_size(dataitem.size);
-        return ::grpc::Status::OK;
-    } else if (allocator->check_dataitem_permission(dataitem, 0, request->uid(),
-                                                    request->gid())) {
+    if ((request->uid() == dataitem.uid) ||
+        allocator->check_dataitem_permission(dataitem, 0, request->uid(),
+                                             request->gid())) {
         response->set_regionid(dataitem.regionId);
         response->set_offset(dataitem.offset);
         response->set_size(dataitem.size);
+        // Register the dataitem and hand out a capability, so that the
+        // client need not check permission again before accessing it.
+        uint64_t key;
+        int ret;
+        try {
+            ret = register_memory(dataitem, NULL, request->uid(),
+                                  request->gid(), key);
+        } catch (Memserver_Exception &e) {
+            response->set_errorcode(e.fam_error());
+            response->set_errormsg(e.fam_error_msg());
+            return ::grpc::Status::OK;
+        }
+        if (ret < 0) {
+            response->set_errorcode(FAM_ERR_RESOURCE);
+            message << "Error while looking up for dataitem : ";
+            message << "dataitem registration failed";
+            response->set_errormsg(message.str());
+            return ::grpc::Status::OK;
+        }
+        response->set_key(key);
+        mint_capability(dataitem, key, request->uid(), request->gid(),
+                        response->mutable_capability());
         return ::grpc::Status::OK;
     } else {
         response->set_errorcode(FAM_ERR_NOPERM);
@@ -431,6 +588,74 @@ response->set_key(key);
     return ::grpc::Status::OK;
 }
 
+::grpc::Status
+Fam_Rpc_Service_Impl::lookup_batch(::grpc::ServerContext *context,
+                                   const ::Fam_Dataitem_Batch_Request *request,
+                                   ::Fam_Dataitem_Batch_Response *response) {
+    Fam_Region_Metadata region;
+    // Resolve the region once for all the items in the batch
+    try {
+        allocator->get_region(request->regionname(), request->uid(),
+                              request->gid(), region);
+    } catch (Memserver_Exception &e) {
+        response->set_errorcode(e.fam_error());
+        response->set_errormsg(e.fam_error_msg());
+        return ::grpc::Status::OK;
+    }
+
+    for (int ndx = 0; ndx < request->items_size(); ndx++) {
+        Fam_DataItem_Metadata dataitem;
+        ::Fam_Dataitem_Response *itemResponse = response->add_items();
+        try {
+            allocator->get_dataitem(request->items(ndx).name(),
+                                    region.regionId, request->uid(),
+                                    request->gid(), dataitem);
+        } catch (Memserver_Exception &e) {
+            itemResponse->set_errorcode(e.fam_error());
+            itemResponse->set_errormsg(e.fam_error_msg());
+            continue;
+        }
+
+        if ((request->uid() == dataitem.uid) ||
+            allocator->check_dataitem_permission(dataitem, 0, request->uid(),
+                                                 request->gid())) {
+            itemResponse->set_regionid(dataitem.regionId);
+            itemResponse->set_offset(dataitem.offset);
+            itemResponse->set_size(dataitem.size);
+            uint64_t key;
+            int ret;
+            try {
+                ret = register_memory(dataitem, NULL, request->uid(),
+                                      request->gid(), key);
+            } catch (Memserver_Exception &e) {
+                itemResponse->set_errorcode(e.fam_error());
+                itemResponse->set_errormsg(e.fam_error_msg());
+                continue;
+            }
+            if (ret < 0) {
+                ostringstream message;
+                itemResponse->set_errorcode(FAM_ERR_RESOURCE);
+                message << "Error while looking up for dataitem : ";
+                message << "dataitem registration failed";
+                itemResponse->set_errormsg(message.str());
+                continue;
+            }
+            itemResponse->set_key(key);
+            mint_capability(dataitem, key, request->uid(), request->gid(),
+                            itemResponse->mutable_capability());
+        } else {
+            ostringstream message;
+            itemResponse->set_errorcode(FAM_ERR_NOPERM);
+            message << "Error while looking up for dataitem : ";
+            message << "Dataitem access in not permitted";
+            itemResponse->set_errormsg(message.str());
+        }
+    }
+
+    // Return status OK
+    return ::grpc::Status::OK;
+}
+
 ::grpc::Status Fam_Rpc_Service_Impl::check_permission_get_region_info(
     ::grpc::ServerContext *context, const ::Fam_Region_Request *request,
     ::Fam_Region_Response *response) {
@@ -465,26 +690,42 @@ response->set_key(key);
     ::Fam_Dataitem_Response *response) {
 
     Fam_DataItem_Metadata dataitem;
-    uint64_t key;
-    ostringstream message;
+    bool regionMemory;
+
     try {
         allocator->get_dataitem(request->regionid(), request->offset(),
                                 request->uid(), request->gid(), dataitem);
+        regionMemory = regionMrMode && use_region_memory(dataitem);
     } catch (Memserver_Exception &e) {
         response->set_errorcode(e.fam_error());
         response->set_errormsg(e.fam_error_msg());
         return ::grpc::Status::OK;
     }
 
-    void *localPointer = 0;
+    set_item_info(dataitem, request->uid(), request->gid(), regionMemory,
+                  response);
+
+    // Return status OK
+    return ::grpc::Status::OK;
+}
+
+/*
+ * Registers a dataitem for the given uid/gid, and fills the response of
+ * check_permission_get_item_info with its info and key, or with the error.
+ */
+void Fam_Rpc_Service_Impl::set_item_info(const Fam_DataItem_Metadata &dataitem,
+                                         uint32_t uid, uint32_t gid,
+                                         bool regionMemory,
+                                         ::Fam_Dataitem_Response *response) {
+    uint64_t key;
+    ostringstream message;
     int ret;
     try {
-        ret = register_memory(dataitem, localPointer, request->uid(),
-                              request->gid(), key);
+        ret = register_memory(dataitem, NULL, uid, gid, regionMemory, key);
     } catch (Memserver_Exception &e) {
         response->set_errorcode(e.fam_error());
         response->set_errormsg(e.fam_error_msg());
-        return ::grpc::Status::OK;
+        return;
     }
 
     if (ret < 0) {
@@ -494,20 +735,71 @@ response->set_key(key);
                        "dataitem : ";
             message << "No permission, dataitem registration failed";
             response->set_errormsg(message.str());
-            return ::grpc::Status::OK;
+            return;
         } else {
             response->set_errorcode(FAM_ERR_RESOURCE);
             message << "Error while checking permission and getting info for "
                        "dataitem";
             message << "dataitem registration failed";
             response->set_errormsg(message.str());
-            return ::grpc::Status::OK;
+            return;
         }
     }
     response->set_regionid(dataitem.regionId);
     response->set_offset(dataitem.offset);
     response->set_key(key);
     response->set_size(dataitem.size);
+    mint_capability(dataitem, key, uid, gid, response->mutable_capability());
+}
+
+::grpc::Status Fam_Rpc_Service_Impl::check_permission_get_item_info_batch(
+    ::grpc::ServerContext *context,
+    const ::Fam_Dataitem_Batch_Request *request,
+    ::Fam_Dataitem_Batch_Response *response) {
+    // Group the items by region, so that each region is looked up once
+    std::map<uint64_t, std::vector<int> > regionItems;
+    for (int ndx = 0; ndx < request->items_size(); ndx++) {
+        response->add_items();
+        regionItems[request->items(ndx).regionid()].push_back(ndx);
+    }
+
+    for (auto &regionObj : regionItems) {
+        std::vector<int> &items = regionObj.second;
+        std::vector<uint64_t> offsets;
+        for (auto ndx : items)
+            offsets.push_back(request->items(ndx).offset());
+
+        std::vector<Fam_DataItem_Metadata> dataitems;
+        std::vector<bool> found;
+        allocator->get_dataitems(regionObj.first, offsets, dataitems, found);
+
+        // All the dataitems of a region are registered the same way
+        bool regionMemory = false;
+        bool regionKnown = false;
+        for (size_t i = 0; i < items.size(); i++) {
+            ::Fam_Dataitem_Response *itemResponse =
+                response->mutable_items(items[i]);
+            if (!found[i]) {
+                itemResponse->set_errorcode(FAM_ERR_NOTFOUND);
+                itemResponse->set_errormsg(
+                    "Error While locating dataitem : could not find the "
+                    "dataitem");
+                continue;
+            }
+            if (regionMrMode && !regionKnown) {
+                try {
+                    regionMemory = use_region_memory(dataitems[i]);
+                } catch (Memserver_Exception &e) {
+                    itemResponse->set_errorcode(e.fam_error());
+                    itemResponse->set_errormsg(e.fam_error_msg());
+                    continue;
+                }
+                regionKnown = true;
+            }
+            set_item_info(dataitems[i], request->uid(), request->gid(),
+                          regionMemory, itemResponse);
+        }
+    }
 
     // Return status OK
     return ::grpc::Status::OK;
@@ -516,9 +808,243 @@ response->set_key(key);
 ::grpc::Status Fam_Rpc_Service_Impl::copy(::grpc::ServerContext *context,
                                           const ::Fam_Copy_Request *request,
                                           ::Fam_Copy_Response *response) {
+    try {
+        if (!request->remotedest()) {
+            allocator->copy(request->regionid(), request->srcoffset(),
+                            request->srccopystart(), request->destregionid(),
+                            request->destoffset(), request->destcopystart(),
+                            request->uid(), request->gid(),
+                            request->copysize());
+        } else {
+            copy_to_peer(request);
+        }
+    } catch (Memserver_Exception &e) {
+        response->set_errorcode(e.fam_error());
+        response->set_errormsg(e.fam_error_msg());
+        return ::grpc::Status::OK;
+    } catch (Fam_Exception &e) {
+        response->set_errorcode(e.fam_error());
+        response->set_errormsg(e.fam_error_msg());
+        return ::grpc::Status::OK;
+    }
+
+    // Return status OK
     return ::grpc::Status::OK;
 }
 
+/*
+ * Returns the memory server with the given id, connecting to it and
+ * inserting its fabric address into the address vector the first time a copy
+ * is pushed to it. Only the memory servers given at startup are known, so
+ * that a client can not make this memory server write anywhere else. The
+ * rpc reading the address is made without holding peerLock; if two copies
+ * race to connect, the first one inserting the memory server wins.
+ */
+Fam_Rpc_Service_Impl::Fam_Peer *
+Fam_Rpc_Service_Impl::get_peer(uint64_t memserverId) {
+    ostringstream message;
+    pthread_mutex_lock(&peerLock);
+    auto peerObj = peers.find(memserverId);
+    if (peerObj != peers.end()) {
+        Fam_Peer *peer = peerObj->second;
+        pthread_mutex_unlock(&peerLock);
+        return peer;
+    }
+    pthread_mutex_unlock(&peerLock);
+
+    auto nameObj = peerNames.find(memserverId);
+    if (nameObj == peerNames.end()) {
+        message << "Memory server of the destination is not known";
+        throw Memserver_Exception(INVALID_OPTIONS, message.str().c_str());
+    }
+    std::string name = nameObj->second + ":" + std::to_string(peerRpcPort);
+    Fam_Peer *peer = new Fam_Peer();
+    peer->stub = Fam_Rpc::NewStub(
+        grpc::CreateChannel(name, ::grpc::InsecureChannelCredentials()));
+
+    // read the fabric address of the memory server, sent as fixed32 words
+    Fam_Request req;
+    Fam_Start_Response res;
+    ::grpc::ClientContext ctx;
+    ctx.set_deadline(std::chrono::system_clock::now() +
+                     std::chrono::seconds(FAM_PEER_RPC_TIMEOUT));
+    ::grpc::Status status = peer->stub->signal_start(&ctx, req, &res);
+    if (!status.ok()) {
+        delete peer;
+        throw Fam_Allocator_Exception(FAM_ERR_GRPC,
+                                      (status.error_message()).c_str());
+    }
+    std::vector<char> addrName(
+        std::max((size_t)res.addrnamelen(),
+                 res.addrname_size() * sizeof(uint32_t)));
+    for (int ndx = 0; ndx < res.addrname_size(); ndx++) {
+        uint32_t word = res.addrname(ndx);
+        memcpy(&addrName[ndx * sizeof(uint32_t)], &word, sizeof(uint32_t));
+    }
+
+    pthread_mutex_lock(&peerLock);
+    peerObj = peers.find(memserverId);
+    if (peerObj != peers.end()) {
+        Fam_Peer *other = peerObj->second;
+        pthread_mutex_unlock(&peerLock);
+        // another copy connected first, let the memory server know the
+        // connection made by this one is gone
+        Fam_Request termReq;
+        Fam_Response termRes;
+        ::grpc::ClientContext termCtx;
+        termCtx.set_deadline(std::chrono::system_clock::now() +
+                             std::chrono::seconds(FAM_PEER_RPC_TIMEOUT));
+        peer->stub->signal_termination(&termCtx, termReq, &termRes);
+        delete peer;
+        return other;
+    }
+    std::vector<fi_addr_t> fiAddrs;
+    int ret = fabric_insert_av(addrName.data(), famOps->get_av(), &fiAddrs);
+    if (ret < 0) {
+        pthread_mutex_unlock(&peerLock);
+        delete peer;
+        message << "Failed to insert the address of the destination memory "
+                   "server";
+        throw Memserver_Exception(OPS_INIT_FAILED, message.str().c_str());
+    }
+    peer->fiAddr = fiAddrs[0];
+    peers.insert({memserverId, peer});
+    pthread_mutex_unlock(&peerLock);
+    return peer;
+}
+
+/*
+ * Push a range of a local dataitem to a dataitem held by another memory
+ * server, with writes of FAM_COPY_CHUNK_SIZE bytes. The permission of the
+ * client on the destination, and its size, are checked with the memory
+ * server holding it, which returns the key the writes are done with. Up to
+ * FAM_COPY_PIPELINE_DEPTH writes are in flight; the copy completes when all
+ * of them do. Each copy writes through its own context, so that concurrent
+ * copies do not wait for each other. Called from the threads of the copy
+ * engine, never from those serving rpcs.
+ */
+void Fam_Rpc_Service_Impl::copy_to_peer(const ::Fam_Copy_Request *request) {
+    ostringstream message;
+    uint64_t nbytes = request->copysize();
+    char *srcStart = (char *)allocator->get_local_range(
+        request->regionid(), request->srcoffset(), request->srccopystart(),
+        nbytes, request->uid(), request->gid());
+    openfam_invalidate(srcStart, nbytes);
+
+    Fam_Peer *peer = get_peer(request->destmemserverid());
+    Fam_Dataitem_Request itemReq;
+    Fam_Dataitem_Response itemRes;
+    ::grpc::ClientContext ctx;
+    ctx.set_deadline(std::chrono::system_clock::now() +
+                     std::chrono::seconds(FAM_PEER_RPC_TIMEOUT));
+    itemReq.set_regionid(request->destregionid());
+    itemReq.set_offset(request->destoffset());
+    itemReq.set_uid(request->uid());
+    itemReq.set_gid(request->gid());
+    ::grpc::Status status =
+        peer->stub->check_permission_get_item_info(&ctx, itemReq, &itemRes);
+    if (!status.ok()) {
+        throw Fam_Allocator_Exception(FAM_ERR_GRPC,
+                                      (status.error_message()).c_str());
+    }
+    if (itemRes.errorcode()) {
+        throw Fam_Allocator_Exception((enum Fam_Error)itemRes.errorcode(),
+                                      (itemRes.errormsg()).c_str());
+    }
+    // the lowest bit of the key is its write permission
+    uint64_t destKey = itemRes.key();
+    if (!(destKey & 1)) {
+        message << "Not permitted to write the destination dataitem";
+        throw Memserver_Exception(NO_PERMISSION, message.str().c_str());
+    }
+    if ((request->destcopystart() > itemRes.size()) ||
+        (nbytes > itemRes.size() - request->destcopystart())) {
+        message << "Destination offset or size is beyond dataitem boundary";
+        throw Memserver_Exception(OUT_OF_RANGE, message.str().c_str());
+    }
+
+    Fam_Context *copyCtx = new Fam_Context(
+        famOps->get_fi(), famOps->get_domain(), FAM_THREAD_SERIALIZE);
+    int ret = fabric_enable_bind_ep(famOps->get_fi(), famOps->get_av(),
+                                    famOps->get_eq(), copyCtx->get_ep());
+    if (ret < 0) {
+        delete copyCtx;
+        message << "Failed to enable the endpoint of the copy";
+        throw Memserver_Exception(OPS_INIT_FAILED, message.str().c_str());
+    }
+    uint64_t inFlight = 0;
+    try {
+        for (uint64_t start = 0; start < nbytes;
+             start += FAM_COPY_CHUNK_SIZE) {
+            uint64_t size =
+                std::min((uint64_t)FAM_COPY_CHUNK_SIZE, nbytes - start);
+            fabric_write_nonblocking(destKey, srcStart + start, size,
+                                     request->destcopystart() + start,
+                                     peer->fiAddr, copyCtx);
+            if (++inFlight == FAM_COPY_PIPELINE_DEPTH) {
+                inFlight = 0;
+                fabric_quiet(copyCtx);
+            }
+        }
+        if (inFlight > 0) {
+            inFlight = 0;
+            fabric_quiet(copyCtx);
+        }
+    } catch (...) {
+        // Wait for the writes already issued, so that none is left
+        // outstanding on the context by the failed copy
+        if (inFlight > 0) {
+            try {
+                fabric_quiet(copyCtx);
+            } catch (Fam_Exception &e) {
+                cout << "error: writes of a failed copy failed: "
+                     << e.fam_error_msg() << endl;
+            }
+        }
+        delete copyCtx;
+        throw;
+    }
+    delete copyCtx;
+}
+
+::grpc::Status Fam_Rpc_Service_Impl::fill(::grpc::ServerContext *context,
+                                          const ::Fam_Fill_Request *request,
+                                          ::Fam_Copy_Response *response) {
+    try {
+        allocator->fill(request->regionid(), request->offset(),
+                        request->filloffset(), request->size(), request->uid(),
+                        request->gid(), request->pattern(),
+                        request->patternsize());
+    } catch (Memserver_Exception &e) {
+        response->set_errorcode(e.fam_error());
+        response->set_errormsg(e.fam_error_msg());
+        return ::grpc::Status::OK;
+    }
+
+    // Return status OK
+    return ::grpc::Status::OK;
+}
+
+void Fam_Rpc_Service_Impl::mint_capability(
+    const Fam_DataItem_Metadata &dataitem, uint64_t key, uint32_t uid,
+    uint32_t gid, ::Fam_Capability_Token *token) {
+    Fam_Capability cap;
+    cap.key = key;
+    cap.size = dataitem.size;
+    // Least significant bit of the key holds the permission
+    cap.perm = key & 1;
+    cap.expiry = (uint64_t)time(NULL) + FAM_CAPABILITY_LIFETIME;
+    cap.uid = uid;
+    cap.gid = gid;
+
+    token->set_key(cap.key);
+    token->set_size(cap.size);
+    token->set_perm(cap.perm);
+    token->set_expiry(cap.expiry);
+    token->set_uid(cap.uid);
+    token->set_gid(cap.gid);
+}
+
 uint64_t Fam_Rpc_Service_Impl::generate_access_key(uint64_t regionId,
                                                    uint64_t dataitemId,
                                                    bool permission) {
@@ -568,56 +1094,238 @@ int Fam_Rpc_Service_Impl::register_fence_memory() {
 int Fam_Rpc_Service_Impl::register_memory(Fam_DataItem_Metadata dataitem,
                                           void *localPointer, uint32_t uid,
                                           uint32_t gid, uint64_t &key) {
+    return register_memory(dataitem, localPointer, uid, gid,
+                           regionMrMode && use_region_memory(dataitem), key);
+}
+
+/*
+ * Same as above, with regionMemory telling whether the dataitem may be
+ * accessed through the registrations of its whole region, as found by
+ * use_region_memory(), so that callers registering several dataitems of a
+ * region find it once.
+ */
+int Fam_Rpc_Service_Impl::register_memory(Fam_DataItem_Metadata dataitem,
+                                          void *localPointer, uint32_t uid,
+                                          uint32_t gid, bool regionMemory,
+                                          uint64_t &key) {
     uint64_t dataitemId = dataitem.offset / MIN_OBJ_SIZE;
     fiMrs = famOps->get_fiMrs();
     fid_mr *mr = 0;
     int ret = 0;
-    if (!localPointer) {
-        localPointer =
-            allocator->get_local_pointer(dataitem.regionId, dataitem.offset);
-    }
 
+    bool permission;
     if (allocator->check_dataitem_permission(dataitem, 1, uid, gid)) {
-        key = generate_access_key(dataitem.regionId, dataitemId, 1);
-        // register the data item with required permission with libfabric
-        pthread_mutex_lock(famOps->get_mr_lock());
-        auto mrObj = fiMrs->find(key);
-        if (mrObj == fiMrs->end()) {
-            ret = fabric_register_mr(localPointer, dataitem.size, &key,
-                                     famOps->get_domain(), 1, mr);
-            if (ret < 0) {
-                pthread_mutex_unlock(famOps->get_mr_lock());
-                cout << "error: memory register failed" << endl;
-                return ITEM_REGISTRATION_FAILED;
+        permission = 1;
+    } else if (allocator->check_dataitem_permission(dataitem, 0, uid, gid)) {
+        permission = 0;
+    } else {
+        cout << "error: Not permitted to register dataitem" << endl;
+        return NOT_PERMITTED;
+    }
+
+    // Dataitems of a region registered as a whole are accessed with the key of
+    // the region memory region, tagged with their offset
+    if (regionMrMode && regionMemory && !(dataitem.offset % DATAITEMID_UNIT)) {
+        ret = register_region_memory(dataitem.regionId, permission);
+        if (ret == 0) {
+            key = generate_access_key(dataitem.regionId,
+                                      dataitem.offset / DATAITEMID_UNIT,
+                                      permission) |
+                  FAM_KEY_REGION_MR;
+            return 0;
+        } else if (ret == REGION_KEY_MISMATCH) {
+            cout << "warning: provider keys in use, registering dataitems "
+                    "individually"
+                 << endl;
+            regionMrMode = false;
+        } else if (ret != REGION_MR_EXCLUDED) {
+            return ret;
+        }
+    }
+
+    key = generate_access_key(dataitem.regionId, dataitemId, permission);
+    // register the data item with required permission with libfabric. The
+    // local pointer is only resolved when the dataitem is not registered yet,
+    // so that registering it again, as every lookup does, stays cheap.
+    pthread_mutex_lock(famOps->get_mr_lock());
+    auto mrObj = fiMrs->find(key);
+    if (mrObj == fiMrs->end()) {
+        try {
+            if (!localPointer) {
+                localPointer = allocator->get_local_pointer(dataitem.regionId,
+                                                            dataitem.offset);
             }
+        } catch (Memserver_Exception &e) {
+            pthread_mutex_unlock(famOps->get_mr_lock());
+            throw;
+        }
+        ret = fabric_register_mr(localPointer, dataitem.size, &key,
+                                 famOps->get_domain(), permission, mr);
+        if (ret < 0) {
+            pthread_mutex_unlock(famOps->get_mr_lock());
+            cout << "error: memory register failed" << endl;
+            return ITEM_REGISTRATION_FAILED;
+        }
+
+        fiMrs->insert({key, mr});
+    }
+    pthread_mutex_unlock(famOps->get_mr_lock());
+    // Return status OK
+    return 0;
+}
 
-            fiMrs->insert({key, mr});
+/*
+ * Tells whether a dataitem may be accessed through the registrations of its
+ * whole region. A key of the region reaches every dataitem in it, so only
+ * the regions created while registering regions as a whole are, as all their
+ * dataitems have the owner and the permission of the region. This holds for
+ * the dataitems allocated before a restart of the memory server too, as it is
+ * recorded with the region.
+ */
+bool Fam_Rpc_Service_Impl::use_region_memory(
+    const Fam_DataItem_Metadata &dataitem) {
+    Fam_Region_Metadata region;
+    allocator->get_region(dataitem.regionId, dataitem.uid, dataitem.gid,
+                          region);
+    return region.uniformItems;
+}
+
+/*
+ * Registers the whole memory of a region with the given permission, if not
+ * registered yet. Returns REGION_KEY_MISMATCH if the provider chose another
+ * key than the one requested, which then can not be derived by the clients,
+ * and REGION_MR_EXCLUDED if the memory of the region can not be registered
+ * as a whole, so that its dataitems are registered individually.
+ */
+int Fam_Rpc_Service_Impl::register_region_memory(uint64_t regionId,
+                                                 bool permission) {
+    uint64_t key = generate_access_key(regionId, 0, permission) |
+                   FAM_KEY_REGION_MR;
+    uint64_t requestedKey = key;
+    fid_mr *mr = 0;
+    void *base;
+    size_t size;
+    int ret = 0;
+
+    try {
+        allocator->get_region_memory(regionId, base, size);
+    } catch (Memserver_Exception &e) {
+        cout << "warning: " << e.fam_error_msg()
+             << ", registering its dataitems individually" << endl;
+        return REGION_MR_EXCLUDED;
+    }
+
+    pthread_mutex_lock(famOps->get_mr_lock());
+    auto mrObj = fiMrs->find(key);
+    if (mrObj == fiMrs->end()) {
+        ret = fabric_register_mr(base, size, &key, famOps->get_domain(),
+                                 permission, mr);
+        if (ret < 0) {
+            pthread_mutex_unlock(famOps->get_mr_lock());
+            cout << "error: memory register failed" << endl;
+            return ITEM_REGISTRATION_FAILED;
         }
-        pthread_mutex_unlock(famOps->get_mr_lock());
-        // Return status OK
-        return 0;
-    } else if (allocator->check_dataitem_permission(dataitem, 0, uid, gid)) {
-        key = generate_access_key(dataitem.regionId, dataitemId, 0);
-        // register the data item with required permission with libfabric
+        if (key != requestedKey) {
+            fabric_deregister_mr(mr);
+            pthread_mutex_unlock(famOps->get_mr_lock());
+            return REGION_KEY_MISMATCH;
+        }
+
+        fiMrs->insert({key, mr});
+    }
+    pthread_mutex_unlock(famOps->get_mr_lock());
+    return 0;
+}
+
+int Fam_Rpc_Service_Impl::deregister_region_memory(uint64_t regionId,
+                                                   bool permission) {
+    int ret = 0;
+    uint64_t key = generate_access_key(regionId, 0, permission) |
+                   FAM_KEY_REGION_MR;
+
+    pthread_mutex_lock(famOps->get_mr_lock());
+    auto mr = fiMrs->find(key);
+    if (mr != fiMrs->end()) {
+        ret = fabric_deregister_mr(mr->second);
+        if (ret < 0) {
+            pthread_mutex_unlock(famOps->get_mr_lock());
+            cout << "error: memory deregister failed" << endl;
+            return ITEM_DEREGISTRATION_FAILED;
+        }
+        fiMrs->erase(mr);
+    }
+
+    pthread_mutex_unlock(famOps->get_mr_lock());
+    return 0;
+}
+
+/*
+ * Registers again the memory of a resized region, so that its registrations
+ * cover the new size. The new registration is made with the key of the old
+ * one, which is only released once replaced, so that accesses to the region
+ * keep working. Providers which refuse a key in use get the old registration
+ * released first, and accesses to the region fail until it is registered
+ * again. If the resized region can not be registered as a whole, the old
+ * registrations are kept and the resize reports the failure.
+ */
+void Fam_Rpc_Service_Impl::refresh_region_memory(uint64_t regionId) {
+    void *base;
+    size_t size;
+
+    fiMrs = famOps->get_fiMrs();
+    pthread_mutex_lock(famOps->get_mr_lock());
+    bool registered =
+        (fiMrs->count(generate_access_key(regionId, 0, 0) |
+                      FAM_KEY_REGION_MR) ||
+         fiMrs->count(generate_access_key(regionId, 0, 1) | FAM_KEY_REGION_MR));
+    pthread_mutex_unlock(famOps->get_mr_lock());
+    if (!registered)
+        return;
+
+    try {
+        allocator->get_region_memory(regionId, base, size);
+    } catch (Memserver_Exception &e) {
+        throw Memserver_Exception(RESIZE_FAILED, e.fam_error_msg());
+    }
+
+    for (int permission = 0; permission < 2; permission++) {
+        uint64_t key = generate_access_key(regionId, 0, permission) |
+                       FAM_KEY_REGION_MR;
+        uint64_t newKey = key;
+        fid_mr *mr = 0;
+
         pthread_mutex_lock(famOps->get_mr_lock());
         auto mrObj = fiMrs->find(key);
         if (mrObj == fiMrs->end()) {
-            ret = fabric_register_mr(localPointer, dataitem.size, &key,
-                                     famOps->get_domain(), 0, mr);
-            if (ret < 0) {
-                pthread_mutex_unlock(famOps->get_mr_lock());
-                cout << "error: memory register failed" << endl;
-                return ITEM_REGISTRATION_FAILED;
-            }
-
-            fiMrs->insert({key, mr});
+            pthread_mutex_unlock(famOps->get_mr_lock());
+            continue;
+        }
+        fid_mr *oldMr = mrObj->second;
+        int ret = fabric_register_mr(base, size, &newKey, famOps->get_domain(),
+                                     permission, mr);
+        if (ret < 0) {
+            // the provider refuses a key in use
+            fabric_deregister_mr(oldMr);
+            fiMrs->erase(mrObj);
+            oldMr = NULL;
+            newKey = key;
+            ret = fabric_register_mr(base, size, &newKey, famOps->get_domain(),
+                                     permission, mr);
         }
+        if ((ret == 0) && (newKey != key)) {
+            fabric_deregister_mr(mr);
+            ret = REGION_KEY_MISMATCH;
+        }
+        if (ret < 0) {
+            pthread_mutex_unlock(famOps->get_mr_lock());
+            throw Memserver_Exception(
+                RESIZE_FAILED,
+                "Error while resizing region : region registration failed");
+        }
+        (*fiMrs)[key] = mr;
+        if (oldMr != NULL)
+            fabric_deregister_mr(oldMr);
         pthread_mutex_unlock(famOps->get_mr_lock());
-        // Return status OK
-        return 0;
-    } else {
-        cout << "error: Not permitted to register dataitem" << endl;
-        return NOT_PERMITTED;
     }
 }
 
@@ -697,4 +1405,236 @@ Fam_Rpc_Service_Impl::release_CAS_lock(::grpc::ServerContext *context,
     return ::grpc::Status::OK;
 }
 
+::grpc::Status
+Fam_Rpc_Service_Impl::wait_until(::grpc::ServerContext *context,
+                                 const ::Fam_Wait_Request *request,
+                                 ::Fam_Wait_Response *response) {
+    uint64_t value = 0;
+    bool satisfied;
+    try {
+        satisfied = allocator->wait_until(
+            request->regionid(), request->offset(), request->waitoffset(),
+            request->uid(), request->gid(), (Fam_Cmp)request->cmp(),
+            request->value(), request->timeout(), value);
+    } catch (Memserver_Exception &e) {
+        response->set_errorcode(e.fam_error());
+        response->set_errormsg(e.fam_error_msg());
+        return ::grpc::Status::OK;
+    }
+    response->set_value(value);
+    response->set_satisfied(satisfied);
+
+    // Return status OK
+    return ::grpc::Status::OK;
+}
+
+/*
+ * One-sided writes and atomics complete without the memory server being
+ * involved, so the watched range is compared with a snapshot at every
+ * interval, and an event covering all the bytes which changed since the
+ * previous check is streamed to the client. The stream ends when the client
+ * cancels the watch or the server shuts down. The dataitem is looked up again
+ * before every check, so that the watch ends with an error once the dataitem
+ * is deallocated, replaced or no longer readable by the client, instead of
+ * reading memory it no longer owns. Note that each watch holds one of the
+ * server threads for as long as it is active.
+ */
+::grpc::Status
+Fam_Rpc_Service_Impl::watch(::grpc::ServerContext *context,
+                            const ::Fam_Watch_Request *request,
+                            ::grpc::ServerWriter<::Fam_Watch_Event> *writer) {
+    ostringstream message;
+    Fam_Watch_Event event;
+    Fam_DataItem_Metadata dataitem;
+    char *live;
+    uint64_t size = request->size();
+    try {
+        if (size > FAM_WATCH_MAX_SIZE) {
+            message << "Watched range is larger than " << FAM_WATCH_MAX_SIZE
+                    << " bytes";
+            throw Memserver_Exception(OUT_OF_RANGE, message.str().c_str());
+        }
+        allocator->get_dataitem(request->regionid(), request->offset(),
+                                request->uid(), request->gid(), dataitem);
+        live = (char *)allocator->get_local_range(
+            request->regionid(), request->offset(), request->watchoffset(),
+            size, request->uid(), request->gid());
+    } catch (Memserver_Exception &e) {
+        event.set_errorcode(e.fam_error());
+        event.set_errormsg(e.fam_error_msg());
+        writer->Write(event);
+        return ::grpc::Status::OK;
+    }
+
+    uint64_t interval =
+        std::max(request->interval(), (uint64_t)FAM_WATCH_MIN_INTERVAL);
+    openfam_invalidate(live, size);
+    std::vector<char> snapshot(live, live + size);
+    while (!shouldShutdown && !context->IsCancelled()) {
+        usleep((useconds_t)(interval * 1000));
+        try {
+            Fam_DataItem_Metadata current;
+            allocator->get_dataitem(request->regionid(), request->offset(),
+                                    request->uid(), request->gid(), current);
+            if (current.generation != dataitem.generation) {
+                message << "Watched dataitem was deallocated";
+                throw Memserver_Exception(DATAITEM_NOT_FOUND,
+                                          message.str().c_str());
+            }
+            live = (char *)allocator->get_local_range(
+                request->regionid(), request->offset(),
+                request->watchoffset(), size, request->uid(), request->gid());
+        } catch (Memserver_Exception &e) {
+            event.set_errorcode(e.fam_error());
+            event.set_errormsg(e.fam_error_msg());
+            writer->Write(event);
+            break;
+        }
+        openfam_invalidate(live, size);
+        uint64_t first, last;
+        if (fam_watch_scan(live, snapshot.data(), size, &first, &last)) {
+            event.set_watchoffset(request->watchoffset() + first);
+            event.set_size(last - first);
+            if (!writer->Write(event))
+                break;
+        }
+    }
+
+    // Return status OK
+    return ::grpc::Status::OK;
+}
+
+::grpc::Status
+Fam_Rpc_Service_Impl::reduce_item(::grpc::ServerContext *context,
+                                  const ::Fam_Reduce_Request *request,
+                                  ::Fam_Reduce_Response *response) {
+    uint64_t result;
+    try {
+        result = allocator->reduce_item(
+            request->regionid(), request->offset(), request->reduceoffset(),
+            request->nelements(), request->uid(), request->gid(),
+            (Fam_Type)request->type(), (Fam_Reduce_Op)request->op());
+    } catch (Memserver_Exception &e) {
+        response->set_errorcode(e.fam_error());
+        response->set_errormsg(e.fam_error_msg());
+        return ::grpc::Status::OK;
+    }
+    response->set_result(result);
+
+    // Return status OK
+    return ::grpc::Status::OK;
+}
+
+/*
+ * Convert the records, predicates and columns of a scan request
+ */
+static void get_scan_query(const ::Fam_Scan_Request *request,
+                           Fam_Scan_Query &query) {
+    query.recordSize = request->recordsize();
+    query.nRecords = request->nrecords();
+    for (const Fam_Scan_Filter &filter : request->filters()) {
+        Fam_Scan_Predicate predicate;
+        uint64_t low = filter.low();
+        uint64_t high = filter.high();
+        predicate.fieldOffset = filter.fieldoffset();
+        predicate.type = (Fam_Type)filter.type();
+        predicate.op = (Fam_Scan_Op)filter.op();
+        memcpy(&predicate.low, &low, sizeof(low));
+        memcpy(&predicate.high, &high, sizeof(high));
+        query.predicates.push_back(predicate);
+    }
+    for (const Fam_Scan_Projection &projection : request->projections()) {
+        Fam_Scan_Column column;
+        column.offset = projection.offset();
+        column.size = projection.size();
+        query.columns.push_back(column);
+    }
+}
+
+/*
+ * The matching records are either written to a dataitem on this server, or
+ * returned in the response, which is bounded by FAM_SCAN_MAX_RESPONSE.
+ */
+::grpc::Status
+Fam_Rpc_Service_Impl::scan(::grpc::ServerContext *context,
+                           const ::Fam_Scan_Request *request,
+                           ::Fam_Scan_Response *response) {
+    Fam_Scan_Query query;
+    uint64_t nMatched, nScanned = 0;
+    get_scan_query(request, query);
+    try {
+        if (request->todest()) {
+            nMatched = allocator->scan_to_item(
+                request->regionid(), request->offset(), request->scanoffset(),
+                query, request->destregionid(), request->destoffset(),
+                request->destscanoffset(), request->maxsize(), request->uid(),
+                request->gid(), nScanned);
+        } else {
+            std::string *data = response->mutable_data();
+            data->resize(std::min(request->maxsize(),
+                                  (uint64_t)FAM_SCAN_MAX_RESPONSE));
+            nMatched = allocator->scan(request->regionid(), request->offset(),
+                                       request->scanoffset(), query,
+                                       request->uid(), request->gid(),
+                                       &(*data)[0], data->size(), nScanned);
+            data->resize(nMatched * fam_scan_result_size(query));
+        }
+    } catch (Memserver_Exception &e) {
+        response->clear_data();
+        response->set_errorcode(e.fam_error());
+        response->set_errormsg(e.fam_error_msg());
+        return ::grpc::Status::OK;
+    }
+    response->set_nmatched(nMatched);
+    response->set_nscanned(nScanned);
+
+    // Return status OK
+    return ::grpc::Status::OK;
+}
+
+::grpc::Status
+Fam_Rpc_Service_Impl::checksum(::grpc::ServerContext *context,
+                               const ::Fam_Checksum_Request *request,
+                               ::Fam_Checksum_Response *response) {
+    uint64_t digest;
+    try {
+        digest = allocator->checksum(
+            request->regionid(), request->offset(), request->checksumoffset(),
+            request->size(), request->uid(), request->gid(),
+            (Fam_Checksum_Algo)request->algo());
+    } catch (Memserver_Exception &e) {
+        response->set_errorcode(e.fam_error());
+        response->set_errormsg(e.fam_error_msg());
+        return ::grpc::Status::OK;
+    }
+    response->set_digest(digest);
+
+    // Return status OK
+    return ::grpc::Status::OK;
+}
+
+::grpc::Status
+Fam_Rpc_Service_Impl::compare(::grpc::ServerContext *context,
+                              const ::Fam_Compare_Request *request,
+                              ::Fam_Compare_Response *response) {
+    uint64_t diffOffset = 0;
+    bool equal;
+    try {
+        equal = allocator->compare(
+            request->regionid(), request->offset(), request->compareoffset(),
+            request->otherregionid(), request->otheroffset(),
+            request->othercompareoffset(), request->size(), request->uid(),
+            request->gid(), diffOffset);
+    } catch (Memserver_Exception &e) {
+        response->set_errorcode(e.fam_error());
+        response->set_errormsg(e.fam_error_msg());
+        return ::grpc::Status::OK;
+    }
+    response->set_equal(equal);
+    response->set_diffoffset(diffOffset);
+
+    // Return status OK
+    return ::grpc::Status::OK;
+}
+
 } // namespace openfam
@@ -43,10 +43,13 @@
 #include "metadata/fam_metadata_manager.h"
 #include "rpc/fam_rpc.grpc.pb.h"
 
+#include "common/fam_capability.h"
 #include "common/fam_internal.h"
 #include "common/fam_libfabric.h"
 #include "common/fam_ops_libfabric.h"
 #include "common/fam_options.h"
+#include "common/fam_scan.h"
+#include "common/fam_watch.h"
 #include "common/memserver_exception.h"
 
 #include <boost/atomic.hpp>
@@ -56,10 +59,21 @@ namespace openfam {
 #define NOT_PERMITTED -3
 #define ITEM_REGISTRATION_FAILED -4
 #define ITEM_DEREGISTRATION_FAILED -5
+#define REGION_KEY_MISMATCH -6
+#define REGION_MR_EXCLUDED -7
 
 #define CAS_LOCK_CNT 128
 #define LOCKHASH(offset) (offset >> 7) % CAS_LOCK_CNT
 
+// Size of the writes pushing a copy to another memory server, and number of
+// them in flight before waiting for their completion
+#define FAM_COPY_CHUNK_SIZE (1UL << 20)
+#define FAM_COPY_PIPELINE_DEPTH 8
+
+// Deadline, in seconds, of the rpcs made to the memory server a copy is
+// pushed to
+#define FAM_PEER_RPC_TIMEOUT 10
+
 using namespace std;
 using namespace nvmm;
 using namespace metadata;
@@ -84,7 +98,10 @@ class Fam_Rpc_Service_Impl : public Fam_Rpc::Service {
     ~Fam_Rpc_Service_Impl();
 
     void rpc_service_initialize(char *name, char *service, char *provider,
-                                Memserver_Allocator *memAlloc);
+                                Memserver_Allocator *memAlloc,
+                                bool regionMr = false,
+                                MemServerMap peerList = MemServerMap(),
+                                uint64_t peerPort = 0);
 
     void rpc_service_finalize();
 
@@ -116,6 +133,16 @@ class Fam_Rpc_Service_Impl : public Fam_Rpc::Service {
                               const ::Fam_Dataitem_Request *request,
                               ::Fam_Dataitem_Response *response) override;
 
+    ::grpc::Status
+    allocate_batch(::grpc::ServerContext *context,
+                   const ::Fam_Dataitem_Batch_Request *request,
+                   ::Fam_Dataitem_Batch_Response *response) override;
+
+    ::grpc::Status
+    deallocate_batch(::grpc::ServerContext *context,
+                     const ::Fam_Dataitem_Batch_Request *request,
+                     ::Fam_Dataitem_Batch_Response *response) override;
+
     ::grpc::Status
     change_region_permission(::grpc::ServerContext *context,
                              const ::Fam_Region_Request *request,
@@ -133,6 +160,11 @@ class Fam_Rpc_Service_Impl : public Fam_Rpc::Service {
                           const ::Fam_Dataitem_Request *request,
                           ::Fam_Dataitem_Response *response) override;
 
+    ::grpc::Status
+    lookup_batch(::grpc::ServerContext *context,
+                 const ::Fam_Dataitem_Batch_Request *request,
+                 ::Fam_Dataitem_Batch_Response *response) override;
+
     ::grpc::Status
     check_permission_get_region_info(::grpc::ServerContext *context,
                                      const ::Fam_Region_Request *request,
@@ -143,10 +175,19 @@ class Fam_Rpc_Service_Impl : public Fam_Rpc::Service {
                                    const ::Fam_Dataitem_Request *request,
                                    ::Fam_Dataitem_Response *response) override;
 
+    ::grpc::Status check_permission_get_item_info_batch(
+        ::grpc::ServerContext *context,
+        const ::Fam_Dataitem_Batch_Request *request,
+        ::Fam_Dataitem_Batch_Response *response) override;
+
     ::grpc::Status copy(::grpc::ServerContext *context,
                         const ::Fam_Copy_Request *request,
                         ::Fam_Copy_Response *response) override;
 
+    ::grpc::Status fill(::grpc::ServerContext *context,
+                        const ::Fam_Fill_Request *request,
+                        ::Fam_Copy_Response *response) override;
+
     ::grpc::Status acquire_CAS_lock(::grpc::ServerContext *context,
                                     const ::Fam_Dataitem_Request *request,
                                     ::Fam_Dataitem_Response *response) override;
@@ -155,6 +196,30 @@ class Fam_Rpc_Service_Impl : public Fam_Rpc::Service {
                                     const ::Fam_Dataitem_Request *request,
                                     ::Fam_Dataitem_Response *response) override;
 
+    ::grpc::Status wait_until(::grpc::ServerContext *context,
+                              const ::Fam_Wait_Request *request,
+                              ::Fam_Wait_Response *response) override;
+
+    ::grpc::Status
+    watch(::grpc::ServerContext *context, const ::Fam_Watch_Request *request,
+          ::grpc::ServerWriter<::Fam_Watch_Event> *writer) override;
+
+    ::grpc::Status reduce_item(::grpc::ServerContext *context,
+                               const ::Fam_Reduce_Request *request,
+                               ::Fam_Reduce_Response *response) override;
+
+    ::grpc::Status scan(::grpc::ServerContext *context,
+                        const ::Fam_Scan_Request *request,
+                        ::Fam_Scan_Response *response) override;
+
+    ::grpc::Status checksum(::grpc::ServerContext *context,
+                            const ::Fam_Checksum_Request *request,
+                            ::Fam_Checksum_Response *response) override;
+
+    ::grpc::Status compare(::grpc::ServerContext *context,
+                           const ::Fam_Compare_Request *request,
+                           ::Fam_Compare_Response *response) override;
+
   protected:
     uint64_t port;
     Memserver_Allocator *allocator;
@@ -170,6 +235,34 @@ class Fam_Rpc_Service_Impl : public Fam_Rpc::Service {
 
     std::map<uint64_t, fid_mr *> *fiMrs;
 
+    // Register the memory of regions as a whole instead of each dataitem.
+    // Turned off if the provider does not use the keys requested.
+    boost::atomic<bool> regionMrMode;
+
+    // Memory server a copy is pushed to, with its fabric address
+    typedef struct {
+        std::unique_ptr<Fam_Rpc::Stub> stub;
+        fi_addr_t fiAddr;
+    } Fam_Peer;
+
+    // Memory servers copies may be pushed to, by memory server id, and the
+    // grpc port they serve
+    MemServerMap peerNames;
+    uint64_t peerRpcPort;
+
+    // Memory servers copies were pushed to, by memory server id. The lock
+    // is never held across an rpc.
+    std::map<uint64_t, Fam_Peer *> peers;
+    pthread_mutex_t peerLock;
+
+    Fam_Peer *get_peer(uint64_t memserverId);
+
+    void copy_to_peer(const ::Fam_Copy_Request *request);
+
+    void mint_capability(const Fam_DataItem_Metadata &dataitem, uint64_t key,
+                         uint32_t uid, uint32_t gid,
+                         ::Fam_Capability_Token *token);
+
     uint64_t generate_access_key(uint64_t regionId, uint64_t dataitemId,
                                  bool permission);
 
@@ -178,6 +271,25 @@ class Fam_Rpc_Service_Impl : public Fam_Rpc::Service {
     int register_memory(Fam_DataItem_Metadata dataitem, void *localPointer,
                         uint32_t uid, uint32_t gid, uint64_t &key);
 
+    int register_memory(Fam_DataItem_Metadata dataitem, void *localPointer,
+                        uint32_t uid, uint32_t gid, bool regionMemory,
+                        uint64_t &key);
+
+    void set_item_info(const Fam_DataItem_Metadata &dataitem, uint32_t uid,
+                       uint32_t gid, bool regionMemory,
+                       ::Fam_Dataitem_Response *response);
+
+    int register_region_memory(uint64_t regionId, bool permission);
+
+    int deregister_region_memory(uint64_t regionId, bool permission);
+
+    bool use_region_memory(const Fam_DataItem_Metadata &dataitem);
+
+    void refresh_region_memory(uint64_t regionId);
+
+    void release_items(std::vector<Fam_DataItem_Metadata> &dataitems,
+                       uint32_t uid, uint32_t gid);
+
     int register_fence_memory();
 
     int deregister_fence_memory();
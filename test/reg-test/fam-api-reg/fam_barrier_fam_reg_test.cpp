@@ -0,0 +1,116 @@
+/*
+ * fam_barrier_fam_reg_test.cpp
+ * Copyright (c) 2020 Hewlett Packard Enterprise Development, LP. All rights
+ * reserved. Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+#include <fam/fam_exception.h>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <stdio.h>
+#include <string.h>
+
+#include <fam/fam.h>
+
+#include "common/fam_test_config.h"
+
+#define BARRIER_ITERATIONS 16
+
+using namespace std;
+using namespace openfam;
+
+fam *my_fam;
+Fam_Options fam_opts;
+
+// Test case 1 - every PE increments a counter between FAM barriers, and
+// checks that all the increments of the iteration are visible.
+TEST(FamBarrierFam, BarrierFamSuccess) {
+    Fam_Region_Descriptor *desc;
+    Fam_Descriptor *item;
+    const char *testRegion = "barrierFamRegion";
+    const char *firstItem = "barrierFamItem";
+
+    int *myPE;
+    int *numPEs;
+    EXPECT_NO_THROW(myPE = (int *)my_fam->fam_get_option(strdup("PE_ID")));
+    EXPECT_NE((void *)NULL, myPE);
+    EXPECT_NO_THROW(numPEs =
+                        (int *)my_fam->fam_get_option(strdup("PE_COUNT")));
+    EXPECT_NE((void *)NULL, numPEs);
+
+    if (*myPE == 0) {
+        EXPECT_NO_THROW(
+            desc = my_fam->fam_create_region(testRegion, 8192, 0777, RAID1));
+        EXPECT_NE((void *)NULL, desc);
+        EXPECT_NO_THROW(
+            item = my_fam->fam_allocate(firstItem, 1024, 0777, desc));
+        EXPECT_NE((void *)NULL, item);
+        EXPECT_NO_THROW(my_fam->fam_set(item, 0, (uint64_t)0));
+        EXPECT_NO_THROW(my_fam->fam_quiet());
+    }
+
+    EXPECT_NO_THROW(my_fam->fam_barrier_all());
+
+    if (*myPE != 0) {
+        EXPECT_NO_THROW(desc = my_fam->fam_lookup_region(testRegion));
+        EXPECT_NO_THROW(item = my_fam->fam_lookup(firstItem, testRegion));
+    }
+
+    for (int i = 1; i <= BARRIER_ITERATIONS; i++) {
+        EXPECT_NO_THROW(my_fam->fam_add(item, 0, (uint64_t)1));
+        EXPECT_NO_THROW(my_fam->fam_barrier_all());
+        uint64_t value = 0;
+        EXPECT_NO_THROW(value = my_fam->fam_fetch_uint64(item, 0));
+        EXPECT_EQ((uint64_t)(i * (*numPEs)), value);
+        EXPECT_NO_THROW(my_fam->fam_barrier_all());
+    }
+
+    if (*myPE == 0) {
+        EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+        EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+    }
+
+    delete item;
+    delete desc;
+}
+
+int main(int argc, char **argv) {
+    int ret;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    my_fam = new fam();
+
+    init_fam_options(&fam_opts);
+    fam_opts.barrier = strdup("FAM");
+
+    EXPECT_NO_THROW(my_fam->fam_initialize("default", &fam_opts));
+
+    ret = RUN_ALL_TESTS();
+
+    EXPECT_NO_THROW(my_fam->fam_finalize("default"));
+
+    return ret;
+}
@@ -0,0 +1,167 @@
+/*
+ * fam_capability_reg_test.cpp
+ * Copyright (c) 2020 Hewlett Packard Enterprise Development, LP. All rights
+ * reserved. Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+#include <fam/fam_exception.h>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <stdio.h>
+#include <string.h>
+
+#include <fam/fam.h>
+
+#include "common/fam_test_config.h"
+
+using namespace std;
+using namespace openfam;
+
+fam *my_fam;
+Fam_Options fam_opts;
+
+// Test case 1 - access a data item through a descriptor built from the
+// global descriptor and the capability of another descriptor.
+TEST(FamCapability, CapabilitySuccess) {
+    Fam_Region_Descriptor *desc;
+    Fam_Descriptor *item;
+    char *local = strdup("Test message");
+    const char *testRegion = get_uniq_str("test", my_fam);
+    const char *firstItem = get_uniq_str("first", my_fam);
+
+    EXPECT_NO_THROW(
+        desc = my_fam->fam_create_region(testRegion, 8192, 0777, RAID1));
+    EXPECT_NE((void *)NULL, desc);
+
+    // Allocating data items in the created region
+    EXPECT_NO_THROW(item = my_fam->fam_allocate(firstItem, 1024, 0777, desc));
+    EXPECT_NE((void *)NULL, item);
+
+    Fam_Capability cap = item->get_capability();
+    EXPECT_NE((uint64_t)0, cap.expiry);
+    EXPECT_EQ(item->get_key(), cap.key);
+    EXPECT_EQ((uint64_t)1024, cap.size);
+
+    Fam_Descriptor *itemCopy = new Fam_Descriptor(item->get_global_descriptor());
+    itemCopy->set_capability(cap);
+
+    EXPECT_NO_THROW(my_fam->fam_put_blocking(local, itemCopy, 0, 13));
+    EXPECT_EQ(cap.key, itemCopy->get_key());
+    EXPECT_EQ((uint64_t)1024, itemCopy->get_size());
+
+    char *local2 = (char *)malloc(20);
+    EXPECT_NO_THROW(my_fam->fam_get_blocking(local2, itemCopy, 0, 13));
+    EXPECT_STREQ(local, local2);
+
+    EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+    EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+
+    delete itemCopy;
+    delete item;
+    delete desc;
+
+    free(local);
+    free(local2);
+    free((void *)testRegion);
+    free((void *)firstItem);
+}
+
+// Test case 2 - an expired capability, or one handed out for another user,
+// falls back to checking permission with the memory server.
+TEST(FamCapability, CapabilityExpired) {
+    Fam_Region_Descriptor *desc;
+    Fam_Descriptor *item;
+    Fam_Descriptor *lookupItem;
+    char *local = strdup("Test message");
+    const char *testRegion = get_uniq_str("test", my_fam);
+    const char *firstItem = get_uniq_str("first", my_fam);
+
+    EXPECT_NO_THROW(
+        desc = my_fam->fam_create_region(testRegion, 8192, 0777, RAID1));
+    EXPECT_NE((void *)NULL, desc);
+
+    EXPECT_NO_THROW(item = my_fam->fam_allocate(firstItem, 1024, 0777, desc));
+    EXPECT_NE((void *)NULL, item);
+
+    // Lookup also returns a capability
+    EXPECT_NO_THROW(lookupItem = my_fam->fam_lookup(firstItem, testRegion));
+    EXPECT_NE((uint64_t)0, lookupItem->get_capability().expiry);
+
+    Fam_Capability cap = item->get_capability();
+    cap.expiry = 1;
+    Fam_Descriptor *itemCopy = new Fam_Descriptor(item->get_global_descriptor());
+    itemCopy->set_capability(cap);
+
+    EXPECT_NO_THROW(my_fam->fam_put_blocking(local, itemCopy, 0, 13));
+    EXPECT_EQ(item->get_key(), itemCopy->get_key());
+    EXPECT_LT((uint64_t)1, itemCopy->get_capability().expiry);
+
+    char *local2 = (char *)malloc(20);
+    EXPECT_NO_THROW(my_fam->fam_get_blocking(local2, itemCopy, 0, 13));
+    EXPECT_STREQ(local, local2);
+
+    cap = item->get_capability();
+    cap.uid++;
+    Fam_Descriptor *otherCopy =
+        new Fam_Descriptor(item->get_global_descriptor());
+    otherCopy->set_capability(cap);
+
+    memset(local2, 0, 20);
+    EXPECT_NO_THROW(my_fam->fam_get_blocking(local2, otherCopy, 0, 13));
+    EXPECT_STREQ(local, local2);
+    EXPECT_EQ(item->get_capability().uid, otherCopy->get_capability().uid);
+
+    EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+    EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+
+    delete otherCopy;
+    delete itemCopy;
+    delete lookupItem;
+    delete item;
+    delete desc;
+
+    free(local);
+    free(local2);
+    free((void *)testRegion);
+    free((void *)firstItem);
+}
+
+int main(int argc, char **argv) {
+    int ret;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    my_fam = new fam();
+
+    init_fam_options(&fam_opts);
+
+    EXPECT_NO_THROW(my_fam->fam_initialize("default", &fam_opts));
+
+    ret = RUN_ALL_TESTS();
+
+    EXPECT_NO_THROW(my_fam->fam_finalize("default"));
+
+    return ret;
+}
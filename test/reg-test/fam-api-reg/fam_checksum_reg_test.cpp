@@ -0,0 +1,169 @@
+/*
+ * fam_checksum_reg_test.cpp
+ * Copyright (c) 2020 Hewlett Packard Enterprise Development, LP. All rights
+ * reserved. Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+#include <fam/fam_exception.h>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <stdio.h>
+#include <string.h>
+
+#include <fam/fam.h>
+
+#include "common/fam_test_config.h"
+
+using namespace std;
+using namespace openfam;
+
+fam *my_fam;
+Fam_Options fam_opts;
+
+#define ITEM_SIZE 200000
+
+// Test case 1 - digests of known inputs.
+TEST(FamChecksum, ChecksumSuccess) {
+    Fam_Region_Descriptor *desc;
+    Fam_Descriptor *item;
+    const char *testRegion = get_uniq_str("test", my_fam);
+    const char *firstItem = get_uniq_str("first", my_fam);
+    const char *input = "123456789";
+    uint64_t digest;
+
+    EXPECT_NO_THROW(
+        desc = my_fam->fam_create_region(testRegion, 1048576, 0777, RAID1));
+    EXPECT_NE((void *)NULL, desc);
+
+    EXPECT_NO_THROW(item = my_fam->fam_allocate(firstItem, 1024, 0777, desc));
+    EXPECT_NE((void *)NULL, item);
+
+    EXPECT_NO_THROW(my_fam->fam_put_blocking((void *)input, item, 16, 9));
+
+    EXPECT_NO_THROW(
+        digest = my_fam->fam_checksum(item, 16, 9, FAM_CHECKSUM_CRC32C));
+    EXPECT_EQ(0xE3069283ULL, digest);
+    EXPECT_NO_THROW(
+        digest = my_fam->fam_checksum(item, 16, 0, FAM_CHECKSUM_XXH64));
+    EXPECT_EQ(0xEF46DB3751D8E999ULL, digest);
+
+    // Range beyond the data item, invalid algorithm
+    EXPECT_THROW(my_fam->fam_checksum(item, 16, 1024, FAM_CHECKSUM_XXH64),
+                 Fam_Exception);
+    EXPECT_THROW(my_fam->fam_checksum(item, 0, 16, (Fam_Checksum_Algo)99),
+                 Fam_Exception);
+
+    EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+    EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+
+    delete item;
+    delete desc;
+
+    free((void *)testRegion);
+    free((void *)firstItem);
+}
+
+// Test case 2 - compare equal, differing and shorter data items.
+TEST(FamChecksum, CompareItemsSuccess) {
+    Fam_Region_Descriptor *desc;
+    Fam_Descriptor *first, *second, *shorter;
+    const char *testRegion = get_uniq_str("test", my_fam);
+    const char *firstItem = get_uniq_str("first", my_fam);
+    const char *secondItem = get_uniq_str("second", my_fam);
+    const char *shorterItem = get_uniq_str("shorter", my_fam);
+    char *local = (char *)malloc(ITEM_SIZE);
+    uint64_t diffOffset = 0;
+    bool equal;
+
+    EXPECT_NO_THROW(
+        desc = my_fam->fam_create_region(testRegion, 1048576, 0777, RAID1));
+    EXPECT_NE((void *)NULL, desc);
+
+    EXPECT_NO_THROW(
+        first = my_fam->fam_allocate(firstItem, ITEM_SIZE, 0777, desc));
+    EXPECT_NO_THROW(
+        second = my_fam->fam_allocate(secondItem, ITEM_SIZE, 0777, desc));
+    EXPECT_NO_THROW(shorter = my_fam->fam_allocate(shorterItem,
+                                                   ITEM_SIZE / 2, 0777, desc));
+
+    for (int i = 0; i < ITEM_SIZE; i++)
+        local[i] = (char)(i % 251);
+    EXPECT_NO_THROW(my_fam->fam_put_blocking(local, first, 0, ITEM_SIZE));
+    EXPECT_NO_THROW(my_fam->fam_put_blocking(local, second, 0, ITEM_SIZE));
+    EXPECT_NO_THROW(
+        my_fam->fam_put_blocking(local, shorter, 0, ITEM_SIZE / 2));
+
+    EXPECT_NO_THROW(equal = my_fam->fam_compare_items(first, second));
+    EXPECT_TRUE(equal);
+    EXPECT_EQ(my_fam->fam_checksum(first, 0, ITEM_SIZE, FAM_CHECKSUM_XXH64),
+              my_fam->fam_checksum(second, 0, ITEM_SIZE, FAM_CHECKSUM_XXH64));
+
+    local[123457] = (char)(local[123457] + 1);
+    EXPECT_NO_THROW(
+        my_fam->fam_put_blocking(local + 123457, second, 123457, 1));
+    EXPECT_NO_THROW(
+        equal = my_fam->fam_compare_items(first, second, &diffOffset));
+    EXPECT_FALSE(equal);
+    EXPECT_EQ((uint64_t)123457, diffOffset);
+
+    EXPECT_NO_THROW(
+        equal = my_fam->fam_compare_items(first, shorter, &diffOffset));
+    EXPECT_FALSE(equal);
+    EXPECT_EQ((uint64_t)(ITEM_SIZE / 2), diffOffset);
+
+    EXPECT_NO_THROW(my_fam->fam_deallocate(first));
+    EXPECT_NO_THROW(my_fam->fam_deallocate(second));
+    EXPECT_NO_THROW(my_fam->fam_deallocate(shorter));
+    EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+
+    delete first;
+    delete second;
+    delete shorter;
+    delete desc;
+
+    free(local);
+    free((void *)testRegion);
+    free((void *)firstItem);
+    free((void *)secondItem);
+    free((void *)shorterItem);
+}
+
+int main(int argc, char **argv) {
+    int ret;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    my_fam = new fam();
+
+    init_fam_options(&fam_opts);
+
+    EXPECT_NO_THROW(my_fam->fam_initialize("default", &fam_opts));
+
+    ret = RUN_ALL_TESTS();
+
+    EXPECT_NO_THROW(my_fam->fam_finalize("default"));
+
+    return ret;
+}
@@ -0,0 +1,131 @@
+/*
+ * fam_collective_reg_test.cpp
+ * Copyright (c) 2020 Hewlett Packard Enterprise Development, LP. All rights
+ * reserved. Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+#include <fam/fam_exception.h>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <stdio.h>
+#include <string.h>
+
+#include <fam/fam.h>
+
+#include "common/fam_test_config.h"
+
+// Large enough to be processed in several chunks
+#define NUM_ELEMENTS 10000
+
+using namespace std;
+using namespace openfam;
+
+fam *my_fam;
+Fam_Options fam_opts;
+int myPE;
+int numPEs;
+
+// Test case 1 - broadcast a buffer from every PE in turn.
+TEST(FamCollective, BroadcastSuccess) {
+    uint64_t *data = (uint64_t *)malloc(NUM_ELEMENTS * sizeof(uint64_t));
+
+    for (int root = 0; root < numPEs; root++) {
+        for (int i = 0; i < NUM_ELEMENTS; i++)
+            data[i] = (myPE == root) ? (uint64_t)(root * NUM_ELEMENTS + i) : 0;
+        EXPECT_NO_THROW(
+            my_fam->fam_broadcast(data, NUM_ELEMENTS * sizeof(uint64_t), root));
+        for (int i = 0; i < NUM_ELEMENTS; i++)
+            EXPECT_EQ((uint64_t)(root * NUM_ELEMENTS + i), data[i]);
+    }
+    free(data);
+}
+
+// Test case 2 - reduce to every PE in turn.
+TEST(FamCollective, ReduceSuccess) {
+    int64_t *src = (int64_t *)malloc(NUM_ELEMENTS * sizeof(int64_t));
+    int64_t *dest = (int64_t *)malloc(NUM_ELEMENTS * sizeof(int64_t));
+
+    for (int i = 0; i < NUM_ELEMENTS; i++)
+        src[i] = myPE + i;
+    for (int root = 0; root < numPEs; root++) {
+        EXPECT_NO_THROW(my_fam->fam_reduce(dest, src, NUM_ELEMENTS,
+                                           FAM_TYPE_INT64, FAM_REDUCE_SUM,
+                                           root));
+        if (myPE == root) {
+            for (int i = 0; i < NUM_ELEMENTS; i++)
+                EXPECT_EQ((int64_t)(numPEs * (numPEs - 1) / 2 + numPEs * i),
+                          dest[i]);
+        }
+    }
+    free(src);
+    free(dest);
+}
+
+// Test case 3 - allreduce with min and max.
+TEST(FamCollective, AllreduceSuccess) {
+    double *src = (double *)malloc(NUM_ELEMENTS * sizeof(double));
+    double *dest = (double *)malloc(NUM_ELEMENTS * sizeof(double));
+
+    for (int i = 0; i < NUM_ELEMENTS; i++)
+        src[i] = (double)(myPE * i);
+    EXPECT_NO_THROW(my_fam->fam_allreduce(dest, src, NUM_ELEMENTS,
+                                          FAM_TYPE_DOUBLE, FAM_REDUCE_MAX));
+    for (int i = 0; i < NUM_ELEMENTS; i++)
+        EXPECT_EQ((double)((numPEs - 1) * i), dest[i]);
+
+    EXPECT_NO_THROW(my_fam->fam_allreduce(dest, src, NUM_ELEMENTS,
+                                          FAM_TYPE_DOUBLE, FAM_REDUCE_MIN));
+    for (int i = 0; i < NUM_ELEMENTS; i++)
+        EXPECT_EQ((double)0, dest[i]);
+    free(src);
+    free(dest);
+}
+
+// Test case 4 - invalid root PE.
+TEST(FamCollective, InvalidRoot) {
+    uint64_t data = 0;
+    EXPECT_THROW(my_fam->fam_broadcast(&data, sizeof(data), numPEs),
+                 Fam_InvalidOption_Exception);
+}
+
+int main(int argc, char **argv) {
+    int ret;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    my_fam = new fam();
+
+    init_fam_options(&fam_opts);
+
+    EXPECT_NO_THROW(my_fam->fam_initialize("default", &fam_opts));
+    myPE = *(int *)my_fam->fam_get_option(strdup("PE_ID"));
+    numPEs = *(int *)my_fam->fam_get_option(strdup("PE_COUNT"));
+
+    ret = RUN_ALL_TESTS();
+
+    EXPECT_NO_THROW(my_fam->fam_finalize("default"));
+
+    return ret;
+}
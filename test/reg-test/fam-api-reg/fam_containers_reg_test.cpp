@@ -0,0 +1,244 @@
+/*
+ * fam_containers_reg_test.cpp
+ * Copyright (c) 2020 Hewlett Packard Enterprise Development, LP. All rights
+ * reserved. Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+#include <fam/fam_exception.h>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <stdio.h>
+#include <string.h>
+
+#include <fam/fam.h>
+#include <fam/fam_containers.h>
+
+#include "common/fam_test_config.h"
+
+#define NUM_ITEMS 32
+
+using namespace std;
+using namespace openfam;
+
+fam *my_fam;
+Fam_Options fam_opts;
+int myPE;
+int numPEs;
+Fam_Region_Descriptor *desc = NULL;
+
+// Allocate a data item on PE 0 and share it with all the PEs
+static Fam_Descriptor *allocate_shared(const char *name, uint64_t size) {
+    Fam_Descriptor *item = NULL;
+    if (myPE == 0)
+        EXPECT_NO_THROW(item = my_fam->fam_allocate(name, size, 0777, desc));
+    EXPECT_NO_THROW(item = my_fam->fam_broadcast_descriptor(0, item));
+    return item;
+}
+
+static void free_shared(Fam_Descriptor *item) {
+    my_fam->fam_barrier_all();
+    if (myPE == 0)
+        EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+    delete item;
+}
+
+// Test case 1 - every PE enqueues elements, then the PEs drain the queue.
+TEST(FamContainers, QueueSuccess) {
+    uint64_t capacity = NUM_ITEMS * numPEs;
+    Fam_Descriptor *item =
+        allocate_shared("queue", Fam_Queue::size(capacity, sizeof(uint64_t)));
+    if (myPE == 0)
+        EXPECT_NO_THROW(Fam_Queue::initialize(my_fam, item, capacity,
+                                              sizeof(uint64_t)));
+    my_fam->fam_barrier_all();
+
+    Fam_Queue queue(my_fam, item);
+    for (uint64_t i = 0; i < NUM_ITEMS; i++) {
+        uint64_t element = myPE * NUM_ITEMS + i;
+        EXPECT_TRUE(queue.enqueue(&element));
+    }
+    my_fam->fam_quiet();
+    my_fam->fam_barrier_all();
+
+    uint64_t element = 0;
+    if (myPE == 0)
+        EXPECT_FALSE(queue.enqueue(&element));
+    my_fam->fam_barrier_all();
+
+    uint64_t sum = 0, count = 0;
+    while (queue.dequeue(&element)) {
+        sum += element;
+        count++;
+    }
+    uint64_t totals[2] = { sum, count };
+    my_fam->fam_allreduce(totals, totals, 2, FAM_TYPE_UINT64, FAM_REDUCE_SUM);
+    EXPECT_EQ(capacity * (capacity - 1) / 2, totals[0]);
+    EXPECT_EQ(capacity, totals[1]);
+    EXPECT_FALSE(queue.dequeue(&element));
+
+    free_shared(item);
+}
+
+// Test case 2 - every PE appends records, then reads the whole log.
+TEST(FamContainers, LogSuccess) {
+    uint64_t capacity = 2 * NUM_ITEMS * numPEs * 32;
+    Fam_Descriptor *item = allocate_shared("log", Fam_Log::size(capacity));
+    if (myPE == 0)
+        EXPECT_NO_THROW(Fam_Log::initialize(my_fam, item, capacity));
+    my_fam->fam_barrier_all();
+
+    Fam_Log log(my_fam, item);
+    char record[32];
+    for (int i = 0; i < NUM_ITEMS; i++) {
+        snprintf(record, sizeof(record), "record %d %d", myPE, i);
+        EXPECT_NO_THROW(log.append(record, strlen(record) + 1));
+    }
+    const void *records[NUM_ITEMS];
+    uint64_t sizes[NUM_ITEMS];
+    for (int i = 0; i < NUM_ITEMS; i++) {
+        records[i] = "batch";
+        sizes[i] = 6;
+    }
+    EXPECT_NO_THROW(log.append_batch(records, sizes, NUM_ITEMS));
+    my_fam->fam_barrier_all();
+
+    uint64_t position = 0, next = 0, count = 0;
+    while (position < log.tail()) {
+        uint64_t length = 0;
+        EXPECT_NO_THROW(length =
+                            log.read(position, record, sizeof(record), &next));
+        EXPECT_EQ(strlen(record) + 1, length);
+        position = next;
+        count++;
+    }
+    EXPECT_EQ((uint64_t)(2 * NUM_ITEMS * numPEs), count);
+    my_fam->fam_barrier_all();
+
+    // An append which does not fit leaves the tail unchanged
+    if (myPE == 0) {
+        uint64_t tail = log.tail();
+        EXPECT_THROW(log.append(record, capacity), Fam_Exception);
+        EXPECT_EQ(tail, log.tail());
+    }
+
+    free_shared(item);
+}
+
+// Test case 3 - every PE inserts keys, then looks up the keys of all PEs.
+TEST(FamContainers, HashMapSuccess) {
+    uint64_t capacity = 2 * NUM_ITEMS * numPEs;
+    Fam_Descriptor *item = allocate_shared(
+        "hashmap", Fam_Hash_Map::size(capacity, sizeof(uint64_t)));
+    if (myPE == 0)
+        EXPECT_NO_THROW(Fam_Hash_Map::initialize(my_fam, item, capacity,
+                                                 sizeof(uint64_t)));
+    my_fam->fam_barrier_all();
+
+    Fam_Hash_Map map(my_fam, item);
+    for (uint64_t i = 0; i < NUM_ITEMS; i++) {
+        uint64_t key = myPE * NUM_ITEMS + i + 1;
+        uint64_t value = key * 10;
+        EXPECT_TRUE(map.insert(key, &value));
+        EXPECT_FALSE(map.insert(key, &value));
+    }
+    my_fam->fam_quiet();
+    my_fam->fam_barrier_all();
+
+    for (uint64_t key = 1; key <= (uint64_t)(NUM_ITEMS * numPEs); key++) {
+        uint64_t value = 0;
+        EXPECT_TRUE(map.find(key, &value));
+        EXPECT_EQ(key * 10, value);
+    }
+    uint64_t value = 0;
+    EXPECT_FALSE(map.find(NUM_ITEMS * numPEs + 1, &value));
+
+    free_shared(item);
+}
+
+// Test case 4 - PE 0 adds all the tasks, which spawn new tasks, and the other
+// PEs steal them.
+TEST(FamContainers, TaskPoolSuccess) {
+    uint64_t capacity = 2 * NUM_ITEMS;
+    Fam_Descriptor *item = allocate_shared(
+        "taskpool", Fam_Task_Pool::size(numPEs, capacity, sizeof(uint64_t)));
+    if (myPE == 0)
+        EXPECT_NO_THROW(Fam_Task_Pool::initialize(my_fam, item, numPEs,
+                                                  capacity, sizeof(uint64_t)));
+    my_fam->fam_barrier_all();
+
+    Fam_Task_Pool pool(my_fam, item, 4);
+    if (myPE == 0) {
+        uint64_t tasks[NUM_ITEMS];
+        for (uint64_t i = 0; i < NUM_ITEMS; i++)
+            tasks[i] = i;
+        EXPECT_TRUE(pool.add_batch(tasks, NUM_ITEMS));
+    }
+    my_fam->fam_barrier_all();
+
+    uint64_t task, sum = 0, count = 0;
+    while (pool.get(&task)) {
+        if (task < NUM_ITEMS) {
+            uint64_t child = task + NUM_ITEMS;
+            EXPECT_TRUE(pool.add(&child));
+        }
+        sum += task;
+        count++;
+    }
+    uint64_t totals[2] = { sum, count };
+    my_fam->fam_allreduce(totals, totals, 2, FAM_TYPE_UINT64, FAM_REDUCE_SUM);
+    EXPECT_EQ((uint64_t)NUM_ITEMS * (2 * NUM_ITEMS - 1), totals[0]);
+    EXPECT_EQ((uint64_t)(2 * NUM_ITEMS), totals[1]);
+
+    free_shared(item);
+}
+
+int main(int argc, char **argv) {
+    int ret;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    my_fam = new fam();
+
+    init_fam_options(&fam_opts);
+
+    EXPECT_NO_THROW(my_fam->fam_initialize("default", &fam_opts));
+    myPE = *(int *)my_fam->fam_get_option(strdup("PE_ID"));
+    numPEs = *(int *)my_fam->fam_get_option(strdup("PE_COUNT"));
+
+    if (myPE == 0)
+        EXPECT_NO_THROW(desc = my_fam->fam_create_region(
+                            "containerRegion", 1048576, 0777, RAID1));
+    my_fam->fam_barrier_all();
+
+    ret = RUN_ALL_TESTS();
+
+    my_fam->fam_barrier_all();
+    if (myPE == 0)
+        EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+
+    EXPECT_NO_THROW(my_fam->fam_finalize("default"));
+
+    return ret;
+}
@@ -203,6 +203,58 @@ TEST(FamCopy, CopyFailLenOutOfRange) {
     free((void *)firstItem);
 }
 
+// Test case 5 - copy into an existing data item, and out of its range.
+TEST(FamCopy, CopyToExistingItemSuccess) {
+    Fam_Region_Descriptor *desc;
+    Fam_Descriptor *item, *dest;
+    char *local = strdup("Test message");
+    const char *testRegion = get_uniq_str("test", my_fam);
+    const char *firstItem = get_uniq_str("first", my_fam);
+    const char *secondItem = get_uniq_str("second", my_fam);
+    void *waitObj;
+
+    EXPECT_NO_THROW(
+        desc = my_fam->fam_create_region(testRegion, 8192, 0777, RAID1));
+    EXPECT_NE((void *)NULL, desc);
+
+    EXPECT_NO_THROW(item = my_fam->fam_allocate(firstItem, 128, 0777, desc));
+    EXPECT_NE((void *)NULL, item);
+    EXPECT_NO_THROW(dest = my_fam->fam_allocate(secondItem, 64, 0777, desc));
+    EXPECT_NE((void *)NULL, dest);
+
+    EXPECT_NO_THROW(my_fam->fam_put_blocking(local, item, 0, 13));
+
+    // Copy twice into the same destination, at different offsets
+    char *local2 = (char *)malloc(13);
+    for (uint64_t destOffset = 0; destOffset <= 51; destOffset += 51) {
+        EXPECT_NO_THROW(waitObj =
+                            my_fam->fam_copy(item, 0, dest, destOffset, 13));
+        EXPECT_NE((void *)NULL, waitObj);
+        EXPECT_NO_THROW(my_fam->fam_copy_wait(waitObj));
+        EXPECT_NO_THROW(
+            my_fam->fam_get_blocking(local2, dest, destOffset, 13));
+        EXPECT_STREQ(local, local2);
+    }
+
+    EXPECT_THROW(my_fam->fam_copy(item, 0, dest, 52, 13),
+                 Fam_Allocator_Exception);
+    EXPECT_THROW(my_fam->fam_copy(item, 120, dest, 0, 13),
+                 Fam_Allocator_Exception);
+
+    EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+    EXPECT_NO_THROW(my_fam->fam_deallocate(dest));
+    EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+
+    delete item;
+    delete dest;
+    delete desc;
+
+    free(local2);
+    free((void *)testRegion);
+    free((void *)firstItem);
+    free((void *)secondItem);
+}
+
 int main(int argc, char **argv) {
     int ret;
     ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,157 @@
+/*
+ * fam_descriptor_bcast_reg_test.cpp
+ * Copyright (c) 2020 Hewlett Packard Enterprise Development, LP. All rights
+ * reserved. Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+#include <fam/fam_exception.h>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <stdio.h>
+#include <string.h>
+
+#include <fam/fam.h>
+
+#include "common/fam_test_config.h"
+
+using namespace std;
+using namespace openfam;
+
+fam *my_fam;
+Fam_Options fam_opts;
+
+// Test case 1 - serialize a descriptor and access the data item through the
+// deserialized descriptor.
+TEST(FamDescriptorBcast, SerializeSuccess) {
+    Fam_Region_Descriptor *desc;
+    Fam_Descriptor *item;
+    Fam_Descriptor *copy;
+    char buffer[FAM_DESCRIPTOR_SERIALIZED_SIZE];
+    size_t len = sizeof(buffer);
+    char *local = strdup("Test message");
+    const char *testRegion = get_uniq_str("test", my_fam);
+    const char *firstItem = get_uniq_str("first", my_fam);
+
+    EXPECT_NO_THROW(
+        desc = my_fam->fam_create_region(testRegion, 8192, 0777, RAID1));
+    EXPECT_NE((void *)NULL, desc);
+
+    EXPECT_NO_THROW(item = my_fam->fam_allocate(firstItem, 1024, 0777, desc));
+    EXPECT_NE((void *)NULL, item);
+
+    EXPECT_NO_THROW(my_fam->fam_descriptor_serialize(item, buffer, &len));
+    EXPECT_EQ((size_t)FAM_DESCRIPTOR_SERIALIZED_SIZE, len);
+
+    EXPECT_NO_THROW(copy = my_fam->fam_descriptor_deserialize(buffer, len));
+    EXPECT_NE((void *)NULL, copy);
+    EXPECT_EQ(item->get_global_descriptor().regionId,
+              copy->get_global_descriptor().regionId);
+    EXPECT_EQ(item->get_global_descriptor().offset,
+              copy->get_global_descriptor().offset);
+    EXPECT_EQ(item->get_memserver_id(), copy->get_memserver_id());
+
+    EXPECT_NO_THROW(my_fam->fam_put_blocking(local, copy, 0, 13));
+    char *local2 = (char *)malloc(20);
+    EXPECT_NO_THROW(my_fam->fam_get_blocking(local2, item, 0, 13));
+    EXPECT_STREQ(local, local2);
+
+    EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+    EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+
+    delete copy;
+    delete item;
+    delete desc;
+
+    free(local2);
+    free((void *)testRegion);
+    free((void *)firstItem);
+}
+
+// Test case 2 - deserialize a buffer which does not hold a descriptor.
+TEST(FamDescriptorBcast, DeserializeFail) {
+    char buffer[FAM_DESCRIPTOR_SERIALIZED_SIZE];
+    size_t len = 8;
+
+    memset(buffer, 0, sizeof(buffer));
+    EXPECT_THROW(my_fam->fam_descriptor_deserialize(buffer, sizeof(buffer)),
+                 Fam_InvalidOption_Exception);
+    EXPECT_THROW(my_fam->fam_descriptor_deserialize(buffer, len),
+                 Fam_InvalidOption_Exception);
+}
+
+// Test case 3 - PE 0 looks up a data item and broadcasts its descriptor to
+// all the PEs.
+TEST(FamDescriptorBcast, BroadcastSuccess) {
+    Fam_Region_Descriptor *desc = NULL;
+    Fam_Descriptor *item = NULL;
+    Fam_Descriptor *bcastItem;
+    uint64_t value = 0;
+    int *myPE = (int *)my_fam->fam_get_option(strdup("PE_ID"));
+    const char *testRegion = "bcastRegion";
+    const char *firstItem = "bcastItem";
+
+    if (*myPE == 0) {
+        EXPECT_NO_THROW(
+            desc = my_fam->fam_create_region(testRegion, 8192, 0777, RAID1));
+        EXPECT_NO_THROW(
+            item = my_fam->fam_allocate(firstItem, 1024, 0777, desc));
+        EXPECT_NO_THROW(my_fam->fam_set(item, 0, (uint64_t)0xABCD));
+        EXPECT_NO_THROW(my_fam->fam_quiet());
+    }
+
+    EXPECT_NO_THROW(bcastItem = my_fam->fam_broadcast_descriptor(0, item));
+    EXPECT_NE((void *)NULL, bcastItem);
+    EXPECT_NO_THROW(value = my_fam->fam_fetch_uint64(bcastItem, 0));
+    EXPECT_EQ((uint64_t)0xABCD, value);
+
+    my_fam->fam_barrier_all();
+
+    if (*myPE == 0) {
+        EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+        EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+        delete item;
+        delete desc;
+    } else {
+        delete bcastItem;
+    }
+}
+
+int main(int argc, char **argv) {
+    int ret;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    my_fam = new fam();
+
+    init_fam_options(&fam_opts);
+
+    EXPECT_NO_THROW(my_fam->fam_initialize("default", &fam_opts));
+
+    ret = RUN_ALL_TESTS();
+
+    EXPECT_NO_THROW(my_fam->fam_finalize("default"));
+
+    return ret;
+}
@@ -0,0 +1,168 @@
+/*
+ * fam_fill_reg_test.cpp
+ * Copyright (c) 2020 Hewlett Packard Enterprise Development, LP. All rights
+ * reserved. Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+#include <fam/fam_exception.h>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <stdio.h>
+#include <string.h>
+
+#include <fam/fam.h>
+
+#include "common/fam_test_config.h"
+
+using namespace std;
+using namespace openfam;
+
+fam *my_fam;
+Fam_Options fam_opts;
+
+#define ITEM_SIZE 4096
+
+// Test case 1 - memset a range and check the bytes around it are untouched.
+TEST(FamFill, MemsetSuccess) {
+    Fam_Region_Descriptor *desc;
+    Fam_Descriptor *item;
+    const char *testRegion = get_uniq_str("test", my_fam);
+    const char *firstItem = get_uniq_str("first", my_fam);
+    unsigned char buf[ITEM_SIZE];
+    void *waitObj;
+
+    EXPECT_NO_THROW(
+        desc = my_fam->fam_create_region(testRegion, 8192, 0777, RAID1));
+    EXPECT_NE((void *)NULL, desc);
+
+    EXPECT_NO_THROW(
+        item = my_fam->fam_allocate(firstItem, ITEM_SIZE, 0777, desc));
+    EXPECT_NE((void *)NULL, item);
+
+    memset(buf, 0xAA, sizeof(buf));
+    EXPECT_NO_THROW(my_fam->fam_put_blocking(buf, item, 0, sizeof(buf)));
+
+    // Unaligned start and length exercise the head and tail of the fill
+    EXPECT_NO_THROW(waitObj = my_fam->fam_memset(item, 13, 0x1FF, 3001));
+    EXPECT_NO_THROW(my_fam->fam_fill_wait(waitObj));
+
+    EXPECT_NO_THROW(my_fam->fam_get_blocking(buf, item, 0, sizeof(buf)));
+    for (uint64_t i = 0; i < ITEM_SIZE; i++) {
+        if ((i >= 13) && (i < 13 + 3001))
+            EXPECT_EQ(0xFF, buf[i]);
+        else
+            EXPECT_EQ(0xAA, buf[i]);
+    }
+
+    // Range beyond the end of the data item
+    EXPECT_THROW(
+        {
+            waitObj = my_fam->fam_memset(item, ITEM_SIZE - 8, 0, 16);
+            my_fam->fam_fill_wait(waitObj);
+        },
+        Fam_Exception);
+    EXPECT_THROW(my_fam->fam_memset(NULL, 0, 0, 16), Fam_Exception);
+    EXPECT_THROW(my_fam->fam_fill_wait(NULL), Fam_Exception);
+
+    EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+    EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+
+    delete item;
+    delete desc;
+
+    free((void *)testRegion);
+    free((void *)firstItem);
+}
+
+// Test case 2 - fill elements of different types.
+TEST(FamFill, FillTypesSuccess) {
+    Fam_Region_Descriptor *desc;
+    Fam_Descriptor *item;
+    const char *testRegion = get_uniq_str("test", my_fam);
+    const char *firstItem = get_uniq_str("first", my_fam);
+    int32_t i32[ITEM_SIZE / sizeof(int32_t)];
+    uint64_t u64[ITEM_SIZE / sizeof(uint64_t)];
+    double dbl[ITEM_SIZE / sizeof(double)];
+    void *waitObj;
+
+    EXPECT_NO_THROW(
+        desc = my_fam->fam_create_region(testRegion, 8192, 0777, RAID1));
+    EXPECT_NE((void *)NULL, desc);
+
+    EXPECT_NO_THROW(
+        item = my_fam->fam_allocate(firstItem, ITEM_SIZE, 0777, desc));
+    EXPECT_NE((void *)NULL, item);
+
+    // Start at an element not aligned to 8 bytes
+    uint64_t nElements = ITEM_SIZE / sizeof(int32_t) - 1;
+    EXPECT_NO_THROW(waitObj = my_fam->fam_fill(item, sizeof(int32_t),
+                                               (int32_t)-12345, nElements));
+    EXPECT_NO_THROW(my_fam->fam_fill_wait(waitObj));
+    EXPECT_NO_THROW(my_fam->fam_get_blocking(i32, item, 0, sizeof(i32)));
+    for (uint64_t i = 1; i < ITEM_SIZE / sizeof(int32_t); i++)
+        EXPECT_EQ(-12345, i32[i]);
+
+    EXPECT_NO_THROW(waitObj = my_fam->fam_fill(item, 0,
+                                               (uint64_t)0x0123456789ABCDEF,
+                                               ITEM_SIZE / sizeof(uint64_t)));
+    EXPECT_NO_THROW(my_fam->fam_fill_wait(waitObj));
+    EXPECT_NO_THROW(my_fam->fam_get_blocking(u64, item, 0, sizeof(u64)));
+    for (uint64_t i = 0; i < ITEM_SIZE / sizeof(uint64_t); i++)
+        EXPECT_EQ(0x0123456789ABCDEFUL, u64[i]);
+
+    EXPECT_NO_THROW(waitObj = my_fam->fam_fill(item, 0, 2.5,
+                                               ITEM_SIZE / sizeof(double)));
+    EXPECT_NO_THROW(my_fam->fam_fill_wait(waitObj));
+    EXPECT_NO_THROW(my_fam->fam_get_blocking(dbl, item, 0, sizeof(dbl)));
+    for (uint64_t i = 0; i < ITEM_SIZE / sizeof(double); i++)
+        EXPECT_EQ(2.5, dbl[i]);
+
+    EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+    EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+
+    delete item;
+    delete desc;
+
+    free((void *)testRegion);
+    free((void *)firstItem);
+}
+
+int main(int argc, char **argv) {
+    int ret;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    my_fam = new fam();
+
+    init_fam_options(&fam_opts);
+
+    EXPECT_NO_THROW(my_fam->fam_initialize("default", &fam_opts));
+
+    ret = RUN_ALL_TESTS();
+
+    EXPECT_NO_THROW(my_fam->fam_finalize("default"));
+
+    return ret;
+}
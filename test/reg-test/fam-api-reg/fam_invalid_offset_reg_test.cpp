@@ -72,6 +72,43 @@ TEST(FamInvalidOffset, InvalidOffsetSuccess) {
     free((void *)firstItem);
 }
 
+// Test case 2 - gather and atomics beyond the data item.
+TEST(FamInvalidOffset, InvalidElementSuccess) {
+    Fam_Region_Descriptor *desc;
+    Fam_Descriptor *item;
+    uint64_t local[4];
+    uint64_t indexes[] = {0, 1, 128};
+    const char *testRegion = get_uniq_str("test", my_fam);
+    const char *firstItem = get_uniq_str("first", my_fam);
+
+    EXPECT_NO_THROW(
+        desc = my_fam->fam_create_region(testRegion, 8192, 0777, RAID1));
+    EXPECT_NE((void *)NULL, desc);
+
+    // Allocating data items in the created region
+    EXPECT_NO_THROW(item = my_fam->fam_allocate(firstItem, 1024, 0777, desc));
+    EXPECT_NE((void *)NULL, item);
+
+    EXPECT_THROW(my_fam->fam_gather_blocking(local, item, 4, 0, 64,
+                                             sizeof(uint64_t)),
+                 Fam_Datapath_Exception);
+    EXPECT_THROW(my_fam->fam_gather_blocking(local, item, 3, indexes,
+                                             sizeof(uint64_t)),
+                 Fam_Datapath_Exception);
+    EXPECT_THROW(my_fam->fam_set(item, 1024, (uint64_t)1),
+                 Fam_Datapath_Exception);
+    EXPECT_THROW(my_fam->fam_fetch_uint64(item, 1024), Fam_Datapath_Exception);
+
+    EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+    EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+
+    delete item;
+    delete desc;
+
+    free((void *)testRegion);
+    free((void *)firstItem);
+}
+
 int main(int argc, char **argv) {
     int ret;
     ::testing::InitGoogleTest(&argc, argv);
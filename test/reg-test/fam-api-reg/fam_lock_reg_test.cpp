@@ -0,0 +1,156 @@
+/*
+ * fam_lock_reg_test.cpp
+ * Copyright (c) 2020 Hewlett Packard Enterprise Development, LP. All rights
+ * reserved. Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+#include <fam/fam_exception.h>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <stdio.h>
+#include <string.h>
+
+#include <fam/fam.h>
+#include <fam/fam_lock.h>
+
+#include "common/fam_test_config.h"
+
+#define LOCK_ITERATIONS 50
+
+using namespace std;
+using namespace openfam;
+
+fam *my_fam;
+Fam_Options fam_opts;
+int myPE;
+int numPEs;
+
+// Allocate a zeroed data item on PE 0 and share it with all the PEs
+static Fam_Descriptor *allocate_shared(const char *regionName,
+                                       Fam_Region_Descriptor **desc,
+                                       uint64_t size) {
+    Fam_Descriptor *item = NULL;
+    if (myPE == 0) {
+        EXPECT_NO_THROW(
+            *desc = my_fam->fam_create_region(regionName, 8192 + size, 0777,
+                                              RAID1));
+        EXPECT_NO_THROW(item = my_fam->fam_allocate("lock", size, 0777, *desc));
+        char *zero = (char *)calloc(1, size);
+        EXPECT_NO_THROW(my_fam->fam_put_blocking(zero, item, 0, size));
+        free(zero);
+    }
+    EXPECT_NO_THROW(item = my_fam->fam_broadcast_descriptor(0, item));
+    return item;
+}
+
+static void free_shared(Fam_Region_Descriptor *desc, Fam_Descriptor *item) {
+    my_fam->fam_barrier_all();
+    if (myPE == 0) {
+        EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+        EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+        delete desc;
+    }
+    delete item;
+}
+
+// Test case 1 - increment a counter with a non-atomic read-modify-write under
+// the lock.
+TEST(FamLock, LockSuccess) {
+    Fam_Region_Descriptor *desc = NULL;
+    uint64_t counterOffset = Fam_Lock::size(numPEs);
+    Fam_Descriptor *item = allocate_shared(
+        "lockRegion", &desc, counterOffset + sizeof(uint64_t));
+
+    Fam_Lock lock(my_fam, item);
+    for (int i = 0; i < LOCK_ITERATIONS; i++) {
+        EXPECT_NO_THROW(lock.lock());
+        uint64_t value = my_fam->fam_fetch_uint64(item, counterOffset);
+        my_fam->fam_set(item, counterOffset, value + 1);
+        EXPECT_NO_THROW(lock.unlock());
+    }
+    my_fam->fam_barrier_all();
+
+    EXPECT_EQ((uint64_t)(numPEs * LOCK_ITERATIONS),
+              my_fam->fam_fetch_uint64(item, counterOffset));
+
+    my_fam->fam_barrier_all();
+    if (myPE == 0) {
+        EXPECT_TRUE(lock.try_lock());
+        EXPECT_NO_THROW(lock.unlock());
+    }
+    free_shared(desc, item);
+}
+
+// Test case 2 - writers update two words together, readers check that they
+// always see them equal.
+TEST(FamLock, RWLockSuccess) {
+    Fam_Region_Descriptor *desc = NULL;
+    uint64_t dataOffset = Fam_RW_Lock::size(numPEs);
+    Fam_Descriptor *item = allocate_shared(
+        "rwLockRegion", &desc, dataOffset + 2 * sizeof(uint64_t));
+
+    Fam_RW_Lock lock(my_fam, item);
+    for (int i = 0; i < LOCK_ITERATIONS; i++) {
+        if (i % 5 == 0) {
+            EXPECT_NO_THROW(lock.write_lock());
+            uint64_t value = my_fam->fam_fetch_uint64(item, dataOffset);
+            my_fam->fam_set(item, dataOffset, value + 1);
+            my_fam->fam_set(item, dataOffset + sizeof(uint64_t), value + 1);
+            EXPECT_NO_THROW(lock.write_unlock());
+        } else {
+            EXPECT_NO_THROW(lock.read_lock());
+            uint64_t first = my_fam->fam_fetch_uint64(item, dataOffset);
+            uint64_t second =
+                my_fam->fam_fetch_uint64(item, dataOffset + sizeof(uint64_t));
+            EXPECT_EQ(first, second);
+            EXPECT_NO_THROW(lock.read_unlock());
+        }
+    }
+    my_fam->fam_barrier_all();
+
+    EXPECT_EQ((uint64_t)(numPEs * LOCK_ITERATIONS / 5),
+              my_fam->fam_fetch_uint64(item, dataOffset));
+    free_shared(desc, item);
+}
+
+int main(int argc, char **argv) {
+    int ret;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    my_fam = new fam();
+
+    init_fam_options(&fam_opts);
+
+    EXPECT_NO_THROW(my_fam->fam_initialize("default", &fam_opts));
+    myPE = *(int *)my_fam->fam_get_option(strdup("PE_ID"));
+    numPEs = *(int *)my_fam->fam_get_option(strdup("PE_COUNT"));
+
+    ret = RUN_ALL_TESTS();
+
+    EXPECT_NO_THROW(my_fam->fam_finalize("default"));
+
+    return ret;
+}
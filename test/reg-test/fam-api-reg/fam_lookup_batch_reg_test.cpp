@@ -0,0 +1,150 @@
+/*
+ * fam_lookup_batch_reg_test.cpp
+ * Copyright (c) 2019 Hewlett Packard Enterprise Development, LP. All rights
+ * reserved. Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+#include <fam/fam_exception.h>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <stdio.h>
+#include <string.h>
+
+#include <fam/fam.h>
+
+#include "common/fam_test_config.h"
+
+#define NUM_ITEMS 16
+
+using namespace std;
+using namespace openfam;
+
+fam *my_fam;
+Fam_Options fam_opts;
+
+// Test case 1 - fam_lookup_batch and fam_prepare test (success).
+TEST(FamLookupBatch, LookupBatchSuccess) {
+    Fam_Region_Descriptor *desc;
+    Fam_Descriptor *item[NUM_ITEMS];
+    Fam_Descriptor *lookupItem[NUM_ITEMS];
+    const char *itemName[NUM_ITEMS];
+    const char *testRegion = get_uniq_str("test", my_fam);
+
+    EXPECT_NO_THROW(
+        desc = my_fam->fam_create_region(testRegion, 8192, 0777, RAID1));
+    EXPECT_NE((void *)NULL, desc);
+
+    // Allocating data items in the created region
+    for (int i = 0; i < NUM_ITEMS; i++) {
+        std::string baseName = "item" + std::to_string(i);
+        itemName[i] = get_uniq_str(baseName.c_str(), my_fam);
+        EXPECT_NO_THROW(item[i] =
+                            my_fam->fam_allocate(itemName[i], 128, 0777, desc));
+        EXPECT_NE((void *)NULL, item[i]);
+        EXPECT_NO_THROW(my_fam->fam_put_blocking(&i, item[i], 0, sizeof(i)));
+    }
+
+    EXPECT_NO_THROW(my_fam->fam_lookup_batch(itemName, NUM_ITEMS, testRegion,
+                                             lookupItem));
+
+    for (int i = 0; i < NUM_ITEMS; i++) {
+        Fam_Global_Descriptor globalDesc = item[i]->get_global_descriptor();
+        Fam_Global_Descriptor lookupDesc =
+            lookupItem[i]->get_global_descriptor();
+        EXPECT_EQ(globalDesc.regionId, lookupDesc.regionId);
+        EXPECT_EQ(globalDesc.offset, lookupDesc.offset);
+        EXPECT_EQ((uint64_t)128, lookupItem[i]->get_size());
+    }
+
+    // Resolve the keys of all the looked up items at once
+    EXPECT_NO_THROW(my_fam->fam_prepare(lookupItem, NUM_ITEMS));
+
+    for (int i = 0; i < NUM_ITEMS; i++) {
+        int value = -1;
+        EXPECT_NO_THROW(
+            my_fam->fam_get_blocking(&value, lookupItem[i], 0, sizeof(value)));
+        EXPECT_EQ(i, value);
+    }
+
+    for (int i = 0; i < NUM_ITEMS; i++) {
+        EXPECT_NO_THROW(my_fam->fam_deallocate(item[i]));
+        delete item[i];
+        delete lookupItem[i];
+        free((void *)itemName[i]);
+    }
+    EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+
+    delete desc;
+
+    free((void *)testRegion);
+}
+
+// Test case 2 - (Negative test case) one of the data items does not exist
+TEST(FamLookupBatch, LookupBatchFailNotFound) {
+    Fam_Region_Descriptor *desc;
+    Fam_Descriptor *item;
+    Fam_Descriptor *lookupItem[2];
+    const char *testRegion = get_uniq_str("test", my_fam);
+    const char *firstItem = get_uniq_str("first", my_fam);
+    const char *itemName[2] = {firstItem, "noSuchItem"};
+
+    EXPECT_NO_THROW(
+        desc = my_fam->fam_create_region(testRegion, 8192, 0777, RAID1));
+    EXPECT_NE((void *)NULL, desc);
+
+    EXPECT_NO_THROW(item = my_fam->fam_allocate(firstItem, 128, 0777, desc));
+    EXPECT_NE((void *)NULL, item);
+
+    EXPECT_THROW(
+        my_fam->fam_lookup_batch(itemName, 2, testRegion, lookupItem),
+        Fam_Allocator_Exception);
+
+    EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+    EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+
+    delete item;
+    delete desc;
+
+    free((void *)testRegion);
+    free((void *)firstItem);
+}
+
+int main(int argc, char **argv) {
+    int ret;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    my_fam = new fam();
+
+    init_fam_options(&fam_opts);
+
+    EXPECT_NO_THROW(my_fam->fam_initialize("default", &fam_opts));
+
+    ret = RUN_ALL_TESTS();
+
+    EXPECT_NO_THROW(my_fam->fam_finalize("default"));
+
+    return ret;
+}
@@ -0,0 +1,155 @@
+/*
+ * fam_put_signal_reg_test.cpp
+ * Copyright (c) 2020 Hewlett Packard Enterprise Development, LP. All rights
+ * reserved. Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+#include <fam/fam_exception.h>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <stdio.h>
+#include <string.h>
+
+#include <fam/fam.h>
+
+#include "common/fam_test_config.h"
+
+using namespace std;
+using namespace openfam;
+
+fam *my_fam;
+Fam_Options fam_opts;
+
+// Test case 1 - put with a signal word in the same data item.
+TEST(FamPutSignal, PutSignalSameItemSuccess) {
+    Fam_Region_Descriptor *desc;
+    Fam_Descriptor *item;
+    char *local = strdup("Test message");
+    char local2[20];
+    const char *testRegion = get_uniq_str("test", my_fam);
+    const char *firstItem = get_uniq_str("first", my_fam);
+
+    EXPECT_NO_THROW(
+        desc = my_fam->fam_create_region(testRegion, 8192, 0777, RAID1));
+    EXPECT_NE((void *)NULL, desc);
+
+    EXPECT_NO_THROW(item = my_fam->fam_allocate(firstItem, 1024, 0777, desc));
+    EXPECT_NE((void *)NULL, item);
+    EXPECT_NO_THROW(my_fam->fam_set(item, 0, (uint64_t)0));
+    EXPECT_NO_THROW(my_fam->fam_quiet());
+
+    EXPECT_NO_THROW(my_fam->fam_put_signal(local, item, 64, 13, item, 0,
+                                           (uint64_t)5, FAM_SIGNAL_SET));
+    EXPECT_NO_THROW(my_fam->fam_quiet());
+    EXPECT_EQ((uint64_t)5, my_fam->fam_fetch_uint64(item, 0));
+    EXPECT_NO_THROW(my_fam->fam_get_blocking(local2, item, 64, 13));
+    EXPECT_STREQ(local, local2);
+
+    EXPECT_NO_THROW(my_fam->fam_put_signal(local, item, 128, 13, item, 0,
+                                           (uint64_t)3, FAM_SIGNAL_ADD));
+    EXPECT_NO_THROW(my_fam->fam_quiet());
+    EXPECT_EQ((uint64_t)8, my_fam->fam_fetch_uint64(item, 0));
+    EXPECT_NO_THROW(my_fam->fam_get_blocking(local2, item, 128, 13));
+    EXPECT_STREQ(local, local2);
+
+    EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+    EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+
+    delete item;
+    delete desc;
+
+    free(local);
+    free((void *)testRegion);
+    free((void *)firstItem);
+}
+
+// Test case 2 - put with a signal word in another data item.
+TEST(FamPutSignal, PutSignalOtherItemSuccess) {
+    Fam_Region_Descriptor *desc;
+    Fam_Descriptor *item, *flag;
+    char *local = strdup("Test message");
+    char local2[20];
+    const char *testRegion = get_uniq_str("test", my_fam);
+    const char *firstItem = get_uniq_str("first", my_fam);
+    const char *flagItem = get_uniq_str("flag", my_fam);
+
+    EXPECT_NO_THROW(
+        desc = my_fam->fam_create_region(testRegion, 8192, 0777, RAID1));
+    EXPECT_NE((void *)NULL, desc);
+
+    EXPECT_NO_THROW(item = my_fam->fam_allocate(firstItem, 1024, 0777, desc));
+    EXPECT_NE((void *)NULL, item);
+    EXPECT_NO_THROW(flag = my_fam->fam_allocate(flagItem, 64, 0777, desc));
+    EXPECT_NE((void *)NULL, flag);
+    EXPECT_NO_THROW(my_fam->fam_set(flag, 0, (uint64_t)0));
+    EXPECT_NO_THROW(my_fam->fam_quiet());
+
+    EXPECT_NO_THROW(my_fam->fam_put_signal(local, item, 0, 13, flag, 0,
+                                           (uint64_t)1, FAM_SIGNAL_ADD));
+    EXPECT_NO_THROW(my_fam->fam_quiet());
+    EXPECT_EQ((uint64_t)1, my_fam->fam_fetch_uint64(flag, 0));
+    EXPECT_NO_THROW(my_fam->fam_get_blocking(local2, item, 0, 13));
+    EXPECT_STREQ(local, local2);
+
+    // Invalid signal operation
+    EXPECT_THROW(my_fam->fam_put_signal(local, item, 0, 13, flag, 0,
+                                        (uint64_t)1, (Fam_Signal_Op)10),
+                 Fam_Exception);
+    // Missing signal descriptor
+    EXPECT_THROW(my_fam->fam_put_signal(local, item, 0, 13, NULL, 0,
+                                        (uint64_t)1, FAM_SIGNAL_SET),
+                 Fam_Exception);
+
+    EXPECT_NO_THROW(my_fam->fam_deallocate(flag));
+    EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+    EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+
+    delete flag;
+    delete item;
+    delete desc;
+
+    free(local);
+    free((void *)testRegion);
+    free((void *)firstItem);
+    free((void *)flagItem);
+}
+
+int main(int argc, char **argv) {
+    int ret;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    my_fam = new fam();
+
+    init_fam_options(&fam_opts);
+
+    EXPECT_NO_THROW(my_fam->fam_initialize("default", &fam_opts));
+
+    ret = RUN_ALL_TESTS();
+
+    EXPECT_NO_THROW(my_fam->fam_finalize("default"));
+
+    return ret;
+}
@@ -0,0 +1,198 @@
+/*
+ * fam_reduce_item_reg_test.cpp
+ * Copyright (c) 2020 Hewlett Packard Enterprise Development, LP. All rights
+ * reserved. Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+#include <fam/fam_exception.h>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <fam/fam.h>
+
+#include "common/fam_test_config.h"
+
+using namespace std;
+using namespace openfam;
+
+fam *my_fam;
+Fam_Options fam_opts;
+
+#define NUM_ELEMENTS 1001
+
+// Test case 1 - reduce doubles, skipping the first element.
+TEST(FamReduceItem, ReduceDoubleSuccess) {
+    Fam_Region_Descriptor *desc;
+    Fam_Descriptor *item;
+    const char *testRegion = get_uniq_str("test", my_fam);
+    const char *firstItem = get_uniq_str("first", my_fam);
+    double values[NUM_ELEMENTS];
+    double result, sumSquares = 0;
+
+    EXPECT_NO_THROW(
+        desc = my_fam->fam_create_region(testRegion, 65536, 0777, RAID1));
+    EXPECT_NE((void *)NULL, desc);
+
+    EXPECT_NO_THROW(
+        item = my_fam->fam_allocate(firstItem, sizeof(values), 0777, desc));
+    EXPECT_NE((void *)NULL, item);
+
+    // Integral values, so that the result does not depend on the order in
+    // which the elements are combined
+    values[0] = -1000;
+    for (int i = 1; i < NUM_ELEMENTS; i++) {
+        values[i] = (double)((i * 37) % 101) - 50;
+        sumSquares += values[i] * values[i];
+    }
+    EXPECT_NO_THROW(
+        my_fam->fam_put_blocking(values, item, 0, sizeof(values)));
+
+    double sum = 0, min = values[1], max = values[1];
+    for (int i = 1; i < NUM_ELEMENTS; i++) {
+        sum += values[i];
+        min = std::min(min, values[i]);
+        max = std::max(max, values[i]);
+    }
+
+    EXPECT_NO_THROW(my_fam->fam_reduce_item(item, sizeof(double),
+                                            NUM_ELEMENTS - 1, FAM_TYPE_DOUBLE,
+                                            FAM_REDUCE_SUM, &result));
+    EXPECT_EQ(sum, result);
+    EXPECT_NO_THROW(my_fam->fam_reduce_item(item, sizeof(double),
+                                            NUM_ELEMENTS - 1, FAM_TYPE_DOUBLE,
+                                            FAM_REDUCE_MIN, &result));
+    EXPECT_EQ(min, result);
+    EXPECT_NO_THROW(my_fam->fam_reduce_item(item, sizeof(double),
+                                            NUM_ELEMENTS - 1, FAM_TYPE_DOUBLE,
+                                            FAM_REDUCE_MAX, &result));
+    EXPECT_EQ(max, result);
+    EXPECT_NO_THROW(my_fam->fam_reduce_item(item, sizeof(double),
+                                            NUM_ELEMENTS - 1, FAM_TYPE_DOUBLE,
+                                            FAM_REDUCE_NORM, &result));
+    EXPECT_DOUBLE_EQ(sqrt(sumSquares), result);
+
+    // Whole data item, including the first element
+    EXPECT_NO_THROW(my_fam->fam_reduce_item(item, 0, NUM_ELEMENTS,
+                                            FAM_TYPE_DOUBLE, FAM_REDUCE_MIN,
+                                            &result));
+    EXPECT_EQ(-1000, result);
+
+    EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+    EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+
+    delete item;
+    delete desc;
+
+    free((void *)testRegion);
+    free((void *)firstItem);
+}
+
+// Test case 2 - reduce integers, and invalid reductions.
+TEST(FamReduceItem, ReduceIntegerSuccess) {
+    Fam_Region_Descriptor *desc;
+    Fam_Descriptor *item;
+    const char *testRegion = get_uniq_str("test", my_fam);
+    const char *firstItem = get_uniq_str("first", my_fam);
+    int32_t values[NUM_ELEMENTS];
+    int32_t result;
+    double norm;
+
+    EXPECT_NO_THROW(
+        desc = my_fam->fam_create_region(testRegion, 65536, 0777, RAID1));
+    EXPECT_NE((void *)NULL, desc);
+
+    EXPECT_NO_THROW(
+        item = my_fam->fam_allocate(firstItem, sizeof(values), 0777, desc));
+    EXPECT_NE((void *)NULL, item);
+
+    for (int i = 0; i < NUM_ELEMENTS; i++)
+        values[i] = i - 500;
+    EXPECT_NO_THROW(
+        my_fam->fam_put_blocking(values, item, 0, sizeof(values)));
+
+    EXPECT_NO_THROW(my_fam->fam_reduce_item(item, 0, NUM_ELEMENTS,
+                                            FAM_TYPE_INT32, FAM_REDUCE_SUM,
+                                            &result));
+    EXPECT_EQ(0, result);
+    EXPECT_NO_THROW(my_fam->fam_reduce_item(item, 0, NUM_ELEMENTS,
+                                            FAM_TYPE_INT32, FAM_REDUCE_MAX,
+                                            &result));
+    EXPECT_EQ(500, result);
+    EXPECT_NO_THROW(my_fam->fam_reduce_item(item, 498 * sizeof(int32_t), 5,
+                                            FAM_TYPE_INT32, FAM_REDUCE_PROD,
+                                            &result));
+    EXPECT_EQ(0, result);
+    EXPECT_NO_THROW(my_fam->fam_reduce_item(item, 501 * sizeof(int32_t), 4,
+                                            FAM_TYPE_INT32, FAM_REDUCE_PROD,
+                                            &result));
+    EXPECT_EQ(24, result);
+    EXPECT_NO_THROW(my_fam->fam_reduce_item(item, 503 * sizeof(int32_t), 2,
+                                            FAM_TYPE_INT32, FAM_REDUCE_NORM,
+                                            &norm));
+    EXPECT_DOUBLE_EQ(5.0, norm);
+
+    // No elements, elements beyond the data item, invalid operation
+    EXPECT_THROW(my_fam->fam_reduce_item(item, 0, 0, FAM_TYPE_INT32,
+                                         FAM_REDUCE_SUM, &result),
+                 Fam_Exception);
+    EXPECT_THROW(my_fam->fam_reduce_item(item, sizeof(int32_t), NUM_ELEMENTS,
+                                         FAM_TYPE_INT32, FAM_REDUCE_SUM,
+                                         &result),
+                 Fam_Exception);
+    EXPECT_THROW(my_fam->fam_reduce_item(item, 0, NUM_ELEMENTS,
+                                         FAM_TYPE_INT32, (Fam_Reduce_Op)99,
+                                         &result),
+                 Fam_Exception);
+
+    EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+    EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+
+    delete item;
+    delete desc;
+
+    free((void *)testRegion);
+    free((void *)firstItem);
+}
+
+int main(int argc, char **argv) {
+    int ret;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    my_fam = new fam();
+
+    init_fam_options(&fam_opts);
+
+    EXPECT_NO_THROW(my_fam->fam_initialize("default", &fam_opts));
+
+    ret = RUN_ALL_TESTS();
+
+    EXPECT_NO_THROW(my_fam->fam_finalize("default"));
+
+    return ret;
+}
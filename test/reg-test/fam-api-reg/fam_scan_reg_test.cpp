@@ -0,0 +1,309 @@
+/*
+ * fam_scan_reg_test.cpp
+ * Copyright (c) 2020 Hewlett Packard Enterprise Development, LP. All rights
+ * reserved. Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+#include <fam/fam_exception.h>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <fam/fam.h>
+
+#include "common/fam_test_config.h"
+
+using namespace std;
+using namespace openfam;
+
+fam *my_fam;
+Fam_Options fam_opts;
+
+#define NUM_RECORDS 1000
+
+typedef struct {
+    uint64_t id;
+    int32_t age;
+    float score;
+    double balance;
+} Test_Record;
+
+typedef struct {
+    uint64_t id;
+    float score;
+} Test_Result;
+
+static void init_records(Test_Record *records) {
+    for (uint64_t i = 0; i < NUM_RECORDS; i++) {
+        records[i].id = i;
+        records[i].age = (int32_t)(i % 90);
+        records[i].score = (float)(i % 7);
+        records[i].balance = (double)i * 10;
+    }
+}
+
+// Test case 1 - range and equality predicates, with and without projection.
+TEST(FamScan, ScanToBufferSuccess) {
+    Fam_Region_Descriptor *desc;
+    Fam_Descriptor *item;
+    const char *testRegion = get_uniq_str("test", my_fam);
+    const char *firstItem = get_uniq_str("first", my_fam);
+    Test_Record *records = new Test_Record[NUM_RECORDS];
+    Test_Result results[NUM_RECORDS];
+    Fam_Scan_Predicate predicates[2];
+    Fam_Scan_Column columns[2];
+    uint64_t nMatched, nScanned;
+
+    EXPECT_NO_THROW(desc = my_fam->fam_create_region(
+                        testRegion, 1048576, 0777, RAID1));
+    EXPECT_NE((void *)NULL, desc);
+
+    EXPECT_NO_THROW(item = my_fam->fam_allocate(
+                        firstItem, NUM_RECORDS * sizeof(Test_Record), 0777,
+                        desc));
+    EXPECT_NE((void *)NULL, item);
+
+    init_records(records);
+    EXPECT_NO_THROW(my_fam->fam_put_blocking(
+        records, item, 0, NUM_RECORDS * sizeof(Test_Record)));
+
+    // 20 <= age <= 29 and score == 3
+    predicates[0].fieldOffset = offsetof(Test_Record, age);
+    predicates[0].type = FAM_TYPE_INT32;
+    predicates[0].op = FAM_SCAN_RANGE;
+    predicates[0].low.i32 = 20;
+    predicates[0].high.i32 = 29;
+    predicates[1].fieldOffset = offsetof(Test_Record, score);
+    predicates[1].type = FAM_TYPE_FLOAT;
+    predicates[1].op = FAM_SCAN_EQUAL;
+    predicates[1].low.f = 3;
+    columns[0].offset = offsetof(Test_Record, id);
+    columns[0].size = sizeof(uint64_t);
+    columns[1].offset = offsetof(Test_Record, score);
+    columns[1].size = sizeof(float);
+
+    uint64_t expected = 0;
+    for (uint64_t i = 0; i < NUM_RECORDS; i++) {
+        if ((records[i].age >= 20) && (records[i].age <= 29) &&
+            (records[i].score == 3))
+            expected++;
+    }
+
+    // Projected columns are packed: 12 bytes per result
+    char packed[NUM_RECORDS * 12];
+    EXPECT_NO_THROW(nMatched = my_fam->fam_scan(
+                        item, 0, sizeof(Test_Record), NUM_RECORDS, predicates,
+                        2, columns, 2, packed, sizeof(packed), &nScanned));
+    EXPECT_EQ(expected, nMatched);
+    EXPECT_EQ((uint64_t)NUM_RECORDS, nScanned);
+    for (uint64_t i = 0; i < nMatched; i++) {
+        uint64_t id;
+        float score;
+        memcpy(&id, packed + i * 12, sizeof(id));
+        memcpy(&score, packed + i * 12 + sizeof(id), sizeof(score));
+        EXPECT_GE(records[id].age, 20);
+        EXPECT_LE(records[id].age, 29);
+        EXPECT_EQ(3, score);
+    }
+
+    // Whole records, with a buffer holding only two of them
+    Test_Record matches[2];
+    EXPECT_NO_THROW(nMatched = my_fam->fam_scan(
+                        item, 0, sizeof(Test_Record), NUM_RECORDS, predicates,
+                        1, NULL, 0, matches, sizeof(matches), &nScanned));
+    EXPECT_EQ(2U, nMatched);
+    EXPECT_EQ(22U, nScanned);
+    EXPECT_EQ(20U, matches[0].id);
+    EXPECT_EQ(21U, matches[1].id);
+
+    // Predicate beyond the end of a record
+    predicates[0].fieldOffset = sizeof(Test_Record) - 2;
+    EXPECT_THROW(my_fam->fam_scan(item, 0, sizeof(Test_Record), NUM_RECORDS,
+                                  predicates, 1, NULL, 0, results,
+                                  sizeof(results)),
+                 Fam_Exception);
+
+    EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+    EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+
+    delete item;
+    delete desc;
+    delete[] records;
+
+    free((void *)testRegion);
+    free((void *)firstItem);
+}
+
+// Test case 2 - compact the matching records into another data item.
+TEST(FamScan, ScanToItemSuccess) {
+    Fam_Region_Descriptor *desc;
+    Fam_Descriptor *item, *dest;
+    const char *testRegion = get_uniq_str("test", my_fam);
+    const char *firstItem = get_uniq_str("first", my_fam);
+    const char *secondItem = get_uniq_str("second", my_fam);
+    Test_Record *records = new Test_Record[NUM_RECORDS];
+    Fam_Scan_Predicate predicate;
+    uint64_t nMatched, nScanned;
+
+    EXPECT_NO_THROW(desc = my_fam->fam_create_region(
+                        testRegion, 1048576, 0777, RAID1));
+    EXPECT_NE((void *)NULL, desc);
+
+    EXPECT_NO_THROW(item = my_fam->fam_allocate(
+                        firstItem, NUM_RECORDS * sizeof(Test_Record), 0777,
+                        desc));
+    EXPECT_NE((void *)NULL, item);
+    EXPECT_NO_THROW(dest = my_fam->fam_allocate(
+                        secondItem, NUM_RECORDS * sizeof(Test_Record), 0777,
+                        desc));
+    EXPECT_NE((void *)NULL, dest);
+
+    init_records(records);
+    EXPECT_NO_THROW(my_fam->fam_put_blocking(
+        records, item, 0, NUM_RECORDS * sizeof(Test_Record)));
+
+    // balance >= 9000.0
+    predicate.fieldOffset = offsetof(Test_Record, balance);
+    predicate.type = FAM_TYPE_DOUBLE;
+    predicate.op = FAM_SCAN_RANGE;
+    predicate.low.d = 9000.0;
+    predicate.high.d = 1e300;
+
+    EXPECT_NO_THROW(nMatched = my_fam->fam_scan_to_item(
+                        item, 0, sizeof(Test_Record), NUM_RECORDS, &predicate,
+                        1, NULL, 0, dest, sizeof(Test_Record),
+                        NUM_RECORDS * sizeof(Test_Record) -
+                            sizeof(Test_Record),
+                        &nScanned));
+    EXPECT_EQ(100U, nMatched);
+    EXPECT_EQ((uint64_t)NUM_RECORDS, nScanned);
+
+    memset(records, 0, NUM_RECORDS * sizeof(Test_Record));
+    EXPECT_NO_THROW(my_fam->fam_get_blocking(
+        records, dest, sizeof(Test_Record), 100 * sizeof(Test_Record)));
+    for (uint64_t i = 0; i < 100; i++) {
+        EXPECT_EQ(900 + i, records[i].id);
+        EXPECT_EQ((double)(900 + i) * 10, records[i].balance);
+    }
+
+    EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+    EXPECT_NO_THROW(my_fam->fam_deallocate(dest));
+    EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+
+    delete item;
+    delete dest;
+    delete desc;
+    delete[] records;
+
+    free((void *)testRegion);
+    free((void *)firstItem);
+    free((void *)secondItem);
+}
+
+// Test case 3 - compact the matching records, with reordered columns, over
+// the scanned records of the same data item.
+TEST(FamScan, ScanToSameItemSuccess) {
+    Fam_Region_Descriptor *desc;
+    Fam_Descriptor *item;
+    const char *testRegion = get_uniq_str("test", my_fam);
+    const char *firstItem = get_uniq_str("first", my_fam);
+    Test_Record *records = new Test_Record[NUM_RECORDS];
+    Fam_Scan_Predicate predicate;
+    Fam_Scan_Column columns[2];
+    uint64_t nMatched;
+    char *result;
+
+    EXPECT_NO_THROW(desc = my_fam->fam_create_region(
+                        testRegion, 1048576, 0777, RAID1));
+    EXPECT_NE((void *)NULL, desc);
+
+    EXPECT_NO_THROW(item = my_fam->fam_allocate(
+                        firstItem, NUM_RECORDS * sizeof(Test_Record), 0777,
+                        desc));
+    EXPECT_NE((void *)NULL, item);
+
+    init_records(records);
+    EXPECT_NO_THROW(my_fam->fam_put_blocking(
+        records, item, 0, NUM_RECORDS * sizeof(Test_Record)));
+
+    // score == 0.0, projected as score followed by id
+    predicate.fieldOffset = offsetof(Test_Record, score);
+    predicate.type = FAM_TYPE_FLOAT;
+    predicate.op = FAM_SCAN_EQUAL;
+    predicate.low.f = 0.0;
+    columns[0].offset = offsetof(Test_Record, score);
+    columns[0].size = sizeof(float);
+    columns[1].offset = offsetof(Test_Record, id);
+    columns[1].size = sizeof(uint64_t);
+
+    EXPECT_NO_THROW(nMatched = my_fam->fam_scan_to_item(
+                        item, 0, sizeof(Test_Record), NUM_RECORDS, &predicate,
+                        1, columns, 2, item, 0,
+                        NUM_RECORDS * sizeof(Test_Record)));
+    EXPECT_EQ(143U, nMatched);
+
+    result = (char *)records;
+    EXPECT_NO_THROW(my_fam->fam_get_blocking(
+        result, item, 0, nMatched * (sizeof(float) + sizeof(uint64_t))));
+    for (uint64_t i = 0; i < nMatched; i++) {
+        float score;
+        uint64_t id;
+        memcpy(&score, result, sizeof(float));
+        memcpy(&id, result + sizeof(float), sizeof(uint64_t));
+        EXPECT_EQ(0.0, score);
+        EXPECT_EQ(i * 7, id);
+        result += sizeof(float) + sizeof(uint64_t);
+    }
+
+    EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+    EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+
+    delete item;
+    delete desc;
+    delete[] records;
+
+    free((void *)testRegion);
+    free((void *)firstItem);
+}
+
+int main(int argc, char **argv) {
+    int ret;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    my_fam = new fam();
+
+    init_fam_options(&fam_opts);
+
+    EXPECT_NO_THROW(my_fam->fam_initialize("default", &fam_opts));
+
+    ret = RUN_ALL_TESTS();
+
+    EXPECT_NO_THROW(my_fam->fam_finalize("default"));
+
+    return ret;
+}
@@ -0,0 +1,170 @@
+/*
+ * fam_scatter_gather_iov_reg_test.cpp
+ * Copyright (c) 2020 Hewlett Packard Enterprise Development, LP. All rights
+ * reserved. Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+#include <fam/fam_exception.h>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <stdio.h>
+#include <string.h>
+
+#include <fam/fam.h>
+
+#include "common/fam_test_config.h"
+
+using namespace std;
+using namespace openfam;
+
+fam *my_fam;
+Fam_Options fam_opts;
+
+#define NUM_RECORDS 5
+
+// Records of different lengths, as the adjacency lists of a CSR graph
+uint64_t recordOffsets[NUM_RECORDS + 1] = { 0, 24, 32, 96, 104, 200 };
+
+// Test case 1 - blocking scatter and gather of variable-length records.
+TEST(FamScatterGatherIov, ScatterGatherIovBlockingSuccess) {
+    Fam_Region_Descriptor *desc;
+    Fam_Descriptor *item;
+    const char *testRegion = get_uniq_str("test", my_fam);
+    const char *firstItem = get_uniq_str("first", my_fam);
+    char local[200], result[200];
+    struct iovec iov[NUM_RECORDS];
+    uint64_t offsets[NUM_RECORDS];
+
+    EXPECT_NO_THROW(
+        desc = my_fam->fam_create_region(testRegion, 8192, 0777, RAID1));
+    EXPECT_NE((void *)NULL, desc);
+
+    EXPECT_NO_THROW(item = my_fam->fam_allocate(firstItem, 1024, 0777, desc));
+    EXPECT_NE((void *)NULL, item);
+
+    // Records are packed locally and spread out in FAM in reverse order
+    for (int i = 0; i < 200; i++)
+        local[i] = (char)i;
+    for (int i = 0; i < NUM_RECORDS; i++) {
+        iov[i].iov_base = local + recordOffsets[i];
+        iov[i].iov_len = recordOffsets[i + 1] - recordOffsets[i];
+        offsets[i] = 800 - recordOffsets[i + 1] - 8 * i;
+    }
+    EXPECT_NO_THROW(
+        my_fam->fam_scatter_iov_blocking(iov, item, offsets, NUM_RECORDS));
+
+    memset(result, 0, sizeof(result));
+    for (int i = 0; i < NUM_RECORDS; i++)
+        iov[i].iov_base = result + recordOffsets[i];
+    EXPECT_NO_THROW(
+        my_fam->fam_gather_iov_blocking(iov, item, offsets, NUM_RECORDS));
+    EXPECT_EQ(0, memcmp(local, result, sizeof(local)));
+
+    EXPECT_THROW(my_fam->fam_gather_iov_blocking(NULL, item, offsets, 1),
+                 Fam_Exception);
+    EXPECT_THROW(my_fam->fam_gather_iov_blocking(iov, item, offsets, 0),
+                 Fam_Exception);
+
+    // Records beyond the data item, or whose end overflows
+    uint64_t badOffsets[2] = { 0, 1024 - iov[1].iov_len + 1 };
+    EXPECT_THROW(my_fam->fam_scatter_iov_blocking(iov, item, badOffsets, 2),
+                 Fam_Datapath_Exception);
+    badOffsets[1] = UINT64_MAX;
+    EXPECT_THROW(my_fam->fam_gather_iov_blocking(iov, item, badOffsets, 2),
+                 Fam_Datapath_Exception);
+
+    EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+    EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+
+    delete item;
+    delete desc;
+
+    free((void *)testRegion);
+    free((void *)firstItem);
+}
+
+// Test case 2 - nonblocking scatter and gather of variable-length records.
+TEST(FamScatterGatherIov, ScatterGatherIovNonblockingSuccess) {
+    Fam_Region_Descriptor *desc;
+    Fam_Descriptor *item;
+    const char *testRegion = get_uniq_str("test", my_fam);
+    const char *firstItem = get_uniq_str("first", my_fam);
+    char local[200], result[200];
+    struct iovec iov[NUM_RECORDS];
+    uint64_t offsets[NUM_RECORDS];
+
+    EXPECT_NO_THROW(
+        desc = my_fam->fam_create_region(testRegion, 8192, 0777, RAID1));
+    EXPECT_NE((void *)NULL, desc);
+
+    EXPECT_NO_THROW(item = my_fam->fam_allocate(firstItem, 1024, 0777, desc));
+    EXPECT_NE((void *)NULL, item);
+
+    for (int i = 0; i < 200; i++)
+        local[i] = (char)(200 - i);
+    for (int i = 0; i < NUM_RECORDS; i++) {
+        iov[i].iov_base = local + recordOffsets[i];
+        iov[i].iov_len = recordOffsets[i + 1] - recordOffsets[i];
+        offsets[i] = 2 * recordOffsets[i];
+    }
+    EXPECT_NO_THROW(
+        my_fam->fam_scatter_iov_nonblocking(iov, item, offsets, NUM_RECORDS));
+    EXPECT_NO_THROW(my_fam->fam_quiet());
+
+    memset(result, 0, sizeof(result));
+    for (int i = 0; i < NUM_RECORDS; i++)
+        iov[i].iov_base = result + recordOffsets[i];
+    EXPECT_NO_THROW(
+        my_fam->fam_gather_iov_nonblocking(iov, item, offsets, NUM_RECORDS));
+    EXPECT_NO_THROW(my_fam->fam_quiet());
+    EXPECT_EQ(0, memcmp(local, result, sizeof(local)));
+
+    EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+    EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+
+    delete item;
+    delete desc;
+
+    free((void *)testRegion);
+    free((void *)firstItem);
+}
+
+int main(int argc, char **argv) {
+    int ret;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    my_fam = new fam();
+
+    init_fam_options(&fam_opts);
+
+    EXPECT_NO_THROW(my_fam->fam_initialize("default", &fam_opts));
+
+    ret = RUN_ALL_TESTS();
+
+    EXPECT_NO_THROW(my_fam->fam_finalize("default"));
+
+    return ret;
+}
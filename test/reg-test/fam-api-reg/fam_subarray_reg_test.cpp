@@ -0,0 +1,200 @@
+/*
+ * fam_subarray_reg_test.cpp
+ * Copyright (c) 2020 Hewlett Packard Enterprise Development, LP. All rights
+ * reserved. Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+#include <fam/fam_exception.h>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <stdio.h>
+#include <string.h>
+
+#include <fam/fam.h>
+
+#include "common/fam_test_config.h"
+
+using namespace std;
+using namespace openfam;
+
+fam *my_fam;
+Fam_Options fam_opts;
+
+#define MATRIX_DIM 16
+#define CUBE_DIM 4
+
+// Test case 1 - get and put a tile of a matrix.
+TEST(FamSubarray, Subarray2DSuccess) {
+    Fam_Region_Descriptor *desc;
+    Fam_Descriptor *item;
+    const char *testRegion = get_uniq_str("test", my_fam);
+    const char *firstItem = get_uniq_str("first", my_fam);
+    uint64_t matrix[MATRIX_DIM * MATRIX_DIM];
+    uint64_t tile[4 * 8];
+    uint64_t shape[2] = { 4, 4 };
+    uint64_t famStrides[2] = { MATRIX_DIM, 1 };
+    uint64_t localStrides[2] = { 8, 1 };
+    uint64_t offset = (2 * MATRIX_DIM + 3) * sizeof(uint64_t);
+
+    EXPECT_NO_THROW(
+        desc = my_fam->fam_create_region(testRegion, 8192, 0777, RAID1));
+    EXPECT_NE((void *)NULL, desc);
+
+    EXPECT_NO_THROW(
+        item = my_fam->fam_allocate(firstItem, sizeof(matrix), 0777, desc));
+    EXPECT_NE((void *)NULL, item);
+
+    for (uint64_t i = 0; i < MATRIX_DIM * MATRIX_DIM; i++)
+        matrix[i] = i;
+    EXPECT_NO_THROW(
+        my_fam->fam_put_blocking(matrix, item, 0, sizeof(matrix)));
+
+    // Packed tile
+    memset(tile, 0, sizeof(tile));
+    EXPECT_NO_THROW(my_fam->fam_get_subarray(tile, item, offset,
+                                             sizeof(uint64_t), 2, shape,
+                                             famStrides));
+    for (uint64_t i = 0; i < 4; i++)
+        for (uint64_t j = 0; j < 4; j++)
+            EXPECT_EQ((2 + i) * MATRIX_DIM + 3 + j, tile[i * 4 + j]);
+
+    // Tile within a larger local buffer, written back negated
+    memset(tile, 0, sizeof(tile));
+    EXPECT_NO_THROW(my_fam->fam_get_subarray(tile, item, offset,
+                                             sizeof(uint64_t), 2, shape,
+                                             famStrides, localStrides));
+    for (uint64_t i = 0; i < 4; i++)
+        for (uint64_t j = 0; j < 4; j++) {
+            EXPECT_EQ((2 + i) * MATRIX_DIM + 3 + j, tile[i * 8 + j]);
+            tile[i * 8 + j] = ~tile[i * 8 + j];
+        }
+    EXPECT_NO_THROW(my_fam->fam_put_subarray(tile, item, offset,
+                                             sizeof(uint64_t), 2, shape,
+                                             famStrides, localStrides));
+
+    EXPECT_NO_THROW(
+        my_fam->fam_get_blocking(matrix, item, 0, sizeof(matrix)));
+    for (uint64_t i = 0; i < MATRIX_DIM; i++)
+        for (uint64_t j = 0; j < MATRIX_DIM; j++) {
+            uint64_t value = i * MATRIX_DIM + j;
+            if ((i >= 2) && (i < 6) && (j >= 3) && (j < 7))
+                value = ~value;
+            EXPECT_EQ(value, matrix[i * MATRIX_DIM + j]);
+        }
+
+    EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+    EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+
+    delete item;
+    delete desc;
+
+    free((void *)testRegion);
+    free((void *)firstItem);
+}
+
+// Test case 2 - get a block of a cube, and invalid subarrays.
+TEST(FamSubarray, Subarray3DSuccess) {
+    Fam_Region_Descriptor *desc;
+    Fam_Descriptor *item;
+    const char *testRegion = get_uniq_str("test", my_fam);
+    const char *firstItem = get_uniq_str("first", my_fam);
+    uint32_t cube[CUBE_DIM * CUBE_DIM * CUBE_DIM];
+    uint32_t block[2 * 2 * 3];
+    uint64_t shape[4] = { 2, 2, 3, 1 };
+    uint64_t famStrides[4] = { CUBE_DIM * CUBE_DIM, CUBE_DIM, 1, 1 };
+
+    EXPECT_NO_THROW(
+        desc = my_fam->fam_create_region(testRegion, 8192, 0777, RAID1));
+    EXPECT_NE((void *)NULL, desc);
+
+    EXPECT_NO_THROW(
+        item = my_fam->fam_allocate(firstItem, sizeof(cube), 0777, desc));
+    EXPECT_NE((void *)NULL, item);
+
+    for (uint32_t i = 0; i < CUBE_DIM * CUBE_DIM * CUBE_DIM; i++)
+        cube[i] = i;
+    EXPECT_NO_THROW(my_fam->fam_put_blocking(cube, item, 0, sizeof(cube)));
+
+    uint64_t offset = (CUBE_DIM * CUBE_DIM + CUBE_DIM + 1) * sizeof(uint32_t);
+    EXPECT_NO_THROW(my_fam->fam_get_subarray(block, item, offset,
+                                             sizeof(uint32_t), 3, shape,
+                                             famStrides));
+    for (uint32_t i = 0; i < 2; i++)
+        for (uint32_t j = 0; j < 2; j++)
+            for (uint32_t k = 0; k < 3; k++)
+                EXPECT_EQ((1 + i) * CUBE_DIM * CUBE_DIM +
+                              (1 + j) * CUBE_DIM + 1 + k,
+                          block[(i * 2 + j) * 3 + k]);
+
+    // Invalid number of dimensions or shape
+    EXPECT_THROW(my_fam->fam_get_subarray(block, item, 0, sizeof(uint32_t),
+                                          4, shape, famStrides),
+                 Fam_Exception);
+    EXPECT_THROW(my_fam->fam_get_subarray(block, item, 0, sizeof(uint32_t),
+                                          0, shape, famStrides),
+                 Fam_Exception);
+    EXPECT_THROW(my_fam->fam_get_subarray(block, item, 0, sizeof(uint32_t),
+                                          2, shape, NULL),
+                 Fam_Exception);
+
+    // Subarray beyond the data item, or whose extent overflows
+    uint64_t lastOffset = (CUBE_DIM * CUBE_DIM * CUBE_DIM - 1) *
+                          sizeof(uint32_t);
+    EXPECT_THROW(my_fam->fam_get_subarray(block, item, lastOffset,
+                                          sizeof(uint32_t), 3, shape,
+                                          famStrides),
+                 Fam_Datapath_Exception);
+    uint64_t hugeStrides[3] = { UINT64_MAX / 2, CUBE_DIM, 1 };
+    EXPECT_THROW(my_fam->fam_put_subarray(block, item, 0, sizeof(uint32_t),
+                                          3, shape, hugeStrides),
+                 Fam_Datapath_Exception);
+
+    EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+    EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+
+    delete item;
+    delete desc;
+
+    free((void *)testRegion);
+    free((void *)firstItem);
+}
+
+int main(int argc, char **argv) {
+    int ret;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    my_fam = new fam();
+
+    init_fam_options(&fam_opts);
+
+    EXPECT_NO_THROW(my_fam->fam_initialize("default", &fam_opts));
+
+    ret = RUN_ALL_TESTS();
+
+    EXPECT_NO_THROW(my_fam->fam_finalize("default"));
+
+    return ret;
+}
@@ -0,0 +1,156 @@
+/*
+ * fam_wait_until_reg_test.cpp
+ * Copyright (c) 2020 Hewlett Packard Enterprise Development, LP. All rights
+ * reserved. Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+#include <fam/fam_exception.h>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <stdio.h>
+#include <string.h>
+
+#include <fam/fam.h>
+
+#include "common/fam_test_config.h"
+
+using namespace std;
+using namespace openfam;
+
+fam *my_fam;
+Fam_Options fam_opts;
+int myPE;
+int numPEs;
+
+// Test case 1 - wait on words which already satisfy the condition.
+TEST(FamWaitUntil, WaitUntilLocalSuccess) {
+    Fam_Region_Descriptor *desc;
+    Fam_Descriptor *item;
+    const char *testRegion = get_uniq_str("test", my_fam);
+    const char *firstItem = get_uniq_str("first", my_fam);
+    uint64_t offsets[4] = { 0, 8, 16, 24 };
+
+    EXPECT_NO_THROW(
+        desc = my_fam->fam_create_region(testRegion, 8192, 0777, RAID1));
+    EXPECT_NE((void *)NULL, desc);
+
+    EXPECT_NO_THROW(item = my_fam->fam_allocate(firstItem, 1024, 0777, desc));
+    EXPECT_NE((void *)NULL, item);
+
+    for (uint64_t i = 0; i < 4; i++)
+        EXPECT_NO_THROW(my_fam->fam_set(item, offsets[i], i));
+    EXPECT_NO_THROW(my_fam->fam_quiet());
+
+    EXPECT_EQ((uint64_t)2,
+              my_fam->fam_wait_until(item, 16, FAM_CMP_EQ, (uint64_t)2));
+    EXPECT_EQ((uint64_t)3,
+              my_fam->fam_wait_until(item, 24, FAM_CMP_GT, (uint64_t)1));
+    EXPECT_EQ((uint64_t)0,
+              my_fam->fam_wait_until(item, 0, FAM_CMP_LE, (uint64_t)0));
+    EXPECT_EQ((uint64_t)1,
+              my_fam->fam_wait_until(item, 8, FAM_CMP_NE, (uint64_t)0));
+
+    EXPECT_EQ((uint64_t)3, my_fam->fam_wait_until_any(item, offsets, 4,
+                                                      FAM_CMP_GE, (uint64_t)3));
+    EXPECT_NO_THROW(my_fam->fam_wait_until_all(item, offsets, 4, FAM_CMP_LT,
+                                               (uint64_t)4));
+
+    // Invalid comparison
+    EXPECT_THROW(my_fam->fam_wait_until(item, 0, (Fam_Cmp)10, (uint64_t)0),
+                 Fam_Exception);
+
+    EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+    EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+
+    delete item;
+    delete desc;
+
+    free((void *)testRegion);
+    free((void *)firstItem);
+}
+
+// Test case 2 - every PE waits for the data and signal put by the previous
+// PE.
+TEST(FamWaitUntil, WaitUntilSignalSuccess) {
+    Fam_Region_Descriptor *desc = NULL;
+    Fam_Descriptor *item = NULL;
+    uint64_t size = numPEs * 2 * sizeof(uint64_t);
+
+    if (myPE == 0) {
+        EXPECT_NO_THROW(desc = my_fam->fam_create_region("waitRegion", 8192,
+                                                         0777, RAID1));
+        EXPECT_NO_THROW(item = my_fam->fam_allocate("waitItem", size, 0777,
+                                                    desc));
+        for (int pe = 0; pe < numPEs; pe++)
+            EXPECT_NO_THROW(
+                my_fam->fam_set(item, pe * 2 * sizeof(uint64_t), (uint64_t)0));
+        EXPECT_NO_THROW(my_fam->fam_quiet());
+    }
+    EXPECT_NO_THROW(item = my_fam->fam_broadcast_descriptor(0, item));
+    my_fam->fam_barrier_all();
+
+    // Slot of a PE: signal word followed by the data
+    uint64_t next = ((myPE + 1) % numPEs) * 2 * sizeof(uint64_t);
+    uint64_t mine = myPE * 2 * sizeof(uint64_t);
+    uint64_t data = 100 + myPE;
+    EXPECT_NO_THROW(my_fam->fam_put_signal(&data, item,
+                                           next + sizeof(uint64_t),
+                                           sizeof(data), item, next,
+                                           (uint64_t)1, FAM_SIGNAL_SET));
+    EXPECT_EQ((uint64_t)1,
+              my_fam->fam_wait_until(item, mine, FAM_CMP_EQ, (uint64_t)1));
+    uint64_t received = 0;
+    EXPECT_NO_THROW(my_fam->fam_get_blocking(
+        &received, item, mine + sizeof(uint64_t), sizeof(received)));
+    EXPECT_EQ((uint64_t)(100 + (myPE + numPEs - 1) % numPEs), received);
+
+    my_fam->fam_barrier_all();
+    if (myPE == 0) {
+        EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+        EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+        delete desc;
+    }
+    delete item;
+}
+
+int main(int argc, char **argv) {
+    int ret;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    my_fam = new fam();
+
+    init_fam_options(&fam_opts);
+
+    EXPECT_NO_THROW(my_fam->fam_initialize("default", &fam_opts));
+    myPE = *(int *)my_fam->fam_get_option(strdup("PE_ID"));
+    numPEs = *(int *)my_fam->fam_get_option(strdup("PE_COUNT"));
+
+    ret = RUN_ALL_TESTS();
+
+    EXPECT_NO_THROW(my_fam->fam_finalize("default"));
+
+    return ret;
+}
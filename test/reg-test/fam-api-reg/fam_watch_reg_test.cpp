@@ -0,0 +1,158 @@
+/*
+ * fam_watch_reg_test.cpp
+ * Copyright (c) 2020 Hewlett Packard Enterprise Development, LP. All rights
+ * reserved. Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+#include <fam/fam_exception.h>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <fam/fam.h>
+
+#include "common/fam_test_config.h"
+
+using namespace std;
+using namespace openfam;
+
+fam *my_fam;
+Fam_Options fam_opts;
+
+#define WATCH_INTERVAL 10
+#define WATCH_TIMEOUT 1000
+
+// Test case 1 - changes within the watched range are reported, and changes
+// between two calls of fam_watch_next are coalesced.
+TEST(FamWatch, WatchSuccess) {
+    Fam_Region_Descriptor *desc;
+    Fam_Descriptor *item;
+    Fam_Watch *watch = NULL;
+    const char *testRegion = get_uniq_str("test", my_fam);
+    const char *firstItem = get_uniq_str("first", my_fam);
+    char zeros[1024];
+    uint64_t pattern = 0x0101010101010101;
+    uint64_t offset, nbytes;
+
+    EXPECT_NO_THROW(
+        desc = my_fam->fam_create_region(testRegion, 8192, 0777, RAID1));
+    EXPECT_NE((void *)NULL, desc);
+
+    EXPECT_NO_THROW(item = my_fam->fam_allocate(firstItem, 1024, 0777, desc));
+    EXPECT_NE((void *)NULL, item);
+
+    memset(zeros, 0, sizeof(zeros));
+    EXPECT_NO_THROW(my_fam->fam_put_blocking(zeros, item, 0, sizeof(zeros)));
+
+    EXPECT_NO_THROW(watch = my_fam->fam_watch(item, 64, 256, WATCH_INTERVAL));
+    EXPECT_NE((void *)NULL, watch);
+
+    // No change yet
+    EXPECT_FALSE(my_fam->fam_watch_next(watch, &offset, &nbytes, 100));
+
+    // Single change
+    EXPECT_NO_THROW(
+        my_fam->fam_put_blocking(&pattern, item, 128, sizeof(pattern)));
+    EXPECT_TRUE(
+        my_fam->fam_watch_next(watch, &offset, &nbytes, WATCH_TIMEOUT));
+    EXPECT_EQ((uint64_t)128, offset);
+    EXPECT_EQ(sizeof(pattern), nbytes);
+
+    // Two changes picked up at once are reported as one range
+    EXPECT_NO_THROW(
+        my_fam->fam_put_blocking(&pattern, item, 96, sizeof(pattern)));
+    EXPECT_NO_THROW(my_fam->fam_add(item, 200, (uint64_t)1));
+    EXPECT_NO_THROW(my_fam->fam_quiet());
+    usleep(20 * WATCH_INTERVAL * 1000);
+    EXPECT_TRUE(
+        my_fam->fam_watch_next(watch, &offset, &nbytes, WATCH_TIMEOUT));
+    EXPECT_EQ((uint64_t)96, offset);
+    EXPECT_EQ((uint64_t)(200 + 1 - 96), nbytes);
+
+    // Changes outside of the watched range are not reported
+    EXPECT_NO_THROW(
+        my_fam->fam_put_blocking(&pattern, item, 512, sizeof(pattern)));
+    EXPECT_FALSE(my_fam->fam_watch_next(watch, &offset, &nbytes, 100));
+
+    EXPECT_NO_THROW(my_fam->fam_unwatch(watch));
+
+    EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+    EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+
+    delete item;
+    delete desc;
+
+    free((void *)testRegion);
+    free((void *)firstItem);
+}
+
+// Test case 2 - invalid watches.
+TEST(FamWatch, WatchInvalid) {
+    Fam_Region_Descriptor *desc;
+    Fam_Descriptor *item;
+    const char *testRegion = get_uniq_str("test", my_fam);
+    const char *firstItem = get_uniq_str("first", my_fam);
+
+    EXPECT_NO_THROW(
+        desc = my_fam->fam_create_region(testRegion, 8192, 0777, RAID1));
+    EXPECT_NE((void *)NULL, desc);
+
+    EXPECT_NO_THROW(item = my_fam->fam_allocate(firstItem, 1024, 0777, desc));
+    EXPECT_NE((void *)NULL, item);
+
+    EXPECT_THROW(my_fam->fam_watch(item, 0, 0, WATCH_INTERVAL), Fam_Exception);
+    EXPECT_THROW(my_fam->fam_watch(item, 1000, 100, WATCH_INTERVAL),
+                 Fam_Exception);
+    EXPECT_THROW(my_fam->fam_watch(NULL, 0, 8, WATCH_INTERVAL), Fam_Exception);
+
+    EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+    EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+
+    delete item;
+    delete desc;
+
+    free((void *)testRegion);
+    free((void *)firstItem);
+}
+
+int main(int argc, char **argv) {
+    int ret;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    my_fam = new fam();
+
+    init_fam_options(&fam_opts);
+
+    EXPECT_NO_THROW(my_fam->fam_initialize("default", &fam_opts));
+
+    ret = RUN_ALL_TESTS();
+
+    EXPECT_NO_THROW(my_fam->fam_finalize("default"));
+
+    return ret;
+}